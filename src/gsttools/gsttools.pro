@@ -32,7 +32,9 @@ PRIVATE_HEADERS += \
     qgstreamervideooverlay_p.h \
     qgsttools_global_p.h \
     qgstreamerplayersession_p.h \
-    qgstreamerplayercontrol_p.h
+    qgstreamerplayercontrol_p.h \
+    qgstreamerstatisticscontrol_p.h \
+    qgstreamerpreloadcontrol_p.h
 
 SOURCES += \
     qgstreamerbushelper.cpp \
@@ -50,7 +52,9 @@ SOURCES += \
     qgstreamervideowindow.cpp \
     qgstreamervideooverlay.cpp \
     qgstreamerplayersession.cpp \
-    qgstreamerplayercontrol.cpp
+    qgstreamerplayercontrol.cpp \
+    qgstreamerstatisticscontrol.cpp \
+    qgstreamerpreloadcontrol.cpp
 
 qtHaveModule(widgets) {
     QT += multimediawidgets
@@ -39,10 +39,163 @@
 
 #include "qgstcodecsinfo_p.h"
 #include "qgstutils_p.h"
+#include <QtCore/qmutex.h>
 #include <QtCore/qset.h>
+#include <QtCore/qthreadpool.h>
 
 #include <gst/pbutils/pbutils.h>
 
+namespace {
+
+struct QGstElementOptions
+{
+    QStringList names;
+    QHash<QString, QGstCodecsInfo::CodecOption> options;
+};
+
+struct QGstCodecsTable
+{
+    bool built = false;
+    QStringList codecs;
+    QHash<QString, QGstCodecsInfo::CodecInfo> codecInfo;
+    QHash<QString, QSet<QString>> streamTypes;
+};
+
+// Scanning the registry and the encoder properties is expensive, so it is
+// done once per process and shared by all QGstCodecsInfo instances.
+struct QGstCodecsInfoCache
+{
+    QMutex mutex;
+    QGstCodecsTable tables[QGstCodecsInfo::Muxer + 1];
+    QHash<QByteArray, QGstElementOptions> elementOptions;
+};
+
+}
+
+Q_GLOBAL_STATIC(QGstCodecsInfoCache, qt_gstCodecsInfoCache)
+
+static QGstCodecsInfo::CodecOption optionFromParamSpec(GParamSpec *property)
+{
+    QGstCodecsInfo::CodecOption option;
+    option.name = QLatin1String(property->name);
+
+    if (G_IS_PARAM_SPEC_BOOLEAN(property)) {
+        option.defaultValue = bool(G_PARAM_SPEC_BOOLEAN(property)->default_value);
+    } else if (G_IS_PARAM_SPEC_INT(property)) {
+        GParamSpecInt *spec = G_PARAM_SPEC_INT(property);
+        option.defaultValue = spec->default_value;
+        option.minimum = spec->minimum;
+        option.maximum = spec->maximum;
+    } else if (G_IS_PARAM_SPEC_UINT(property)) {
+        GParamSpecUInt *spec = G_PARAM_SPEC_UINT(property);
+        option.defaultValue = spec->default_value;
+        option.minimum = spec->minimum;
+        option.maximum = spec->maximum;
+    } else if (G_IS_PARAM_SPEC_LONG(property)) {
+        GParamSpecLong *spec = G_PARAM_SPEC_LONG(property);
+        option.defaultValue = qlonglong(spec->default_value);
+        option.minimum = qlonglong(spec->minimum);
+        option.maximum = qlonglong(spec->maximum);
+    } else if (G_IS_PARAM_SPEC_ULONG(property)) {
+        GParamSpecULong *spec = G_PARAM_SPEC_ULONG(property);
+        option.defaultValue = qulonglong(spec->default_value);
+        option.minimum = qulonglong(spec->minimum);
+        option.maximum = qulonglong(spec->maximum);
+    } else if (G_IS_PARAM_SPEC_INT64(property)) {
+        GParamSpecInt64 *spec = G_PARAM_SPEC_INT64(property);
+        option.defaultValue = qlonglong(spec->default_value);
+        option.minimum = qlonglong(spec->minimum);
+        option.maximum = qlonglong(spec->maximum);
+    } else if (G_IS_PARAM_SPEC_UINT64(property)) {
+        GParamSpecUInt64 *spec = G_PARAM_SPEC_UINT64(property);
+        option.defaultValue = qulonglong(spec->default_value);
+        option.minimum = qulonglong(spec->minimum);
+        option.maximum = qulonglong(spec->maximum);
+    } else if (G_IS_PARAM_SPEC_FLOAT(property)) {
+        GParamSpecFloat *spec = G_PARAM_SPEC_FLOAT(property);
+        option.defaultValue = double(spec->default_value);
+        option.minimum = double(spec->minimum);
+        option.maximum = double(spec->maximum);
+    } else if (G_IS_PARAM_SPEC_DOUBLE(property)) {
+        GParamSpecDouble *spec = G_PARAM_SPEC_DOUBLE(property);
+        option.defaultValue = spec->default_value;
+        option.minimum = spec->minimum;
+        option.maximum = spec->maximum;
+    } else if (G_IS_PARAM_SPEC_ENUM(property)) {
+        GParamSpecEnum *spec = G_PARAM_SPEC_ENUM(property);
+        option.defaultValue = spec->default_value;
+        option.minimum = spec->enum_class->minimum;
+        option.maximum = spec->enum_class->maximum;
+    } else if (G_IS_PARAM_SPEC_STRING(property)) {
+        option.defaultValue = QString::fromUtf8(G_PARAM_SPEC_STRING(property)->default_value);
+    }
+
+    return option;
+}
+
+// Reads the properties from the element class, without creating an instance.
+static QGstElementOptions introspectElement(const QByteArray &elementName)
+{
+    QGstElementOptions options;
+
+    GstElementFactory *factory = gst_element_factory_find(elementName.constData());
+    if (!factory)
+        return options;
+
+    GstPluginFeature *loaded = gst_plugin_feature_load(GST_PLUGIN_FEATURE(factory));
+    gst_object_unref(GST_OBJECT(factory));
+    if (!loaded)
+        return options;
+
+    const GType type = gst_element_factory_get_element_type(GST_ELEMENT_FACTORY(loaded));
+    if (type != G_TYPE_INVALID) {
+        gpointer elementClass = g_type_class_ref(type);
+
+        guint numProperties;
+        GParamSpec **properties = g_object_class_list_properties(G_OBJECT_CLASS(elementClass),
+                                                                 &numProperties);
+        for (guint j = 0; j < numProperties; ++j) {
+            GParamSpec *property = properties[j];
+            // ignore some properties
+            if (strcmp(property->name, "name") == 0 || strcmp(property->name, "parent") == 0)
+                continue;
+
+            const QGstCodecsInfo::CodecOption option = optionFromParamSpec(property);
+            options.names.append(option.name);
+            options.options.insert(option.name, option);
+        }
+        g_free(properties);
+        g_type_class_unref(elementClass);
+    }
+    gst_object_unref(GST_OBJECT(loaded));
+
+    return options;
+}
+
+static QGstElementOptions elementOptions(const QByteArray &elementName)
+{
+    if (elementName.isEmpty())
+        return QGstElementOptions();
+
+    QGstCodecsInfoCache *cache = qt_gstCodecsInfoCache();
+    if (!cache)
+        return introspectElement(elementName);
+
+    {
+        QMutexLocker locker(&cache->mutex);
+        auto it = cache->elementOptions.constFind(elementName);
+        if (it != cache->elementOptions.constEnd())
+            return *it;
+    }
+
+    // Not reached by the background scan yet
+    const QGstElementOptions options = introspectElement(elementName);
+
+    QMutexLocker locker(&cache->mutex);
+    cache->elementOptions.insert(elementName, options);
+    return options;
+}
+
 static QSet<QString> streamTypes(GstElementFactory *factory, GstPadDirection direction)
 {
     QSet<QString> types;
@@ -64,6 +217,17 @@ static QSet<QString> streamTypes(GstElementFactory *factory, GstPadDirection dir
 
 QGstCodecsInfo::QGstCodecsInfo(QGstCodecsInfo::ElementType elementType)
 {
+    QGstCodecsInfoCache *cache = qt_gstCodecsInfoCache();
+    QMutexLocker locker(cache ? &cache->mutex : nullptr);
+
+    if (cache && cache->tables[elementType].built) {
+        const QGstCodecsTable &table = cache->tables[elementType];
+        m_codecs = table.codecs;
+        m_codecInfo = table.codecInfo;
+        m_streamTypes = table.streamTypes;
+        return;
+    }
+
     updateCodecs(elementType);
     for (auto &codec : supportedCodecs()) {
         GstElementFactory *factory = gst_element_factory_find(codecElement(codec).constData());
@@ -73,6 +237,29 @@ QGstCodecsInfo::QGstCodecsInfo(QGstCodecsInfo::ElementType elementType)
             gst_object_unref(GST_OBJECT(factory));
         }
     }
+
+    if (!cache)
+        return;
+
+    QGstCodecsTable &table = cache->tables[elementType];
+    table.codecs = m_codecs;
+    table.codecInfo = m_codecInfo;
+    table.streamTypes = m_streamTypes;
+    table.built = true;
+
+    // Encoder options are only queried later, while the settings are
+    // validated, so scan them in the background.
+    if (elementType != Muxer) {
+        QByteArrayList elements;
+        for (auto it = m_codecInfo.cbegin(), end = m_codecInfo.cend(); it != end; ++it) {
+            if (!elements.contains(it->elementName))
+                elements.append(it->elementName);
+        }
+        QThreadPool::globalInstance()->start([elements]() {
+            for (const QByteArray &element : elements)
+                elementOptions(element);
+        });
+    }
 }
 
 QStringList QGstCodecsInfo::supportedCodecs() const
@@ -93,30 +280,22 @@ QByteArray QGstCodecsInfo::codecElement(const QString &codec) const
 
 QStringList QGstCodecsInfo::codecOptions(const QString &codec) const
 {
-    QStringList options;
-
-    QByteArray elementName = m_codecInfo.value(codec).elementName;
-    if (elementName.isEmpty())
-        return options;
+    return elementOptionNames(m_codecInfo.value(codec).elementName);
+}
 
-    GstElement *element = gst_element_factory_make(elementName, nullptr);
-    if (element) {
-        guint numProperties;
-        GParamSpec **properties = g_object_class_list_properties(G_OBJECT_GET_CLASS(element),
-                                                                 &numProperties);
-        for (guint j = 0; j < numProperties; ++j) {
-            GParamSpec *property = properties[j];
-            // ignore some properties
-            if (strcmp(property->name, "name") == 0 || strcmp(property->name, "parent") == 0)
-                continue;
+QGstCodecsInfo::CodecOption QGstCodecsInfo::codecOption(const QString &codec, const QString &option) const
+{
+    return elementOption(m_codecInfo.value(codec).elementName, option);
+}
 
-            options.append(QLatin1String(property->name));
-        }
-        g_free(properties);
-        gst_object_unref(element);
-    }
+QStringList QGstCodecsInfo::elementOptionNames(const QByteArray &elementName)
+{
+    return elementOptions(elementName).names;
+}
 
-    return options;
+QGstCodecsInfo::CodecOption QGstCodecsInfo::elementOption(const QByteArray &elementName, const QString &option)
+{
+    return elementOptions(elementName).options.value(option);
 }
 
 void QGstCodecsInfo::updateCodecs(ElementType elementType)
@@ -183,7 +362,7 @@ void QGstCodecsInfo::updateCodecs(ElementType elementType)
                     GstRank rank = GstRank(gst_plugin_feature_get_rank(GST_PLUGIN_FEATURE(factory)));
 
                     // If two elements provide the same codec, use the highest ranked one
-                    QMap<QString, CodecInfo>::const_iterator it = m_codecInfo.constFind(codec);
+                    QHash<QString, CodecInfo>::const_iterator it = m_codecInfo.constFind(codec);
                     if (it == m_codecInfo.constEnd() || it->rank < rank) {
                         if (it == m_codecInfo.constEnd())
                             m_codecs.append(codec);
@@ -52,8 +52,9 @@
 //
 
 #include <private/qgsttools_global_p.h>
-#include <QtCore/qmap.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qvariant.h>
 #include <QSet>
 
 #include <gst/gst.h>
@@ -71,25 +72,40 @@ public:
         GstRank rank;
     };
 
+    // An encoder property, minimum and maximum are only set for numeric
+    // and enum properties.
+    struct CodecOption {
+        QString name;
+        QVariant defaultValue;
+        QVariant minimum;
+        QVariant maximum;
+    };
+
     QGstCodecsInfo(ElementType elementType);
 
     QStringList supportedCodecs() const;
     QString codecDescription(const QString &codec) const;
     QByteArray codecElement(const QString &codec) const;
     QStringList codecOptions(const QString &codec) const;
+    CodecOption codecOption(const QString &codec, const QString &option) const;
     QSet<QString> supportedStreamTypes(const QString &codec) const;
     QStringList supportedCodecs(const QSet<QString> &types) const;
 
+    // The options of any element, as reported for the codecs it provides
+    static QStringList elementOptionNames(const QByteArray &elementName);
+    static CodecOption elementOption(const QByteArray &elementName, const QString &option);
+
 private:
     void updateCodecs(ElementType elementType);
     GList *elementFactories(ElementType elementType) const;
 
     QStringList m_codecs;
-    QMap<QString, CodecInfo> m_codecInfo;
-    QMap<QString, QSet<QString>> m_streamTypes;
+    QHash<QString, CodecInfo> m_codecInfo;
+    QHash<QString, QSet<QString>> m_streamTypes;
 };
 
 Q_DECLARE_TYPEINFO(QGstCodecsInfo::CodecInfo, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QGstCodecsInfo::CodecOption, Q_MOVABLE_TYPE);
 
 QT_END_NAMESPACE
 
@@ -55,6 +55,8 @@
 #include <QtMultimedia/qmediametadata.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qsize.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qdebug.h>
@@ -110,16 +112,14 @@ typedef enum {
 static GstStaticCaps static_RawCaps = GST_STATIC_CAPS(DEFAULT_RAW_CAPS);
 #endif
 
-QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
-    : QObject(parent)
+// Builds the playbin with its audio output and the video output bin, without
+// anything tied to a particular session.
+static QGstreamerPlaybin createPlaybin()
 {
-    initPlaybin();
-}
+    QGstreamerPlaybin elements;
 
-void QGstreamerPlayerSession::initPlaybin()
-{
-    m_playbin = gst_element_factory_make(QT_GSTREAMER_PLAYBIN_ELEMENT_NAME, nullptr);
-    if (m_playbin) {
+    elements.playbin = gst_element_factory_make(QT_GSTREAMER_PLAYBIN_ELEMENT_NAME, nullptr);
+    if (elements.playbin) {
         //GST_PLAY_FLAG_NATIVE_VIDEO omits configuration of ffmpegcolorspace and videoscale,
         //since those elements are included in the video output bin when necessary.
         int flags = GST_PLAY_FLAG_VIDEO | GST_PLAY_FLAG_AUDIO;
@@ -131,33 +131,32 @@ void QGstreamerPlayerSession::initPlaybin()
             flags |= GST_PLAY_FLAG_NATIVE_VIDEO;
 #endif
         }
-        g_object_set(G_OBJECT(m_playbin), "flags", flags, nullptr);
+        g_object_set(G_OBJECT(elements.playbin), "flags", flags, nullptr);
 
         const QByteArray envAudioSink = qgetenv("QT_GSTREAMER_PLAYBIN_AUDIOSINK");
         GstElement *audioSink = gst_element_factory_make(envAudioSink.isEmpty() ? "autoaudiosink" : envAudioSink, "audiosink");
         if (audioSink) {
             if (usePlaybinVolume()) {
-                m_audioSink = audioSink;
-                m_volumeElement = m_playbin;
+                elements.audioSink = audioSink;
+                elements.volumeElement = elements.playbin;
             } else {
-                m_volumeElement = gst_element_factory_make("volume", "volumeelement");
-                if (m_volumeElement) {
-                    m_audioSink = gst_bin_new("audio-output-bin");
+                elements.volumeElement = gst_element_factory_make("volume", "volumeelement");
+                if (elements.volumeElement) {
+                    elements.audioSink = gst_bin_new("audio-output-bin");
 
-                    gst_bin_add_many(GST_BIN(m_audioSink), m_volumeElement, audioSink, nullptr);
-                    gst_element_link(m_volumeElement, audioSink);
+                    gst_bin_add_many(GST_BIN(elements.audioSink), elements.volumeElement, audioSink, nullptr);
+                    gst_element_link(elements.volumeElement, audioSink);
 
-                    GstPad *pad = gst_element_get_static_pad(m_volumeElement, "sink");
-                    gst_element_add_pad(GST_ELEMENT(m_audioSink), gst_ghost_pad_new("sink", pad));
+                    GstPad *pad = gst_element_get_static_pad(elements.volumeElement, "sink");
+                    gst_element_add_pad(GST_ELEMENT(elements.audioSink), gst_ghost_pad_new("sink", pad));
                     gst_object_unref(GST_OBJECT(pad));
                 } else {
-                    m_audioSink = audioSink;
-                    m_volumeElement = m_playbin;
+                    elements.audioSink = audioSink;
+                    elements.volumeElement = elements.playbin;
                 }
             }
 
-            g_object_set(G_OBJECT(m_playbin), "audio-sink", m_audioSink, nullptr);
-            addAudioBufferProbe();
+            g_object_set(G_OBJECT(elements.playbin), "audio-sink", elements.audioSink, nullptr);
         }
     }
 
@@ -170,58 +169,198 @@ void QGstreamerPlayerSession::initPlaybin()
         qWarning() << "Error:" << convDesc << ":" << QLatin1String(err->message);
         g_clear_error(&err);
     }
-    m_videoIdentity = convElement;
+    elements.videoIdentity = convElement;
 #else
-    m_videoIdentity = GST_ELEMENT(g_object_new(gst_video_connector_get_type(), 0)); // floating ref
-    g_signal_connect(G_OBJECT(m_videoIdentity), "connection-failed", G_CALLBACK(insertColorSpaceElement), (gpointer)this);
-    m_colorSpace = gst_element_factory_make(QT_GSTREAMER_COLORCONVERSION_ELEMENT_NAME, "ffmpegcolorspace-vo");
+    elements.videoIdentity = GST_ELEMENT(g_object_new(gst_video_connector_get_type(), 0)); // floating ref
+    elements.colorSpace = gst_element_factory_make(QT_GSTREAMER_COLORCONVERSION_ELEMENT_NAME, "ffmpegcolorspace-vo");
 
     // might not get a parent, take ownership to avoid leak
-    qt_gst_object_ref_sink(GST_OBJECT(m_colorSpace));
+    qt_gst_object_ref_sink(GST_OBJECT(elements.colorSpace));
 #endif
 
-    m_nullVideoSink = gst_element_factory_make("fakesink", nullptr);
-    g_object_set(G_OBJECT(m_nullVideoSink), "sync", true, nullptr);
-    gst_object_ref(GST_OBJECT(m_nullVideoSink));
+    elements.nullVideoSink = gst_element_factory_make("fakesink", nullptr);
+    g_object_set(G_OBJECT(elements.nullVideoSink), "sync", true, nullptr);
+    gst_object_ref(GST_OBJECT(elements.nullVideoSink));
 
-    m_videoOutputBin = gst_bin_new("video-output-bin");
+    elements.videoOutputBin = gst_bin_new("video-output-bin");
     // might not get a parent, take ownership to avoid leak
-    qt_gst_object_ref_sink(GST_OBJECT(m_videoOutputBin));
+    qt_gst_object_ref_sink(GST_OBJECT(elements.videoOutputBin));
 
-    GstElement *videoOutputSink = m_videoIdentity;
+    GstElement *videoOutputSink = elements.videoIdentity;
 #if QT_CONFIG(gstreamer_gl)
     if (QGstUtils::useOpenGL()) {
         videoOutputSink = gst_element_factory_make("glupload", nullptr);
         GstElement *colorConvert = gst_element_factory_make("glcolorconvert", nullptr);
-        gst_bin_add_many(GST_BIN(m_videoOutputBin), videoOutputSink, colorConvert, m_videoIdentity, m_nullVideoSink, nullptr);
-        gst_element_link_many(videoOutputSink, colorConvert, m_videoIdentity, nullptr);
+        gst_bin_add_many(GST_BIN(elements.videoOutputBin), videoOutputSink, colorConvert, elements.videoIdentity, elements.nullVideoSink, nullptr);
+        gst_element_link_many(videoOutputSink, colorConvert, elements.videoIdentity, nullptr);
     } else {
-        gst_bin_add_many(GST_BIN(m_videoOutputBin), m_videoIdentity, m_nullVideoSink, nullptr);
+        gst_bin_add_many(GST_BIN(elements.videoOutputBin), elements.videoIdentity, elements.nullVideoSink, nullptr);
     }
 #else
-    gst_bin_add_many(GST_BIN(m_videoOutputBin), m_videoIdentity, m_nullVideoSink, nullptr);
+    gst_bin_add_many(GST_BIN(elements.videoOutputBin), elements.videoIdentity, elements.nullVideoSink, nullptr);
 #endif
-    gst_element_link(m_videoIdentity, m_nullVideoSink);
-
-    m_videoSink = m_nullVideoSink;
+    gst_element_link(elements.videoIdentity, elements.nullVideoSink);
 
     // add ghostpads
     GstPad *pad = gst_element_get_static_pad(videoOutputSink, "sink");
-    gst_element_add_pad(GST_ELEMENT(m_videoOutputBin), gst_ghost_pad_new("sink", pad));
+    gst_element_add_pad(GST_ELEMENT(elements.videoOutputBin), gst_ghost_pad_new("sink", pad));
     gst_object_unref(GST_OBJECT(pad));
 
+    if (elements.playbin)
+        g_object_set(G_OBJECT(elements.playbin), "video-sink", elements.videoOutputBin, nullptr);
+
+    return elements;
+}
+
+static void releasePlaybin(QGstreamerPlaybin &elements)
+{
+    if (elements.playbin)
+        gst_object_unref(GST_OBJECT(elements.playbin));
+#if !GST_CHECK_VERSION(1,0,0)
+    if (elements.colorSpace)
+        gst_object_unref(GST_OBJECT(elements.colorSpace));
+#endif
+    if (elements.nullVideoSink)
+        gst_object_unref(GST_OBJECT(elements.nullVideoSink));
+    if (elements.videoOutputBin)
+        gst_object_unref(GST_OBJECT(elements.videoOutputBin));
+
+    elements = QGstreamerPlaybin();
+}
+
+/*
+    Keeps a few playbins built ahead of time, so that neither a new session
+    nor a preload has to wait for the elements to be created and linked.
+    The pool is refilled from the event loop, one playbin at a time.
+
+    Nothing is built ahead until the first preload, so applications which
+    never preload do not keep an idle playbin with its decoders and sinks.
+*/
+class QGstreamerPlaybinPool
+{
+public:
+    ~QGstreamerPlaybinPool()
+    {
+        for (QGstreamerPlaybin &elements : m_idle)
+            releasePlaybin(elements);
+        delete m_context;
+    }
+
+    QGstreamerPlaybin take(bool preload = false)
+    {
+        QMutexLocker locker(&m_mutex);
+        if (preload)
+            m_preloaded = true;
+
+        QGstreamerPlaybin elements;
+        if (!m_idle.isEmpty()) {
+            elements = m_idle.takeFirst();
+        } else {
+            locker.unlock();
+            elements = createPlaybin();
+            locker.relock();
+        }
+
+        scheduleRefill();
+        return elements;
+    }
+
+private:
+    static int capacity()
+    {
+        static const int size = qEnvironmentVariableIsSet("QT_GSTREAMER_PLAYBIN_POOL_SIZE")
+                ? qMax(0, qEnvironmentVariableIntValue("QT_GSTREAMER_PLAYBIN_POOL_SIZE"))
+                : 1;
+        return size;
+    }
+
+    void scheduleRefill()
+    {
+        if (!m_preloaded || m_refillPending || m_idle.size() >= capacity() || !QCoreApplication::instance())
+            return;
+
+        // Sessions may be created on threads without an event loop, the
+        // refill always runs on the application thread.
+        if (!m_context) {
+            m_context = new QObject;
+            m_context->moveToThread(QCoreApplication::instance()->thread());
+        }
+
+        m_refillPending = true;
+        QMetaObject::invokeMethod(m_context, [this]() { refill(); }, Qt::QueuedConnection);
+    }
+
+    void refill()
+    {
+        QGstreamerPlaybin elements = createPlaybin();
+
+        QMutexLocker locker(&m_mutex);
+        m_refillPending = false;
+
+        if (!elements.playbin || m_idle.size() >= capacity()) {
+            releasePlaybin(elements);
+            return;
+        }
+
+        m_idle.append(elements);
+        scheduleRefill();
+    }
+
+    QMutex m_mutex;
+    QList<QGstreamerPlaybin> m_idle;
+    QObject *m_context = nullptr;
+    bool m_refillPending = false;
+    bool m_preloaded = false;
+};
+
+Q_GLOBAL_STATIC(QGstreamerPlaybinPool, playbinPool)
+
+QGstreamerPlayerSession::QGstreamerPlayerSession(QObject *parent)
+    : QObject(parent)
+{
+    initPlaybin();
+}
+
+void QGstreamerPlayerSession::initPlaybin()
+{
+    setPlaybin(playbinPool()->take(), false);
+}
+
+void QGstreamerPlayerSession::setPlaybin(const QGstreamerPlaybin &elements, bool prerolled)
+{
+    m_playbin = elements.playbin;
+    m_audioSink = elements.audioSink;
+    m_volumeElement = elements.volumeElement;
+    m_videoOutputBin = elements.videoOutputBin;
+    m_videoIdentity = elements.videoIdentity;
+#if !GST_CHECK_VERSION(1,0,0)
+    m_colorSpace = elements.colorSpace;
+    g_signal_connect(G_OBJECT(m_videoIdentity), "connection-failed", G_CALLBACK(insertColorSpaceElement), (gpointer)this);
+#endif
+    m_nullVideoSink = elements.nullVideoSink;
+    m_videoSink = m_nullVideoSink;
+
+    if (m_audioSink)
+        addAudioBufferProbe();
+
     if (m_playbin != 0) {
         // Sort out messages
         setBus(gst_element_get_bus(m_playbin));
 
-        g_object_set(G_OBJECT(m_playbin), "video-sink", m_videoOutputBin, nullptr);
+        // A preloaded playbin had its source configured while prerolling
+        if (!prerolled)
+            connectSourceSignals(m_playbin);
 
-        g_signal_connect(G_OBJECT(m_playbin), "notify::source", G_CALLBACK(playbinNotifySource), this);
-        g_signal_connect(G_OBJECT(m_playbin), "element-added",  G_CALLBACK(handleElementAdded), this);
+        if (prerolled && m_volumeElement) {
+            g_object_set(G_OBJECT(m_volumeElement), "volume", m_volume / 100.0, nullptr);
+            g_object_set(G_OBJECT(m_volumeElement), "mute", m_muted ? TRUE : FALSE, nullptr);
+        }
 
         if (usePlaybinVolume()) {
-            updateVolume();
-            updateMuted();
+            if (!prerolled) {
+                updateVolume();
+                updateMuted();
+            }
             g_signal_connect(G_OBJECT(m_playbin), "notify::volume", G_CALLBACK(handleVolumeChange), this);
             g_signal_connect(G_OBJECT(m_playbin), "notify::mute", G_CALLBACK(handleMutedChange), this);
         }
@@ -230,22 +369,31 @@ void QGstreamerPlayerSession::initPlaybin()
         g_signal_connect(G_OBJECT(m_playbin), "audio-changed", G_CALLBACK(handleStreamsChange), this);
         g_signal_connect(G_OBJECT(m_playbin), "text-changed", G_CALLBACK(handleStreamsChange), this);
 
-#if QT_CONFIG(gstreamer_app)
-        g_signal_connect(G_OBJECT(m_playbin), "deep-notify::source", G_CALLBACK(configureAppSrcElement), this);
-#endif
-
         m_pipeline = m_playbin;
         gst_object_ref(GST_OBJECT(m_pipeline));
     }
 }
 
+void QGstreamerPlayerSession::connectSourceSignals(GstElement *playbin)
+{
+    g_signal_connect(G_OBJECT(playbin), "notify::source", G_CALLBACK(playbinNotifySource), this);
+    g_signal_connect(G_OBJECT(playbin), "element-added",  G_CALLBACK(handleElementAdded), this);
+
+#if QT_CONFIG(gstreamer_app)
+    g_signal_connect(G_OBJECT(playbin), "deep-notify::source", G_CALLBACK(configureAppSrcElement), this);
+#endif
+}
+
 QGstreamerPlayerSession::~QGstreamerPlayerSession()
 {
+    discardPreload();
+
     if (m_pipeline) {
         stop();
 
         removeVideoBufferProbe();
         removeAudioBufferProbe();
+        detachStatistics();
 
         delete m_busHelper;
         m_busHelper = nullptr;
@@ -278,6 +426,7 @@ void QGstreamerPlayerSession::resetElements()
     m_videoIdentity = nullptr;
     m_pendingVideoSink = nullptr;
     m_videoSink = nullptr;
+    m_warmPipeline = false;
 }
 
 GstElement *QGstreamerPlayerSession::playbin() const
@@ -314,13 +463,14 @@ void QGstreamerPlayerSession::loadFromStream(const QNetworkRequest &request, QIO
     m_duration = 0;
     m_lastPosition = 0;
 
+    discardPreload();
+
     if (!m_appSrc)
         m_appSrc = new QGstAppSrc(this);
     m_appSrc->setStream(appSrcStream);
 
     if (!parsePipeline() && m_playbin) {
-        m_tags.clear();
-        emit tagsChanged();
+        clearTags();
 
         g_object_set(G_OBJECT(m_playbin), "uri", "appsrc://", nullptr);
 
@@ -350,11 +500,17 @@ void QGstreamerPlayerSession::loadFromUri(const QNetworkRequest &request)
     }
 #endif
 
+    const bool preloaded = m_preload.playbin && request == m_preloadRequest;
+    if (preloaded)
+        usePreload();
+    else
+        discardPreload();
+
     if (!parsePipeline() && m_playbin) {
-        m_tags.clear();
-        emit tagsChanged();
+        clearTags();
 
-        g_object_set(G_OBJECT(m_playbin), "uri", m_request.url().toEncoded().constData(), nullptr);
+        if (!preloaded)
+            g_object_set(G_OBJECT(m_playbin), "uri", m_request.url().toEncoded().constData(), nullptr);
 
         if (!m_streamTypes.isEmpty()) {
             m_streamProperties.clear();
@@ -365,6 +521,86 @@ void QGstreamerPlayerSession::loadFromUri(const QNetworkRequest &request)
     }
 }
 
+void QGstreamerPlayerSession::preload(const QNetworkRequest &request)
+{
+#ifdef DEBUG_PLAYBIN
+    qDebug() << Q_FUNC_INFO << request.url();
+#endif
+    if (m_preload.playbin && request == m_preloadRequest)
+        return;
+
+    discardPreload();
+
+    // Custom pipelines are built on demand and can't be prepared ahead
+    if (request.url().isEmpty() || request.url().scheme() == QLatin1String("gst-pipeline"))
+        return;
+
+    m_preload = playbinPool()->take(true);
+    if (!m_preload.playbin) {
+        releasePlaybin(m_preload);
+        return;
+    }
+
+    m_preloadRequest = request;
+    m_preloadSourceType = UnknownSrc;
+    m_preloadIsLiveSource = false;
+
+    // The bus is not watched until the playbin is used, so the messages
+    // posted while prerolling are delivered to the session afterwards.
+    connectSourceSignals(m_preload.playbin);
+    g_object_set(G_OBJECT(m_preload.playbin), "uri", request.url().toEncoded().constData(), nullptr);
+
+    if (gst_element_set_state(m_preload.playbin, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE)
+        discardPreload();
+}
+
+void QGstreamerPlayerSession::discardPreload()
+{
+    if (!m_preload.playbin)
+        return;
+
+    gst_element_set_state(m_preload.playbin, GST_STATE_NULL);
+    g_signal_handlers_disconnect_by_data(m_preload.playbin, this);
+    releasePlaybin(m_preload);
+    m_preloadRequest = QNetworkRequest();
+}
+
+void QGstreamerPlayerSession::usePreload()
+{
+#ifdef DEBUG_PLAYBIN
+    qDebug() << Q_FUNC_INFO << m_preloadRequest.url();
+#endif
+    if (m_pipeline)
+        gst_element_set_state(m_pipeline, GST_STATE_NULL);
+
+    removeVideoBufferProbe();
+    removeAudioBufferProbe();
+    detachStatistics();
+
+    // Hand the video sink of the current output over to the preloaded playbin
+    if (m_videoOutputBin && m_videoSink && m_videoSink != m_nullVideoSink) {
+        gst_element_set_state(m_videoSink, GST_STATE_NULL);
+        gst_bin_remove(GST_BIN(m_videoOutputBin), m_videoSink);
+    }
+
+    if (m_playbin)
+        g_signal_handlers_disconnect_by_data(m_playbin, this);
+    resetElements();
+
+    const QGstreamerPlaybin elements = m_preload;
+    m_preload = QGstreamerPlaybin();
+    m_preloadRequest = QNetworkRequest();
+    m_sourceType = m_preloadSourceType;
+    m_isLiveSource = m_preloadIsLiveSource;
+
+    setPlaybin(elements, true);
+
+    // Keep the prerolled pipeline running while the video output is attached
+    m_pendingState = QMediaPlayer::PausedState;
+    m_warmPipeline = true;
+    updateVideoRenderer();
+}
+
 bool QGstreamerPlayerSession::parsePipeline()
 {
     if (m_request.url().scheme() != QLatin1String("gst-pipeline")) {
@@ -520,37 +756,123 @@ QMediaTimeRange QGstreamerPlayerSession::availablePlaybackRanges() const
     if (duration() <= 0)
         return ranges;
 
+#if GST_CHECK_VERSION(1, 0, 0)
+    // Prefer ranges reported in time, which are exact even for VBR media.
+    // queue2 and downloadbuffer usually only know their ranges in bytes,
+    // those are converted to time by the demuxer.
+    ranges = queryBufferingRanges(GST_FORMAT_TIME);
+    if (ranges.isEmpty())
+        ranges = queryBufferingRanges(GST_FORMAT_BYTES);
+#endif
+
 #if GST_CHECK_VERSION(0, 10, 31)
-    //GST_FORMAT_TIME would be more appropriate, but unfortunately it's not supported.
-    //with GST_FORMAT_PERCENT media is treated as encoded with constant bitrate.
-    GstQuery* query = gst_query_new_buffering(GST_FORMAT_PERCENT);
+    // With GST_FORMAT_PERCENT media is treated as encoded with constant bitrate.
+    if (ranges.isEmpty())
+        ranges = queryBufferingRanges(GST_FORMAT_PERCENT);
+#endif
 
+    if (ranges.isEmpty() && !isLiveSource() && isSeekable())
+        ranges.addInterval(0, duration());
+
+#ifdef DEBUG_PLAYBIN
+    qDebug() << ranges;
+#endif
+
+    return ranges;
+}
+
+QMediaTimeRange QGstreamerPlayerSession::queryBufferingRanges(GstFormat format) const
+{
+    QMediaTimeRange ranges;
+
+#if GST_CHECK_VERSION(0, 10, 31)
+    if (!m_pipeline)
+        return ranges;
+
+    GstQuery *query = gst_query_new_buffering(format);
     if (!gst_element_query(m_pipeline, query)) {
         gst_query_unref(query);
         return ranges;
     }
 
-    gint64 rangeStart = 0;
-    gint64 rangeStop = 0;
-    for (guint index = 0; index < gst_query_get_n_buffering_ranges(query); index++) {
-        if (gst_query_parse_nth_buffering_range(query, index, &rangeStart, &rangeStop))
-            ranges.addInterval(rangeStart * duration() / 100,
-                               rangeStop * duration() / 100);
+    GstFormat rangeFormat = format;
+    gst_query_parse_buffering_range(query, &rangeFormat, nullptr, nullptr, nullptr);
+    if (rangeFormat != format) {
+        gst_query_unref(query);
+        return ranges;
     }
 
-    gst_query_unref(query);
-#endif
+    const qint64 mediaDuration = duration();
+    gint64 totalBytes = -1;
+    if (format == GST_FORMAT_BYTES
+            && !qt_gst_element_query_duration(m_pipeline, GST_FORMAT_BYTES, &totalBytes)) {
+        totalBytes = -1;
+    }
 
-    if (ranges.isEmpty() && !isLiveSource() && isSeekable())
-        ranges.addInterval(0, duration());
+    // Returns the stream time in milliseconds, or -1 if it can't be determined
+    auto toTime = [&](gint64 value) -> qint64 {
+        switch (format) {
+        case GST_FORMAT_TIME:
+            return value / 1000000;
+        case GST_FORMAT_PERCENT:
+            return value * mediaDuration / GST_FORMAT_PERCENT_MAX;
+        case GST_FORMAT_BYTES: {
+            gint64 time = -1;
+#if GST_CHECK_VERSION(1,0,0)
+            if (gst_element_query_convert(m_pipeline, GST_FORMAT_BYTES, value, GST_FORMAT_TIME, &time)
+                    && time >= 0) {
+                return time / 1000000;
+            }
+#else
+            GstFormat timeFormat = GST_FORMAT_TIME;
+            if (gst_element_query_convert(m_pipeline, GST_FORMAT_BYTES, value, &timeFormat, &time)
+                    && timeFormat == GST_FORMAT_TIME && time >= 0) {
+                return time / 1000000;
+            }
+#endif
+            // The demuxer could not convert, fall back to a constant bitrate estimate
+            if (totalBytes > 0)
+                return value * mediaDuration / totalBytes;
+            return -1;
+        }
+        default:
+            return -1;
+        }
+    };
+
+    const guint count = gst_query_get_n_buffering_ranges(query);
+    for (guint index = 0; index < count; ++index) {
+        gint64 rangeStart = 0;
+        gint64 rangeStop = 0;
+        if (!gst_query_parse_nth_buffering_range(query, index, &rangeStart, &rangeStop))
+            continue;
+
+        const qint64 start = toTime(rangeStart);
+        const qint64 stop = toTime(rangeStop);
+        if (start < 0 || stop < 0)
+            continue;
+
+        ranges.addInterval(qBound<qint64>(0, start, mediaDuration),
+                           qBound<qint64>(0, stop, mediaDuration));
+    }
 
-#ifdef DEBUG_PLAYBIN
-    qDebug() << ranges;
+    gst_query_unref(query);
+#else
+    Q_UNUSED(format);
 #endif
 
     return ranges;
 }
 
+void QGstreamerPlayerSession::updatePlaybackRanges()
+{
+    const QMediaTimeRange ranges = availablePlaybackRanges();
+    if (ranges != m_playbackRanges) {
+        m_playbackRanges = ranges;
+        emit availablePlaybackRangesChanged(m_playbackRanges);
+    }
+}
+
 int QGstreamerPlayerSession::activeStream(QMediaStreamsControl::StreamType streamType) const
 {
     int streamNumber = -1;
@@ -709,7 +1031,7 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
     qDebug() << "Reconfigure video output";
 #endif
 
-    if (m_state == QMediaPlayer::StoppedState) {
+    if (m_state == QMediaPlayer::StoppedState && !m_warmPipeline) {
 #ifdef DEBUG_PLAYBIN
         qDebug() << "The pipeline has not started yet, pending state:" << m_pendingState;
 #endif
@@ -732,7 +1054,9 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
 
         gst_bin_remove(GST_BIN(m_videoOutputBin), m_videoSink);
 
+        detachStatistics();
         m_videoSink = videoSink;
+        attachStatistics();
 
         gst_bin_add(GST_BIN(m_videoOutputBin), m_videoSink);
 
@@ -799,7 +1123,11 @@ void QGstreamerPlayerSession::setVideoRenderer(QObject *videoOutput)
         //Unpause the sink to avoid waiting until the buffer is processed
         //while the sink is paused. The pad will be blocked as soon as the current
         //buffer is processed.
-        if (m_state == QMediaPlayer::PausedState) {
+        GstState sinkState = GST_STATE_NULL;
+        if (m_warmPipeline)
+            gst_element_get_state(m_videoSink, &sinkState, nullptr, 0);
+
+        if (m_state == QMediaPlayer::PausedState || sinkState == GST_STATE_PAUSED) {
 #ifdef DEBUG_PLAYBIN
             qDebug() << "Starting video output to avoid blocking in paused state...";
 #endif
@@ -865,8 +1193,10 @@ void QGstreamerPlayerSession::finishVideoOutputChange()
 
     gst_bin_remove(GST_BIN(m_videoOutputBin), m_videoSink);
 
+    detachStatistics();
     m_videoSink = m_pendingVideoSink;
     m_pendingVideoSink = 0;
+    attachStatistics();
 
     gst_bin_add(GST_BIN(m_videoOutputBin), m_videoSink);
 
@@ -1059,6 +1389,7 @@ void QGstreamerPlayerSession::stop()
     qDebug() << Q_FUNC_INFO;
 #endif
     m_everPlayed = false;
+    m_seekTimer.invalidate();
     if (m_pipeline) {
 
         if (m_renderer)
@@ -1066,6 +1397,7 @@ void QGstreamerPlayerSession::stop()
 
         flushVideoProbes();
         gst_element_set_state(m_pipeline, GST_STATE_NULL);
+        m_warmPipeline = false;
 
         m_lastPosition = 0;
         QMediaPlayer::State oldState = m_state;
@@ -1095,8 +1427,11 @@ bool QGstreamerPlayerSession::seek(qint64 ms)
                                           GstSeekFlags(GST_SEEK_FLAG_FLUSH),
                                           GST_SEEK_TYPE_SET, from * 1000000,
                                           GST_SEEK_TYPE_SET, to * 1000000);
-        if (isSeeking)
+        if (isSeeking) {
             m_lastPosition = ms;
+            m_statistics.increment(QMediaStatistics::Seeks);
+            m_seekTimer.start();
+        }
 
         return isSeeking;
     }
@@ -1156,14 +1491,22 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
             GstTagList *tag_list;
             gst_message_parse_tag(gm, &tag_list);
 
-            QMap<QByteArray, QVariant> newTags = QGstUtils::gstTagListToMap(tag_list);
-            QMap<QByteArray, QVariant>::const_iterator it = newTags.constBegin();
-            for ( ; it != newTags.constEnd(); ++it)
-                m_tags.insert(it.key(), it.value()); // overwrite existing tags
+            // Streams repeat most of their tags with every update,
+            // only report the ones which changed
+            const QMap<QByteArray, QVariant> newTags = QGstUtils::gstTagListToMap(tag_list);
+            QList<QByteArray> changedTags;
+            for (auto it = newTags.cbegin(), end = newTags.cend(); it != end; ++it) {
+                const auto current = m_tags.constFind(it.key());
+                if (current == m_tags.cend() || current.value() != it.value()) {
+                    m_tags.insert(it.key(), it.value()); // overwrite existing tags
+                    changedTags.append(it.key());
+                }
+            }
 
             gst_tag_list_free(tag_list);
 
-            emit tagsChanged();
+            if (!changedTags.isEmpty())
+                emit tagsChanged(changedTags);
         } else if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_DURATION) {
             updateDuration();
         }
@@ -1181,9 +1524,14 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
         if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_BUFFERING) {
             int progress = 0;
             gst_message_parse_buffering(gm, &progress);
+            m_statistics.setBufferFill(progress);
             emit bufferingProgressChanged(progress);
+            updatePlaybackRanges();
         }
 
+        if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_QOS)
+            processQosMessage(gm);
+
         bool handlePlaybin2 = false;
         if (GST_MESSAGE_SRC(gm) == GST_OBJECT_CAST(m_pipeline)) {
             switch (GST_MESSAGE_TYPE(gm))  {
@@ -1224,6 +1572,7 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
                     {
                         QMediaPlayer::State prevState = m_state;
                         m_state = QMediaPlayer::PausedState;
+                        m_warmPipeline = false;
 
                         //check for seekable
                         if (oldState == GST_STATE_READY) {
@@ -1256,6 +1605,7 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
                     }
                     case GST_STATE_PLAYING:
                         m_everPlayed = true;
+                        m_warmPipeline = false;
                         if (m_state != QMediaPlayer::PlayingState) {
                             emit stateChanged(m_state = QMediaPlayer::PlayingState);
 
@@ -1342,6 +1692,11 @@ bool QGstreamerPlayerSession::processBusMessage(const QGstreamerMessage &message
                 break;
             case GST_MESSAGE_ASYNC_DONE:
             {
+                if (m_seekTimer.isValid()) {
+                    m_statistics.recordLatency(QMediaStatistics::SeekLatency, m_seekTimer.nsecsElapsed() / 1000);
+                    m_seekTimer.invalidate();
+                }
+
                 gint64      position = 0;
                 if (qt_gst_element_query_position(m_pipeline, GST_FORMAT_TIME, &position)) {
                     position /= 1000000;
@@ -1580,10 +1935,20 @@ void QGstreamerPlayerSession::updateVideoResolutionTag()
                 m_tags.insert("pixel-aspect-ratio", QVariant(aspectRatio));
         }
 
-        emit tagsChanged();
+        emit tagsChanged(QList<QByteArray>() << "resolution" << "pixel-aspect-ratio");
     }
 }
 
+void QGstreamerPlayerSession::clearTags()
+{
+    if (m_tags.isEmpty())
+        return;
+
+    const QList<QByteArray> keys = m_tags.keys();
+    m_tags.clear();
+    emit tagsChanged(keys);
+}
+
 void QGstreamerPlayerSession::updateDuration()
 {
     gint64 gstDuration = 0;
@@ -1636,18 +2001,24 @@ void QGstreamerPlayerSession::playbinNotifySource(GObject *o, GParamSpec *p, gpo
 
     QGstreamerPlayerSession *self = reinterpret_cast<QGstreamerPlayerSession *>(d);
 
+    // The source of a preloaded playbin belongs to the next media
+    const bool preloading = self->m_preload.playbin && o == G_OBJECT(self->m_preload.playbin);
+    const QNetworkRequest &request = preloading ? self->m_preloadRequest : self->m_request;
+    SourceType &sourceType = preloading ? self->m_preloadSourceType : self->m_sourceType;
+    bool &isLiveSource = preloading ? self->m_preloadIsLiveSource : self->m_isLiveSource;
+
     // User-Agent - special case, souphhtpsrc will always set something, even if
     // defined in extra-headers
     if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "user-agent") != 0) {
         g_object_set(G_OBJECT(source), "user-agent",
-                     self->m_request.rawHeader(userAgentString).constData(), nullptr);
+                     request.rawHeader(userAgentString).constData(), nullptr);
     }
 
     // The rest
     if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "extra-headers") != 0) {
         GstStructure *extras = qt_gst_structure_new_empty("extras");
 
-        const auto rawHeaderList = self->m_request.rawHeaderList();
+        const auto rawHeaderList = request.rawHeaderList();
         for (const QByteArray &rawHeader : rawHeaderList) {
             if (rawHeader == userAgentString) // Filter User-Agent
                 continue;
@@ -1658,7 +2029,7 @@ void QGstreamerPlayerSession::playbinNotifySource(GObject *o, GParamSpec *p, gpo
                 g_value_init(&headerValue, G_TYPE_STRING);
 
                 g_value_set_string(&headerValue,
-                                   self->m_request.rawHeader(rawHeader).constData());
+                                   request.rawHeader(rawHeader).constData());
 
                 gst_structure_set_value(extras, rawHeader.constData(), &headerValue);
             }
@@ -1682,11 +2053,11 @@ void QGstreamerPlayerSession::playbinNotifySource(GObject *o, GParamSpec *p, gpo
         convertedTimeout *= 1000000;
 #endif
         g_object_set(G_OBJECT(source), "timeout", convertedTimeout, nullptr);
-        self->m_sourceType = UDPSrc;
+        sourceType = UDPSrc;
         //The udpsrc is always a live source.
-        self->m_isLiveSource = true;
+        isLiveSource = true;
 
-        QUrlQuery query(self->m_request.url());
+        QUrlQuery query(request.url());
         const QString var = QLatin1String("udpsrc.caps");
         if (query.hasQueryItem(var)) {
             GstCaps *caps = gst_caps_from_string(query.queryItemValue(var).toLatin1().constData());
@@ -1696,34 +2067,34 @@ void QGstreamerPlayerSession::playbinNotifySource(GObject *o, GParamSpec *p, gpo
     } else if (qstrcmp(G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(source)), "GstSoupHTTPSrc") == 0) {
         //souphttpsrc timeout unit = second
         g_object_set(G_OBJECT(source), "timeout", guint(timeout), nullptr);
-        self->m_sourceType = SoupHTTPSrc;
+        sourceType = SoupHTTPSrc;
         //since gst_base_src_is_live is not reliable, so we check the source property directly
         gboolean isLive = false;
         g_object_get(G_OBJECT(source), "is-live", &isLive, nullptr);
-        self->m_isLiveSource = isLive;
+        isLiveSource = isLive;
     } else if (qstrcmp(G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(source)), "GstMMSSrc") == 0) {
-        self->m_sourceType = MMSSrc;
-        self->m_isLiveSource = gst_base_src_is_live(GST_BASE_SRC(source));
+        sourceType = MMSSrc;
+        isLiveSource = gst_base_src_is_live(GST_BASE_SRC(source));
         g_object_set(G_OBJECT(source), "tcp-timeout", G_GUINT64_CONSTANT(timeout*1000000), nullptr);
     } else if (qstrcmp(G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(source)), "GstRTSPSrc") == 0) {
         //rtspsrc acts like a live source and will therefore only generate data in the PLAYING state.
-        self->m_sourceType = RTSPSrc;
-        self->m_isLiveSource = true;
+        sourceType = RTSPSrc;
+        isLiveSource = true;
         g_object_set(G_OBJECT(source), "buffer-mode", 1, nullptr);
     } else {
-        self->m_sourceType = UnknownSrc;
-        self->m_isLiveSource = gst_base_src_is_live(GST_BASE_SRC(source));
+        sourceType = UnknownSrc;
+        isLiveSource = gst_base_src_is_live(GST_BASE_SRC(source));
     }
 
 #ifdef DEBUG_PLAYBIN
-    if (self->m_isLiveSource)
+    if (isLiveSource)
         qDebug() << "Current source is a live source";
     else
         qDebug() << "Current source is a non-live source";
 #endif
 
-    if (self->m_videoSink)
-        g_object_set(G_OBJECT(self->m_videoSink), "sync", !self->m_isLiveSource, nullptr);
+    if (!preloading && self->m_videoSink)
+        g_object_set(G_OBJECT(self->m_videoSink), "sync", !isLiveSource, nullptr);
 
     gst_object_unref(source);
 }
@@ -1977,6 +2348,48 @@ void QGstreamerPlayerSession::addVideoBufferProbe()
     }
 }
 
+void QGstreamerPlayerSession::attachStatistics()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    // Only our own sink knows when a frame actually reached the surface.
+    QGstVideoRendererSink::setStatistics(m_videoSink, &m_statistics);
+#endif
+}
+
+void QGstreamerPlayerSession::detachStatistics()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    QGstVideoRendererSink::setStatistics(m_videoSink, nullptr);
+#endif
+}
+
+static bool isDescendant(GstObject *object, GstElement *ancestor)
+{
+    for (; object; object = GST_OBJECT_PARENT(object)) {
+        if (object == GST_OBJECT_CAST(ancestor))
+            return true;
+    }
+    return false;
+}
+
+void QGstreamerPlayerSession::processQosMessage(GstMessage *message)
+{
+#if GST_CHECK_VERSION(0,10,29)
+    // Audio sinks report the samples they skipped, video sinks and decoders
+    // the buffers that were too late.
+    GstFormat format = GST_FORMAT_UNDEFINED;
+    gst_message_parse_qos_stats(message, &format, nullptr, nullptr);
+
+    GstObject * const source = GST_MESSAGE_SRC(message);
+    if (format == GST_FORMAT_DEFAULT || (m_audioSink && isDescendant(source, m_audioSink)))
+        m_statistics.increment(QMediaStatistics::AudioUnderruns);
+    else if (format == GST_FORMAT_BUFFERS || isDescendant(source, m_videoOutputBin))
+        m_statistics.increment(QMediaStatistics::LateFrames);
+#else
+    Q_UNUSED(message);
+#endif
+}
+
 void QGstreamerPlayerSession::removeAudioBufferProbe()
 {
     if (!m_audioProbe)
@@ -54,9 +54,11 @@
 #include <QtMultimedia/private/qtmultimediaglobal_p.h>
 #include <QObject>
 #include <QtCore/qmutex.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtNetwork/qnetworkrequest.h>
 #include <private/qgstreamerplayercontrol_p.h>
 #include <private/qgstreamerbushelper_p.h>
+#include <private/qmediastatistics_p.h>
 #include <qmediaplayer.h>
 #include <qmediastreamscontrol.h>
 #include <qaudioformat.h>
@@ -82,6 +84,19 @@ typedef enum {
   GST_AUTOPLUG_SELECT_SKIP
 } GstAutoplugSelectResult;
 
+struct QGstreamerPlaybin
+{
+    GstElement *playbin = nullptr;
+    GstElement *audioSink = nullptr;
+    GstElement *volumeElement = nullptr;
+    GstElement *videoOutputBin = nullptr;
+    GstElement *videoIdentity = nullptr;
+#if !GST_CHECK_VERSION(1,0,0)
+    GstElement *colorSpace = nullptr;
+#endif
+    GstElement *nullVideoSink = nullptr;
+};
+
 class Q_GSTTOOLS_EXPORT QGstreamerPlayerSession
     : public QObject
     , public QGstreamerBusMessageFilter
@@ -129,6 +144,8 @@ public:
     int activeStream(QMediaStreamsControl::StreamType streamType) const;
     void setActiveStream(QMediaStreamsControl::StreamType streamType, int streamNumber);
 
+    QMediaStatistics *statistics() { return &m_statistics; }
+
     bool processBusMessage(const QGstreamerMessage &message) override;
 
 #if QT_CONFIG(gstreamer_app)
@@ -148,6 +165,7 @@ public:
 
 public slots:
     void loadFromUri(const QNetworkRequest &url);
+    void preload(const QNetworkRequest &url);
     void loadFromStream(const QNetworkRequest &url, QIODevice *stream);
     bool play();
     bool pause();
@@ -169,8 +187,9 @@ signals:
     void audioAvailableChanged(bool audioAvailable);
     void videoAvailableChanged(bool videoAvailable);
     void bufferingProgressChanged(int percentFilled);
+    void availablePlaybackRangesChanged(const QMediaTimeRange &ranges);
     void playbackFinished();
-    void tagsChanged();
+    void tagsChanged(const QList<QByteArray> &keys);
     void streamsChanged();
     void seekableChanged(bool);
     void error(int error, const QString &errorString);
@@ -188,6 +207,7 @@ private slots:
     void updateVolume();
     void updateMuted();
     void updateDuration();
+    void updatePlaybackRanges();
 
 private:
     static void playbinNotifySource(GObject *o, GParamSpec *p, gpointer d);
@@ -208,11 +228,20 @@ private:
     void addAudioBufferProbe();
     void flushVideoProbes();
     void resumeVideoProbes();
+    QMediaTimeRange queryBufferingRanges(GstFormat format) const;
     bool parsePipeline();
     bool setPipeline(GstElement *pipeline);
     void resetElements();
+    void clearTags();
     void initPlaybin();
+    void setPlaybin(const QGstreamerPlaybin &playbin, bool prerolled);
+    void connectSourceSignals(GstElement *playbin);
+    void usePreload();
+    void discardPreload();
     void setBus(GstBus *bus);
+    void attachStatistics();
+    void detachStatistics();
+    void processQosMessage(GstMessage *message);
 
     QNetworkRequest m_request;
     QMediaPlayer::State m_state = QMediaPlayer::StoppedState;
@@ -261,6 +290,10 @@ private:
     mutable qint64 m_lastPosition = 0;
     qint64 m_duration = 0;
     int m_durationQueries = 0;
+    QMediaTimeRange m_playbackRanges;
+
+    QMediaStatistics m_statistics;
+    QElapsedTimer m_seekTimer;
 
     bool m_displayPrerolledFrame = true;
 
@@ -277,6 +310,12 @@ private:
     bool m_isLiveSource = false;
 
     gulong pad_probe_id = 0;
+
+    QGstreamerPlaybin m_preload;
+    QNetworkRequest m_preloadRequest;
+    SourceType m_preloadSourceType = UnknownSrc;
+    bool m_preloadIsLiveSource = false;
+    bool m_warmPipeline = false;
 };
 
 QT_END_NAMESPACE
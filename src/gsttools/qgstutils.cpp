@@ -43,6 +43,7 @@
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qsize.h>
@@ -150,14 +151,9 @@ static void addTagToMap(const GstTagList *list,
                 if (caps && !gst_caps_is_empty(caps)) {
                     GstStructure *structure = gst_caps_get_structure(caps, 0);
                     const gchar *name = gst_structure_get_name(structure);
-                    if (QByteArray(name).startsWith("image/")) {
-                        GstBuffer *buffer = gst_sample_get_buffer(sample);
-                        if (buffer) {
-                            GstMapInfo info;
-                            gst_buffer_map(buffer, &info, GST_MAP_READ);
-                            map->insert(QByteArray(tag), QImage::fromData(info.data, info.size, name));
-                            gst_buffer_unmap(buffer, &info);
-                        }
+                    if (QByteArray(name).startsWith("image/") && gst_sample_get_buffer(sample)) {
+                        // Decoded only when the image is asked for
+                        map->insert(QByteArray(tag), QVariant::fromValue(QGstTagImage(sample)));
                     }
                 }
 #endif
@@ -184,10 +180,16 @@ static void addTagToMap(const GstTagList *list,
   Convert GstTagList structure to QMap<QByteArray, QVariant>.
 
   Mapping to int, bool, char, string, fractions and date are supported.
-  Fraction values are converted to doubles.
+  Fraction values are converted to doubles, images to QGstTagImage.
 */
 QMap<QByteArray, QVariant> QGstUtils::gstTagListToMap(const GstTagList *tags)
 {
+#if GST_CHECK_VERSION(1,0,0)
+    static const bool registered = QMetaType::registerEqualsComparator<QGstTagImage>()
+            && QMetaType::registerConverter<QGstTagImage, QImage>(&QGstTagImage::image);
+    Q_UNUSED(registered);
+#endif
+
     QMap<QByteArray, QVariant> res;
     gst_tag_list_foreach(tags, addTagToMap, &res);
 
@@ -1733,6 +1735,77 @@ void qt_gst_util_double_to_fraction(gdouble src, gint *dest_n, gint *dest_d)
 #endif
 }
 
+#if GST_CHECK_VERSION(1,0,0)
+struct QGstTagImage::Data
+{
+    ~Data() { gst_sample_unref(sample); }
+
+    GstSample *sample = nullptr;
+    QByteArray mimeType;
+
+    QMutex mutex;
+    bool decoded = false;
+    QImage image;
+};
+
+QGstTagImage::QGstTagImage(GstSample *sample)
+    : d(new Data)
+{
+    d->sample = gst_sample_ref(sample);
+
+    GstCaps *caps = gst_sample_get_caps(sample);
+    if (caps && !gst_caps_is_empty(caps))
+        d->mimeType = gst_structure_get_name(gst_caps_get_structure(caps, 0));
+}
+
+QByteArray QGstTagImage::mimeType() const
+{
+    return d ? d->mimeType : QByteArray();
+}
+
+QImage QGstTagImage::image() const
+{
+    if (!d)
+        return QImage();
+
+    QMutexLocker locker(&d->mutex);
+    if (!d->decoded) {
+        d->decoded = true;
+
+        GstBuffer *buffer = gst_sample_get_buffer(d->sample);
+        GstMapInfo info;
+        if (buffer && gst_buffer_map(buffer, &info, GST_MAP_READ)) {
+            d->image = QImage::fromData(info.data, info.size, d->mimeType.constData());
+            gst_buffer_unmap(buffer, &info);
+        }
+    }
+    return d->image;
+}
+
+bool QGstTagImage::operator==(const QGstTagImage &other) const
+{
+    if (d == other.d)
+        return true;
+    if (!d || !other.d)
+        return false;
+
+    GstBuffer *buffer = gst_sample_get_buffer(d->sample);
+    GstBuffer *otherBuffer = gst_sample_get_buffer(other.d->sample);
+    if (buffer == otherBuffer)
+        return true;
+    if (!buffer || !otherBuffer || gst_buffer_get_size(buffer) != gst_buffer_get_size(otherBuffer))
+        return false;
+
+    // Tags are resent with fresh buffers, compare the bytes rather than decode them
+    GstMapInfo info;
+    if (!gst_buffer_map(otherBuffer, &info, GST_MAP_READ))
+        return false;
+    const bool equal = gst_buffer_memcmp(buffer, 0, info.data, info.size) == 0;
+    gst_buffer_unmap(otherBuffer, &info);
+    return equal;
+}
+#endif
+
 QDebug operator <<(QDebug debug, GstCaps *caps)
 {
     if (caps) {
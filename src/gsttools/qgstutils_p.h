@@ -53,7 +53,9 @@
 
 #include <private/qgsttools_global_p.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qmetatype.h>
 #include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qvector.h>
 #include <gst/gst.h>
 #include <gst/video/video.h>
@@ -171,6 +173,31 @@ Q_GSTTOOLS_EXPORT void qt_gst_util_double_to_fraction(gdouble src, gint *dest_n,
 
 Q_GSTTOOLS_EXPORT QDebug operator <<(QDebug debug, GstCaps *caps);
 
+#if GST_CHECK_VERSION(1,0,0)
+// An image tag, kept encoded until it is first asked for.
+class Q_GSTTOOLS_EXPORT QGstTagImage
+{
+public:
+    QGstTagImage() = default;
+    explicit QGstTagImage(GstSample *sample);
+
+    bool isNull() const { return !d; }
+    QByteArray mimeType() const;
+    QImage image() const;
+
+    bool operator==(const QGstTagImage &other) const;
+    bool operator!=(const QGstTagImage &other) const { return !operator==(other); }
+
+private:
+    struct Data;
+    QSharedPointer<Data> d;
+};
+#endif
+
 QT_END_NAMESPACE
 
+#if GST_CHECK_VERSION(1,0,0)
+Q_DECLARE_METATYPE(QGstTagImage)
+#endif
+
 #endif
@@ -46,6 +46,7 @@
 #include <QCoreApplication>
 
 #include <private/qmediapluginloader_p.h>
+#include <private/qmediastatistics_p.h>
 #include "qgstvideobuffer_p.h"
 
 #include "qgstvideorenderersink_p.h"
@@ -304,11 +305,21 @@ GstFlowReturn QVideoSurfaceGstDelegate::render(GstBuffer *buffer)
 {
     QMutexLocker locker(&m_mutex);
 
+    QMediaStatistics * const statistics = m_statistics.loadAcquire();
+    if (statistics) {
+        statistics->increment(QMediaStatistics::DecodedFrames);
+        m_renderTimer.start();
+    }
+
     m_renderReturn = GST_FLOW_OK;
     m_renderBuffer = buffer;
 
     waitForAsyncEvent(&locker, &m_renderCondition, 300);
 
+    // The buffer is still pending if the surface did not pick it up in time.
+    if (statistics && m_renderBuffer)
+        statistics->increment(QMediaStatistics::DroppedFrames);
+
     m_renderBuffer = 0;
 
     return m_renderReturn;
@@ -492,19 +503,34 @@ bool QVideoSurfaceGstDelegate::handleEvent(QMutexLocker *locker)
         m_renderBuffer = 0;
         m_renderReturn = GST_FLOW_ERROR;
 
+        QMediaStatistics * const statistics = m_statistics.loadAcquire();
+        if (statistics && m_renderTimer.isValid())
+            statistics->recordLatency(QMediaStatistics::SinkToPresentLatency, m_renderTimer.nsecsElapsed() / 1000);
+
         if (m_activeRenderer && m_surface) {
             gst_buffer_ref(buffer);
 
             locker->unlock();
 
+            QElapsedTimer presentTimer;
+            if (statistics)
+                presentTimer.start();
+
             const bool rendered = m_activeRenderer->present(m_surface, buffer);
 
+            if (statistics) {
+                statistics->recordLatency(QMediaStatistics::PresentToRenderLatency, presentTimer.nsecsElapsed() / 1000);
+                statistics->increment(rendered ? QMediaStatistics::RenderedFrames : QMediaStatistics::DroppedFrames);
+            }
+
             gst_buffer_unref(buffer);
 
             locker->relock();
 
             if (rendered)
                 m_renderReturn = GST_FLOW_OK;
+        } else if (statistics) {
+            statistics->increment(QMediaStatistics::DroppedFrames);
         }
 
         m_renderCondition.wakeAll();
@@ -587,6 +613,14 @@ void QGstVideoRendererSink::setSurface(QAbstractVideoSurface *surface)
     get_type();
 }
 
+void QGstVideoRendererSink::setStatistics(GstElement *element, QMediaStatistics *statistics)
+{
+    if (element && G_TYPE_CHECK_INSTANCE_TYPE(element, get_type())) {
+        VO_SINK(element);
+        sink->delegate->setStatistics(statistics);
+    }
+}
+
 GType QGstVideoRendererSink::get_type()
 {
     static GType type = 0;
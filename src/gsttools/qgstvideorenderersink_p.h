@@ -60,6 +60,8 @@
 #include <QtCore/qqueue.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qwaitcondition.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
 #include <qvideosurfaceformat.h>
 #include <qvideoframe.h>
 #include <qabstractvideobuffer.h>
@@ -77,6 +79,7 @@
 
 QT_BEGIN_NAMESPACE
 class QAbstractVideoSurface;
+class QMediaStatistics;
 
 class QGstDefaultVideoRenderer : public QGstVideoRenderer
 {
@@ -118,6 +121,8 @@ public:
 
     GstFlowReturn render(GstBuffer *buffer);
 
+    void setStatistics(QMediaStatistics *statistics) { m_statistics.storeRelease(statistics); }
+
     bool event(QEvent *event) override;
     bool query(GstQuery *query);
 
@@ -135,6 +140,8 @@ private:
     QWaitCondition m_setupCondition;
     QWaitCondition m_renderCondition;
     GstFlowReturn m_renderReturn = GST_FLOW_OK;
+    QAtomicPointer<QMediaStatistics> m_statistics;
+    QElapsedTimer m_renderTimer;
     QList<QGstVideoRenderer *> m_renderers;
     QGstVideoRenderer *m_renderer = nullptr;
     QGstVideoRenderer *m_activeRenderer = nullptr;
@@ -158,6 +165,7 @@ public:
 
     static QGstVideoRendererSink *createSink(QAbstractVideoSurface *surface);
     static void setSurface(QAbstractVideoSurface *surface);
+    static void setStatistics(GstElement *element, QMediaStatistics *statistics);
 
 private:
     static GType get_type();
@@ -80,6 +80,9 @@ public:
         qmlRegisterType<QDeclarativeAudioEngine, 1>(uri, 1, 1, "AudioEngine");
         qmlRegisterType<QDeclarativeSound, 1>(uri, 1, 1, "Sound");
 
+        qmlRegisterType<QDeclarativeAudioEngine, 15>(uri, 1, 15, "AudioEngine");
+        qmlRegisterType<QDeclarativeSound, 15>(uri, 1, 15, "Sound");
+
         qmlRegisterModule(uri, 1, QT_VERSION_MINOR);
     }
 };
@@ -23,7 +23,8 @@ HEADERS += \
         qaudioengine_p.h \
         qsoundsource_p.h \
         qsoundbuffer_p.h \
-        qaudioengine_openal_p.h
+        qaudioengine_openal_p.h \
+        ../../multimedia/audio/qwavedecoder_p.h
 
 SOURCES += \
         audioengine.cpp \
@@ -38,6 +39,7 @@ SOURCES += \
         qsoundinstance_p.cpp \
         qaudioengine_p.cpp \
         qsoundsource_openal_p.cpp  \
-        qaudioengine_openal_p.cpp
+        qaudioengine_openal_p.cpp \
+        ../../multimedia/audio/qwavedecoder_p.cpp
 
 load(qml_plugin)
@@ -41,11 +41,14 @@
 
 #include <QtCore/QMutex>
 #include <QtCore/QThread>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkAccessManager>
 
 #include "qsamplecache_p.h"
+#include "qwavedecoder_p.h"
 
 #include "qdebug.h"
 
@@ -58,6 +61,79 @@ QSoundBufferPrivateAL::QSoundBufferPrivateAL(QObject *parent)
 {
 }
 
+void QSoundBufferPrivateAL::sourcePlay(ALuint alSource)
+{
+    alSourcePlay(alSource);
+}
+
+void QSoundBufferPrivateAL::sourcePause(ALuint alSource)
+{
+    alSourcePause(alSource);
+}
+
+void QSoundBufferPrivateAL::sourceStop(ALuint alSource)
+{
+    alSourceStop(alSource);
+}
+
+void QSoundBufferPrivateAL::setSourceLooping(ALuint alSource, bool looping)
+{
+    alSourcei(alSource, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+}
+
+bool QSoundBufferPrivateAL::isSourceLooping(ALuint alSource) const
+{
+    ALint looping = 0;
+    alGetSourcei(alSource, AL_LOOPING, &looping);
+    return looping == AL_TRUE ? true : false;
+}
+
+bool QSoundBufferPrivateAL::isSourceStarving(ALuint alSource) const
+{
+    Q_UNUSED(alSource);
+    return false;
+}
+
+ALenum QSoundBufferPrivateAL::alFormat(const QAudioFormat &format)
+{
+    const int channels = format.channelCount();
+    if (format.sampleSize() == 8) {
+        if (channels == 1)
+            return AL_FORMAT_MONO8;
+        if (channels == 2)
+            return AL_FORMAT_STEREO8;
+    } else if (format.sampleSize() == 16) {
+        if (channels == 1)
+            return AL_FORMAT_MONO16;
+        if (channels == 2)
+            return AL_FORMAT_STEREO16;
+    }
+
+    // Multichannel layouts need AL_EXT_MCFORMATS
+    if (channels > 2 && alIsExtensionPresent("AL_EXT_MCFORMATS")) {
+        const char *name = nullptr;
+        if (format.sampleSize() == 16) {
+            switch (channels) {
+            case 4: name = "AL_FORMAT_QUAD16"; break;
+            case 6: name = "AL_FORMAT_51CHN16"; break;
+            case 7: name = "AL_FORMAT_61CHN16"; break;
+            case 8: name = "AL_FORMAT_71CHN16"; break;
+            }
+        } else if (format.sampleSize() == 8) {
+            switch (channels) {
+            case 4: name = "AL_FORMAT_QUAD8"; break;
+            case 6: name = "AL_FORMAT_51CHN8"; break;
+            case 7: name = "AL_FORMAT_61CHN8"; break;
+            case 8: name = "AL_FORMAT_71CHN8"; break;
+            }
+        }
+        if (name)
+            return alGetEnumValue(name);
+    }
+
+    return 0;
+}
+
 
 StaticSoundBufferAL::StaticSoundBufferAL(QObject *parent, const QUrl &url, QSampleCache *sampleLoader)
     : QSoundBufferPrivateAL(parent),
@@ -134,7 +210,7 @@ void StaticSoundBufferAL::sampleReady()
     disconnect(m_sample, SIGNAL(ready()), this, SLOT(sampleReady()));
 
     if (m_sample->data().size() > 1024 * 1024 * 4) {
-        qWarning() << "source [" << m_url << "] size too large!";
+        qWarning() << "source [" << m_url << "] size too large, use a streaming sample instead!";
         decoderError();
         return;
     }
@@ -145,12 +221,8 @@ void StaticSoundBufferAL::sampleReady()
         return;
     }
 
-    ALenum alFormat = 0;
-    if (m_sample->format().sampleSize() == 8) {
-        alFormat = m_sample->format().channelCount() == 1 ? AL_FORMAT_MONO8 : AL_FORMAT_STEREO8;
-    } else if (m_sample->format().sampleSize() == 16) {
-        alFormat = m_sample->format().channelCount() == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
-    } else {
+    ALenum alFormat = QSoundBufferPrivateAL::alFormat(m_sample->format());
+    if (alFormat == 0) {
         qWarning() << "source [" << m_url << "] invalid sample size:"
                    << m_sample->format().sampleSize() << "(should be 8 or 16)";
         decoderError();
@@ -193,6 +265,372 @@ void StaticSoundBufferAL::decoderError()
 }
 
 
+/////////////////////////////////////////////////////////////////
+QSoundStreamAL::QSoundStreamAL(const QUrl &url, ALuint alSource)
+    : m_url(url),
+      m_alSource(alSource),
+      m_alFormat(0),
+      m_file(0),
+      m_decoder(0),
+      m_refillTimer(0),
+      m_dataStart(0),
+      m_dataRead(0),
+      m_endOfStream(false),
+      m_finished(false),
+      m_handledPlayRequest(0)
+{
+    for (int i = 0; i < QueueLength; ++i)
+        m_alBuffers[i] = 0;
+}
+
+QSoundStreamAL::~QSoundStreamAL()
+{
+    shutdown();
+}
+
+void QSoundStreamAL::requestPlay()
+{
+    // Until the streaming thread confirms playback, the source may be
+    // stopped only because nothing has been queued yet
+    m_starving.storeRelaxed(1);
+    m_playing.storeRelaxed(1);
+    // A stream that has played to the end is restarted by the streaming thread
+    m_playRequest.fetchAndAddRelease(1);
+    alSourcePlay(m_alSource);
+}
+
+void QSoundStreamAL::requestPause()
+{
+    m_playing.storeRelaxed(0);
+    m_starving.storeRelaxed(0);
+    alSourcePause(m_alSource);
+}
+
+void QSoundStreamAL::requestStop()
+{
+    m_playing.storeRelaxed(0);
+    m_starving.storeRelaxed(0);
+    alSourceStop(m_alSource);
+    // The queue is rebuilt from the beginning of the file by the streaming thread
+    m_rewind.storeRelaxed(1);
+}
+
+void QSoundStreamAL::start()
+{
+#ifdef DEBUG_AUDIOENGINE
+    qDebug() << "QSoundStreamAL: start streaming [" << m_url << "]";
+#endif
+    m_file = new QFile(StreamingSoundBufferAL::localFileName(m_url), this);
+    if (!m_file->open(QIODevice::ReadOnly)) {
+        qWarning() << "streaming [" << m_url << "] failed:" << m_file->errorString();
+        failed();
+        return;
+    }
+
+    m_decoder = new QWaveDecoder(m_file, this);
+    connect(m_decoder, SIGNAL(formatKnown()), this, SLOT(formatKnown()));
+    connect(m_decoder, SIGNAL(parsingError()), this, SLOT(parsingError()));
+}
+
+void QSoundStreamAL::shutdown()
+{
+    if (m_refillTimer) {
+        m_refillTimer->stop();
+        delete m_refillTimer;
+        m_refillTimer = 0;
+    }
+
+    if (m_alBuffers[0] != 0) {
+        alGetError(); // clear error
+        alSourceStop(m_alSource);
+        alSourcei(m_alSource, AL_BUFFER, 0);
+        alDeleteBuffers(QueueLength, m_alBuffers);
+        QAudioEnginePrivate::checkNoError("delete stream buffers");
+        for (int i = 0; i < QueueLength; ++i)
+            m_alBuffers[i] = 0;
+    }
+
+    delete m_decoder;
+    m_decoder = 0;
+    delete m_file;
+    m_file = 0;
+}
+
+void QSoundStreamAL::formatKnown()
+{
+    m_format = m_decoder->audioFormat();
+    m_alFormat = QSoundBufferPrivateAL::alFormat(m_format);
+    if (m_alFormat == 0) {
+        qWarning() << "streaming [" << m_url << "] unsupported format:"
+                   << m_format.channelCount() << "channels," << m_format.sampleSize() << "bits";
+        failed();
+        return;
+    }
+
+    m_dataStart = m_file->pos();
+    m_chunk.resize(m_format.bytesForDuration(ChunkDurationMs * 1000));
+
+    m_rewind.storeRelaxed(0);
+
+    alGetError(); // clear error
+    alGenBuffers(QueueLength, m_alBuffers);
+    if (!QAudioEnginePrivate::checkNoError("create stream buffers")) {
+        for (int i = 0; i < QueueLength; ++i)
+            m_alBuffers[i] = 0;
+        failed();
+        return;
+    }
+
+    // Queue the first chunk right away so that playback can start as soon
+    // as possible, the rest of the queue is filled by the refill timer.
+    if (fillBuffer(m_alBuffers[0]))
+        alSourceQueueBuffers(m_alSource, 1, &m_alBuffers[0]);
+    for (int i = 1; i < QueueLength; ++i) {
+        if (!fillBuffer(m_alBuffers[i]))
+            break;
+        alSourceQueueBuffers(m_alSource, 1, &m_alBuffers[i]);
+    }
+    QAudioEnginePrivate::checkNoError("queue stream buffers");
+
+    if (m_playing.loadRelaxed()) {
+        alSourcePlay(m_alSource);
+        m_starving.storeRelaxed(0);
+    }
+
+    m_refillTimer = new QTimer(this);
+    m_refillTimer->setInterval(RefillIntervalMs);
+    connect(m_refillTimer, SIGNAL(timeout()), this, SLOT(refill()));
+    m_refillTimer->start();
+}
+
+void QSoundStreamAL::parsingError()
+{
+    qWarning() << "streaming [" << m_url << "] failed: not a valid wave file";
+    failed();
+}
+
+void QSoundStreamAL::failed()
+{
+    m_playing.storeRelaxed(0);
+    m_starving.storeRelaxed(0);
+    emit error();
+}
+
+void QSoundStreamAL::rewind()
+{
+    m_file->seek(m_dataStart);
+    m_dataRead = 0;
+    m_endOfStream = false;
+    m_finished = false;
+}
+
+bool QSoundStreamAL::fillBuffer(ALuint alBuffer)
+{
+    const qint64 dataSize = m_decoder->size();
+    qint64 filled = 0;
+    while (filled < m_chunk.size()) {
+        qint64 toRead = m_chunk.size() - filled;
+        if (dataSize > 0)
+            toRead = qMin(toRead, dataSize - m_dataRead);
+        const qint64 read = toRead > 0 ? m_file->read(m_chunk.data() + filled, toRead) : 0;
+        if (read > 0) {
+            filled += read;
+            m_dataRead += read;
+            continue;
+        }
+        if (!isLooping() || m_dataRead == 0) {
+            m_endOfStream = true;
+            break;
+        }
+        rewind();
+    }
+
+    // Only queue whole frames
+    filled -= filled % qMax(1, m_format.bytesPerFrame());
+    if (filled <= 0)
+        return false;
+
+    alBufferData(alBuffer, m_alFormat, m_chunk.constData(), ALsizei(filled), m_format.sampleRate());
+    return QAudioEnginePrivate::checkNoError("fill stream buffer");
+}
+
+void QSoundStreamAL::refill()
+{
+    const int playRequest = m_playRequest.loadAcquire();
+    if (playRequest != m_handledPlayRequest) {
+        m_handledPlayRequest = playRequest;
+        if (m_finished)
+            m_rewind.storeRelaxed(1);
+    }
+
+    if (m_rewind.testAndSetRelaxed(1, 0)) {
+        // Drop whatever is queued and start over
+        alSourceStop(m_alSource);
+        alSourcei(m_alSource, AL_BUFFER, 0);
+        rewind();
+        for (int i = 0; i < QueueLength; ++i) {
+            if (!fillBuffer(m_alBuffers[i]))
+                break;
+            alSourceQueueBuffers(m_alSource, 1, &m_alBuffers[i]);
+        }
+        QAudioEnginePrivate::checkNoError("requeue stream buffers");
+        if (m_playing.loadRelaxed())
+            alSourcePlay(m_alSource);
+        return;
+    }
+
+    ALint processed = 0;
+    alGetSourcei(m_alSource, AL_BUFFERS_PROCESSED, &processed);
+    while (processed-- > 0) {
+        ALuint alBuffer = 0;
+        alSourceUnqueueBuffers(m_alSource, 1, &alBuffer);
+        if (m_endOfStream || !fillBuffer(alBuffer))
+            continue;
+        alSourceQueueBuffers(m_alSource, 1, &alBuffer);
+    }
+
+    ALint queued = 0;
+    ALint state = AL_STOPPED;
+    alGetSourcei(m_alSource, AL_BUFFERS_QUEUED, &queued);
+    alGetSourcei(m_alSource, AL_SOURCE_STATE, &state);
+
+    if (m_playing.loadRelaxed() && state == AL_STOPPED) {
+        if (queued > 0) {
+            // Decoding did not keep up, resume with what has been queued since
+            alSourcePlay(m_alSource);
+            m_starving.storeRelaxed(0);
+        } else if (m_endOfStream) {
+            // Played to the end, unless play was requested again meanwhile
+            m_finished = true;
+            if (m_playRequest.loadAcquire() == playRequest)
+                m_playing.testAndSetRelaxed(1, 0);
+            m_starving.storeRelaxed(0);
+        } else {
+            m_starving.storeRelaxed(1);
+        }
+    } else {
+        m_starving.storeRelaxed(0);
+    }
+}
+
+
+StreamingSoundBufferAL::StreamingSoundBufferAL(QObject *parent, const QUrl &url, QThread *streamingThread)
+    : QSoundBufferPrivateAL(parent),
+      m_ref(1),
+      m_url(url),
+      m_state(Creating),
+      m_streamingThread(streamingThread)
+{
+#ifdef DEBUG_AUDIOENGINE
+    qDebug() << "creating new StreamingSoundBufferAL";
+#endif
+}
+
+StreamingSoundBufferAL::~StreamingSoundBufferAL()
+{
+    const QList<ALuint> sources = m_streams.keys();
+    for (ALuint alSource : sources)
+        unbindFromSource(alSource);
+}
+
+QString StreamingSoundBufferAL::localFileName(const QUrl &url)
+{
+    if (url.scheme().compare(QLatin1String("qrc"), Qt::CaseInsensitive) == 0)
+        return QLatin1Char(':') + url.path();
+    return url.toLocalFile();
+}
+
+QSoundBuffer::State StreamingSoundBufferAL::state() const
+{
+    return m_state;
+}
+
+void StreamingSoundBufferAL::load()
+{
+    if (m_state == Loading || m_state == Ready)
+        return;
+
+    // Nothing is decoded up front, every bound source streams on its own.
+    const QString fileName = localFileName(m_url);
+    if (fileName.isEmpty() || !QFileInfo(fileName).isReadable()) {
+        qWarning() << "streaming [" << m_url << "] failed: only local files can be streamed";
+        m_state = Error;
+        emit stateChanged(m_state);
+        emit error();
+        return;
+    }
+
+    m_state = Ready;
+    emit stateChanged(m_state);
+    emit ready();
+}
+
+void StreamingSoundBufferAL::bindToSource(ALuint alSource)
+{
+    Q_ASSERT(m_state == Ready);
+    Q_ASSERT(!m_streams.contains(alSource));
+
+    // Sources are looped by rewinding the stream, not by OpenAL
+    alSourcei(alSource, AL_LOOPING, AL_FALSE);
+    alSourcei(alSource, AL_BUFFER, 0);
+
+    QSoundStreamAL *stream = new QSoundStreamAL(m_url, alSource);
+    stream->moveToThread(m_streamingThread);
+    m_streams.insert(alSource, stream);
+    QMetaObject::invokeMethod(stream, "start", Qt::QueuedConnection);
+}
+
+void StreamingSoundBufferAL::unbindFromSource(ALuint alSource)
+{
+    QSoundStreamAL *stream = m_streams.take(alSource);
+    if (!stream)
+        return;
+
+    // The source may be reused right after this, so release its queue synchronously
+    QMetaObject::invokeMethod(stream, "shutdown", Qt::BlockingQueuedConnection);
+    stream->deleteLater();
+    alSourcei(alSource, AL_BUFFER, 0);
+}
+
+void StreamingSoundBufferAL::sourcePlay(ALuint alSource)
+{
+    if (QSoundStreamAL *stream = m_streams.value(alSource))
+        stream->requestPlay();
+}
+
+void StreamingSoundBufferAL::sourcePause(ALuint alSource)
+{
+    if (QSoundStreamAL *stream = m_streams.value(alSource))
+        stream->requestPause();
+}
+
+void StreamingSoundBufferAL::sourceStop(ALuint alSource)
+{
+    if (QSoundStreamAL *stream = m_streams.value(alSource))
+        stream->requestStop();
+    else
+        alSourceStop(alSource);
+}
+
+void StreamingSoundBufferAL::setSourceLooping(ALuint alSource, bool looping)
+{
+    if (QSoundStreamAL *stream = m_streams.value(alSource))
+        stream->setLooping(looping);
+}
+
+bool StreamingSoundBufferAL::isSourceLooping(ALuint alSource) const
+{
+    QSoundStreamAL *stream = m_streams.value(alSource);
+    return stream && stream->isLooping();
+}
+
+bool StreamingSoundBufferAL::isSourceStarving(ALuint alSource) const
+{
+    QSoundStreamAL *stream = m_streams.value(alSource);
+    return stream && stream->isStarving();
+}
+
+
 /////////////////////////////////////////////////////////////////
 QAudioEnginePrivate::QAudioEnginePrivate(QObject *parent)
     : QObject(parent)
@@ -204,6 +642,10 @@ QAudioEnginePrivate::QAudioEnginePrivate(QObject *parent)
     m_sampleLoader->setCapacity(0);
     connect(m_sampleLoader, SIGNAL(isLoadingChanged()), this, SIGNAL(isLoadingChanged()));
 
+    m_streamingThread = new QThread(this);
+    m_streamingThread->setObjectName(QLatin1String("QAudioEngine::StreamingThread"));
+    m_streamingThread->start();
+
 #ifdef DEBUG_AUDIOENGINE
     qDebug() << "default openal device = " << alcGetString(NULL, ALC_DEFAULT_DEVICE_SPECIFIER);
 
@@ -254,6 +696,14 @@ QAudioEnginePrivate::~QAudioEnginePrivate()
     }
     m_staticBufferPool.clear();
 
+    for (QSoundBufferPrivateAL *buffer : qAsConst(m_streamingBufferPool)) {
+        delete buffer;
+    }
+    m_streamingBufferPool.clear();
+
+    m_streamingThread->quit();
+    m_streamingThread->wait();
+
     delete m_sampleLoader;
 
     ALCcontext* context = alcGetCurrentContext();
@@ -282,7 +732,8 @@ QSoundSource* QAudioEnginePrivate::createSoundSource()
         instance = m_instancePool.front();
         m_instancePool.pop_front();
     }
-    connect(instance, SIGNAL(activate(QObject*)), this, SLOT(soundSourceActivate(QObject*)));
+    connect(instance, SIGNAL(activate(QObject*)), this, SLOT(soundSourceActivate(QObject*)),
+            Qt::UniqueConnection);
     return instance;
 }
 
@@ -293,8 +744,13 @@ void QAudioEnginePrivate::releaseSoundSource(QSoundSource *soundInstance)
     qDebug() << "recycle soundInstance" << privInstance;
 #endif
     privInstance->unbindBuffer();
-    m_instancePool.push_front(privInstance);
     m_activeInstances.removeOne(privInstance);
+    if (m_instancePool.count() >= MaxPooledSources) {
+        // Keep the number of idle AL sources bounded
+        delete privInstance;
+        return;
+    }
+    m_instancePool.push_front(privInstance);
 }
 
 QSoundBuffer* QAudioEnginePrivate::getStaticSoundBuffer(const QUrl& url)
@@ -311,6 +767,20 @@ QSoundBuffer* QAudioEnginePrivate::getStaticSoundBuffer(const QUrl& url)
     return staticBuffer;
 }
 
+QSoundBuffer* QAudioEnginePrivate::getStreamingSoundBuffer(const QUrl& url)
+{
+    StreamingSoundBufferAL *streamingBuffer = NULL;
+    QMap<QUrl, QSoundBufferPrivateAL*>::iterator it = m_streamingBufferPool.find(url);
+    if (it == m_streamingBufferPool.end()) {
+        streamingBuffer = new StreamingSoundBufferAL(this, url, m_streamingThread);
+        m_streamingBufferPool.insert(url, streamingBuffer);
+    } else {
+        streamingBuffer = static_cast<StreamingSoundBufferAL*>(*it);
+        streamingBuffer->addRef();
+    }
+    return streamingBuffer;
+}
+
 void QAudioEnginePrivate::releaseSoundBuffer(QSoundBuffer *buffer)
 {
 #ifdef DEBUG_AUDIOENGINE
@@ -320,6 +790,9 @@ void QAudioEnginePrivate::releaseSoundBuffer(QSoundBuffer *buffer)
         //decrement the reference count, still kept in memory for reuse
         staticBuffer->release();
         //TODO implement some resource recycle strategy
+    } else if (StreamingSoundBufferAL *streamingBuffer = qobject_cast<StreamingSoundBufferAL *>(buffer)) {
+        //streams are per source and already released on unbind
+        streamingBuffer->release();
     } else {
         //TODO
         Q_ASSERT(0);
@@ -56,6 +56,8 @@
 #include <QMap>
 #include <QTimer>
 #include <QUrl>
+#include <QAtomicInt>
+#include <QAudioFormat>
 
 #if defined(HEADER_OPENAL_PREFIX)
 #include <OpenAL/al.h>
@@ -72,6 +74,9 @@ QT_BEGIN_NAMESPACE
 
 class QSample;
 class QSampleCache;
+class QFile;
+class QThread;
+class QWaveDecoder;
 
 class QSoundBufferPrivateAL : public QSoundBuffer
 {
@@ -80,6 +85,17 @@ public:
     QSoundBufferPrivateAL(QObject* parent);
     virtual void bindToSource(ALuint alSource) = 0;
     virtual void unbindFromSource(ALuint alSource) = 0;
+
+    // Transport control of a source bound to this buffer
+    virtual void sourcePlay(ALuint alSource);
+    virtual void sourcePause(ALuint alSource);
+    virtual void sourceStop(ALuint alSource);
+    virtual void setSourceLooping(ALuint alSource, bool looping);
+    virtual bool isSourceLooping(ALuint alSource) const;
+    // true while the source is waiting for more data to be decoded
+    virtual bool isSourceStarving(ALuint alSource) const;
+
+    static ALenum alFormat(const QAudioFormat &format);
 };
 
 
@@ -116,6 +132,102 @@ private:
 };
 
 
+// Decodes one sound file incrementally for a single AL source and keeps
+// a small queue of AL buffers filled. Lives in the engine's streaming thread.
+class QSoundStreamAL : public QObject
+{
+    Q_OBJECT
+public:
+    QSoundStreamAL(const QUrl &url, ALuint alSource);
+    ~QSoundStreamAL();
+
+    void requestPlay();
+    void requestPause();
+    void requestStop();
+
+    void setLooping(bool looping) { m_looping.storeRelaxed(looping); }
+    bool isLooping() const { return m_looping.loadRelaxed(); }
+    bool isStarving() const { return m_starving.loadRelaxed(); }
+
+public Q_SLOTS:
+    void start();
+    void shutdown();
+
+Q_SIGNALS:
+    void error();
+
+private Q_SLOTS:
+    void formatKnown();
+    void parsingError();
+    void refill();
+
+private:
+    enum { QueueLength = 4, ChunkDurationMs = 250, RefillIntervalMs = 50 };
+
+    void rewind();
+    bool fillBuffer(ALuint alBuffer);
+    void failed();
+
+    QUrl m_url;
+    ALuint m_alSource;
+    ALuint m_alBuffers[QueueLength];
+    ALenum m_alFormat;
+    QAudioFormat m_format;
+    QByteArray m_chunk;
+    QFile *m_file;
+    QWaveDecoder *m_decoder;
+    QTimer *m_refillTimer;
+    qint64 m_dataStart;
+    qint64 m_dataRead;
+    bool m_endOfStream;
+    bool m_finished;
+    int m_handledPlayRequest;
+
+    QAtomicInt m_looping;
+    QAtomicInt m_playing;
+    QAtomicInt m_playRequest;
+    QAtomicInt m_rewind;
+    QAtomicInt m_starving;
+};
+
+
+class StreamingSoundBufferAL : public QSoundBufferPrivateAL
+{
+    Q_OBJECT
+
+public:
+    StreamingSoundBufferAL(QObject *parent, const QUrl &url, QThread *streamingThread);
+    ~StreamingSoundBufferAL();
+
+    State state() const override;
+
+    void load() override;
+
+    void bindToSource(ALuint alSource) override;
+    void unbindFromSource(ALuint alSource) override;
+
+    void sourcePlay(ALuint alSource) override;
+    void sourcePause(ALuint alSource) override;
+    void sourceStop(ALuint alSource) override;
+    void setSourceLooping(ALuint alSource, bool looping) override;
+    bool isSourceLooping(ALuint alSource) const override;
+    bool isSourceStarving(ALuint alSource) const override;
+
+    inline long addRef() { return ++m_ref; }
+    inline long release() { return --m_ref; }
+    inline long refCount() const { return m_ref; }
+
+    static QString localFileName(const QUrl &url);
+
+private:
+    long m_ref;
+    QUrl m_url;
+    State m_state;
+    QThread *m_streamingThread;
+    QMap<ALuint, QSoundStreamAL*> m_streams;
+};
+
+
 class QSoundSourcePrivate : public QSoundSource
 {
     Q_OBJECT
@@ -160,6 +272,7 @@ private:
     ALuint  m_alSource;
     QSoundBufferPrivateAL *m_bindBuffer;
     bool                 m_isReady; //true if the sound source is already bound to some sound buffer
+    bool                 m_looping;
     QSoundSource::State  m_state;
     qreal   m_gain;
     qreal   m_pitch;
@@ -181,6 +294,7 @@ public:
     QSoundSource* createSoundSource();
     void releaseSoundSource(QSoundSource *soundInstance);
     QSoundBuffer* getStaticSoundBuffer(const QUrl& url);
+    QSoundBuffer* getStreamingSoundBuffer(const QUrl& url);
     void releaseSoundBuffer(QSoundBuffer *buffer);
 
     QVector3D listenerPosition() const;
@@ -203,11 +317,15 @@ private Q_SLOTS:
     void soundSourceActivate(QObject *soundSource);
 
 private:
+    enum { MaxPooledSources = 32 };
+
     QList<QSoundSourcePrivate*> m_activeInstances;
     QList<QSoundSourcePrivate*> m_instancePool;
     QMap<QUrl, QSoundBufferPrivateAL*> m_staticBufferPool;
+    QMap<QUrl, QSoundBufferPrivateAL*> m_streamingBufferPool;
 
     QSampleCache *m_sampleLoader;
+    QThread *m_streamingThread;
     QTimer m_updateTimer;
 };
 
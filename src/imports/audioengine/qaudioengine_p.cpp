@@ -86,6 +86,11 @@ QSoundBuffer* QAudioEngine::getStaticSoundBuffer(const QUrl& url)
     return d->getStaticSoundBuffer(url);
 }
 
+QSoundBuffer* QAudioEngine::getStreamingSoundBuffer(const QUrl& url)
+{
+    return d->getStreamingSoundBuffer(url);
+}
+
 void QAudioEngine::releaseSoundBuffer(QSoundBuffer *buffer)
 {
     d->releaseSoundBuffer(buffer);
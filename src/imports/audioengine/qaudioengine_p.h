@@ -72,6 +72,7 @@ public:
     virtual void releaseSoundSource(QSoundSource *soundInstance);
 
     virtual QSoundBuffer* getStaticSoundBuffer(const QUrl& url);
+    virtual QSoundBuffer* getStreamingSoundBuffer(const QUrl& url);
     virtual void releaseSoundBuffer(QSoundBuffer *buffer);
 
     virtual bool isLoading() const;
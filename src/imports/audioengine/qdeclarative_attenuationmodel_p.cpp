@@ -41,6 +41,9 @@
 #include "qdeclarative_audioengine_p.h"
 #include "qdebug.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define DEBUG_AUDIOENGINE
 
 QT_USE_NAMESPACE
@@ -74,6 +77,14 @@ void QDeclarativeAttenuationModel::setName(const QString& name)
     m_name = name;
 }
 
+void QDeclarativeAttenuationModel::calculateGains(const QVector3D &listenerPosition,
+                                                  const float *x, const float *y, const float *z,
+                                                  float *gains, int count) const
+{
+    for (int i = 0; i < count; ++i)
+        gains[i] = calculateGain(listenerPosition, QVector3D(x[i], y[i], z[i]));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 /*!
     \qmltype AttenuationModelLinear
@@ -203,6 +214,32 @@ qreal QDeclarativeAttenuationModelLinear::calculateGain(const QVector3D &listene
     return qreal(1) - (d / md);
 }
 
+void QDeclarativeAttenuationModelLinear::calculateGains(const QVector3D &listenerPosition,
+                                                        const float *x, const float *y, const float *z,
+                                                        float *gains, int count) const
+{
+    const float md = float(m_end - m_start);
+    if (md == 0) {
+        std::fill(gains, gains + count, 1.0f);
+        return;
+    }
+
+    // Branch free so that the compiler can vectorize it
+    const float lx = listenerPosition.x();
+    const float ly = listenerPosition.y();
+    const float lz = listenerPosition.z();
+    const float start = float(m_start);
+    const float invMd = 1.0f / md;
+    for (int i = 0; i < count; ++i) {
+        const float dx = x[i] - lx;
+        const float dy = y[i] - ly;
+        const float dz = z[i] - lz;
+        float d = std::sqrt(dx * dx + dy * dy + dz * dz) - start;
+        d = std::min(std::max(d, 0.0f), md);
+        gains[i] = 1.0f - d * invMd;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 /*!
     \qmltype AttenuationModelInverse
@@ -362,3 +399,26 @@ qreal QDeclarativeAttenuationModelInverse::calculateGain(const QVector3D &listen
     return m_ref / (m_ref + (qBound<qreal>(m_ref, (listenerPosition - sourcePosition).length(), m_max) - m_ref) * m_rolloff);
 }
 
+void QDeclarativeAttenuationModelInverse::calculateGains(const QVector3D &listenerPosition,
+                                                         const float *x, const float *y, const float *z,
+                                                         float *gains, int count) const
+{
+    Q_ASSERT(m_ref > 0);
+
+    // Branch free so that the compiler can vectorize it
+    const float lx = listenerPosition.x();
+    const float ly = listenerPosition.y();
+    const float lz = listenerPosition.z();
+    const float ref = float(m_ref);
+    const float max = float(m_max);
+    const float rolloff = float(m_rolloff);
+    for (int i = 0; i < count; ++i) {
+        const float dx = x[i] - lx;
+        const float dy = y[i] - ly;
+        const float dz = z[i] - lz;
+        float d = std::sqrt(dx * dx + dy * dy + dz * dz);
+        d = std::min(std::max(d, ref), max);
+        gains[i] = ref / (ref + (d - ref) * rolloff);
+    }
+}
+
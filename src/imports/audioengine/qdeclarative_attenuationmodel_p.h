@@ -72,6 +72,11 @@ public:
 
     virtual qreal calculateGain(const QVector3D &listenerPosition, const QVector3D &sourcePosition) const = 0;
 
+    //batched variant, source positions are passed as separate coordinate arrays
+    virtual void calculateGains(const QVector3D &listenerPosition,
+                                const float *x, const float *y, const float *z,
+                                float *gains, int count) const;
+
     virtual void setEngine(QDeclarativeAudioEngine *engine);
 
 protected:
@@ -98,6 +103,9 @@ public:
     void setEndDistance(qreal endDist);
 
     qreal calculateGain(const QVector3D &listenerPosition, const QVector3D &sourcePosition) const override;
+    void calculateGains(const QVector3D &listenerPosition,
+                        const float *x, const float *y, const float *z,
+                        float *gains, int count) const override;
 
     void setEngine(QDeclarativeAudioEngine *engine) override;
 
@@ -127,6 +135,9 @@ public:
     void setRolloffFactor(qreal rolloffFactor);
 
     qreal calculateGain(const QVector3D &listenerPosition, const QVector3D &sourcePosition) const override;
+    void calculateGains(const QVector3D &listenerPosition,
+                        const float *x, const float *y, const float *z,
+                        float *gains, int count) const override;
 
     void setEngine(QDeclarativeAudioEngine *engine) override;
 
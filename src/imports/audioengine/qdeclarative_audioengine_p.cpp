@@ -118,12 +118,14 @@ QDeclarativeAudioEngine::QDeclarativeAudioEngine(QObject *parent)
     , m_defaultCategory(0)
     , m_defaultAttenuationModel(0)
     , m_audioEngine(0)
+    , m_updateInterval(100)
+    , m_maxVoices(0)
 {
     m_audioEngine = QAudioEngine::create(this);
     connect(m_audioEngine, SIGNAL(isLoadingChanged()), this, SIGNAL(isLoadingChanged()));
     connect(m_audioEngine, SIGNAL(isLoadingChanged()), this, SLOT(handleLoadingChanged()));
     m_listener = new QDeclarativeAudioListener(this);
-    m_updateTimer.setInterval(100);
+    m_updateTimer.setInterval(m_updateInterval);
     connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateSoundInstances()));
 }
 
@@ -209,8 +211,10 @@ QSoundInstance* QDeclarativeAudioEngine::newSoundInstance(const QString &name)
     }
     instance->bindSoundDescription(qobject_cast<QDeclarativeSound*>(qvariant_cast<QObject*>(m_sounds.value(name))));
     m_activeSoundInstances.push_back(instance);
-    if (!m_updateTimer.isActive())
+    if (!m_updateTimer.isActive() && m_updateInterval > 0) {
+        m_updateClock.start();
         m_updateTimer.start();
+    }
     emit liveInstanceCountChanged();
     return instance;
 }
@@ -493,6 +497,12 @@ void QDeclarativeAudioEngine::componentComplete()
 
 void QDeclarativeAudioEngine::updateSoundInstances()
 {
+    qreal deltaTime = 0;
+    if (m_updateClock.isValid())
+        deltaTime = m_updateClock.restart() / qreal(1000);
+    else
+        m_updateClock.start();
+
     for (QList<QDeclarativeSoundInstance*>::Iterator it = m_managedDeclSoundInstances.begin();
          it != m_managedDeclSoundInstances.end();) {
         QDeclarativeSoundInstance *declSndInstance = *it;
@@ -503,21 +513,220 @@ void QDeclarativeAudioEngine::updateSoundInstances()
     qDebug() << "AudioEngine removed managed sounce instance";
 #endif
         } else {
-            declSndInstance->updatePosition(qreal(0.1));
+            declSndInstance->updatePosition(deltaTime);
             ++it;
         }
     }
 
-    QVector3D listenerPosition = this->listener()->position();
+    updateAttenuation();
+    enforceVoiceLimit();
+
+    if (m_activeSoundInstances.count() == 0) {
+        m_updateTimer.stop();
+        m_updateClock.invalidate();
+    }
+}
+
+void QDeclarativeAudioEngine::updateAttenuation()
+{
+    // Gather the attenuated voices into a structure of arrays so that
+    // the gains of all voices sharing a model are computed in one pass
+    m_batchInstances.clear();
     for (QSoundInstance *instance : qAsConst(m_activeSoundInstances)) {
         if (instance->state() == QSoundInstance::PlayingState
             &&  instance->attenuationEnabled()) {
-            instance->update3DVolume(listenerPosition);
+            m_batchInstances.append(instance);
+        }
+    }
+
+    const int count = m_batchInstances.count();
+    if (count == 0)
+        return;
+
+    m_batchX.resize(count);
+    m_batchY.resize(count);
+    m_batchZ.resize(count);
+    m_batchGains.resize(count);
+
+    const QVector3D listenerPosition = this->listener()->position();
+    int done = 0;
+    while (done < count) {
+        // Partition the remaining instances so that the ones sharing the
+        // model of the first remaining instance are contiguous
+        QDeclarativeAttenuationModel *model = m_batchInstances.at(done)->sound()->attenuationModelObject();
+        int end = done;
+        for (int i = done; i < count; ++i) {
+            if (m_batchInstances.at(i)->sound()->attenuationModelObject() == model) {
+                std::swap(m_batchInstances[i], m_batchInstances[end]);
+                ++end;
+            }
+        }
+
+        for (int i = done; i < end; ++i) {
+            const QVector3D position = m_batchInstances.at(i)->position();
+            m_batchX[i] = position.x();
+            m_batchY[i] = position.y();
+            m_batchZ[i] = position.z();
         }
+
+        model->calculateGains(listenerPosition,
+                              m_batchX.constData() + done,
+                              m_batchY.constData() + done,
+                              m_batchZ.constData() + done,
+                              m_batchGains.data() + done,
+                              end - done);
+
+        for (int i = done; i < end; ++i)
+            m_batchInstances.at(i)->setAttenuationGain(m_batchGains.at(i));
+
+        done = end;
+    }
+}
+
+int QDeclarativeAudioEngine::playingVoiceCount() const
+{
+    int count = 0;
+    for (QSoundInstance *instance : qAsConst(m_activeSoundInstances)) {
+        if (instance->state() != QSoundInstance::StoppedState)
+            ++count;
+    }
+    return count;
+}
+
+QSoundInstance *QDeclarativeAudioEngine::voiceToSteal(QSoundInstance *exclude) const
+{
+    QSoundInstance *victim = 0;
+    for (QSoundInstance *instance : qAsConst(m_activeSoundInstances)) {
+        if (instance == exclude || instance->state() == QSoundInstance::StoppedState)
+            continue;
+        if (!victim
+            || instance->priority() < victim->priority()
+            || (instance->priority() == victim->priority()
+                && instance->effectiveGain() < victim->effectiveGain())) {
+            victim = instance;
+        }
+    }
+    return victim;
+}
+
+void QDeclarativeAudioEngine::enforceVoiceLimit()
+{
+    if (m_maxVoices <= 0)
+        return;
+
+    int excess = playingVoiceCount() - m_maxVoices;
+    while (excess-- > 0) {
+        QSoundInstance *victim = voiceToSteal(0);
+        if (!victim)
+            break;
+#ifdef DEBUG_AUDIOENGINE
+        qDebug() << "AudioEngine: stealing voice" << victim;
+#endif
+        victim->stop();
     }
+}
+
+bool QDeclarativeAudioEngine::acquireVoice(QSoundInstance *instance)
+{
+    if (m_maxVoices <= 0 || playingVoiceCount() < m_maxVoices)
+        return true;
+
+    if (instance->attenuationEnabled())
+        instance->update3DVolume(this->listener()->position());
+
+    QSoundInstance *victim = voiceToSteal(instance);
+    if (!victim)
+        return false;
+    if (victim->priority() > instance->priority()
+        || (victim->priority() == instance->priority()
+            && victim->effectiveGain() > instance->effectiveGain())) {
+        return false;
+    }
+
+#ifdef DEBUG_AUDIOENGINE
+    qDebug() << "AudioEngine: stealing voice" << victim << "for" << instance;
+#endif
+    victim->stop();
+    return true;
+}
+
+/*!
+    \qmlmethod QtAudioEngine::AudioEngine::update()
+    \since 5.15
 
-    if (m_activeSoundInstances.count() == 0)
+    Updates the positions and distance attenuation of all playing sounds and
+    stops the least important sounds if there are more than \l maxVoices.
+
+    This is done automatically every \l updateInterval milliseconds. When
+    \l updateInterval is set to 0, call this method once per frame instead,
+    for example from the \c afterAnimating signal of the Window, so that the
+    audio scene is updated in step with rendering.
+*/
+void QDeclarativeAudioEngine::update()
+{
+    updateSoundInstances();
+}
+
+/*!
+    \qmlproperty int QtAudioEngine::AudioEngine::updateInterval
+    \since 5.15
+
+    This property holds the interval in milliseconds at which the positions
+    and distance attenuation of the playing sounds are updated. When set to 0,
+    no automatic updates are done and \l update() must be called by the
+    application, typically once per rendered frame.
+
+    The default value is 100.
+*/
+int QDeclarativeAudioEngine::updateInterval() const
+{
+    return m_updateInterval;
+}
+
+void QDeclarativeAudioEngine::setUpdateInterval(int interval)
+{
+    interval = qMax(0, interval);
+    if (m_updateInterval == interval)
+        return;
+
+    m_updateInterval = interval;
+    if (m_updateInterval == 0) {
         m_updateTimer.stop();
+    } else {
+        m_updateTimer.setInterval(m_updateInterval);
+        if (!m_updateTimer.isActive() && m_activeSoundInstances.count() > 0)
+            m_updateTimer.start();
+    }
+    emit updateIntervalChanged();
+}
+
+/*!
+    \qmlproperty int QtAudioEngine::AudioEngine::maxVoices
+    \since 5.15
+
+    This property holds the maximum number of sounds which can play at the
+    same time. When the limit is reached, playing another sound stops the
+    playing sound with the lowest \l{QtAudioEngine::Sound::priority}{priority},
+    preferring the one which is heard the least because of its distance to the
+    listener and its gain. If all playing sounds are more important, the new
+    sound is not played.
+
+    The default value is 0, which means there is no limit.
+*/
+int QDeclarativeAudioEngine::maxVoices() const
+{
+    return m_maxVoices;
+}
+
+void QDeclarativeAudioEngine::setMaxVoices(int maxVoices)
+{
+    maxVoices = qMax(0, maxVoices);
+    if (m_maxVoices == maxVoices)
+        return;
+
+    m_maxVoices = maxVoices;
+    enforceVoiceLimit();
+    emit maxVoicesChanged();
 }
 
 void QDeclarativeAudioEngine::appendFunction(QQmlListProperty<QObject> *property, QObject *value)
@@ -56,6 +56,8 @@
 #include <QtQml/qqmlpropertymap.h>
 #include <QtCore/QMap>
 #include <QtCore/QList>
+#include <QtCore/QVector>
+#include <QtCore/QElapsedTimer>
 #include <QTimer>
 #include "qaudioengine_p.h"
 
@@ -84,6 +86,8 @@ class QDeclarativeAudioEngine : public QObject, public QQmlParserStatus
     Q_PROPERTY(QDeclarativeAudioListener* listener READ listener CONSTANT)
     Q_PROPERTY(qreal dopplerFactor READ dopplerFactor WRITE setDopplerFactor)
     Q_PROPERTY(qreal speedOfSound READ speedOfSound WRITE setSpeedOfSound)
+    Q_PROPERTY(int updateInterval READ updateInterval WRITE setUpdateInterval NOTIFY updateIntervalChanged REVISION 15)
+    Q_PROPERTY(int maxVoices READ maxVoices WRITE setMaxVoices NOTIFY maxVoicesChanged REVISION 15)
     Q_CLASSINFO("DefaultProperty", "bank")
 
 public:
@@ -113,6 +117,15 @@ public:
 
     int liveInstanceCount() const;
 
+    int updateInterval() const;
+    void setUpdateInterval(int interval);
+
+    int maxVoices() const;
+    void setMaxVoices(int maxVoices);
+
+    //returns false if the instance can not get a voice to play with
+    bool acquireVoice(QSoundInstance *instance);
+
     //for child elements
     bool isReady() const;
     QAudioEngine* engine() const;
@@ -133,11 +146,15 @@ public:
     Q_REVISION(1) Q_INVOKABLE void addAudioCategory(QDeclarativeAudioCategory *);
     Q_REVISION(1) Q_INVOKABLE void addAttenuationModel(QDeclarativeAttenuationModel *);
 
+    Q_REVISION(15) Q_INVOKABLE void update();
+
 Q_SIGNALS:
     void ready();
     void liveInstanceCountChanged();
     void isLoadingChanged();
     void finishedLoading();
+    Q_REVISION(15) void updateIntervalChanged();
+    Q_REVISION(15) void maxVoicesChanged();
 
 private Q_SLOTS:
     void updateSoundInstances();
@@ -168,6 +185,21 @@ private:
     QList<QSoundInstance*> m_activeSoundInstances;
 
     QTimer m_updateTimer;
+    int m_updateInterval;
+    QElapsedTimer m_updateClock;
+    int m_maxVoices;
+
+    //scratch buffers for the batched attenuation pass, kept to avoid reallocation
+    QVector<QSoundInstance*> m_batchInstances;
+    QVector<float> m_batchX;
+    QVector<float> m_batchY;
+    QVector<float> m_batchZ;
+    QVector<float> m_batchGains;
+    void updateAttenuation();
+    void enforceVoiceLimit();
+    QSoundInstance *voiceToSteal(QSoundInstance *exclude) const;
+    int playingVoiceCount() const;
+
     QList<QDeclarativeSoundInstance*> m_managedDeclSoundInstances;
     QList<QDeclarativeSoundInstance*> m_managedDeclSndInstancePool;
     void releaseManagedDeclarativeSoundInstance(QDeclarativeSoundInstance* declSndInstance);
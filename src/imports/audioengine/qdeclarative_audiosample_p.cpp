@@ -112,6 +112,18 @@ void QDeclarativeAudioSample::setSource(const QUrl& url)
     m_url = url;
 }
 
+/*!
+    \qmlproperty bool QtAudioEngine::AudioSample::streaming
+
+    This property indicates whether this sample is streamed from its source
+    rather than decoded into memory up front. Streamed samples are decoded
+    incrementally while they play, so playback starts as soon as the first
+    chunk is available and memory use does not grow with the length of the
+    file. This is suited for music and long ambience tracks. Only local files
+    and resources can be streamed.
+
+    This property can not be changed after initialization.
+*/
 bool QDeclarativeAudioSample::isStreaming() const
 {
     return m_streaming;
@@ -214,19 +226,18 @@ void QDeclarativeAudioSample::init()
 {
     Q_ASSERT(m_engine != 0);
 
-    if (m_streaming) {
-        //TODO
+    if (m_streaming)
+        m_soundBuffer = m_engine->engine()->getStreamingSoundBuffer(m_url);
+    else
+        m_soundBuffer = m_engine->engine()->getStaticSoundBuffer(m_url);
 
+    if (m_soundBuffer->state() == QSoundBuffer::Ready) {
+        emit loadedChanged();
     } else {
-        m_soundBuffer = m_engine->engine()->getStaticSoundBuffer(m_url);
-        if (m_soundBuffer->state() == QSoundBuffer::Ready) {
-            emit loadedChanged();
-        } else {
-            connect(m_soundBuffer, SIGNAL(ready()), this, SIGNAL(loadedChanged()));
-        }
-        if (m_preloaded) {
-            m_soundBuffer->load();
-        }
+        connect(m_soundBuffer, SIGNAL(ready()), this, SIGNAL(loadedChanged()));
+    }
+    if (m_preloaded) {
+        m_soundBuffer->load();
     }
 }
 
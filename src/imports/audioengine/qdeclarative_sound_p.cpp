@@ -221,6 +221,7 @@ void QDeclarativeSoundCone::setEngine(QDeclarativeAudioEngine *engine)
 QDeclarativeSound::QDeclarativeSound(QObject *parent)
     : QObject(parent)
     , m_playType(Random)
+    , m_priority(0)
     , m_attenuationModelObject(0)
     , m_categoryObject(0)
     , m_engine(0)
@@ -341,6 +342,28 @@ void QDeclarativeSound::setAttenuationModel(const QString &attenuationModel)
     m_attenuationModel = attenuationModel;
 }
 
+/*!
+    \qmlproperty int QtAudioEngine::Sound::priority
+    \since 5.15
+
+    This property holds the priority of the sound when the number of voices
+    is limited by \l{QtAudioEngine::AudioEngine::maxVoices}{AudioEngine.maxVoices}.
+    When no voice is free, playing a sound stops the instance with the lowest
+    priority, and among those the one which is heard the least. A sound can not
+    steal the voice of a sound with a higher priority.
+
+    The default value is 0.
+*/
+int QDeclarativeSound::priority() const
+{
+    return m_priority;
+}
+
+void QDeclarativeSound::setPriority(int priority)
+{
+    m_priority = priority;
+}
+
 void QDeclarativeSound::setEngine(QDeclarativeAudioEngine *engine)
 {
     if (m_engine) {
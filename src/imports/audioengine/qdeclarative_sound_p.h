@@ -102,6 +102,7 @@ class QDeclarativeSound : public QObject
     Q_PROPERTY(QString category READ category WRITE setCategory)
     Q_PROPERTY(QDeclarativeSoundCone* cone READ cone CONSTANT)
     Q_PROPERTY(QString attenuationModel READ attenuationModel WRITE setAttenuationModel)
+    Q_PROPERTY(int priority READ priority WRITE setPriority REVISION 15)
     Q_PROPERTY(QQmlListProperty<QDeclarativePlayVariation> playVariationlist READ playVariationlist CONSTANT)
     Q_CLASSINFO("DefaultProperty", "playVariationlist")
 
@@ -128,6 +129,9 @@ public:
     QString attenuationModel() const;
     void setAttenuationModel(const QString &attenuationModel);
 
+    int priority() const;
+    void setPriority(int priority);
+
     QDeclarativeAudioEngine *engine() const;
     void setEngine(QDeclarativeAudioEngine *);
 
@@ -170,6 +174,7 @@ private:
     QString m_name;
     QString m_category;
     QString m_attenuationModel;
+    int m_priority;
     QList<QDeclarativePlayVariation*> m_playlist;
     QDeclarativeSoundCone *m_cone;
 
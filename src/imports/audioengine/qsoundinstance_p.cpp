@@ -100,6 +100,7 @@ void QSoundInstance::bindSoundDescription(QDeclarativeSound *sound)
             m_soundSource = m_engine->engine()->createSoundSource();
             connect(m_soundSource, SIGNAL(stateChanged(QSoundSource::State)),
                     this, SLOT(handleSourceStateChanged(QSoundSource::State)));
+            m_position = m_soundSource->position();
         }
     } else {
         if (m_soundSource) {
@@ -238,6 +239,12 @@ void QSoundInstance::play()
 #endif
     if (!m_soundSource || m_state == QSoundInstance::PlayingState)
         return;
+    if (!m_engine->acquireVoice(this)) {
+#ifdef DEBUG_AUDIOENGINE
+        qDebug() << "QSoundInstance: no voice available";
+#endif
+        return;
+    }
     if (!m_isReady) {
         setState(QSoundInstance::PlayingState);
         return;
@@ -300,9 +307,15 @@ void QSoundInstance::setPosition(const QVector3D& position)
 {
     if (!m_soundSource)
         return;
+    m_position = position;
     m_soundSource->setPosition(position);
 }
 
+QVector3D QSoundInstance::position() const
+{
+    return m_position;
+}
+
 void QSoundInstance::setDirection(const QVector3D& direction)
 {
     if (!m_soundSource)
@@ -347,6 +360,21 @@ bool QSoundInstance::attenuationEnabled() const
     return true;
 }
 
+QDeclarativeSound *QSoundInstance::sound() const
+{
+    return m_sound;
+}
+
+int QSoundInstance::priority() const
+{
+    return m_sound ? m_sound->priority() : 0;
+}
+
+qreal QSoundInstance::effectiveGain() const
+{
+    return m_gain * m_varGain * m_attenuationGain * categoryVolume();
+}
+
 void QSoundInstance::update3DVolume(const QVector3D& listenerPosition)
 {
     if (!m_sound || !m_soundSource)
@@ -354,7 +382,15 @@ void QSoundInstance::update3DVolume(const QVector3D& listenerPosition)
     QDeclarativeAttenuationModel *attenModel = m_sound->attenuationModelObject();
     if (!attenModel)
         return;
-    m_attenuationGain = attenModel->calculateGain(listenerPosition, m_soundSource->position());
+    m_attenuationGain = attenModel->calculateGain(listenerPosition, m_position);
+    updateGain();
+}
+
+void QSoundInstance::setAttenuationGain(qreal attenuationGain)
+{
+    if (!m_soundSource || m_attenuationGain == attenuationGain)
+        return;
+    m_attenuationGain = attenuationGain;
     updateGain();
 }
 
@@ -78,6 +78,7 @@ public:
     State state() const;
 
     void setPosition(const QVector3D& position);
+    QVector3D position() const;
     void setDirection(const QVector3D& direction);
     void setVelocity(const QVector3D& velocity);
 
@@ -92,8 +93,15 @@ public:
     void bindSoundDescription(QDeclarativeSound *sound);
 
     void update3DVolume(const QVector3D& listenerPosition);
+    //used by the batched update in QDeclarativeAudioEngine
+    void setAttenuationGain(qreal attenuationGain);
 
     bool attenuationEnabled() const;
+    QDeclarativeSound *sound() const;
+
+    //used for voice stealing, the quietest voice with the lowest priority is stolen first
+    int priority() const;
+    qreal effectiveGain() const;
 
 Q_SIGNALS:
     void stateChanged(QSoundInstance::State state);
@@ -135,6 +143,7 @@ private:
     qreal                m_varPitch;
     State                m_state;
     qreal                m_coneOuterGain;
+    QVector3D            m_position;
 
     QDeclarativeAudioEngine *m_engine;
 };
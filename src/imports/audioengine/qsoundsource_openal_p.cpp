@@ -49,6 +49,7 @@ QSoundSourcePrivate::QSoundSourcePrivate(QObject *parent)
     , m_alSource(0)
     , m_bindBuffer(0)
     , m_isReady(false)
+    , m_looping(false)
     , m_state(QSoundSource::StoppedState)
     , m_gain(0)
     , m_pitch(0)
@@ -94,6 +95,7 @@ void QSoundSourcePrivate::bindBuffer(QSoundBuffer* soundBuffer)
     Q_ASSERT(soundBuffer->state() == QSoundBuffer::Ready);
     m_bindBuffer = qobject_cast<QSoundBufferPrivateAL*>(soundBuffer);
     m_bindBuffer->bindToSource(m_alSource);
+    m_bindBuffer->setSourceLooping(m_alSource, m_looping);
     m_isReady = true;
 }
 
@@ -114,7 +116,7 @@ void QSoundSourcePrivate::play()
 {
     if (!m_alSource || !m_isReady)
         return;
-    alSourcePlay(m_alSource);
+    m_bindBuffer->sourcePlay(m_alSource);
 #ifdef DEBUG_AUDIOENGINE
     QAudioEnginePrivate::checkNoError("play");
 #endif
@@ -125,6 +127,8 @@ bool QSoundSourcePrivate::isLooping() const
 {
     if (!m_alSource)
         return false;
+    if (m_bindBuffer)
+        return m_bindBuffer->isSourceLooping(m_alSource);
     ALint looping = 0;
     alGetSourcei(m_alSource, AL_LOOPING, &looping);
     return looping == AL_TRUE ? true : false;
@@ -134,7 +138,7 @@ void QSoundSourcePrivate::pause()
 {
     if (!m_alSource || !m_isReady)
         return;
-    alSourcePause(m_alSource);
+    m_bindBuffer->sourcePause(m_alSource);
 #ifdef DEBUG_AUDIOENGINE
     QAudioEnginePrivate::checkNoError("pause");
 #endif
@@ -144,7 +148,10 @@ void QSoundSourcePrivate::stop()
 {
     if (!m_alSource)
         return;
-    alSourceStop(m_alSource);
+    if (m_bindBuffer)
+        m_bindBuffer->sourceStop(m_alSource);
+    else
+        alSourceStop(m_alSource);
 #ifdef DEBUG_AUDIOENGINE
     QAudioEnginePrivate::checkNoError("stop");
 #endif
@@ -169,6 +176,11 @@ void QSoundSourcePrivate::checkState()
         case AL_PAUSED:
             st = QSoundSource::PausedState;
             break;
+        default:
+            // a streaming source stops while it waits for data to be decoded
+            if (m_bindBuffer && m_bindBuffer->isSourceStarving(m_alSource))
+                st = QSoundSource::PlayingState;
+            break;
         }
     }
     if (st == m_state)
@@ -181,7 +193,11 @@ void QSoundSourcePrivate::setLooping(bool looping)
 {
     if (!m_alSource)
         return;
-    alSourcei(m_alSource, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
+    m_looping = looping;
+    if (m_bindBuffer)
+        m_bindBuffer->setSourceLooping(m_alSource, looping);
+    else
+        alSourcei(m_alSource, AL_LOOPING, looping ? AL_TRUE : AL_FALSE);
 }
 
 void QSoundSourcePrivate::setPosition(const QVector3D& position)
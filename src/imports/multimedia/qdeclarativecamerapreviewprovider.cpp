@@ -38,16 +38,130 @@
 ****************************************************************************/
 
 #include "qdeclarativecamerapreviewprovider_p.h"
+#include <QtCore/qhash.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qwaitcondition.h>
 #include <QtCore/qdebug.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
-struct QDeclarativeCameraPreviewProviderPrivate
+namespace {
+
+// Bytes of full-resolution and scaled previews kept. The least recently
+// used captures are dropped first, but the latest one is always kept.
+const qint64 maxCacheBytes = 64 * 1024 * 1024;
+// Scaled variants kept per capture, e.g. a thumbnail and a full view.
+const int maxVariants = 4;
+
+struct PreviewEntry
 {
-    QString id;
     QImage image;
+
+    // Guards variants and pending. It is not held while scaling, so cached
+    // sizes are served while another size is being generated.
+    QMutex mutex;
+    QWaitCondition scaled;
+    QList<QImage> variants;
+    // Sizes being scaled by another thread, each size is scaled once.
+    QSet<quint64> pending;
+
+    // Bytes accounted for this capture, guarded by the provider mutex.
+    qint64 cost = 0;
+};
+
+quint64 sizeKey(const QSize &size)
+{
+    return (quint64(quint32(size.width())) << 32) | quint32(size.height());
+}
+
+// Averages factor x factor blocks. This is much cheaper than a smooth
+// transformation over the full-resolution image and leaves only a
+// reduction of less than 2x for QImage::scaled().
+QImage boxDownscale(const QImage &source, int factor)
+{
+    const QImage image = source.format() == QImage::Format_RGB32
+            ? source
+            : source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    const int width = image.width() / factor;
+    const int height = image.height() / factor;
+    QImage result(width, height, image.format());
+    if (result.isNull())
+        return source;
+
+    const int area = factor * factor;
+    for (int y = 0; y < height; ++y) {
+        QRgb *dst = reinterpret_cast<QRgb *>(result.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            quint32 a = 0, r = 0, g = 0, b = 0;
+            for (int j = 0; j < factor; ++j) {
+                const QRgb *src = reinterpret_cast<const QRgb *>(image.constScanLine(y * factor + j)) + x * factor;
+                for (int i = 0; i < factor; ++i) {
+                    a += qAlpha(src[i]);
+                    r += qRed(src[i]);
+                    g += qGreen(src[i]);
+                    b += qBlue(src[i]);
+                }
+            }
+            dst[x] = qRgba(r / area, g / area, b / area, a / area);
+        }
+    }
+
+    return result;
+}
+
+QImage scaledPreview(const QImage &image, const QSize &requestedSize)
+{
+    const QSize target = image.size().scaled(requestedSize, Qt::KeepAspectRatio);
+    if (target.isEmpty())
+        return image;
+
+    const int factor = qMin(image.width() / target.width(), image.height() / target.height());
+    const QImage reduced = factor >= 2 ? boxDownscale(image, factor) : image;
+
+    return reduced.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+}
+
+struct QDeclarativeCameraPreviewProviderPrivate
+{
+    QHash<QString, QSharedPointer<PreviewEntry>> previews;
+    QList<QString> order; // least recently used first
+    qint64 bytes = 0;
     QMutex mutex;
+
+    QSharedPointer<PreviewEntry> entry(const QString &id)
+    {
+        QMutexLocker lock(&mutex);
+        const QSharedPointer<PreviewEntry> result = previews.value(id);
+        if (result && order.last() != id) {
+            order.removeOne(id);
+            order.append(id);
+        }
+        return result;
+    }
+
+    void addCost(const QString &id, const QSharedPointer<PreviewEntry> &entry, qint64 delta)
+    {
+        QMutexLocker lock(&mutex);
+        // Not accounted any more if the capture was dropped while scaling
+        if (previews.value(id) != entry)
+            return;
+        entry->cost += delta;
+        bytes += delta;
+        evict();
+    }
+
+    void evict()
+    {
+        while (bytes > maxCacheBytes && order.size() > 1)
+            bytes -= previews.take(order.takeFirst())->cost;
+    }
 };
 
 Q_GLOBAL_STATIC(QDeclarativeCameraPreviewProviderPrivate, qDeclarativeCameraPreviewProviderPrivate)
@@ -61,21 +175,53 @@ QDeclarativeCameraPreviewProvider::~QDeclarativeCameraPreviewProvider()
 {
     QDeclarativeCameraPreviewProviderPrivate *d = qDeclarativeCameraPreviewProviderPrivate();
     QMutexLocker lock(&d->mutex);
-    d->id.clear();
-    d->image = QImage();
+    d->previews.clear();
+    d->order.clear();
+    d->bytes = 0;
 }
 
+/*
+    Runs on the QML image loader threads for asynchronous images. The mutexes
+    only guard the lookups; scaling runs unlocked, and each requested size is
+    scaled once and then served from the cache.
+*/
 QImage QDeclarativeCameraPreviewProvider::requestImage(const QString &id, QSize *size, const QSize& requestedSize)
 {
     QDeclarativeCameraPreviewProviderPrivate *d = qDeclarativeCameraPreviewProviderPrivate();
-    QMutexLocker lock(&d->mutex);
-
-    if (d->id != id)
+    const QSharedPointer<PreviewEntry> entry = d->entry(id);
+    if (!entry)
         return QImage();
 
-    QImage res = d->image;
-    if (!requestedSize.isEmpty())
-        res = res.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QImage res = entry->image;
+    if (!requestedSize.isEmpty()) {
+        const QSize target = res.size().scaled(requestedSize, Qt::KeepAspectRatio);
+        const quint64 key = sizeKey(target);
+        const auto hasKey = [key](const QImage &variant) { return sizeKey(variant.size()) == key; };
+
+        QMutexLocker lock(&entry->mutex);
+        while (entry->pending.contains(key))
+            entry->scaled.wait(&entry->mutex);
+
+        auto it = std::find_if(entry->variants.begin(), entry->variants.end(), hasKey);
+        if (it != entry->variants.end()) {
+            res = *it;
+        } else {
+            entry->pending.insert(key);
+            lock.unlock();
+            res = scaledPreview(entry->image, requestedSize);
+            lock.relock();
+
+            qint64 delta = res.sizeInBytes();
+            entry->variants.append(res);
+            if (entry->variants.size() > maxVariants)
+                delta -= entry->variants.takeFirst().sizeInBytes();
+            entry->pending.remove(key);
+            entry->scaled.wakeAll();
+            lock.unlock();
+
+            d->addCost(id, entry, delta);
+        }
+    }
 
     if (size)
         *size = res.size();
@@ -85,11 +231,21 @@ QImage QDeclarativeCameraPreviewProvider::requestImage(const QString &id, QSize
 
 void QDeclarativeCameraPreviewProvider::registerPreview(const QString &id, const QImage &preview)
 {
-    //only the last preview is kept
     QDeclarativeCameraPreviewProviderPrivate *d = qDeclarativeCameraPreviewProviderPrivate();
+    QSharedPointer<PreviewEntry> entry(new PreviewEntry);
+    entry->image = preview;
+    entry->cost = preview.sizeInBytes();
+
     QMutexLocker lock(&d->mutex);
-    d->id = id;
-    d->image = preview;
+    if (const QSharedPointer<PreviewEntry> previous = d->previews.take(id)) {
+        d->order.removeOne(id);
+        d->bytes -= previous->cost;
+    }
+    d->previews.insert(id, entry);
+    d->order.append(id);
+    d->bytes += entry->cost;
+
+    d->evict();
 }
 
 QT_END_NAMESPACE
@@ -20,6 +20,9 @@ PRIVATE_HEADERS += \
            audio/qwavedecoder_p.h \
            audio/qsamplecache_p.h \
            audio/qaudiohelpers_p.h \
+           audio/qaudioconverter_p.h \
+           audio/qaudioformatadapter_p.h \
+           audio/qaudiodecoderconsumer_p.h \
            audio/qaudiosystempluginext_p.h
 
 SOURCES += \
@@ -38,7 +41,12 @@ SOURCES += \
            audio/qaudiobuffer.cpp \
            audio/qaudioprobe.cpp \
            audio/qaudiodecoder.cpp \
-           audio/qaudiohelpers.cpp
+           audio/qaudiodecoderconsumer.cpp \
+           audio/qaudiohelpers.cpp \
+           audio/qaudioconverter.cpp \
+           audio/qaudioformatadapter.cpp
+
+SSE2_SOURCES += audio/qaudioconverter_sse2.cpp
 
 qtConfig(pulseaudio) {
     QMAKE_USE_FOR_PRIVATE += pulseaudio
@@ -0,0 +1,774 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaudioconverter_p.h"
+
+#include <QtCore/qendian.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qsysinfo.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+extern void QT_FASTCALL qt_audio_s16_to_float_sse2(const qint16 *src, float *dst, int count);
+extern void QT_FASTCALL qt_audio_float_to_s16_sse2(const float *src, qint16 *dst, int count);
+extern float QT_FASTCALL qt_audio_dot_product_sse2(const float *a, const float *b, int count);
+#endif
+
+namespace {
+
+// Number of kernel table entries per zero crossing of the sinc.
+const int KernelPhases = 256;
+
+static void QT_FASTCALL qt_audio_s16_to_float(const qint16 *src, float *dst, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = src[i] * (1.0f / 32768.0f);
+}
+
+static void QT_FASTCALL qt_audio_float_to_s16(const float *src, qint16 *dst, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = qint16(qRound(qBound(-32768.0f, src[i] * 32768.0f, 32767.0f)));
+}
+
+static float QT_FASTCALL qt_audio_dot_product(const float *a, const float *b, int count)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+struct AudioKernels
+{
+    AudioKernels()
+    {
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+        if (qCpuHasFeature(SSE2)) {
+            s16ToFloat = qt_audio_s16_to_float_sse2;
+            floatToS16 = qt_audio_float_to_s16_sse2;
+            dotProduct = qt_audio_dot_product_sse2;
+        }
+#endif
+    }
+
+    AudioS16ToFloatFunc s16ToFloat = qt_audio_s16_to_float;
+    AudioFloatToS16Func floatToS16 = qt_audio_float_to_s16;
+    AudioDotProductFunc dotProduct = qt_audio_dot_product;
+};
+
+static const AudioKernels &audioKernels()
+{
+    static const AudioKernels kernels;
+    return kernels;
+}
+
+static bool isNativeS16(const QAudioFormat &format)
+{
+    return format.sampleType() == QAudioFormat::SignedInt
+            && format.sampleSize() == 16
+            && format.byteOrder() == QAudioFormat::Endian(QSysInfo::ByteOrder);
+}
+
+template <typename T>
+static inline T readSample(const uchar *src, QAudioFormat::Endian byteOrder)
+{
+    return byteOrder == QAudioFormat::LittleEndian
+            ? qFromLittleEndian<T>(src)
+            : qFromBigEndian<T>(src);
+}
+
+template <typename T>
+static inline void writeSample(T value, uchar *dst, QAudioFormat::Endian byteOrder)
+{
+    if (byteOrder == QAudioFormat::LittleEndian)
+        qToLittleEndian<T>(value, dst);
+    else
+        qToBigEndian<T>(value, dst);
+}
+
+static inline qint32 readInt24(const uchar *src, QAudioFormat::Endian byteOrder)
+{
+    const quint32 value = byteOrder == QAudioFormat::LittleEndian
+            ? quint32(src[0]) | quint32(src[1]) << 8 | quint32(src[2]) << 16
+            : quint32(src[2]) | quint32(src[1]) << 8 | quint32(src[0]) << 16;
+    return qint32(value << 8) >> 8;
+}
+
+static inline void writeInt24(qint32 value, uchar *dst, QAudioFormat::Endian byteOrder)
+{
+    const quint32 v = quint32(value);
+    if (byteOrder == QAudioFormat::LittleEndian) {
+        dst[0] = uchar(v);
+        dst[1] = uchar(v >> 8);
+        dst[2] = uchar(v >> 16);
+    } else {
+        dst[0] = uchar(v >> 16);
+        dst[1] = uchar(v >> 8);
+        dst[2] = uchar(v);
+    }
+}
+
+static inline qint32 toInt(float value, float scale)
+{
+    return qint32(qRound(qBound(-scale, value * scale, scale - 1.0f)));
+}
+
+// Zeroth order modified Bessel function of the first kind, used by the
+// Kaiser window.
+static double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12)
+            break;
+    }
+    return sum;
+}
+
+// Speaker positions, QAudioFormat has no channel mask so the WAVE default
+// layout for the channel count is assumed.
+enum Speaker
+{
+    FrontLeft,
+    FrontRight,
+    FrontCenter,
+    LowFrequency,
+    BackLeft,
+    BackRight,
+    BackCenter,
+    SideLeft,
+    SideRight,
+    UnknownSpeaker
+};
+
+static QVector<Speaker> channelLayout(int channels)
+{
+    switch (channels) {
+    case 1:
+        return { FrontCenter };
+    case 2:
+        return { FrontLeft, FrontRight };
+    case 3:
+        return { FrontLeft, FrontRight, FrontCenter };
+    case 4:
+        return { FrontLeft, FrontRight, BackLeft, BackRight };
+    case 5:
+        return { FrontLeft, FrontRight, FrontCenter, BackLeft, BackRight };
+    case 6:
+        return { FrontLeft, FrontRight, FrontCenter, LowFrequency, BackLeft, BackRight };
+    case 7:
+        return { FrontLeft, FrontRight, FrontCenter, LowFrequency, BackCenter, SideLeft, SideRight };
+    case 8:
+        return { FrontLeft, FrontRight, FrontCenter, LowFrequency, BackLeft, BackRight, SideLeft, SideRight };
+    default:
+        return QVector<Speaker>(channels, UnknownSpeaker);
+    }
+}
+
+// Gains of each input channel in each output channel, one row per output
+// channel. Down-mixing follows ITU-R BS.775: the centre and the surrounds
+// go to the nearest remaining speakers at -3 dB and the LFE is dropped.
+static QVector<float> mixMatrix(int inputChannels, int outputChannels)
+{
+    QVector<float> matrix(inputChannels * outputChannels, 0.0f);
+    const auto gain = [&](int output, int input) -> float & {
+        return matrix[output * inputChannels + input];
+    };
+
+    if (inputChannels == outputChannels) {
+        for (int channel = 0; channel < inputChannels; ++channel)
+            gain(channel, channel) = 1.0f;
+        return matrix;
+    }
+
+    if (outputChannels == 1) {
+        // Fold to stereo first and average the two sides, the centre stays as is.
+        const QVector<float> stereo = mixMatrix(inputChannels, 2);
+        const QVector<Speaker> input = channelLayout(inputChannels);
+        for (int channel = 0; channel < inputChannels; ++channel) {
+            gain(0, channel) = input.at(channel) == FrontCenter
+                    ? 1.0f
+                    : 0.5f * (stereo.at(channel) + stereo.at(inputChannels + channel));
+        }
+        return matrix;
+    }
+
+    const float minus3dB = float(M_SQRT1_2);
+    const QVector<Speaker> input = channelLayout(inputChannels);
+    const QVector<Speaker> output = channelLayout(outputChannels);
+
+    // Sends an input channel to the first of the speakers present in the output.
+    const auto route = [&](int channel, std::initializer_list<Speaker> speakers, float level) {
+        for (Speaker speaker : speakers) {
+            const int index = output.indexOf(speaker);
+            if (index >= 0) {
+                gain(index, channel) = level;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const bool hasFront = output.contains(FrontLeft) && output.contains(FrontRight);
+    for (int channel = 0; channel < inputChannels; ++channel) {
+        const Speaker speaker = input.at(channel);
+
+        if (inputChannels == 1 && hasFront) {
+            // Mono is played on both front speakers.
+            route(channel, { FrontLeft }, 1.0f);
+            route(channel, { FrontRight }, 1.0f);
+            continue;
+        }
+
+        if (speaker == UnknownSpeaker) {
+            // Nothing is known about the layout, keep the channel order.
+            if (channel < outputChannels)
+                gain(channel, channel) = 1.0f;
+            continue;
+        }
+
+        if (route(channel, { speaker }, 1.0f))
+            continue;
+
+        switch (speaker) {
+        case FrontCenter:
+            route(channel, { FrontLeft }, minus3dB);
+            route(channel, { FrontRight }, minus3dB);
+            break;
+        case BackLeft:
+            if (!route(channel, { SideLeft }, 1.0f))
+                route(channel, { FrontLeft }, minus3dB);
+            break;
+        case BackRight:
+            if (!route(channel, { SideRight }, 1.0f))
+                route(channel, { FrontRight }, minus3dB);
+            break;
+        case SideLeft:
+            if (!route(channel, { BackLeft }, 1.0f))
+                route(channel, { FrontLeft }, minus3dB);
+            break;
+        case SideRight:
+            if (!route(channel, { BackRight }, 1.0f))
+                route(channel, { FrontRight }, minus3dB);
+            break;
+        case BackCenter:
+            if (output.contains(BackLeft) || output.contains(SideLeft)) {
+                route(channel, { BackLeft, SideLeft }, minus3dB);
+                route(channel, { BackRight, SideRight }, minus3dB);
+            } else {
+                route(channel, { FrontLeft }, 0.5f);
+                route(channel, { FrontRight }, 0.5f);
+            }
+            break;
+        default:
+            // The LFE carries nothing the full range speakers would miss.
+            break;
+        }
+    }
+
+    return matrix;
+}
+
+} // namespace
+
+/*
+    QAudioConverter converts linear PCM between sample formats, channel
+    layouts and sample rates.
+
+    Samples are decoded to interleaved floats, mixed into one planar buffer
+    per output channel, resampled if the rates differ and finally encoded
+    into the output format. Partial frames and the resampler history are
+    carried over between calls to convert(), so a stream can be fed in
+    arbitrarily sized chunks; flush() drains what is left at the end.
+
+    Mixing assumes the default WAVE speaker layout for each channel count,
+    so 5.1 is FL FR FC LFE BL BR.
+
+    FastQuality resamples with linear interpolation. MediumQuality and
+    BestQuality use a Kaiser windowed sinc, read from a precomputed table,
+    with 8 and 32 zero crossings respectively. The inner loops use SSE2
+    where the CPU supports it.
+
+    outputBytesForInput() rounds up and is meant for sizing buffers, while
+    inputBytesForOutput() rounds down so that converting the returned amount
+    never produces more than was asked for.
+*/
+
+QAudioConverter::QAudioConverter()
+{
+}
+
+QAudioConverter::QAudioConverter(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat,
+                                 Quality quality)
+    : m_quality(quality)
+{
+    setFormats(inputFormat, outputFormat);
+}
+
+QAudioConverter::~QAudioConverter()
+{
+}
+
+bool QAudioConverter::isFormatSupported(const QAudioFormat &format)
+{
+    if (!format.isValid() || format.codec() != QLatin1String("audio/pcm"))
+        return false;
+
+    switch (format.sampleType()) {
+    case QAudioFormat::SignedInt:
+    case QAudioFormat::UnSignedInt:
+        return format.sampleSize() == 8 || format.sampleSize() == 16
+                || format.sampleSize() == 24 || format.sampleSize() == 32;
+    case QAudioFormat::Float:
+        return format.sampleSize() == 32;
+    default:
+        return false;
+    }
+}
+
+void QAudioConverter::setFormats(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat)
+{
+    m_inputFormat = inputFormat;
+    m_outputFormat = outputFormat;
+    m_valid = isFormatSupported(inputFormat) && isFormatSupported(outputFormat);
+    m_passthrough = !m_valid || inputFormat == outputFormat;
+    m_resampling = m_valid && inputFormat.sampleRate() != outputFormat.sampleRate();
+    m_mixMatrix = m_valid
+            ? mixMatrix(inputFormat.channelCount(), outputFormat.channelCount())
+            : QVector<float>();
+
+    setupResampler();
+    reset();
+}
+
+void QAudioConverter::setQuality(Quality quality)
+{
+    if (m_quality == quality)
+        return;
+
+    m_quality = quality;
+    setupResampler();
+    reset();
+}
+
+void QAudioConverter::reset()
+{
+    m_remainder.clear();
+    m_fraction = 0;
+
+    m_planes.clear();
+    if (!m_valid || m_passthrough)
+        return;
+
+    m_planes.resize(m_outputFormat.channelCount());
+    if (m_resampling) {
+        // Start with enough silence in front of the first frame that it can
+        // be the centre of the first output frame.
+        for (QVector<float> &plane : m_planes)
+            plane.fill(0.0f, m_halfWidth - 1);
+        m_position = m_halfWidth - 1;
+    } else {
+        m_position = 0;
+    }
+}
+
+void QAudioConverter::setupResampler()
+{
+    m_kernel.clear();
+    m_weights.clear();
+    m_halfWidth = 0;
+    m_cutoff = 1.0f;
+
+    if (!m_resampling)
+        return;
+
+    const double ratio = double(m_outputFormat.sampleRate()) / m_inputFormat.sampleRate();
+
+    int zeroCrossings = 1;
+    if (m_quality == FastQuality) {
+        m_kernel.resize(KernelPhases + 2);
+        for (int i = 0; i <= KernelPhases; ++i)
+            m_kernel[i] = 1.0f - float(i) / KernelPhases;
+        m_kernel[KernelPhases + 1] = 0.0f;
+    } else {
+        zeroCrossings = m_quality == BestQuality ? 32 : 8;
+        const double beta = m_quality == BestQuality ? 10.0 : 6.0;
+        const double rolloff = m_quality == BestQuality ? 0.95 : 0.9;
+
+        // Lower the cutoff below the output Nyquist frequency when
+        // downsampling, which stretches the kernel over more input frames.
+        m_cutoff = float(rolloff * qMin(1.0, ratio));
+
+        const int size = zeroCrossings * KernelPhases;
+        const double norm = besselI0(beta);
+        m_kernel.resize(size + 2);
+        m_kernel[0] = m_cutoff;
+        for (int i = 1; i <= size; ++i) {
+            const double x = double(i) / KernelPhases;
+            const double r = x / zeroCrossings;
+            const double window = besselI0(beta * qSqrt(qMax(0.0, 1.0 - r * r))) / norm;
+            m_kernel[i] = float(m_cutoff * qSin(M_PI * x) / (M_PI * x) * window);
+        }
+        m_kernel[size] = 0.0f;
+        m_kernel[size + 1] = 0.0f;
+    }
+
+    m_halfWidth = qMax(1, qCeil(zeroCrossings / m_cutoff));
+    m_weights.resize(2 * m_halfWidth);
+}
+
+void QAudioConverter::decode(const uchar *src, float *dst, int samples) const
+{
+    const QAudioFormat &format = m_inputFormat;
+    const QAudioFormat::Endian byteOrder = format.byteOrder();
+
+    if (isNativeS16(format)) {
+        audioKernels().s16ToFloat(reinterpret_cast<const qint16 *>(src), dst, samples);
+        return;
+    }
+
+    const bool isSigned = format.sampleType() == QAudioFormat::SignedInt;
+    switch (format.sampleSize()) {
+    case 8:
+        for (int i = 0; i < samples; ++i) {
+            const int value = isSigned ? int(qint8(src[i])) : int(src[i]) - 128;
+            dst[i] = value * (1.0f / 128.0f);
+        }
+        break;
+    case 16:
+        for (int i = 0; i < samples; ++i, src += 2) {
+            const int value = isSigned ? int(readSample<qint16>(src, byteOrder))
+                                       : int(readSample<quint16>(src, byteOrder)) - 32768;
+            dst[i] = value * (1.0f / 32768.0f);
+        }
+        break;
+    case 24:
+        for (int i = 0; i < samples; ++i, src += 3) {
+            qint32 value = readInt24(src, byteOrder);
+            if (!isSigned)
+                value = qint32((quint32(value) ^ 0x800000) << 8) >> 8;
+            dst[i] = value * (1.0f / 8388608.0f);
+        }
+        break;
+    case 32:
+        if (format.sampleType() == QAudioFormat::Float) {
+            for (int i = 0; i < samples; ++i, src += 4) {
+                const quint32 bits = readSample<quint32>(src, byteOrder);
+                memcpy(dst + i, &bits, sizeof(float));
+            }
+        } else {
+            for (int i = 0; i < samples; ++i, src += 4) {
+                const double value = isSigned ? double(readSample<qint32>(src, byteOrder))
+                                              : double(readSample<quint32>(src, byteOrder)) - 2147483648.0;
+                dst[i] = float(value * (1.0 / 2147483648.0));
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void QAudioConverter::encode(const float *src, uchar *dst, int samples) const
+{
+    const QAudioFormat &format = m_outputFormat;
+    const QAudioFormat::Endian byteOrder = format.byteOrder();
+
+    if (isNativeS16(format)) {
+        audioKernels().floatToS16(src, reinterpret_cast<qint16 *>(dst), samples);
+        return;
+    }
+
+    const bool isSigned = format.sampleType() == QAudioFormat::SignedInt;
+    switch (format.sampleSize()) {
+    case 8:
+        for (int i = 0; i < samples; ++i) {
+            const qint32 value = toInt(src[i], 128.0f);
+            dst[i] = isSigned ? uchar(qint8(value)) : uchar(value + 128);
+        }
+        break;
+    case 16:
+        for (int i = 0; i < samples; ++i, dst += 2) {
+            const qint32 value = toInt(src[i], 32768.0f);
+            if (isSigned)
+                writeSample<qint16>(qint16(value), dst, byteOrder);
+            else
+                writeSample<quint16>(quint16(value + 32768), dst, byteOrder);
+        }
+        break;
+    case 24:
+        for (int i = 0; i < samples; ++i, dst += 3) {
+            const qint32 value = toInt(src[i], 8388608.0f);
+            writeInt24(isSigned ? value : value + 8388608, dst, byteOrder);
+        }
+        break;
+    case 32:
+        if (format.sampleType() == QAudioFormat::Float) {
+            for (int i = 0; i < samples; ++i, dst += 4) {
+                quint32 bits;
+                memcpy(&bits, src + i, sizeof(float));
+                writeSample<quint32>(bits, dst, byteOrder);
+            }
+        } else {
+            for (int i = 0; i < samples; ++i, dst += 4) {
+                const double value = qBound(-2147483648.0, src[i] * 2147483648.0, 2147483647.0);
+                const qint64 rounded = qRound64(value);
+                if (isSigned)
+                    writeSample<qint32>(qint32(rounded), dst, byteOrder);
+                else
+                    writeSample<quint32>(quint32(rounded + Q_INT64_C(2147483648)), dst, byteOrder);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void QAudioConverter::mix(const float *src, int frames)
+{
+    const int inputChannels = m_inputFormat.channelCount();
+    const int outputChannels = m_planes.size();
+
+    for (int channel = 0; channel < outputChannels; ++channel) {
+        QVector<float> &plane = m_planes[channel];
+        const int offset = plane.size();
+        plane.resize(offset + frames);
+        float *dst = plane.data() + offset;
+        const float *gains = m_mixMatrix.constData() + channel * inputChannels;
+
+        bool silent = true;
+        for (int in = 0; in < inputChannels; ++in) {
+            const float gain = gains[in];
+            if (gain == 0.0f)
+                continue;
+
+            if (silent && gain == 1.0f) {
+                for (int i = 0; i < frames; ++i)
+                    dst[i] = src[i * inputChannels + in];
+            } else if (silent) {
+                for (int i = 0; i < frames; ++i)
+                    dst[i] = gain * src[i * inputChannels + in];
+            } else {
+                for (int i = 0; i < frames; ++i)
+                    dst[i] += gain * src[i * inputChannels + in];
+            }
+            silent = false;
+        }
+
+        if (silent)
+            memset(dst, 0, frames * sizeof(float));
+    }
+}
+
+int QAudioConverter::resample(QVector<float> *output)
+{
+    const int channels = m_planes.size();
+    const qint64 frames = m_planes.isEmpty() ? 0 : m_planes.first().size();
+    const qint64 inputRate = m_inputFormat.sampleRate();
+    const qint64 outputRate = m_outputFormat.sampleRate();
+    const int taps = 2 * m_halfWidth;
+    const float scale = m_cutoff * KernelPhases;
+    const int lastIndex = m_kernel.size() - 1;
+    const AudioDotProductFunc dotProduct = audioKernels().dotProduct;
+
+    const qint64 available = frames > m_position + m_halfWidth
+            ? ((frames - m_position - m_halfWidth) * outputRate - m_fraction + inputRate - 1) / inputRate
+            : 0;
+    const int produced = int(available);
+    int offset = output->size();
+    output->resize(offset + produced * channels);
+    float *out = output->data() + offset;
+    float *weights = m_weights.data();
+    const float *kernel = m_kernel.constData();
+
+    for (int n = 0; n < produced; ++n) {
+        const float fraction = float(double(m_fraction) / outputRate);
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) {
+            const float x = qAbs(float(m_halfWidth - 1 - k) + fraction) * scale;
+            const int index = int(x);
+            float weight = 0.0f;
+            if (index < lastIndex)
+                weight = kernel[index] + (x - index) * (kernel[index + 1] - kernel[index]);
+            weights[k] = weight;
+            sum += weight;
+        }
+        if (sum != 0.0f) {
+            const float normalize = 1.0f / sum;
+            for (int k = 0; k < taps; ++k)
+                weights[k] *= normalize;
+        }
+
+        const qint64 first = m_position - m_halfWidth + 1;
+        for (int channel = 0; channel < channels; ++channel)
+            *out++ = dotProduct(m_planes.at(channel).constData() + first, weights, taps);
+
+        m_fraction += inputRate;
+        m_position += m_fraction / outputRate;
+        m_fraction %= outputRate;
+    }
+
+    // Drop the input frames no later output frame can reach.
+    const int consumed = int(qBound<qint64>(0, m_position - m_halfWidth + 1, frames));
+    if (consumed > 0) {
+        for (QVector<float> &plane : m_planes)
+            plane.remove(0, consumed);
+        m_position -= consumed;
+    }
+
+    return produced;
+}
+
+QByteArray QAudioConverter::drain()
+{
+    const int channels = m_planes.size();
+    const float *samples = nullptr;
+    int count = 0;
+
+    m_resampled.clear();
+    if (m_resampling) {
+        resample(&m_resampled);
+        samples = m_resampled.constData();
+        count = m_resampled.size();
+    } else if (channels > 0) {
+        const int frames = m_planes.first().size();
+        m_resampled.resize(frames * channels);
+        float *dst = m_resampled.data();
+        for (int channel = 0; channel < channels; ++channel) {
+            const float *src = m_planes.at(channel).constData();
+            for (int i = 0; i < frames; ++i)
+                dst[i * channels + channel] = src[i];
+        }
+        for (QVector<float> &plane : m_planes)
+            plane.clear();
+        samples = m_resampled.constData();
+        count = m_resampled.size();
+    }
+
+    QByteArray result(count * (m_outputFormat.sampleSize() / 8), Qt::Uninitialized);
+    encode(samples, reinterpret_cast<uchar *>(result.data()), count);
+    return result;
+}
+
+QByteArray QAudioConverter::convert(const char *data, int length)
+{
+    if (m_passthrough)
+        return QByteArray(data, length);
+
+    const int inputFrameBytes = m_inputFormat.bytesPerFrame();
+    const uchar *src = reinterpret_cast<const uchar *>(data);
+    int bytes = length;
+
+    if (!m_remainder.isEmpty()) {
+        m_remainder.append(data, length);
+        src = reinterpret_cast<const uchar *>(m_remainder.constData());
+        bytes = m_remainder.size();
+    }
+
+    const int frames = bytes / inputFrameBytes;
+    const int samples = frames * m_inputFormat.channelCount();
+    m_decoded.resize(samples);
+    decode(src, m_decoded.data(), samples);
+
+    const int leftover = bytes - frames * inputFrameBytes;
+    if (m_remainder.isEmpty())
+        m_remainder = QByteArray(data + length - leftover, leftover);
+    else
+        m_remainder.remove(0, frames * inputFrameBytes);
+
+    if (!m_resampling && m_inputFormat.channelCount() == m_outputFormat.channelCount()) {
+        // Only the sample format differs, skip the planar stage.
+        QByteArray result(samples * (m_outputFormat.sampleSize() / 8), Qt::Uninitialized);
+        encode(m_decoded.constData(), reinterpret_cast<uchar *>(result.data()), samples);
+        return result;
+    }
+
+    mix(m_decoded.constData(), frames);
+    return drain();
+}
+
+QByteArray QAudioConverter::flush()
+{
+    if (m_passthrough) {
+        m_remainder.clear();
+        return QByteArray();
+    }
+
+    QByteArray result;
+    if (m_resampling) {
+        // Pad with silence so the last input frames reach the kernel centre.
+        for (QVector<float> &plane : m_planes)
+            plane.resize(plane.size() + m_halfWidth);
+        result = drain();
+    }
+    reset();
+    return result;
+}
+
+int QAudioConverter::outputBytesForInput(int inputBytes) const
+{
+    if (m_passthrough)
+        return inputBytes;
+
+    const qint64 frames = inputBytes / m_inputFormat.bytesPerFrame();
+    const qint64 outputFrames = (frames * m_outputFormat.sampleRate() + m_inputFormat.sampleRate() - 1)
+            / m_inputFormat.sampleRate();
+    return int(outputFrames * m_outputFormat.bytesPerFrame());
+}
+
+int QAudioConverter::inputBytesForOutput(int outputBytes) const
+{
+    if (m_passthrough)
+        return outputBytes;
+
+    const qint64 frames = outputBytes / m_outputFormat.bytesPerFrame();
+    const qint64 inputFrames = frames * m_inputFormat.sampleRate() / m_outputFormat.sampleRate();
+    return int(inputFrames * m_inputFormat.bytesPerFrame());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QAUDIOCONVERTER_P_H
+#define QAUDIOCONVERTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qtmultimediaglobal.h>
+#include <QtMultimedia/qaudioformat.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qvector.h>
+
+#include <private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+typedef void (QT_FASTCALL *AudioS16ToFloatFunc)(const qint16 *src, float *dst, int count);
+typedef void (QT_FASTCALL *AudioFloatToS16Func)(const float *src, qint16 *dst, int count);
+typedef float (QT_FASTCALL *AudioDotProductFunc)(const float *a, const float *b, int count);
+
+class Q_MULTIMEDIA_EXPORT QAudioConverter
+{
+public:
+    enum Quality
+    {
+        FastQuality,
+        MediumQuality,
+        BestQuality
+    };
+
+    QAudioConverter();
+    QAudioConverter(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat,
+                    Quality quality = MediumQuality);
+    ~QAudioConverter();
+
+    static bool isFormatSupported(const QAudioFormat &format);
+
+    void setFormats(const QAudioFormat &inputFormat, const QAudioFormat &outputFormat);
+    QAudioFormat inputFormat() const { return m_inputFormat; }
+    QAudioFormat outputFormat() const { return m_outputFormat; }
+
+    Quality quality() const { return m_quality; }
+    void setQuality(Quality quality);
+
+    bool isValid() const { return m_valid; }
+    bool isPassthrough() const { return m_passthrough; }
+
+    QByteArray convert(const char *data, int length);
+    QByteArray convert(const QByteArray &data) { return convert(data.constData(), data.size()); }
+    QByteArray flush();
+    void reset();
+
+    int outputBytesForInput(int inputBytes) const;
+    int inputBytesForOutput(int outputBytes) const;
+
+private:
+    void setupResampler();
+    void decode(const uchar *src, float *dst, int samples) const;
+    void encode(const float *src, uchar *dst, int samples) const;
+    void mix(const float *src, int frames);
+    int resample(QVector<float> *output);
+    QByteArray drain();
+
+    QAudioFormat m_inputFormat;
+    QAudioFormat m_outputFormat;
+    Quality m_quality = MediumQuality;
+    bool m_valid = false;
+    bool m_passthrough = true;
+
+    QByteArray m_remainder;
+    QVector<float> m_decoded;
+    QVector<float> m_resampled;
+    QVector<QVector<float> > m_planes;
+    QVector<float> m_mixMatrix;
+
+    // Resampler state; positions are in input frames relative to the first
+    // frame still held in m_planes, the fraction is in units of 1/outputRate.
+    bool m_resampling = false;
+    int m_halfWidth = 0;
+    qint64 m_position = 0;
+    qint64 m_fraction = 0;
+    float m_cutoff = 1.0f;
+    QVector<float> m_kernel;
+    QVector<float> m_weights;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOCONVERTER_P_H
@@ -42,6 +42,8 @@
 #include "qmediaobject_p.h"
 #include <qmediaservice.h>
 #include "qaudiodecodercontrol.h"
+#include "qaudiodecoderconsumer_p.h"
+#include "qaudiodecoderconsumercontrol_p.h"
 #include <private/qmediaserviceprovider_p.h>
 
 #include <QtCore/qcoreevent.h>
@@ -67,6 +69,14 @@ QT_BEGIN_NAMESPACE
     directly to audio hardware, and playlists and network and streaming
     based media is not supported.
 
+    For batch processing, such as computing waveforms or audio fingerprints,
+    a callback can be set with setBufferCallback(). Decoded buffers are then
+    delivered without a round trip through the event loop of the decoder's
+    thread, and decoding runs as fast as the callback consumes the buffers.
+    The buffers can be delivered as they are decoded, in blocks of a fixed
+    number of frames, or as one contiguous buffer holding the whole file, see
+    setBufferMode().
+
     \sa QAudioBuffer
 */
 
@@ -74,6 +84,7 @@ static void qRegisterAudioDecoderMetaTypes()
 {
     qRegisterMetaType<QAudioDecoder::State>("QAudioDecoder::State");
     qRegisterMetaType<QAudioDecoder::Error>("QAudioDecoder::Error");
+    qRegisterMetaType<QAudioDecoder::BufferMode>("QAudioDecoder::BufferMode");
 }
 
 Q_CONSTRUCTOR_FUNCTION(qRegisterAudioDecoderMetaTypes)
@@ -86,20 +97,53 @@ public:
     QAudioDecoderPrivate()
         : provider(nullptr)
         , control(nullptr)
+        , consumerControl(nullptr)
         , state(QAudioDecoder::StoppedState)
         , error(QAudioDecoder::NoError)
+        , bufferContext(nullptr)
+        , bufferMode(QAudioDecoder::NativeBufferMode)
+        , bufferBlockSize(0)
+        , bufferQueueDepth(4)
+        , consumerGeneration(0)
+        , controlFinished(false)
+        , consumerFinished(false)
     {}
 
     QMediaServiceProvider *provider;
     QAudioDecoderControl *control;
+    QAudioDecoderConsumerControl *consumerControl;
     QAudioDecoder::State state;
     QAudioDecoder::Error error;
     QString errorString;
 
+    QObject *bufferContext;
+    QAudioDecoderConsumer::Callback bufferCallback;
+    QAudioDecoder::BufferMode bufferMode;
+    int bufferBlockSize;
+    int bufferQueueDepth;
+    QSharedPointer<QAudioDecoderConsumer> consumer;
+    int consumerGeneration;
+    bool controlFinished;
+    bool consumerFinished;
+
+    void cancelConsumer();
+    void emitFinished();
+
     void _q_stateChanged(QAudioDecoder::State state);
     void _q_error(int error, const QString &errorString);
+    void _q_bufferReady();
+    void _q_finished();
+    void _q_consumerFinished(int generation);
 };
 
+void QAudioDecoderPrivate::cancelConsumer()
+{
+    if (consumer) {
+        consumer->cancel();
+        consumer.reset();
+    }
+}
+
 void QAudioDecoderPrivate::_q_stateChanged(QAudioDecoder::State ps)
 {
     Q_Q(QAudioDecoder);
@@ -121,6 +165,59 @@ void QAudioDecoderPrivate::_q_error(int error, const QString &errorString)
     emit q->error(this->error);
 }
 
+void QAudioDecoderPrivate::_q_bufferReady()
+{
+    // Services without QAudioDecoderConsumerControl deliver to the
+    // buffer callback from the thread of the decoder
+    if (!consumer || consumerControl)
+        return;
+
+    while (control->bufferAvailable())
+        consumer->push(control->read());
+}
+
+void QAudioDecoderPrivate::_q_finished()
+{
+    Q_Q(QAudioDecoder);
+
+    if (!consumer) {
+        emit q->finished();
+        return;
+    }
+
+    if (!consumerControl) {
+        _q_bufferReady();
+        consumer->finish();
+    }
+
+    controlFinished = true;
+    emitFinished();
+}
+
+void QAudioDecoderPrivate::_q_consumerFinished(int generation)
+{
+    // Ignore consumers of an earlier run
+    if (!consumer || generation != consumerGeneration)
+        return;
+
+    consumerFinished = true;
+    emitFinished();
+}
+
+// finished() follows both the end of decoding and the last buffer handed
+// to the callback, which may be delivered on another thread
+void QAudioDecoderPrivate::emitFinished()
+{
+    Q_Q(QAudioDecoder);
+
+    if (!controlFinished || !consumerFinished)
+        return;
+
+    controlFinished = false;
+    consumerFinished = false;
+    emit q->finished();
+}
+
 /*!
     Construct an QAudioDecoder instance
     parented to \a parent.
@@ -141,11 +238,18 @@ QAudioDecoder::QAudioDecoder(QObject *parent)
 
             connect(d->control, SIGNAL(formatChanged(QAudioFormat)), SIGNAL(formatChanged(QAudioFormat)));
             connect(d->control, SIGNAL(sourceChanged()), SIGNAL(sourceChanged()));
+            connect(d->control, SIGNAL(bufferReady()), SLOT(_q_bufferReady()));
             connect(d->control, SIGNAL(bufferReady()), this, SIGNAL(bufferReady()));
             connect(d->control ,SIGNAL(bufferAvailableChanged(bool)), this, SIGNAL(bufferAvailableChanged(bool)));
-            connect(d->control ,SIGNAL(finished()), this, SIGNAL(finished()));
+            // Forwarded once the buffer callback, if any, has received everything
+            connect(d->control, SIGNAL(finished()), SLOT(_q_finished()));
             connect(d->control ,SIGNAL(positionChanged(qint64)), this, SIGNAL(positionChanged(qint64)));
             connect(d->control ,SIGNAL(durationChanged(qint64)), this, SIGNAL(durationChanged(qint64)));
+
+            d->consumerControl = qobject_cast<QAudioDecoderConsumerControl*>(
+                        d->service->requestControl(QAudioDecoderConsumerControl_iid));
+            if (d->consumerControl)
+                d->bufferQueueDepth = d->consumerControl->bufferQueueDepth();
         }
     }
     if (!d->control) {
@@ -162,7 +266,11 @@ QAudioDecoder::~QAudioDecoder()
 {
     Q_D(QAudioDecoder);
 
+    d->cancelConsumer();
+
     if (d->service) {
+        if (d->consumerControl)
+            d->service->releaseControl(d->consumerControl);
         if (d->control)
             d->service->releaseControl(d->control);
 
@@ -216,6 +324,20 @@ void QAudioDecoder::start()
     d->error = NoError;
     d->errorString.clear();
 
+    d->cancelConsumer();
+    d->controlFinished = false;
+    d->consumerFinished = false;
+    if (d->bufferCallback) {
+        // Without a consumer control the buffers are pushed from this thread,
+        // blocking on a queue depth could then dead-lock.
+        d->consumer = QAudioDecoderConsumer::create(d->bufferContext, d->bufferCallback,
+                                                    d->bufferMode, d->bufferBlockSize,
+                                                    d->consumerControl ? d->bufferQueueDepth : 0,
+                                                    this, ++d->consumerGeneration);
+    }
+    if (d->consumerControl)
+        d->consumerControl->setConsumer(d->consumer);
+
     d->control->start();
 }
 
@@ -226,6 +348,9 @@ void QAudioDecoder::stop()
 {
     Q_D(QAudioDecoder);
 
+    // Unblocks the decoding thread before it is stopped
+    d->cancelConsumer();
+
     if (d->control != nullptr)
         d->control->stop();
 }
@@ -420,6 +545,165 @@ QAudioBuffer QAudioDecoder::read() const
     }
 }
 
+/*!
+    \since 5.15
+
+    Returns the maximum number of decoded buffers waiting to be consumed.
+
+    \sa setBufferQueueDepth()
+*/
+int QAudioDecoder::bufferQueueDepth() const
+{
+    return d_func()->bufferQueueDepth;
+}
+
+/*!
+    \since 5.15
+
+    Sets the maximum number of decoded buffers waiting to be consumed to \a depth.
+
+    Decoding is suspended while this many buffers are waiting to be returned by
+    read(), or to be passed to the buffer callback. A deeper queue lets the
+    decoder run further ahead of a consumer whose processing time varies, at
+    the cost of memory. The default depth is 4.
+
+    This property can only be set while the decoder is stopped, and is
+    only supported by some backends.
+
+    \sa setBufferCallback()
+*/
+void QAudioDecoder::setBufferQueueDepth(int depth)
+{
+    Q_D(QAudioDecoder);
+
+    if (depth < 1 || state() != QAudioDecoder::StoppedState)
+        return;
+
+    d->bufferQueueDepth = depth;
+    if (d->consumerControl)
+        d->consumerControl->setBufferQueueDepth(depth);
+}
+
+/*!
+    \since 5.15
+
+    Returns how decoded audio is split into the buffers passed to the buffer callback.
+
+    \sa setBufferMode()
+*/
+QAudioDecoder::BufferMode QAudioDecoder::bufferMode() const
+{
+    return d_func()->bufferMode;
+}
+
+/*!
+    \since 5.15
+
+    Sets how decoded audio is split into the buffers passed to the buffer
+    callback to \a mode. The mode is taken into use when decoding is started
+    the next time.
+
+    \sa setBufferBlockSize(), setBufferCallback()
+*/
+void QAudioDecoder::setBufferMode(QAudioDecoder::BufferMode mode)
+{
+    d_func()->bufferMode = mode;
+}
+
+/*!
+    \since 5.15
+
+    Returns the number of frames in each buffer passed to the buffer callback
+    in FixedBlockBufferMode.
+*/
+int QAudioDecoder::bufferBlockSize() const
+{
+    return d_func()->bufferBlockSize;
+}
+
+/*!
+    \since 5.15
+
+    Sets the number of frames in each buffer passed to the buffer callback in
+    FixedBlockBufferMode to \a frameCount. The last block of the stream may be
+    shorter.
+
+    \sa setBufferMode()
+*/
+void QAudioDecoder::setBufferBlockSize(int frameCount)
+{
+    d_func()->bufferBlockSize = qMax(0, frameCount);
+}
+
+/*!
+    \fn template<typename PointerToMemberFunction> void QAudioDecoder::setBufferCallback(const QObject *receiver, PointerToMemberFunction method)
+    \since 5.15
+
+    Sets the \a method of the \a receiver object to receive the decoded audio
+    in place of read().
+
+    The method takes a \c{const QAudioBuffer &} and is called on the thread of
+    \a receiver. If \a receiver is destroyed while decoding, the remaining
+    buffers are dropped and finished() is not emitted. The buffers are split
+    according to bufferMode(), and at most bufferQueueDepth() of them are
+    waiting for the method at any time.
+
+    While a callback is set, read() does not return any buffers and
+    position() may not be updated, the position of each buffer is available
+    from QAudioBuffer::startTime(). finished() is emitted once decoding has
+    ended and the last buffer has been handed to the callback.
+
+    The callback is taken into use when decoding is started the next time.
+
+    \sa clearBufferCallback(), setBufferMode(), setBufferQueueDepth()
+*/
+
+/*!
+    \fn template<typename Functor> void QAudioDecoder::setBufferCallback(const QObject *context, Functor functor)
+    \since 5.15
+    \overload
+
+    Sets the \a functor to receive the decoded audio in place of read().
+
+    The functor is called on the thread of the \a context object. If the
+    \a context object is destroyed while decoding, the remaining buffers are
+    dropped. If \a context is \nullptr, the functor is
+    called directly on the thread performing the decoding, which is the
+    fastest option but requires the functor to be thread safe.
+*/
+
+void QAudioDecoder::setBufferCallbackImpl(const QObject *context, QtPrivate::QSlotObjectBase *slotObj)
+{
+    Q_D(QAudioDecoder);
+
+    QObject *receiver = const_cast<QObject *>(context);
+    const QSharedPointer<QtPrivate::QSlotObjectBase> slot(slotObj, [](QtPrivate::QSlotObjectBase *s) {
+        s->destroyIfLastRef();
+    });
+
+    d->bufferContext = receiver;
+    d->bufferCallback = [receiver, slot](const QAudioBuffer &buffer) {
+        void *args[] = { nullptr, const_cast<QAudioBuffer *>(&buffer) };
+        slot->call(receiver, args);
+    };
+}
+
+/*!
+    \since 5.15
+
+    Removes the buffer callback, the decoded audio is returned by read() again.
+    This is taken into use when decoding is started the next time.
+
+    \sa setBufferCallback()
+*/
+void QAudioDecoder::clearBufferCallback()
+{
+    Q_D(QAudioDecoder);
+
+    d->bufferContext = nullptr;
+    d->bufferCallback = nullptr;
+}
+
 // Enums
 /*!
     \enum QAudioDecoder::State
@@ -443,6 +727,18 @@ QAudioBuffer QAudioDecoder::read() const
     \value ServiceMissingError A valid playback service was not found, playback cannot proceed.
 */
 
+/*!
+    \enum QAudioDecoder::BufferMode
+    \since 5.15
+
+    Defines how decoded audio is split into the buffers passed to the buffer callback.
+
+    \value NativeBufferMode Buffers are passed on as produced by the decoder.
+    \value FixedBlockBufferMode Buffers hold bufferBlockSize() frames each.
+    \value WholeFileBufferMode The whole stream is passed as one contiguous
+           buffer once decoding has finished.
+*/
+
 // Signals
 /*!
     \fn QAudioDecoder::error(QAudioDecoder::Error error)
@@ -58,6 +58,7 @@ class Q_MULTIMEDIA_EXPORT QAudioDecoder : public QMediaObject
 
     Q_ENUMS(State)
     Q_ENUMS(Error)
+    Q_ENUMS(BufferMode)
 
 public:
     enum State
@@ -75,6 +76,13 @@ public:
         ServiceMissingError
     };
 
+    enum BufferMode
+    {
+        NativeBufferMode,
+        FixedBlockBufferMode,
+        WholeFileBufferMode
+    };
+
     explicit QAudioDecoder(QObject *parent = nullptr);
     ~QAudioDecoder();
 
@@ -100,6 +108,49 @@ public:
     qint64 position() const;
     qint64 duration() const;
 
+    int bufferQueueDepth() const;
+    void setBufferQueueDepth(int depth);
+
+    BufferMode bufferMode() const;
+    void setBufferMode(BufferMode mode);
+
+    int bufferBlockSize() const;
+    void setBufferBlockSize(int frameCount);
+
+#ifdef Q_CLANG_QDOC
+    template<typename PointerToMemberFunction>
+    void setBufferCallback(const QObject *receiver, PointerToMemberFunction method);
+    template<typename Functor>
+    void setBufferCallback(const QObject *context, Functor functor);
+#else
+    // receiver and pointer to member function
+    template <typename Func1>
+    inline void setBufferCallback(const typename QtPrivate::FunctionPointer<Func1>::Object *receiver,
+                                  Func1 slot)
+    {
+        typedef QtPrivate::FunctionPointer<Func1> SlotType;
+        Q_STATIC_ASSERT_X(int(SlotType::ArgumentCount) <= 1,
+                          "The slot must take at most one argument.");
+        Q_STATIC_ASSERT_X((QtPrivate::CheckCompatibleArguments<QtPrivate::List<QAudioBuffer>,
+                                                               typename SlotType::Arguments>::value),
+                          "The slot must take a QAudioBuffer.");
+
+        setBufferCallbackImpl(receiver,
+                              new QtPrivate::QSlotObject<Func1, typename SlotType::Arguments, void>(slot));
+    }
+
+    // context object and functor, a null context calls the functor on the decoding thread
+    template <typename Func1>
+    inline typename std::enable_if<!QtPrivate::FunctionPointer<Func1>::IsPointerToMemberFunction
+                                   && !std::is_same<const char *, Func1>::value, void>::type
+    setBufferCallback(const QObject *context, Func1 slot)
+    {
+        setBufferCallbackImpl(context,
+                              new QtPrivate::QFunctorSlotObject<Func1, 1, QtPrivate::List<const QAudioBuffer &>, void>(std::move(slot)));
+    }
+#endif
+    void clearBufferCallback();
+
 public Q_SLOTS:
     void start();
     void stop();
@@ -124,18 +175,25 @@ public:
     void unbind(QObject *) override;
 
 private:
+    void setBufferCallbackImpl(const QObject *context, QtPrivate::QSlotObjectBase *slotObj);
+
     Q_DISABLE_COPY(QAudioDecoder)
     Q_DECLARE_PRIVATE(QAudioDecoder)
     Q_PRIVATE_SLOT(d_func(), void _q_stateChanged(QAudioDecoder::State))
     Q_PRIVATE_SLOT(d_func(), void _q_error(int, const QString &))
+    Q_PRIVATE_SLOT(d_func(), void _q_bufferReady())
+    Q_PRIVATE_SLOT(d_func(), void _q_finished())
+    Q_PRIVATE_SLOT(d_func(), void _q_consumerFinished(int))
 };
 
 QT_END_NAMESPACE
 
 Q_DECLARE_METATYPE(QAudioDecoder::State)
 Q_DECLARE_METATYPE(QAudioDecoder::Error)
+Q_DECLARE_METATYPE(QAudioDecoder::BufferMode)
 
 Q_MEDIA_ENUM_DEBUG(QAudioDecoder, State)
 Q_MEDIA_ENUM_DEBUG(QAudioDecoder, Error)
+Q_MEDIA_ENUM_DEBUG(QAudioDecoder, BufferMode)
 
 #endif  // QAUDIODECODER_H
@@ -0,0 +1,217 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaudiodecoderconsumer_p.h"
+
+#include <QtCore/qmetaobject.h>
+
+QT_BEGIN_NAMESPACE
+
+QSharedPointer<QAudioDecoderConsumer> QAudioDecoderConsumer::create(QObject *context, const Callback &callback,
+                                                                    QAudioDecoder::BufferMode mode, int blockSize,
+                                                                    int queueDepth, QAudioDecoder *decoder,
+                                                                    int generation)
+{
+    QSharedPointer<QAudioDecoderConsumer> consumer(
+            new QAudioDecoderConsumer(context, callback, mode, blockSize, queueDepth, decoder, generation));
+
+    // Buffers queued to a destroyed context are dropped and never free their
+    // slot, so stop the decoding thread from waiting for them.
+    if (context) {
+        const QWeakPointer<QAudioDecoderConsumer> weak = consumer;
+        consumer->m_contextDestroyed = QObject::connect(context, &QObject::destroyed, [weak]() {
+            if (const QSharedPointer<QAudioDecoderConsumer> consumer = weak.toStrongRef())
+                consumer->cancel();
+        });
+    }
+
+    return consumer;
+}
+
+QAudioDecoderConsumer::QAudioDecoderConsumer(QObject *context, const Callback &callback,
+                                             QAudioDecoder::BufferMode mode, int blockSize, int queueDepth,
+                                             QAudioDecoder *decoder, int generation)
+    : m_context(context)
+    , m_hasContext(context != nullptr)
+    , m_callback(callback)
+    , m_mode(mode)
+    , m_blockSize(blockSize)
+    , m_queueDepth(m_hasContext ? queueDepth : 0)
+    , m_decoder(decoder)
+    , m_generation(generation)
+    , m_free(qMax(0, m_queueDepth))
+    , m_pendingStartTime(-1)
+{
+    if (m_mode == QAudioDecoder::FixedBlockBufferMode && m_blockSize <= 0)
+        m_mode = QAudioDecoder::NativeBufferMode;
+}
+
+QAudioDecoderConsumer::~QAudioDecoderConsumer()
+{
+    QObject::disconnect(m_contextDestroyed);
+}
+
+void QAudioDecoderConsumer::push(const QAudioBuffer &buffer)
+{
+    if (isCancelled() || !buffer.isValid())
+        return;
+
+    switch (m_mode) {
+    case QAudioDecoder::NativeBufferMode:
+        dispatch(buffer);
+        break;
+    case QAudioDecoder::FixedBlockBufferMode: {
+        appendPending(buffer);
+
+        const int blockBytes = m_pendingFormat.bytesForFrames(m_blockSize);
+        if (blockBytes <= 0)
+            break;
+
+        int offset = 0;
+        while (m_pending.size() - offset >= blockBytes && !isCancelled()) {
+            dispatch(QAudioBuffer(m_pending.mid(offset, blockBytes), m_pendingFormat, m_pendingStartTime));
+            if (m_pendingStartTime >= 0)
+                m_pendingStartTime += m_pendingFormat.durationForBytes(blockBytes);
+            offset += blockBytes;
+        }
+        m_pending.remove(0, offset);
+        break;
+    }
+    case QAudioDecoder::WholeFileBufferMode:
+        appendPending(buffer);
+        break;
+    }
+}
+
+void QAudioDecoderConsumer::finish()
+{
+    if (isCancelled())
+        return;
+
+    flushPending();
+
+    if (!m_hasContext) {
+        notifyFinished();
+        return;
+    }
+
+    const QPointer<QObject> context = m_context;
+    if (!context || isCancelled())
+        return;
+
+    // Queued behind the last buffer
+    QSharedPointer<QAudioDecoderConsumer> self = sharedFromThis();
+    QMetaObject::invokeMethod(context.data(), [self]() { self->notifyFinished(); }, Qt::QueuedConnection);
+}
+
+void QAudioDecoderConsumer::cancel()
+{
+    if (m_cancelled.testAndSetOrdered(0, 1) && m_queueDepth > 0)
+        m_free.release(m_queueDepth);
+}
+
+void QAudioDecoderConsumer::appendPending(const QAudioBuffer &buffer)
+{
+    // Blocks never mix formats
+    if (buffer.format() != m_pendingFormat)
+        flushPending();
+
+    if (m_pending.isEmpty()) {
+        m_pendingFormat = buffer.format();
+        m_pendingStartTime = buffer.startTime();
+        if (m_mode == QAudioDecoder::FixedBlockBufferMode)
+            m_pending.reserve(m_pendingFormat.bytesForFrames(m_blockSize) + buffer.byteCount());
+    }
+
+    m_pending.append(static_cast<const char *>(buffer.constData()), buffer.byteCount());
+}
+
+void QAudioDecoderConsumer::flushPending()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    const QAudioBuffer buffer(m_pending, m_pendingFormat, m_pendingStartTime);
+    m_pending.clear();
+    m_pendingStartTime = -1;
+    dispatch(buffer);
+}
+
+void QAudioDecoderConsumer::dispatch(const QAudioBuffer &buffer)
+{
+    if (!m_hasContext) {
+        invoke(buffer);
+        return;
+    }
+
+    if (m_queueDepth > 0) {
+        m_free.acquire();
+        if (isCancelled())
+            return;
+    }
+
+    const QPointer<QObject> context = m_context;
+    if (!context) {
+        cancel();
+        return;
+    }
+
+    QSharedPointer<QAudioDecoderConsumer> self = sharedFromThis();
+    QMetaObject::invokeMethod(context.data(), [self, buffer]() {
+        self->invoke(buffer);
+        if (self->m_queueDepth > 0)
+            self->m_free.release();
+    }, Qt::QueuedConnection);
+}
+
+void QAudioDecoderConsumer::notifyFinished()
+{
+    if (!isCancelled() && m_decoder) {
+        QMetaObject::invokeMethod(m_decoder, "_q_consumerFinished", Qt::QueuedConnection,
+                                  Q_ARG(int, m_generation));
+    }
+}
+
+void QAudioDecoderConsumer::invoke(const QAudioBuffer &buffer)
+{
+    if (!isCancelled() && m_callback)
+        m_callback(buffer);
+}
+
+QT_END_NAMESPACE
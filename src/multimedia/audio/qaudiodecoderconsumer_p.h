@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QAUDIODECODERCONSUMER_P_H
+#define QAUDIODECODERCONSUMER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiodecoder.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+// Hands decoded buffers to the callback set with QAudioDecoder::setBufferCallback().
+// push() and finish() are called by the backend on its decoding thread, the
+// buffers are re-chunked according to the buffer mode and delivered on the
+// thread of the context object. At most queueDepth buffers are waiting for
+// the callback at any time, push() blocks until the consumer catches up.
+// The consumer cancels itself when the context object is destroyed.
+class Q_MULTIMEDIA_EXPORT QAudioDecoderConsumer : public QEnableSharedFromThis<QAudioDecoderConsumer>
+{
+public:
+    typedef std::function<void(const QAudioBuffer &)> Callback;
+
+    static QSharedPointer<QAudioDecoderConsumer> create(QObject *context, const Callback &callback,
+                                                        QAudioDecoder::BufferMode mode, int blockSize,
+                                                        int queueDepth, QAudioDecoder *decoder = nullptr,
+                                                        int generation = 0);
+    ~QAudioDecoderConsumer();
+
+    void push(const QAudioBuffer &buffer);
+    // Delivers what is pending and then tells the decoder the callback has got everything
+    void finish();
+
+    // Drops pending buffers and unblocks push(), called before the backend stops decoding.
+    void cancel();
+    bool isCancelled() const { return m_cancelled.loadAcquire(); }
+
+private:
+    QAudioDecoderConsumer(QObject *context, const Callback &callback,
+                          QAudioDecoder::BufferMode mode, int blockSize, int queueDepth,
+                          QAudioDecoder *decoder, int generation);
+
+    void appendPending(const QAudioBuffer &buffer);
+    void flushPending();
+    void dispatch(const QAudioBuffer &buffer);
+    void invoke(const QAudioBuffer &buffer);
+    void notifyFinished();
+
+    // Only dereferenced while not null, on the decoding thread
+    QPointer<QObject> m_context;
+    bool m_hasContext;
+    QMetaObject::Connection m_contextDestroyed;
+    Callback m_callback;
+    QAudioDecoder::BufferMode m_mode;
+    int m_blockSize;
+    int m_queueDepth;
+    QPointer<QAudioDecoder> m_decoder;
+    int m_generation;
+
+    QSemaphore m_free;
+    QAtomicInt m_cancelled;
+
+    // Decoded data not yet delivered, only touched on the decoding thread
+    QByteArray m_pending;
+    QAudioFormat m_pendingFormat;
+    qint64 m_pendingStartTime;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIODECODERCONSUMER_P_H
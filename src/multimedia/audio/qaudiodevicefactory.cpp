@@ -228,8 +228,10 @@ QAbstractAudioInput* QAudioDeviceFactory::createInputDevice(QAudioDeviceInfo con
 
     if (plugin) {
         QAbstractAudioInput* p = plugin->createInput(deviceInfo.handle());
-        if (p) p->setFormat(format);
-        return p;
+        if (p) {
+            p->setFormat(format);
+            return p;
+        }
     }
 #endif
 
@@ -247,8 +249,10 @@ QAbstractAudioOutput* QAudioDeviceFactory::createOutputDevice(QAudioDeviceInfo c
 
     if (plugin) {
         QAbstractAudioOutput* p = plugin->createOutput(deviceInfo.handle());
-        if (p) p->setFormat(format);
-        return p;
+        if (p) {
+            p->setFormat(format);
+            return p;
+        }
     }
 #endif
 
@@ -0,0 +1,581 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaudioformatadapter_p.h"
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// How long the converting writer waits before offering data the sink
+// refused once more.
+const int WriteRetryInterval = 10;
+
+// Input frames the converting writer converts at a time. At most the
+// converted output of one chunk waits in the writer when the sink is full.
+const int WriteChunkFrames = 256;
+
+// Returns the format the device should be opened with for the requested
+// \a format, which differs only when conversion is enabled and needed.
+static QAudioFormat deviceFormatFor(const QAudioDeviceInfo &device, const QAudioFormat &format,
+                                    bool conversionEnabled)
+{
+    if (!conversionEnabled || device.isNull() || device.isFormatSupported(format)
+            || !QAudioConverter::isFormatSupported(format)) {
+        return format;
+    }
+
+    const QAudioFormat nearest = device.nearestFormat(format);
+    return QAudioConverter::isFormatSupported(nearest) ? nearest : format;
+}
+
+} // namespace
+
+/*
+    QAudioConvertingReader reads from \a source and returns the data
+    converted by \a converter. It is used as the source of an output
+    opened in pull mode, and as the device returned by an input started
+    in pull mode.
+*/
+
+QAudioConvertingReader::QAudioConvertingReader(QIODevice *source, QAudioConverter *converter,
+                                               QObject *parent)
+    : QIODevice(parent)
+    , m_source(source)
+    , m_converter(converter)
+{
+    connect(source, SIGNAL(readyRead()), SIGNAL(readyRead()));
+    open(QIODevice::ReadOnly);
+}
+
+qint64 QAudioConvertingReader::bytesAvailable() const
+{
+    qint64 available = m_buffer.size() + QIODevice::bytesAvailable();
+    if (m_source)
+        available += m_converter->outputBytesForInput(int(qMin<qint64>(m_source->bytesAvailable(), std::numeric_limits<int>::max())));
+    return available;
+}
+
+qint64 QAudioConvertingReader::readData(char *data, qint64 maxlen)
+{
+    const int frameBytes = m_converter->inputFormat().bytesPerFrame();
+
+    while (m_buffer.size() < maxlen && m_source) {
+        const int missing = int(qMin<qint64>(maxlen - m_buffer.size(), std::numeric_limits<int>::max()));
+        const QByteArray input = m_source->read(qMax(frameBytes, m_converter->inputBytesForOutput(missing)));
+        if (input.isEmpty()) {
+            // Drain the resampler once a file-like source is exhausted.
+            if (!m_flushed && !m_source->isSequential() && m_source->atEnd()) {
+                m_buffer.append(m_converter->flush());
+                m_flushed = true;
+            }
+            break;
+        }
+        m_buffer.append(m_converter->convert(input));
+    }
+
+    const int count = int(qMin<qint64>(maxlen, m_buffer.size()));
+    memcpy(data, m_buffer.constData(), count);
+    m_buffer.remove(0, count);
+    return count;
+}
+
+qint64 QAudioConvertingReader::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return -1;
+}
+
+/*
+    QAudioConvertingWriter converts what is written to it with \a converter
+    and passes it on to \a sink. The input is converted in chunks, and no
+    more chunks are taken once the sink refuses data; write() then returns
+    the number of bytes actually consumed. What the sink did not accept of
+    the last chunk is offered again with the next write or after a short
+    delay. finish() hands over what the converter still holds at the end of
+    the stream.
+*/
+
+QAudioConvertingWriter::QAudioConvertingWriter(QIODevice *sink, QAudioConverter *converter,
+                                               QObject *parent)
+    : QIODevice(parent)
+    , m_sink(sink)
+    , m_converter(converter)
+{
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(WriteRetryInterval);
+    connect(&m_retryTimer, SIGNAL(timeout()), SLOT(writePending()));
+    open(QIODevice::WriteOnly);
+}
+
+void QAudioConvertingWriter::finish()
+{
+    m_pending.append(m_converter->flush());
+    writePending();
+}
+
+void QAudioConvertingWriter::writePending()
+{
+    if (!m_sink || m_pending.isEmpty()) {
+        m_retryTimer.stop();
+        return;
+    }
+
+    const qint64 written = m_sink->write(m_pending);
+    if (written > 0)
+        m_pending.remove(0, int(written));
+
+    if (m_pending.isEmpty())
+        m_retryTimer.stop();
+    else if (!m_retryTimer.isActive())
+        m_retryTimer.start();
+}
+
+qint64 QAudioConvertingWriter::readData(char *data, qint64 maxlen)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxlen);
+    return -1;
+}
+
+qint64 QAudioConvertingWriter::writeData(const char *data, qint64 len)
+{
+    // Nothing more is taken while the sink is still full
+    writePending();
+    if (!m_pending.isEmpty())
+        return 0;
+
+    const int frameBytes = m_converter->inputFormat().bytesPerFrame();
+    const qint64 chunkBytes = frameBytes > 0 ? qint64(WriteChunkFrames) * frameBytes : len;
+
+    qint64 consumed = 0;
+    while (consumed < len && m_pending.isEmpty()) {
+        const qint64 chunk = qMin(chunkBytes, len - consumed);
+        m_pending = m_converter->convert(data + consumed, int(chunk));
+        consumed += chunk;
+        writePending();
+    }
+
+    return consumed;
+}
+
+/*
+    QAudioOutputFormatAdapter sits between QAudioOutput and the backend.
+    It forwards everything unchanged unless format conversion is enabled
+    and the device cannot play the requested format, in which case the
+    backend is opened with the nearest supported format and the stream is
+    converted on the way through. Sizes reported to the application are
+    always in the requested format.
+*/
+
+QAudioOutputFormatAdapter::QAudioOutputFormatAdapter(QAbstractAudioOutput *backend,
+                                                     const QAudioDeviceInfo &device)
+    : m_backend(backend)
+    , m_deviceInfo(device)
+    , m_format(backend->format())
+{
+    connect(m_backend, SIGNAL(notify()), SIGNAL(notify()));
+    connect(m_backend, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
+    connect(m_backend, SIGNAL(errorChanged(QAudio::Error)), SIGNAL(errorChanged(QAudio::Error)));
+}
+
+QAudioOutputFormatAdapter::~QAudioOutputFormatAdapter()
+{
+    delete m_backend;
+    delete m_ioDevice;
+}
+
+void QAudioOutputFormatAdapter::prepare()
+{
+    if (m_backend->state() != QAudio::StoppedState)
+        return;
+
+    const QAudioFormat deviceFormat = deviceFormatFor(m_deviceInfo, m_format, m_conversionEnabled);
+    m_converting = deviceFormat != m_format;
+    m_converter.setFormats(m_format, deviceFormat);
+    m_backend->setFormat(deviceFormat);
+    if (m_bufferSize > 0)
+        m_backend->setBufferSize(m_converter.outputBytesForInput(m_bufferSize));
+}
+
+void QAudioOutputFormatAdapter::releaseDevice()
+{
+    delete m_ioDevice;
+    m_ioDevice = nullptr;
+    m_writer = nullptr;
+    m_converter.reset();
+}
+
+void QAudioOutputFormatAdapter::start(QIODevice *device)
+{
+    QIODevice *previous = m_ioDevice;
+    m_ioDevice = nullptr;
+    m_writer = nullptr;
+
+    prepare();
+    if (m_converting) {
+        m_ioDevice = new QAudioConvertingReader(device, &m_converter, this);
+        m_backend->start(m_ioDevice);
+    } else {
+        m_backend->start(device);
+    }
+    delete previous;
+}
+
+QIODevice *QAudioOutputFormatAdapter::start()
+{
+    QIODevice *previous = m_ioDevice;
+    m_ioDevice = nullptr;
+    m_writer = nullptr;
+
+    prepare();
+    QIODevice *device = m_backend->start();
+    if (m_converting && device) {
+        m_writer = new QAudioConvertingWriter(device, &m_converter, this);
+        m_ioDevice = m_writer;
+        device = m_writer;
+    }
+    delete previous;
+    return device;
+}
+
+void QAudioOutputFormatAdapter::stop()
+{
+    // Hand the converter's tail to the device before it is closed
+    if (m_writer)
+        m_writer->finish();
+    m_backend->stop();
+    releaseDevice();
+}
+
+void QAudioOutputFormatAdapter::reset()
+{
+    m_backend->reset();
+    releaseDevice();
+}
+
+void QAudioOutputFormatAdapter::suspend()
+{
+    m_backend->suspend();
+}
+
+void QAudioOutputFormatAdapter::resume()
+{
+    m_backend->resume();
+}
+
+int QAudioOutputFormatAdapter::bytesFree() const
+{
+    const int free = m_backend->bytesFree();
+    if (!m_converting)
+        return free;
+
+    const int pending = m_writer ? m_writer->pendingBytes() : 0;
+    return m_converter.inputBytesForOutput(qMax(0, free - pending));
+}
+
+int QAudioOutputFormatAdapter::periodSize() const
+{
+    const int size = m_backend->periodSize();
+    return m_converting ? m_converter.inputBytesForOutput(size) : size;
+}
+
+void QAudioOutputFormatAdapter::setBufferSize(int value)
+{
+    m_bufferSize = value;
+    m_backend->setBufferSize(m_converting ? m_converter.outputBytesForInput(value) : value);
+}
+
+int QAudioOutputFormatAdapter::bufferSize() const
+{
+    const int size = m_backend->bufferSize();
+    return m_converting ? m_converter.inputBytesForOutput(size) : size;
+}
+
+void QAudioOutputFormatAdapter::setNotifyInterval(int milliSeconds)
+{
+    m_backend->setNotifyInterval(milliSeconds);
+}
+
+int QAudioOutputFormatAdapter::notifyInterval() const
+{
+    return m_backend->notifyInterval();
+}
+
+qint64 QAudioOutputFormatAdapter::processedUSecs() const
+{
+    return m_backend->processedUSecs();
+}
+
+qint64 QAudioOutputFormatAdapter::elapsedUSecs() const
+{
+    return m_backend->elapsedUSecs();
+}
+
+QAudio::Error QAudioOutputFormatAdapter::error() const
+{
+    return m_backend->error();
+}
+
+QAudio::State QAudioOutputFormatAdapter::state() const
+{
+    return m_backend->state();
+}
+
+void QAudioOutputFormatAdapter::setFormat(const QAudioFormat &format)
+{
+    m_format = format;
+    m_backend->setFormat(format);
+}
+
+QAudioFormat QAudioOutputFormatAdapter::format() const
+{
+    return m_format;
+}
+
+void QAudioOutputFormatAdapter::setVolume(qreal volume)
+{
+    m_backend->setVolume(volume);
+}
+
+qreal QAudioOutputFormatAdapter::volume() const
+{
+    return m_backend->volume();
+}
+
+QString QAudioOutputFormatAdapter::category() const
+{
+    return m_backend->category();
+}
+
+void QAudioOutputFormatAdapter::setCategory(const QString &category)
+{
+    m_backend->setCategory(category);
+}
+
+/*
+    QAudioInputFormatAdapter is the capture side counterpart of
+    QAudioOutputFormatAdapter; the device records in the nearest supported
+    format and the data is converted to the requested one.
+*/
+
+QAudioInputFormatAdapter::QAudioInputFormatAdapter(QAbstractAudioInput *backend,
+                                                   const QAudioDeviceInfo &device)
+    : m_backend(backend)
+    , m_deviceInfo(device)
+    , m_format(backend->format())
+{
+    connect(m_backend, SIGNAL(notify()), SIGNAL(notify()));
+    connect(m_backend, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
+    connect(m_backend, SIGNAL(errorChanged(QAudio::Error)), SIGNAL(errorChanged(QAudio::Error)));
+}
+
+QAudioInputFormatAdapter::~QAudioInputFormatAdapter()
+{
+    delete m_backend;
+    delete m_ioDevice;
+}
+
+void QAudioInputFormatAdapter::prepare()
+{
+    if (m_backend->state() != QAudio::StoppedState)
+        return;
+
+    const QAudioFormat deviceFormat = deviceFormatFor(m_deviceInfo, m_format, m_conversionEnabled);
+    m_converting = deviceFormat != m_format;
+    m_converter.setFormats(deviceFormat, m_format);
+    m_backend->setFormat(deviceFormat);
+    if (m_bufferSize > 0)
+        m_backend->setBufferSize(m_converter.inputBytesForOutput(m_bufferSize));
+}
+
+void QAudioInputFormatAdapter::releaseDevice()
+{
+    delete m_ioDevice;
+    m_ioDevice = nullptr;
+    m_reader = nullptr;
+    m_writer = nullptr;
+    m_converter.reset();
+}
+
+void QAudioInputFormatAdapter::start(QIODevice *device)
+{
+    QIODevice *previous = m_ioDevice;
+    m_ioDevice = nullptr;
+    m_reader = nullptr;
+    m_writer = nullptr;
+
+    prepare();
+    if (m_converting) {
+        m_writer = new QAudioConvertingWriter(device, &m_converter, this);
+        m_ioDevice = m_writer;
+        m_backend->start(m_ioDevice);
+    } else {
+        m_backend->start(device);
+    }
+    delete previous;
+}
+
+QIODevice *QAudioInputFormatAdapter::start()
+{
+    QIODevice *previous = m_ioDevice;
+    m_ioDevice = nullptr;
+    m_reader = nullptr;
+    m_writer = nullptr;
+
+    prepare();
+    QIODevice *device = m_backend->start();
+    if (m_converting && device) {
+        m_reader = new QAudioConvertingReader(device, &m_converter, this);
+        m_ioDevice = m_reader;
+        device = m_reader;
+    }
+    delete previous;
+    return device;
+}
+
+void QAudioInputFormatAdapter::stop()
+{
+    m_backend->stop();
+    // The backend has delivered its last period, pass on the converter's tail
+    if (m_writer)
+        m_writer->finish();
+    releaseDevice();
+}
+
+void QAudioInputFormatAdapter::reset()
+{
+    m_backend->reset();
+    releaseDevice();
+}
+
+void QAudioInputFormatAdapter::suspend()
+{
+    m_backend->suspend();
+}
+
+void QAudioInputFormatAdapter::resume()
+{
+    m_backend->resume();
+}
+
+int QAudioInputFormatAdapter::bytesReady() const
+{
+    const int ready = m_backend->bytesReady();
+    if (!m_converting)
+        return ready;
+
+    return m_converter.outputBytesForInput(ready) + (m_reader ? m_reader->bufferedBytes() : 0);
+}
+
+int QAudioInputFormatAdapter::periodSize() const
+{
+    const int size = m_backend->periodSize();
+    return m_converting ? m_converter.outputBytesForInput(size) : size;
+}
+
+void QAudioInputFormatAdapter::setBufferSize(int value)
+{
+    m_bufferSize = value;
+    m_backend->setBufferSize(m_converting ? m_converter.inputBytesForOutput(value) : value);
+}
+
+int QAudioInputFormatAdapter::bufferSize() const
+{
+    const int size = m_backend->bufferSize();
+    return m_converting ? m_converter.outputBytesForInput(size) : size;
+}
+
+void QAudioInputFormatAdapter::setNotifyInterval(int milliSeconds)
+{
+    m_backend->setNotifyInterval(milliSeconds);
+}
+
+int QAudioInputFormatAdapter::notifyInterval() const
+{
+    return m_backend->notifyInterval();
+}
+
+qint64 QAudioInputFormatAdapter::processedUSecs() const
+{
+    return m_backend->processedUSecs();
+}
+
+qint64 QAudioInputFormatAdapter::elapsedUSecs() const
+{
+    return m_backend->elapsedUSecs();
+}
+
+QAudio::Error QAudioInputFormatAdapter::error() const
+{
+    return m_backend->error();
+}
+
+QAudio::State QAudioInputFormatAdapter::state() const
+{
+    return m_backend->state();
+}
+
+void QAudioInputFormatAdapter::setFormat(const QAudioFormat &format)
+{
+    m_format = format;
+    m_backend->setFormat(format);
+}
+
+QAudioFormat QAudioInputFormatAdapter::format() const
+{
+    return m_format;
+}
+
+void QAudioInputFormatAdapter::setVolume(qreal volume)
+{
+    m_backend->setVolume(volume);
+}
+
+qreal QAudioInputFormatAdapter::volume() const
+{
+    return m_backend->volume();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qaudioformatadapter_p.cpp"
@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QAUDIOFORMATADAPTER_P_H
+#define QAUDIOFORMATADAPTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtMultimedia/qaudiosystem.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qtimer.h>
+
+#include "qaudioconverter_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_AUTOTEST_EXPORT QAudioConvertingReader : public QIODevice
+{
+    Q_OBJECT
+public:
+    QAudioConvertingReader(QIODevice *source, QAudioConverter *converter, QObject *parent = nullptr);
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+    int bufferedBytes() const { return m_buffer.size(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    QPointer<QIODevice> m_source;
+    QAudioConverter *m_converter;
+    QByteArray m_buffer;
+    bool m_flushed = false;
+};
+
+class Q_AUTOTEST_EXPORT QAudioConvertingWriter : public QIODevice
+{
+    Q_OBJECT
+public:
+    QAudioConvertingWriter(QIODevice *sink, QAudioConverter *converter, QObject *parent = nullptr);
+
+    bool isSequential() const override { return true; }
+    int pendingBytes() const { return m_pending.size(); }
+
+    void finish();
+
+public Q_SLOTS:
+    void writePending();
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    QPointer<QIODevice> m_sink;
+    QAudioConverter *m_converter;
+    QByteArray m_pending;
+    QTimer m_retryTimer;
+};
+
+class QAudioOutputFormatAdapter : public QAbstractAudioOutput
+{
+    Q_OBJECT
+public:
+    QAudioOutputFormatAdapter(QAbstractAudioOutput *backend, const QAudioDeviceInfo &device);
+    ~QAudioOutputFormatAdapter();
+
+    bool isConversionEnabled() const { return m_conversionEnabled; }
+    void setConversionEnabled(bool enabled) { m_conversionEnabled = enabled; }
+
+    void start(QIODevice *device) override;
+    QIODevice *start() override;
+    void stop() override;
+    void reset() override;
+    void suspend() override;
+    void resume() override;
+    int bytesFree() const override;
+    int periodSize() const override;
+    void setBufferSize(int value) override;
+    int bufferSize() const override;
+    void setNotifyInterval(int milliSeconds) override;
+    int notifyInterval() const override;
+    qint64 processedUSecs() const override;
+    qint64 elapsedUSecs() const override;
+    QAudio::Error error() const override;
+    QAudio::State state() const override;
+    void setFormat(const QAudioFormat &format) override;
+    QAudioFormat format() const override;
+    void setVolume(qreal volume) override;
+    qreal volume() const override;
+    QString category() const override;
+    void setCategory(const QString &category) override;
+
+private:
+    void prepare();
+    void releaseDevice();
+
+    QAbstractAudioOutput *m_backend;
+    QAudioDeviceInfo m_deviceInfo;
+    QAudioFormat m_format;
+    QAudioConverter m_converter;
+    QIODevice *m_ioDevice = nullptr;
+    QAudioConvertingWriter *m_writer = nullptr;
+    int m_bufferSize = 0;
+    bool m_conversionEnabled = false;
+    bool m_converting = false;
+};
+
+class QAudioInputFormatAdapter : public QAbstractAudioInput
+{
+    Q_OBJECT
+public:
+    QAudioInputFormatAdapter(QAbstractAudioInput *backend, const QAudioDeviceInfo &device);
+    ~QAudioInputFormatAdapter();
+
+    bool isConversionEnabled() const { return m_conversionEnabled; }
+    void setConversionEnabled(bool enabled) { m_conversionEnabled = enabled; }
+
+    void start(QIODevice *device) override;
+    QIODevice *start() override;
+    void stop() override;
+    void reset() override;
+    void suspend() override;
+    void resume() override;
+    int bytesReady() const override;
+    int periodSize() const override;
+    void setBufferSize(int value) override;
+    int bufferSize() const override;
+    void setNotifyInterval(int milliSeconds) override;
+    int notifyInterval() const override;
+    qint64 processedUSecs() const override;
+    qint64 elapsedUSecs() const override;
+    QAudio::Error error() const override;
+    QAudio::State state() const override;
+    void setFormat(const QAudioFormat &format) override;
+    QAudioFormat format() const override;
+    void setVolume(qreal volume) override;
+    qreal volume() const override;
+
+private:
+    void prepare();
+    void releaseDevice();
+
+    QAbstractAudioInput *m_backend;
+    QAudioDeviceInfo m_deviceInfo;
+    QAudioFormat m_format;
+    QAudioConverter m_converter;
+    QIODevice *m_ioDevice = nullptr;
+    QAudioConvertingReader *m_reader = nullptr;
+    QAudioConvertingWriter *m_writer = nullptr;
+    int m_bufferSize = 0;
+    bool m_conversionEnabled = false;
+    bool m_converting = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAUDIOFORMATADAPTER_P_H
@@ -44,6 +44,7 @@
 #include "qaudioinput.h"
 
 #include "qaudiodevicefactory_p.h"
+#include "qaudioformatadapter_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -120,7 +121,8 @@ QT_BEGIN_NAMESPACE
 QAudioInput::QAudioInput(const QAudioFormat &format, QObject *parent):
     QObject(parent)
 {
-    d = QAudioDeviceFactory::createDefaultInputDevice(format);
+    const QAudioDeviceInfo device = QAudioDeviceInfo::defaultInputDevice();
+    d = new QAudioInputFormatAdapter(QAudioDeviceFactory::createInputDevice(device, format), device);
     connect(d, SIGNAL(notify()), SIGNAL(notify()));
     connect(d, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
 }
@@ -134,7 +136,7 @@ QAudioInput::QAudioInput(const QAudioFormat &format, QObject *parent):
 QAudioInput::QAudioInput(const QAudioDeviceInfo &audioDevice, const QAudioFormat &format, QObject *parent):
     QObject(parent)
 {
-    d = QAudioDeviceFactory::createInputDevice(audioDevice, format);
+    d = new QAudioInputFormatAdapter(QAudioDeviceFactory::createInputDevice(audioDevice, format), audioDevice);
     connect(d, SIGNAL(notify()), SIGNAL(notify()));
     connect(d, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
 }
@@ -200,6 +202,42 @@ QAudioFormat QAudioInput::format() const
     return d->format();
 }
 
+/*!
+    Sets whether the audio input converts between the requested format and
+    the format of the device to \a enabled.
+
+    By default the format passed to the constructor must be supported by the
+    device, otherwise start() fails with QAudio::OpenError. With conversion
+    enabled, a format the device does not support is instead mapped to
+    QAudioDeviceInfo::nearestFormat(); the sample type, sample size, byte
+    order, channel count and sample rate are converted on the fly, so the
+    application keeps reading data in the format it asked for. All sizes reported
+    by this class, such as bufferSize() and periodSize(), stay in the
+    requested format.
+
+    Only linear PCM is converted. The setting takes effect the next time the
+    audio input is started from the stopped state.
+
+    \since 5.15
+    \sa isFormatConversionEnabled(), QAudioDeviceInfo::isFormatSupported()
+*/
+void QAudioInput::setFormatConversionEnabled(bool enabled)
+{
+    static_cast<QAudioInputFormatAdapter *>(d)->setConversionEnabled(enabled);
+}
+
+/*!
+    Returns true if the audio input converts between the requested format
+    and the format of the device.
+
+    \since 5.15
+    \sa setFormatConversionEnabled()
+*/
+bool QAudioInput::isFormatConversionEnabled() const
+{
+    return static_cast<QAudioInputFormatAdapter *>(d)->isConversionEnabled();
+}
+
 /*!
     Stops the audio input, detaching from the system resource.
 
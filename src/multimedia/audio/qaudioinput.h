@@ -68,6 +68,9 @@ public:
 
     QAudioFormat format() const;
 
+    void setFormatConversionEnabled(bool enabled);
+    bool isFormatConversionEnabled() const;
+
     void start(QIODevice *device);
     QIODevice* start();
 
@@ -44,6 +44,7 @@
 #include "qaudiooutput.h"
 
 #include "qaudiodevicefactory_p.h"
+#include "qaudioformatadapter_p.h"
 
 
 QT_BEGIN_NAMESPACE
@@ -121,7 +122,8 @@ QT_BEGIN_NAMESPACE
 QAudioOutput::QAudioOutput(const QAudioFormat &format, QObject *parent):
     QObject(parent)
 {
-    d = QAudioDeviceFactory::createDefaultOutputDevice(format);
+    const QAudioDeviceInfo device = QAudioDeviceInfo::defaultOutputDevice();
+    d = new QAudioOutputFormatAdapter(QAudioDeviceFactory::createOutputDevice(device, format), device);
     connect(d, SIGNAL(notify()), SIGNAL(notify()));
     connect(d, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
 }
@@ -134,7 +136,7 @@ QAudioOutput::QAudioOutput(const QAudioFormat &format, QObject *parent):
 QAudioOutput::QAudioOutput(const QAudioDeviceInfo &audioDevice, const QAudioFormat &format, QObject *parent):
     QObject(parent)
 {
-    d = QAudioDeviceFactory::createOutputDevice(audioDevice, format);
+    d = new QAudioOutputFormatAdapter(QAudioDeviceFactory::createOutputDevice(audioDevice, format), audioDevice);
     connect(d, SIGNAL(notify()), SIGNAL(notify()));
     connect(d, SIGNAL(stateChanged(QAudio::State)), SIGNAL(stateChanged(QAudio::State)));
 }
@@ -158,6 +160,42 @@ QAudioFormat QAudioOutput::format() const
     return d->format();
 }
 
+/*!
+    Sets whether the audio output converts between the requested format and
+    the format of the device to \a enabled.
+
+    By default the format passed to the constructor must be supported by the
+    device, otherwise start() fails with QAudio::OpenError. With conversion
+    enabled, a format the device does not support is instead mapped to
+    QAudioDeviceInfo::nearestFormat(); the sample type, sample size, byte
+    order, channel count and sample rate are converted on the fly, so the
+    application keeps writing data in the format it asked for. All sizes reported
+    by this class, such as bufferSize() and periodSize(), stay in the
+    requested format.
+
+    Only linear PCM is converted. The setting takes effect the next time the
+    audio output is started from the stopped state.
+
+    \since 5.15
+    \sa isFormatConversionEnabled(), QAudioDeviceInfo::isFormatSupported()
+*/
+void QAudioOutput::setFormatConversionEnabled(bool enabled)
+{
+    static_cast<QAudioOutputFormatAdapter *>(d)->setConversionEnabled(enabled);
+}
+
+/*!
+    Returns true if the audio output converts between the requested format
+    and the format of the device.
+
+    \since 5.15
+    \sa setFormatConversionEnabled()
+*/
+bool QAudioOutput::isFormatConversionEnabled() const
+{
+    return static_cast<QAudioOutputFormatAdapter *>(d)->isConversionEnabled();
+}
+
 /*!
     Starts transferring audio data from the \a device to the system's audio output.
     The \a device must have been opened in the \l{QIODevice::ReadOnly}{ReadOnly} or
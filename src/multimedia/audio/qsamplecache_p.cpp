@@ -45,6 +45,7 @@
 #include <QtNetwork/QNetworkRequest>
 
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
 //#define QT_SAMPLECACHE_DEBUG
 
 #include <mutex>
@@ -396,8 +397,21 @@ void QSample::load()
 #ifdef QT_SAMPLECACHE_DEBUG
     qDebug() << "QSample: load [" << m_url << "]";
 #endif
-    m_stream = m_parent->networkAccessManager().get(QNetworkRequest(m_url));
-    connect(m_stream, SIGNAL(errorOccurred(QNetworkReply::NetworkError)), SLOT(decoderError()));
+    if (m_url.isLocalFile() || m_url.scheme() == QLatin1String("qrc")) {
+        // Opened directly so that the decoder can map the file instead of
+        // streaming it through the network access manager.
+        QFile *file = new QFile(m_url.isLocalFile()
+                                ? m_url.toLocalFile()
+                                : QLatin1Char(':') + m_url.path());
+        m_stream = file;
+        if (!file->open(QIODevice::ReadOnly)) {
+            QMetaObject::invokeMethod(this, "decoderError", Qt::QueuedConnection);
+            return;
+        }
+    } else {
+        m_stream = m_parent->networkAccessManager().get(QNetworkRequest(m_url));
+        connect(m_stream, SIGNAL(errorOccurred(QNetworkReply::NetworkError)), SLOT(decoderError()));
+    }
     m_waveDecoder = new QWaveDecoder(m_stream);
     connect(m_waveDecoder, SIGNAL(formatKnown()), SLOT(decoderReady()));
     connect(m_waveDecoder, SIGNAL(parsingError()), SLOT(decoderError()));
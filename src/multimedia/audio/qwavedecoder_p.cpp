@@ -39,23 +39,54 @@
 
 #include "qwavedecoder_p.h"
 
+#include <QtCore/qbuffer.h>
+#include <QtCore/qfiledevice.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qendian.h>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+
+enum WaveFormatTag
+{
+    WaveFormatUnknown = 0x0000,
+    WaveFormatPcm = 0x0001,
+    WaveFormatIeeeFloat = 0x0003,
+    WaveFormatExtensible = 0xfffe
+};
+
+// Plain fmt chunks have 16 bytes, WAVE_FORMAT_EXTENSIBLE ones 40.
+// Anything beyond that is skipped.
+const quint32 MinimumFormatLength = 16;
+const quint32 ExtensibleFormatLength = 40;
+
+// The KSDATAFORMAT_SUBTYPE_ GUIDs of an extensible fmt chunk all share this
+// tail, their first two bytes are the plain format tag.
+const uchar SubFormatGuidTail[14] = {
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71
+};
+
+}
+
 QWaveDecoder::QWaveDecoder(QIODevice *s, QObject *parent):
     QIODevice(parent),
     haveFormat(false),
     dataSize(0),
+    dataOffset(0),
+    dataPosition(0),
     source(s),
+    mappedBytes(nullptr),
+    mappedSize(0),
     state(QWaveDecoder::InitialState),
     junkToSkip(0),
     bigEndian(false)
 {
     open(QIODevice::ReadOnly | QIODevice::Unbuffered);
 
-    if (enoughDataAvailable())
+    mapSource();
+
+    if (mappedBytes || enoughDataAvailable())
         QTimer::singleShot(0, this, SLOT(handleData()));
     else
         connect(source, SIGNAL(readyRead()), SLOT(handleData()));
@@ -63,6 +94,9 @@ QWaveDecoder::QWaveDecoder(QIODevice *s, QObject *parent):
 
 QWaveDecoder::~QWaveDecoder()
 {
+    QFileDevice *file = qobject_cast<QFileDevice *>(mappedDevice.data());
+    if (file && file->isOpen())
+        file->unmap(const_cast<uchar *>(mappedBytes));
 }
 
 QAudioFormat QWaveDecoder::audioFormat() const
@@ -72,7 +106,17 @@ QAudioFormat QWaveDecoder::audioFormat() const
 
 int QWaveDecoder::duration() const
 {
-    return size() * 1000 / (format.sampleSize() / 8) / format.channelCount() / format.sampleRate();
+    const int bytesPerFrame = format.bytesPerFrame();
+    if (bytesPerFrame <= 0 || format.sampleRate() <= 0)
+        return 0;
+    return size() * 1000 / bytesPerFrame / format.sampleRate();
+}
+
+// Returns the sample data when the source is a file or buffer that could be
+// accessed directly, or null. The pointer stays valid while the source is open.
+const uchar *QWaveDecoder::mappedData() const
+{
+    return haveFormat && mappedBytes ? mappedBytes + dataOffset : nullptr;
 }
 
 qint64 QWaveDecoder::size() const
@@ -87,12 +131,47 @@ bool QWaveDecoder::isSequential() const
 
 qint64 QWaveDecoder::bytesAvailable() const
 {
-    return haveFormat ? source->bytesAvailable() : 0;
+    if (!haveFormat)
+        return 0;
+
+    const qint64 remaining = dataSize - dataPosition;
+    return mappedBytes ? remaining : qMin(source->bytesAvailable(), remaining);
+}
+
+bool QWaveDecoder::seek(qint64 pos)
+{
+    if (!haveFormat || isSequential() || pos < 0 || pos > dataSize)
+        return false;
+
+    if (!mappedBytes && !source->seek(dataOffset + pos))
+        return false;
+
+    dataPosition = pos;
+    return QIODevice::seek(pos);
 }
 
 qint64 QWaveDecoder::readData(char *data, qint64 maxlen)
 {
-    return haveFormat ? source->read(data, maxlen) : 0;
+    if (!haveFormat)
+        return 0;
+
+    const qint64 length = qMin(maxlen, dataSize - dataPosition);
+    if (length <= 0)
+        return 0;
+
+    qint64 read = 0;
+    if (mappedBytes) {
+        if (!mappedDevice || !mappedDevice->isOpen())
+            return -1;
+        memcpy(data, mappedBytes + dataOffset + dataPosition, length);
+        read = length;
+    } else {
+        read = source->read(data, length);
+    }
+
+    if (read > 0)
+        dataPosition += read;
+    return read;
 }
 
 qint64 QWaveDecoder::writeData(const char *data, qint64 len)
@@ -112,6 +191,20 @@ void QWaveDecoder::parsingFailed()
 
 void QWaveDecoder::handleData()
 {
+    if (mappedBytes) {
+        if (!parseMappedData()) {
+            parsingFailed();
+            return;
+        }
+
+        // Leave the source at the first sample, as the streaming parser does
+        source->seek(dataOffset);
+
+        haveFormat = true;
+        emit formatKnown();
+        return;
+    }
+
     // As a special "state", if we have junk to skip, we do
     if (junkToSkip > 0) {
         discardBytes(junkToSkip); // this also updates junkToSkip
@@ -151,51 +244,26 @@ void QWaveDecoder::handleData()
             chunk descriptor;
             peekChunk(&descriptor);
 
-            quint32 rawChunkSize = descriptor.size + sizeof(chunk);
-            if (source->bytesAvailable() < qint64(rawChunkSize))
+            const qint64 rawChunkSize = qint64(sizeof(chunk)) + descriptor.size;
+            if (source->bytesAvailable() < rawChunkSize)
                 return;
 
-            WAVEHeader wave;
-            source->read(reinterpret_cast<char *>(&wave), sizeof(WAVEHeader));
-
-            if (rawChunkSize > sizeof(WAVEHeader))
-                discardBytes(rawChunkSize - sizeof(WAVEHeader));
+            char formatData[ExtensibleFormatLength];
+            const quint32 formatLength = qMin(descriptor.size, ExtensibleFormatLength);
+            discardBytes(sizeof(chunk));
+            source->read(formatData, formatLength);
 
-            // Swizzle this
-            if (bigEndian) {
-                wave.audioFormat = qFromBigEndian<quint16>(wave.audioFormat);
-            } else {
-                wave.audioFormat = qFromLittleEndian<quint16>(wave.audioFormat);
-            }
-
-            if (wave.audioFormat != 0 && wave.audioFormat != 1) {
-                // 32bit wave files have format == 0xFFFE (WAVE_FORMAT_EXTENSIBLE).
-                // but don't support them at the moment.
+            if (!parseFormat(formatData, formatLength)) {
                 parsingFailed();
                 return;
-            } else {
-                format.setCodec(QLatin1String("audio/pcm"));
-
-                if (bigEndian) {
-                    int bps = qFromBigEndian<quint16>(wave.bitsPerSample);
-
-                    format.setSampleType(bps == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
-                    format.setByteOrder(QAudioFormat::BigEndian);
-                    format.setSampleRate(qFromBigEndian<quint32>(wave.sampleRate));
-                    format.setSampleSize(bps);
-                    format.setChannelCount(qFromBigEndian<quint16>(wave.numChannels));
-                } else {
-                    int bps = qFromLittleEndian<quint16>(wave.bitsPerSample);
-
-                    format.setSampleType(bps == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
-                    format.setByteOrder(QAudioFormat::LittleEndian);
-                    format.setSampleRate(qFromLittleEndian<quint32>(wave.sampleRate));
-                    format.setSampleSize(bps);
-                    format.setChannelCount(qFromLittleEndian<quint16>(wave.numChannels));
-                }
-
-                state = QWaveDecoder::WaitingForDataState;
             }
+
+            state = QWaveDecoder::WaitingForDataState;
+
+            // Skip the rest of the chunk, including the pad byte of odd sized chunks
+            discardBytes(rawChunkSize - sizeof(chunk) - formatLength + (descriptor.size & 1));
+            if (junkToSkip > 0)
+                return;
         }
     }
 
@@ -205,12 +273,14 @@ void QWaveDecoder::handleData()
 
             chunk descriptor;
             source->read(reinterpret_cast<char *>(&descriptor), sizeof(chunk));
-            if (bigEndian)
-                descriptor.size = qFromBigEndian<quint32>(descriptor.size);
-            else
-                descriptor.size = qFromLittleEndian<quint32>(descriptor.size);
+            descriptor.size = toHost32(&descriptor.size);
 
             dataSize = descriptor.size;
+            if (!source->isSequential()) {
+                // Writers that could not seek back leave the size at 0xffffffff
+                dataOffset = source->pos();
+                dataSize = qMin(dataSize, source->size() - dataOffset);
+            }
 
             haveFormat = true;
             connect(source, SIGNAL(readyRead()), SIGNAL(readyRead()));
@@ -226,6 +296,138 @@ void QWaveDecoder::handleData()
     }
 }
 
+void QWaveDecoder::mapSource()
+{
+    // Random access files and read-only buffers are parsed and read straight
+    // from memory instead of going through the device.
+    if (!source->isOpen() || !source->isReadable() || source->isSequential())
+        return;
+
+    if (QFileDevice *file = qobject_cast<QFileDevice *>(source)) {
+        if (file->size() > 0)
+            mappedBytes = file->map(0, file->size());
+        if (mappedBytes)
+            mappedSize = file->size();
+    } else if (QBuffer *buffer = qobject_cast<QBuffer *>(source)) {
+        if (!buffer->isWritable()) {
+            mappedBytes = reinterpret_cast<const uchar *>(buffer->data().constData());
+            mappedSize = buffer->data().size();
+        }
+    }
+
+    if (mappedBytes)
+        mappedDevice = source;
+}
+
+bool QWaveDecoder::parseMappedData()
+{
+    if (mappedSize < qint64(sizeof(RIFFHeader)))
+        return false;
+
+    RIFFHeader riff;
+    memcpy(&riff, mappedBytes, sizeof(RIFFHeader));
+
+    // RIFF = little endian RIFF, RIFX = big endian RIFF
+    if (((qstrncmp(riff.descriptor.id, "RIFF", 4) != 0) && (qstrncmp(riff.descriptor.id, "RIFX", 4) != 0))
+            || qstrncmp(riff.type, "WAVE", 4) != 0) {
+        return false;
+    }
+    bigEndian = qstrncmp(riff.descriptor.id, "RIFX", 4) == 0;
+    state = QWaveDecoder::WaitingForFormatState;
+
+    // Walk the chunk headers only, LIST, fact, cue and other chunks are
+    // stepped over without touching their contents.
+    qint64 offset = sizeof(RIFFHeader);
+    while (mappedSize - offset >= qint64(sizeof(chunk))) {
+        chunk descriptor;
+        memcpy(&descriptor, mappedBytes + offset, sizeof(chunk));
+        descriptor.size = toHost32(&descriptor.size);
+        offset += sizeof(chunk);
+
+        const qint64 available = mappedSize - offset;
+        if (qstrncmp(descriptor.id, "fmt ", 4) == 0) {
+            if (descriptor.size > available
+                    || !parseFormat(reinterpret_cast<const char *>(mappedBytes + offset),
+                                    descriptor.size)) {
+                return false;
+            }
+            state = QWaveDecoder::WaitingForDataState;
+        } else if (qstrncmp(descriptor.id, "data", 4) == 0) {
+            if (state != QWaveDecoder::WaitingForDataState)
+                return false;
+
+            dataOffset = offset;
+            dataSize = qMin(qint64(descriptor.size), available);
+            return true;
+        }
+
+        offset += qint64(descriptor.size) + (descriptor.size & 1);
+    }
+
+    return false;
+}
+
+bool QWaveDecoder::parseFormat(const char *data, quint32 length)
+{
+    if (length < MinimumFormatLength)
+        return false;
+
+    quint16 formatTag = toHost16(data);
+    const quint16 channelCount = toHost16(data + 2);
+    const quint32 sampleRate = toHost32(data + 4);
+    const quint16 bitsPerSample = toHost16(data + 14);
+
+    if (formatTag == WaveFormatExtensible) {
+        if (length < ExtensibleFormatLength
+                || memcmp(data + 26, SubFormatGuidTail, sizeof(SubFormatGuidTail)) != 0) {
+            return false;
+        }
+        formatTag = toHost16(data + 24);
+    }
+
+    // Samples are stored in whole bytes, e.g. 20 bit samples take 3 bytes
+    const int sampleSize = (bitsPerSample + 7) & ~7;
+
+    QAudioFormat::SampleType sampleType = QAudioFormat::Unknown;
+    switch (formatTag) {
+    case WaveFormatUnknown:
+    case WaveFormatPcm:
+        if (sampleSize < 8 || sampleSize > 32)
+            return false;
+        sampleType = sampleSize == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt;
+        break;
+    case WaveFormatIeeeFloat:
+        if (sampleSize != 32 && sampleSize != 64)
+            return false;
+        sampleType = QAudioFormat::Float;
+        break;
+    default:
+        return false;
+    }
+
+    if (channelCount == 0 || sampleRate == 0)
+        return false;
+
+    format.setCodec(QLatin1String("audio/pcm"));
+    format.setSampleType(sampleType);
+    format.setByteOrder(bigEndian ? QAudioFormat::BigEndian : QAudioFormat::LittleEndian);
+    format.setSampleRate(sampleRate);
+    format.setSampleSize(sampleSize);
+    format.setChannelCount(channelCount);
+
+    return true;
+}
+
+quint16 QWaveDecoder::toHost16(const void *data) const
+{
+    return bigEndian ? qFromBigEndian<quint16>(data) : qFromLittleEndian<quint16>(data);
+}
+
+quint32 QWaveDecoder::toHost32(const void *data) const
+{
+    return bigEndian ? qFromBigEndian<quint32>(data) : qFromLittleEndian<quint32>(data);
+}
+
 bool QWaveDecoder::enoughDataAvailable()
 {
     chunk descriptor;
@@ -257,8 +459,8 @@ bool QWaveDecoder::findChunk(const char *chunkId)
             return true;
 
         // It's possible that bytes->available() is less than the chunk size
-        // if it's corrupt.
-        junkToSkip = qint64(sizeof(chunk) + descriptor.size);
+        // if it's corrupt. Odd sized chunks are followed by a pad byte.
+        junkToSkip = qint64(sizeof(chunk)) + descriptor.size + (descriptor.size & 1);
 
         // Skip the current amount
         if (junkToSkip > 0)
@@ -280,31 +482,18 @@ bool QWaveDecoder::peekChunk(chunk *pChunk, bool handleEndianness)
         return false;
 
     source->peek(reinterpret_cast<char *>(pChunk), sizeof(chunk));
-    if (handleEndianness) {
-        if (bigEndian)
-            pChunk->size = qFromBigEndian<quint32>(pChunk->size);
-        else
-            pChunk->size = qFromLittleEndian<quint32>(pChunk->size);
-    }
+    if (handleEndianness)
+        pChunk->size = toHost32(&pChunk->size);
     return true;
 }
 
 void QWaveDecoder::discardBytes(qint64 numBytes)
 {
-    // Discards a number of bytes
+    // Discards a number of bytes without buffering them.
     // If the iodevice doesn't have this many bytes in it,
     // remember how much more junk we have to skip.
-    if (source->isSequential()) {
-        QByteArray r = source->read(qMin(numBytes, qint64(16384))); // uggh, wasted memory, limit to a max of 16k
-        if (r.size() < numBytes)
-            junkToSkip = numBytes - r.size();
-        else
-            junkToSkip = 0;
-    } else {
-        quint64 origPos = source->pos();
-        source->seek(source->pos() + numBytes);
-        junkToSkip = origPos + numBytes - source->pos();
-    }
+    const qint64 skipped = source->skip(numBytes);
+    junkToSkip = numBytes - qMax(skipped, qint64(0));
 }
 
 QT_END_NAMESPACE
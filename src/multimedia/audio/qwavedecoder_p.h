@@ -52,13 +52,12 @@
 //
 
 #include <QtCore/qiodevice.h>
+#include <QtCore/qpointer.h>
 #include <qaudioformat.h>
 
 
 QT_BEGIN_NAMESPACE
 
-
-
 class QWaveDecoder : public QIODevice
 {
     Q_OBJECT
@@ -70,9 +69,12 @@ public:
     QAudioFormat audioFormat() const;
     int duration() const;
 
+    const uchar *mappedData() const;
+
     qint64 size() const override;
     bool isSequential() const override;
     qint64 bytesAvailable() const override;
+    bool seek(qint64 pos) override;
 
 Q_SIGNALS:
     void formatKnown();
@@ -90,6 +92,12 @@ private:
     void discardBytes(qint64 numBytes);
     void parsingFailed();
 
+    void mapSource();
+    bool parseMappedData();
+    bool parseFormat(const char *data, quint32 length);
+    quint16 toHost16(const void *data) const;
+    quint32 toHost32(const void *data) const;
+
     enum State {
         InitialState,
         WaitingForFormatState,
@@ -108,23 +116,18 @@ private:
         chunk       descriptor;
         char        type[4];
     };
-    struct WAVEHeader
-    {
-        chunk       descriptor;
-        quint16     audioFormat;
-        quint16     numChannels;
-        quint32     sampleRate;
-        quint32     byteRate;
-        quint16     blockAlign;
-        quint16     bitsPerSample;
-    };
 
     bool haveFormat;
     qint64 dataSize;
+    qint64 dataOffset;
+    qint64 dataPosition;
     QAudioFormat format;
     QIODevice *source;
+    QPointer<QIODevice> mappedDevice;
+    const uchar *mappedBytes;
+    qint64 mappedSize;
     State state;
-    quint32 junkToSkip;
+    qint64 junkToSkip;
     bool bigEndian;
 };
 
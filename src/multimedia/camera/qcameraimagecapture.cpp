@@ -490,6 +490,40 @@ void QCameraImageCapture::setCaptureDestination(QCameraImageCapture::CaptureDest
         d->captureDestinationControl->setCaptureDestination(destination);
 }
 
+/*!
+    Returns the drive mode used for capture requests.
+
+    \since 5.15
+    \sa setDriveMode()
+*/
+QCameraImageCapture::DriveMode QCameraImageCapture::driveMode() const
+{
+    if (d_func()->control)
+        return d_func()->control->driveMode();
+    else
+        return SingleImageCapture;
+}
+
+/*!
+    Sets the drive \a mode used for capture requests.
+
+    In QCameraImageCapture::BurstImageCapture mode, capture() can be called
+    again before the previous image was saved. The requests are queued and
+    served from consecutive frames while the images are encoded and saved in
+    the background, allowing a sustained capture rate close to the camera
+    frame rate. Services not supporting burst capture keep the current mode.
+
+    \since 5.15
+    \sa driveMode(), capture()
+*/
+void QCameraImageCapture::setDriveMode(QCameraImageCapture::DriveMode mode)
+{
+    Q_D(QCameraImageCapture);
+
+    if (d->control)
+        d->control->setDriveMode(mode);
+}
+
 /*!
   \property QCameraImageCapture::readyForCapture
   \brief whether the service is ready to capture a an image immediately.
@@ -588,6 +622,9 @@ void QCameraImageCapture::cancelCapture()
     \enum QCameraImageCapture::DriveMode
 
     \value SingleImageCapture Drive mode is capturing a single picture.
+    \value BurstImageCapture  Drive mode is capturing a series of pictures from
+                              consecutive frames, each capture() call adding one
+                              picture to the series. This value was introduced in Qt 5.15.
 */
 
 /*!
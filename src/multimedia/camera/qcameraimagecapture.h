@@ -77,7 +77,8 @@ public:
 
     enum DriveMode
     {
-        SingleImageCapture
+        SingleImageCapture,
+        BurstImageCapture
     };
 
     enum CaptureDestination
@@ -117,6 +118,9 @@ public:
     CaptureDestinations captureDestination() const;
     void setCaptureDestination(CaptureDestinations destination);
 
+    DriveMode driveMode() const;
+    void setDriveMode(DriveMode mode);
+
 public Q_SLOTS:
     int capture(const QString &location = QString());
     void cancelCapture();
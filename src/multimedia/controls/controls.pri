@@ -42,7 +42,13 @@ PUBLIC_HEADERS += \
 
 PRIVATE_HEADERS += \
     controls/qmediaplaylistcontrol_p.h \
-    controls/qmediaplaylistsourcecontrol_p.h
+    controls/qmediaplaylistsourcecontrol_p.h \
+    controls/qaudiodecoderconsumercontrol_p.h \
+    controls/qmediarecordersegmentcontrol_p.h \
+    controls/qmediastatisticscontrol_p.h \
+    controls/qmediaplayerpreloadcontrol_p.h \
+    controls/qmediathumbnailercontrol_p.h \
+    controls/qmetadatascannercontrol_p.h
 
 SOURCES += \
     controls/qcameracapturebufferformatcontrol.cpp \
@@ -63,11 +69,16 @@ SOURCES += \
     controls/qmediagaplessplaybackcontrol.cpp \
     controls/qmedianetworkaccesscontrol.cpp \
     controls/qmediaplayercontrol.cpp \
+    controls/qmediaplayerpreloadcontrol.cpp \
     controls/qmediaplaylistcontrol.cpp \
     controls/qmediaplaylistsourcecontrol.cpp \
     controls/qmediarecordercontrol.cpp \
+    controls/qmediarecordersegmentcontrol.cpp \
+    controls/qmediastatisticscontrol.cpp \
     controls/qmediastreamscontrol.cpp \
+    controls/qmediathumbnailercontrol.cpp \
     controls/qmetadatareadercontrol.cpp \
+    controls/qmetadatascannercontrol.cpp \
     controls/qmetadatawritercontrol.cpp \
     controls/qradiodatacontrol.cpp \
     controls/qradiotunercontrol.cpp \
@@ -77,6 +88,7 @@ SOURCES += \
     controls/qmediavideoprobecontrol.cpp \
     controls/qmediaavailabilitycontrol.cpp \
     controls/qaudiodecodercontrol.cpp \
+    controls/qaudiodecoderconsumercontrol.cpp \
     controls/qvideoencodersettingscontrol.cpp \
     controls/qaudioencodersettingscontrol.cpp \
     controls/qaudioinputselectorcontrol.cpp \
@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qaudiodecoderconsumercontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QAudioDecoderConsumerControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QAudioDecoderConsumerControl class lets an audio decoder
+    service deliver decoded buffers directly from its decoding thread.
+
+    When a consumer is set, the service no longer queues decoded buffers for
+    QAudioDecoderControl::read(). Instead every decoded buffer is passed to
+    QAudioDecoderConsumer::push() on the decoding thread, and
+    QAudioDecoderConsumer::finish() is called once the end of the stream is
+    reached. The service must call QAudioDecoderConsumer::cancel() before it
+    stops its decoding thread.
+
+    The interface name of QAudioDecoderConsumerControl is \c org.qt-project.qt.audiodecoderconsumercontrol/5.15 as
+    defined in QAudioDecoderConsumerControl_iid.
+
+    \sa QMediaService::requestControl(), QAudioDecoder
+*/
+
+/*!
+    \macro QAudioDecoderConsumerControl_iid
+
+    \c org.qt-project.qt.audiodecoderconsumercontrol/5.15
+
+    Defines the interface name of the QAudioDecoderConsumerControl class.
+
+    \relates QAudioDecoderConsumerControl
+*/
+
+/*!
+    Create a new audio decoder consumer control object with the given \a parent.
+*/
+QAudioDecoderConsumerControl::QAudioDecoderConsumerControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the audio decoder consumer control.
+*/
+QAudioDecoderConsumerControl::~QAudioDecoderConsumerControl()
+{
+}
+
+/*!
+    \fn QAudioDecoderConsumerControl::bufferQueueDepth() const
+
+    Returns the maximum number of decoded buffers queued by the service.
+*/
+
+/*!
+    \fn QAudioDecoderConsumerControl::setBufferQueueDepth(int depth)
+
+    Sets the maximum number of decoded buffers queued by the service to \a depth.
+    Decoding is throttled once this many buffers are waiting to be read.
+*/
+
+/*!
+    \fn QAudioDecoderConsumerControl::setConsumer(const QSharedPointer<QAudioDecoderConsumer> &consumer)
+
+    Sets the \a consumer receiving decoded buffers on the decoding thread.
+    A null \a consumer restores delivery through QAudioDecoderControl::read().
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,97 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediaplayerpreloadcontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaPlayerPreloadControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QMediaPlayerPreloadControl class prepares the media a player
+    is going to play next.
+
+    A backend implementing this control may open and preroll the media in
+    the background, so that a later QMediaPlayerControl::setMedia() with the
+    same content starts without the usual loading delay.
+
+    The interface name of QMediaPlayerPreloadControl is \c org.qt-project.qt.mediaplayerpreloadcontrol/5.15 as
+    defined in QMediaPlayerPreloadControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaPlayer::preload()
+*/
+
+/*!
+    \macro QMediaPlayerPreloadControl_iid
+
+    \c org.qt-project.qt.mediaplayerpreloadcontrol/5.15
+
+    Defines the interface name of the QMediaPlayerPreloadControl class.
+
+    \relates QMediaPlayerPreloadControl
+*/
+
+/*!
+    Create a new media player preload control object with the given \a parent.
+*/
+QMediaPlayerPreloadControl::QMediaPlayerPreloadControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the media player preload control.
+*/
+QMediaPlayerPreloadControl::~QMediaPlayerPreloadControl()
+{
+}
+
+/*!
+    \fn QMediaPlayerPreloadControl::preload(const QMediaContent &media)
+
+    Starts preparing \a media in the background. Only the most recent
+    media is kept prepared; a null \a media drops it.
+*/
+
+QT_END_NAMESPACE
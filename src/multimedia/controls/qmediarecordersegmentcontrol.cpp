@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediarecordersegmentcontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaRecorderSegmentControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QMediaRecorderSegmentControl class splits a recording into
+    consecutive files without interrupting the capture pipeline.
+
+    A new segment is started at the first key frame after the current one
+    reached the maximum duration or size. Each finished segment is announced
+    with the segmentFinalized() signal.
+
+    The interface name of QMediaRecorderSegmentControl is \c org.qt-project.qt.mediarecordersegmentcontrol/5.15 as
+    defined in QMediaRecorderSegmentControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaRecorder
+*/
+
+/*!
+    \macro QMediaRecorderSegmentControl_iid
+
+    \c org.qt-project.qt.mediarecordersegmentcontrol/5.15
+
+    Defines the interface name of the QMediaRecorderSegmentControl class.
+
+    \relates QMediaRecorderSegmentControl
+*/
+
+/*!
+    Create a new media recorder segment control object with the given \a parent.
+*/
+QMediaRecorderSegmentControl::QMediaRecorderSegmentControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the media recorder segment control.
+*/
+QMediaRecorderSegmentControl::~QMediaRecorderSegmentControl()
+{
+}
+
+/*!
+    \fn QMediaRecorderSegmentControl::maxSegmentDuration() const
+
+    Returns the maximum duration of a segment in milliseconds, 0 if unlimited.
+*/
+
+/*!
+    \fn QMediaRecorderSegmentControl::setMaxSegmentDuration(qint64 duration)
+
+    Sets the maximum \a duration of a segment in milliseconds.
+    The value is applied when the next recording starts.
+*/
+
+/*!
+    \fn QMediaRecorderSegmentControl::maxSegmentSize() const
+
+    Returns the maximum size of a segment in bytes, 0 if unlimited.
+*/
+
+/*!
+    \fn QMediaRecorderSegmentControl::setMaxSegmentSize(qint64 size)
+
+    Sets the maximum \a size of a segment in bytes.
+    The value is applied when the next recording starts.
+*/
+
+/*!
+    \fn QMediaRecorderSegmentControl::segmentFinalized(const QUrl &location, qint64 startTime, qint64 endTime)
+
+    Signals that the segment written to \a location is complete. \a startTime
+    and \a endTime give the range of the recording covered by the segment in
+    milliseconds.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediastatisticscontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaStatisticsControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QMediaStatisticsControl class exposes performance counters
+    of a media pipeline.
+
+    The counters are meant for monitoring; backends update them from their
+    streaming threads with atomic operations, so reading them is cheap and
+    never blocks the pipeline.
+
+    The interface name of QMediaStatisticsControl is \c org.qt-project.qt.mediastatisticscontrol/5.15 as
+    defined in QMediaStatisticsControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaPlayer::statistics(), QMediaRecorder::statistics()
+*/
+
+/*!
+    \macro QMediaStatisticsControl_iid
+
+    \c org.qt-project.qt.mediastatisticscontrol/5.15
+
+    Defines the interface name of the QMediaStatisticsControl class.
+
+    \relates QMediaStatisticsControl
+*/
+
+/*!
+    Create a new media statistics control object with the given \a parent.
+*/
+QMediaStatisticsControl::QMediaStatisticsControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the media statistics control.
+*/
+QMediaStatisticsControl::~QMediaStatisticsControl()
+{
+}
+
+/*!
+    \fn QMediaStatisticsControl::statistics() const
+
+    Returns a snapshot of the counters collected since the pipeline was
+    created or the statistics were last reset.
+*/
+
+/*!
+    \fn QMediaStatisticsControl::resetStatistics()
+
+    Sets all counters back to zero.
+*/
+
+QT_END_NAMESPACE
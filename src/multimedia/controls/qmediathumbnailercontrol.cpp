@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediathumbnailercontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaThumbnailerControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QMediaThumbnailerControl class extracts still frames from
+    media files.
+
+    Requests are processed in the background, possibly several at a time,
+    and each one is answered with either thumbnailReady() or failed().
+    Implementations decode only as much of the file as needed for the
+    requested frame and must not open video outputs or audio devices.
+
+    The interface name of QMediaThumbnailerControl is \c org.qt-project.qt.mediathumbnailercontrol/5.15 as
+    defined in QMediaThumbnailerControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaThumbnailer
+*/
+
+/*!
+    \macro QMediaThumbnailerControl_iid
+
+    \c org.qt-project.qt.mediathumbnailercontrol/5.15
+
+    Defines the interface name of the QMediaThumbnailerControl class.
+
+    \relates QMediaThumbnailerControl
+*/
+
+/*!
+    Create a new thumbnailer control object with the given \a parent.
+*/
+QMediaThumbnailerControl::QMediaThumbnailerControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the thumbnailer control.
+*/
+QMediaThumbnailerControl::~QMediaThumbnailerControl()
+{
+}
+
+/*!
+    \fn QMediaThumbnailerControl::request(int id, const QUrl &url, qint64 position, const QSize &size)
+
+    Queues a request for the frame of \a url closest to \a position, in
+    milliseconds, scaled to fit within \a size. An invalid \a size keeps
+    the frame's own size. The result is reported with the given \a id.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::cancel()
+
+    Drops all queued requests. Requests already being processed may still
+    produce a result, which the control discards.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::pendingCount() const
+
+    Returns the number of requests that have not been answered yet.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::maximumWorkerCount() const
+
+    Returns the maximum number of requests processed in parallel.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::setMaximumWorkerCount(int count)
+
+    Sets the maximum number of requests processed in parallel to \a count.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::thumbnailReady(int id, const QImage &image)
+
+    Signals that the frame for request \a id has been extracted as \a image.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::failed(int id, const QString &errorString)
+
+    Signals that request \a id could not be answered, with \a errorString
+    describing why.
+*/
+
+/*!
+    \fn QMediaThumbnailerControl::finished()
+
+    Signals that all queued requests have been answered.
+*/
+
+QT_END_NAMESPACE
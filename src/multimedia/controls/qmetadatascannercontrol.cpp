@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmetadatascannercontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMetaDataScannerControl
+    \internal
+
+    \inmodule QtMultimedia
+
+    \ingroup multimedia_control
+
+    \brief The QMetaDataScannerControl class reads the meta-data of many
+    media files without playing them.
+
+    Files queued with scan() are processed in the background, possibly
+    several at a time, and their results are reported as each one
+    completes. Implementations must not open video outputs or audio
+    devices to do so.
+
+    The interface name of QMetaDataScannerControl is \c org.qt-project.qt.metadatascannercontrol/5.15 as
+    defined in QMetaDataScannerControl_iid.
+
+    \sa QMediaService::requestControl(), QMediaMetaDataScanner
+*/
+
+/*!
+    \macro QMetaDataScannerControl_iid
+
+    \c org.qt-project.qt.metadatascannercontrol/5.15
+
+    Defines the interface name of the QMetaDataScannerControl class.
+
+    \relates QMetaDataScannerControl
+*/
+
+/*!
+    Create a new meta-data scanner control object with the given \a parent.
+*/
+QMetaDataScannerControl::QMetaDataScannerControl(QObject *parent)
+    : QMediaControl(parent)
+{
+}
+
+/*!
+    Destroys the meta-data scanner control.
+*/
+QMetaDataScannerControl::~QMetaDataScannerControl()
+{
+}
+
+/*!
+    \fn QMetaDataScannerControl::scan(const QList<QUrl> &urls)
+
+    Appends \a urls to the queue of files to scan.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::cancel()
+
+    Drops all queued files. Files already being scanned may still report
+    a result, which the control discards.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::pendingCount() const
+
+    Returns the number of queued files that have not been reported yet.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::maximumWorkerCount() const
+
+    Returns the maximum number of files scanned in parallel.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::setMaximumWorkerCount(int count)
+
+    Sets the maximum number of files scanned in parallel to \a count.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::scanned(const QUrl &url, const QVariantMap &metaData)
+
+    Signals that \a url has been scanned. \a metaData is keyed by the
+    QMediaMetaData key names.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::failed(const QUrl &url, const QString &errorString)
+
+    Signals that \a url could not be scanned, with \a errorString
+    describing why.
+*/
+
+/*!
+    \fn QMetaDataScannerControl::finished()
+
+    Signals that the queue has been drained.
+*/
+
+QT_END_NAMESPACE
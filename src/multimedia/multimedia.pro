@@ -25,6 +25,7 @@ PRIVATE_HEADERS += \
     qmediaresourcepolicy_p.h \
     qmediaresourceset_p.h \
     qmediastoragelocation_p.h \
+    qmediastatistics_p.h \
     qmediaopenglhelper_p.h \
     qmultimediautils_p.h
 
@@ -53,6 +54,7 @@ SOURCES += \
     qmediaresourcepolicy_p.cpp \
     qmediaresourceset_p.cpp \
     qmediastoragelocation.cpp \
+    qmediastatistics.cpp \
     qmultimedia.cpp \
     qmultimediautils.cpp
 
@@ -2,9 +2,11 @@ INCLUDEPATH += playback
 
 PUBLIC_HEADERS += \
     playback/qmediacontent.h \
+    playback/qmediametadatascanner.h \
     playback/qmediaplayer.h \
     playback/qmediaplaylist.h \
-    playback/qmediaresource.h
+    playback/qmediaresource.h \
+    playback/qmediathumbnailer.h
 
 PRIVATE_HEADERS += \
     playback/qmediaplaylist_p.h \
@@ -17,10 +19,12 @@ PRIVATE_HEADERS += \
 SOURCES += \
     playback/qmedianetworkplaylistprovider.cpp \
     playback/qmediacontent.cpp \
+    playback/qmediametadatascanner.cpp \
     playback/qmediaplayer.cpp \
     playback/qmediaplaylist.cpp \
     playback/qmediaplaylistioplugin.cpp \
     playback/qmediaplaylistnavigator.cpp \
     playback/qmediaplaylistprovider.cpp \
     playback/qmediaresource.cpp \
+    playback/qmediathumbnailer.cpp \
     playback/qplaylistfileparser.cpp
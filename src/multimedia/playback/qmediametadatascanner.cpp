@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediametadatascanner.h"
+#include "qmediaservice.h"
+#include "qmediaserviceprovider_p.h"
+#include "qmediaserviceproviderplugin.h"
+#include "qmetadatascannercontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaMetaDataScanner
+    \inmodule QtMultimedia
+    \since 5.15
+
+    \ingroup multimedia
+    \ingroup multimedia_playback
+
+    \brief The QMediaMetaDataScanner class reads the meta-data of many
+    local media files without playing them.
+
+    Use QMediaMetaDataScanner to index a media library. Files passed to
+    scan() are queued and read in the background by a pool of workers,
+    so throughput scales with the number of available cores. Each result
+    is delivered with the metaDataScanned() signal as soon as that file is
+    done, in no particular order; files that cannot be read are reported
+    with error(). When the queue runs empty, finished() is emitted.
+
+    The meta-data map is keyed by the QMediaMetaData key names, such as
+    QMediaMetaData::Duration, QMediaMetaData::Resolution or
+    QMediaMetaData::AudioCodec. Only the headers and tags of a file are
+    parsed; no media is rendered and no audio device is opened.
+
+    \sa QMediaMetaData, QMediaPlayer
+*/
+
+class QMediaMetaDataScannerPrivate
+{
+public:
+    QMediaServiceProvider *provider = nullptr;
+    QMediaService *service = nullptr;
+    QMetaDataScannerControl *control = nullptr;
+};
+
+/*!
+    Constructs a meta-data scanner with the given \a parent.
+*/
+QMediaMetaDataScanner::QMediaMetaDataScanner(QObject *parent)
+    : QObject(parent)
+    , d(new QMediaMetaDataScannerPrivate)
+{
+    d->provider = QMediaServiceProvider::defaultServiceProvider();
+    d->service = d->provider->requestService(Q_MEDIASERVICE_METADATASCANNER);
+    if (d->service) {
+        d->control = qobject_cast<QMetaDataScannerControl *>(
+                    d->service->requestControl(QMetaDataScannerControl_iid));
+    }
+
+    if (d->control) {
+        connect(d->control, SIGNAL(scanned(QUrl,QVariantMap)), SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+        connect(d->control, SIGNAL(failed(QUrl,QString)), SIGNAL(error(QUrl,QString)));
+        connect(d->control, SIGNAL(finished()), SIGNAL(finished()));
+    }
+}
+
+/*!
+    Destroys the scanner. Files still queued are dropped.
+*/
+QMediaMetaDataScanner::~QMediaMetaDataScanner()
+{
+    if (d->service) {
+        if (d->control) {
+            d->control->cancel();
+            d->service->releaseControl(d->control);
+        }
+        d->provider->releaseService(d->service);
+    }
+    delete d;
+}
+
+/*!
+    Returns true if a backend able to scan media files is available.
+*/
+bool QMediaMetaDataScanner::isAvailable() const
+{
+    return d->control != nullptr;
+}
+
+/*!
+    \property QMediaMetaDataScanner::pendingCount
+    \brief the number of queued files that have not been reported yet.
+*/
+int QMediaMetaDataScanner::pendingCount() const
+{
+    return d->control ? d->control->pendingCount() : 0;
+}
+
+/*!
+    \property QMediaMetaDataScanner::maximumWorkerCount
+    \brief the maximum number of files read in parallel.
+
+    By default this is the number of processor cores.
+*/
+int QMediaMetaDataScanner::maximumWorkerCount() const
+{
+    return d->control ? d->control->maximumWorkerCount() : 0;
+}
+
+void QMediaMetaDataScanner::setMaximumWorkerCount(int count)
+{
+    if (d->control)
+        d->control->setMaximumWorkerCount(qMax(1, count));
+}
+
+/*!
+    Queues the local file \a url for scanning.
+
+    The result is reported with metaDataScanned() or error(), neither of
+    which is emitted before this function returns.
+*/
+void QMediaMetaDataScanner::scan(const QUrl &url)
+{
+    scan(QList<QUrl>() << url);
+}
+
+/*!
+    \overload
+
+    Queues all of \a urls for scanning.
+*/
+void QMediaMetaDataScanner::scan(const QList<QUrl> &urls)
+{
+    if (urls.isEmpty())
+        return;
+
+    if (!d->control) {
+        // Reported after returning to the event loop, as the backends do
+        for (const QUrl &url : urls) {
+            QMetaObject::invokeMethod(this, "error", Qt::QueuedConnection,
+                                      Q_ARG(QUrl, url),
+                                      Q_ARG(QString, tr("The QMediaMetaDataScanner object does not have a valid service")));
+        }
+        QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
+        return;
+    }
+
+    d->control->scan(urls);
+}
+
+/*!
+    Drops all files that are still queued. Results of files that are
+    already being read are discarded.
+*/
+void QMediaMetaDataScanner::cancel()
+{
+    if (d->control)
+        d->control->cancel();
+}
+
+/*!
+    \fn QMediaMetaDataScanner::metaDataScanned(const QUrl &url, const QVariantMap &metaData)
+
+    Signals that \a url has been read, with its \a metaData keyed by
+    QMediaMetaData key names.
+*/
+
+/*!
+    \fn QMediaMetaDataScanner::error(const QUrl &url, const QString &errorString)
+
+    Signals that \a url could not be read, with \a errorString describing
+    the reason.
+*/
+
+/*!
+    \fn QMediaMetaDataScanner::finished()
+
+    Signals that every queued file has been reported.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qmediametadatascanner.cpp"
@@ -56,7 +56,7 @@ public:
     QList<QMediaContent> resources;
 
     void _q_handleParserError(QPlaylistFileParser::ParserError err, const QString &);
-    void _q_handleNewItem(const QVariant& content);
+    void _q_handleNewItems(const QVariantList &items);
 
     QMediaNetworkPlaylistProvider *q_ptr;
 };
@@ -96,28 +96,34 @@ void QMediaNetworkPlaylistProviderPrivate::_q_handleParserError(QPlaylistFilePar
     emit q->loadFailed(playlistError, errorMessage);
 }
 
-void QMediaNetworkPlaylistProviderPrivate::_q_handleNewItem(const QVariant& content)
+void QMediaNetworkPlaylistProviderPrivate::_q_handleNewItems(const QVariantList &items)
 {
     Q_Q(QMediaNetworkPlaylistProvider);
 
-    QUrl url;
-    if (content.type() == QVariant::Url) {
-        url = content.toUrl();
-    } else if (content.type() == QVariant::Map) {
-        url = content.toMap()[QLatin1String("url")].toUrl();
-    } else {
-        return;
+    QList<QMediaContent> media;
+    media.reserve(items.size());
+    for (const QVariant &content : items) {
+        QUrl url;
+        if (content.type() == QVariant::Url) {
+            url = content.toUrl();
+        } else if (content.type() == QVariant::Map) {
+            url = content.toMap()[QLatin1String("url")].toUrl();
+        } else {
+            continue;
+        }
+        media.append(QMediaContent(url));
     }
 
-    q->addMedia(QMediaContent(url));
+    // One insertion for the whole batch
+    q->addMedia(media);
 }
 
 QMediaNetworkPlaylistProvider::QMediaNetworkPlaylistProvider(QObject *parent)
     :QMediaPlaylistProvider(*new QMediaNetworkPlaylistProviderPrivate, parent)
 {
     d_func()->q_ptr = this;
-    connect(&d_func()->parser, SIGNAL(newItem(QVariant)),
-            this, SLOT(_q_handleNewItem(QVariant)));
+    connect(&d_func()->parser, SIGNAL(newItems(QVariantList)),
+            this, SLOT(_q_handleNewItems(QVariantList)));
     connect(&d_func()->parser, SIGNAL(finished()), this, SIGNAL(loaded()));
     connect(&d_func()->parser, SIGNAL(error(QPlaylistFileParser::ParserError,QString)),
             this, SLOT(_q_handleParserError(QPlaylistFileParser::ParserError,QString)));
@@ -51,6 +51,8 @@
 #include <qmedianetworkaccesscontrol.h>
 #include <qaudiorolecontrol.h>
 #include <qcustomaudiorolecontrol.h>
+#include <qmediastatisticscontrol_p.h>
+#include <qmediaplayerpreloadcontrol_p.h>
 
 #include <QtCore/qcoreevent.h>
 #include <QtCore/qmetaobject.h>
@@ -115,6 +117,8 @@ public:
         , control(nullptr)
         , audioRoleControl(nullptr)
         , customAudioRoleControl(nullptr)
+        , statisticsControl(nullptr)
+        , preloadControl(nullptr)
         , playlist(nullptr)
 #ifndef QT_NO_BEARERMANAGEMENT
         , networkAccessControl(nullptr)
@@ -131,6 +135,8 @@ public:
     QMediaPlayerControl* control;
     QAudioRoleControl *audioRoleControl;
     QCustomAudioRoleControl *customAudioRoleControl;
+    QMediaStatisticsControl *statisticsControl;
+    QMediaPlayerPreloadControl *preloadControl;
     QString errorString;
 
     QPointer<QObject> videoOutput;
@@ -158,6 +164,7 @@ QT_WARNING_POP
     bool isInChain(const QUrl &url);
 
     void setMedia(const QMediaContent &media, QIODevice *stream = nullptr);
+    void preloadNextMedia();
 
     void setPlaylist(QMediaPlaylist *playlist);
     void setPlaylistMedia();
@@ -334,6 +341,8 @@ void QMediaPlayerPrivate::_q_updateMedia(const QMediaContent &media)
     }
 
     _q_stateChanged(control->state());
+
+    preloadNextMedia();
 }
 
 void QMediaPlayerPrivate::_q_playlistDestroyed()
@@ -415,6 +424,20 @@ void QMediaPlayerPrivate::setMedia(const QMediaContent &media, QIODevice *stream
     qrcFile.swap(file); // Cleans up any previous file
 }
 
+void QMediaPlayerPrivate::preloadNextMedia()
+{
+    if (!preloadControl || !playlist)
+        return;
+
+    // Nested playlists and resources are resolved here only once they are reached
+    const QMediaContent next = playlist->media(playlist->nextIndex());
+    if (next.isNull() || next.playlist()
+            || next.request().url().scheme() == QLatin1String("qrc"))
+        return;
+
+    preloadControl->preload(next);
+}
+
 void QMediaPlayerPrivate::_q_handleMediaChanged(const QMediaContent &media)
 {
     Q_Q(QMediaPlayer);
@@ -467,6 +490,7 @@ void QMediaPlayerPrivate::setPlaylistMedia()
             if (isSameMedia) {
                 emit q->currentMediaChanged(q->currentMedia());
             }
+            preloadNextMedia();
         }
     } else {
         setMedia(QMediaContent(), nullptr);
@@ -654,6 +678,9 @@ QT_WARNING_POP
                             &QMediaPlayer::customAudioRoleChanged);
                 }
             }
+
+            d->statisticsControl = d->service->requestControl<QMediaStatisticsControl *>();
+            d->preloadControl = d->service->requestControl<QMediaPlayerPreloadControl *>();
         }
 #ifndef QT_NO_BEARERMANAGEMENT
         if (d->networkAccessControl != nullptr) {
@@ -688,6 +715,10 @@ QMediaPlayer::~QMediaPlayer()
             d->service->releaseControl(d->audioRoleControl);
         if (d->customAudioRoleControl)
             d->service->releaseControl(d->customAudioRoleControl);
+        if (d->statisticsControl)
+            d->service->releaseControl(d->statisticsControl);
+        if (d->preloadControl)
+            d->service->releaseControl(d->preloadControl);
 
         d->provider->releaseService(d->service);
     }
@@ -1223,7 +1254,19 @@ void QMediaPlayer::setVideoOutput(QAbstractVideoSurface *surface)
     Sets multiple video surfaces as the video output of a media player.
     This allows the media player to render video frames on different surfaces.
 
-    All video surfaces must support at least one shared \c QVideoFrame::PixelFormat.
+    Frames are presented to each surface on the thread it lives in. Surfaces
+    living on another thread than the media backend's output are fed through a
+    small queue, and when such a surface falls behind, the oldest frame waiting
+    for it is dropped. The pixel formats preferred by the first surface are
+    negotiated with the media backend, surfaces that do not support the
+    negotiated \c QVideoFrame::PixelFormat receive frames converted on a worker
+    thread to an RGB format they support. Playback fails to start if any of the
+    surfaces can't be started.
+
+    The delivery to a surface can be tuned with dynamic properties set on it
+    before playback starts: \c maximumFrameRate (qreal) limits the rate of
+    frames presented to the surface, and \c maximumQueuedFrames (int) sets the
+    length of its queues, which is 2 by default.
 
     If a video output has already been set on the media player the new surfaces
     will replace it.
@@ -1330,6 +1373,92 @@ QStringList QMediaPlayer::supportedCustomAudioRoles() const
     return QStringList();
 }
 
+/*!
+    Returns a snapshot of the playback performance counters.
+
+    The map is empty if the backend does not collect statistics. The
+    GStreamer backend reports the following keys:
+
+    \table
+    \header \li Key \li Description
+    \row \li \c decodedFrames \li Video frames that reached the video sink.
+    \row \li \c renderedFrames \li Video frames handed to the video output.
+    \row \li \c droppedFrames \li Video frames that arrived at the sink but
+            were never shown, because the output did not take them in time.
+    \row \li \c lateFrames \li Quality of service reports from the video
+            sink, each one for a frame that was too late.
+    \row \li \c audioUnderruns \li Quality of service reports from the
+            audio sink, which it posts when it had to skip samples.
+    \row \li \c seeks \li Seeks requested since the last reset.
+    \row \li \c encodedFrames \li Always 0 for playback; see
+            QMediaRecorder::statistics().
+    \row \li \c bufferFill \li The last reported fill level of the network
+            buffer in percent. Absent until the pipeline buffered once.
+    \row \li \c sinkToPresentLatency \li Time from a frame reaching the video
+            sink until the video output is asked to present it.
+    \row \li \c presentToRenderLatency \li Time the video output takes to
+            accept a presented frame.
+    \row \li \c seekLatency \li Time from a seek request until the pipeline
+            prerolled at the new position.
+    \endtable
+
+    Latencies are maps with the keys \c count, \c max, \c p50, \c p95,
+    \c p99, \c histogram and \c bucketBounds; all times are in
+    microseconds. The percentiles are the upper bounds of the histogram
+    buckets they fall in.
+
+    The counters are updated with atomic operations on the streaming
+    threads and can be polled at any rate without affecting playback.
+
+    \since 5.15
+    \sa resetStatistics()
+*/
+QVariantMap QMediaPlayer::statistics() const
+{
+    Q_D(const QMediaPlayer);
+
+    if (d->statisticsControl)
+        return d->statisticsControl->statistics();
+
+    return QVariantMap();
+}
+
+/*!
+    Sets all playback performance counters back to zero.
+
+    \since 5.15
+    \sa statistics()
+*/
+void QMediaPlayer::resetStatistics()
+{
+    Q_D(QMediaPlayer);
+
+    if (d->statisticsControl)
+        d->statisticsControl->resetStatistics();
+}
+
+/*!
+    Starts preparing \a media in the background, so that a following
+    setMedia() with the same content can start playback without waiting
+    for the media to be opened and prerolled.
+
+    Only the most recently preloaded media is kept; passing a null
+    QMediaContent releases it. When a playlist is set, the player preloads
+    the next item of the playlist on its own.
+
+    This is a hint, backends that can't prepare media ahead ignore it.
+
+    \since 5.15
+    \sa setMedia()
+*/
+void QMediaPlayer::preload(const QMediaContent &media)
+{
+    Q_D(QMediaPlayer);
+
+    if (d->preloadControl)
+        d->preloadControl->preload(media);
+}
+
 // Enums
 /*!
     \enum QMediaPlayer::State
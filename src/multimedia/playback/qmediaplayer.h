@@ -174,6 +174,11 @@ QT_WARNING_POP
     void setCustomAudioRole(const QString &audioRole);
     QStringList supportedCustomAudioRoles() const;
 
+    Q_INVOKABLE QVariantMap statistics() const;
+    Q_INVOKABLE void resetStatistics();
+
+    Q_INVOKABLE void preload(const QMediaContent &media);
+
 public Q_SLOTS:
     void play();
     void pause();
@@ -0,0 +1,208 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediathumbnailer.h"
+#include "qmediaservice.h"
+#include "qmediaserviceprovider_p.h"
+#include "qmediaserviceproviderplugin.h"
+#include "qmediathumbnailercontrol_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QMediaThumbnailer
+    \inmodule QtMultimedia
+    \since 5.15
+
+    \ingroup multimedia
+    \ingroup multimedia_playback
+
+    \brief The QMediaThumbnailer class extracts still frames from video
+    files.
+
+    Use QMediaThumbnailer to fill grid views or scrubbing previews with
+    frames of a video without setting up a QMediaPlayer for each file.
+    Every call to requestThumbnail() returns an id and is answered with
+    either thumbnailReady() or error() carrying that id. Requests are
+    handled in the background by a pool of workers, in no particular
+    order. When no request is left, finished() is emitted.
+
+    To stay fast, the frame delivered is the key frame nearest to the
+    requested position, rather than the exact frame at that position.
+
+    \sa QMediaMetaDataScanner, QMediaPlayer
+*/
+
+class QMediaThumbnailerPrivate
+{
+public:
+    QMediaServiceProvider *provider = nullptr;
+    QMediaService *service = nullptr;
+    QMediaThumbnailerControl *control = nullptr;
+    int nextId = 1;
+};
+
+/*!
+    Constructs a thumbnailer with the given \a parent.
+*/
+QMediaThumbnailer::QMediaThumbnailer(QObject *parent)
+    : QObject(parent)
+    , d(new QMediaThumbnailerPrivate)
+{
+    d->provider = QMediaServiceProvider::defaultServiceProvider();
+    d->service = d->provider->requestService(Q_MEDIASERVICE_THUMBNAILER);
+    if (d->service) {
+        d->control = qobject_cast<QMediaThumbnailerControl *>(
+                    d->service->requestControl(QMediaThumbnailerControl_iid));
+    }
+
+    if (d->control) {
+        connect(d->control, SIGNAL(thumbnailReady(int,QImage)), SIGNAL(thumbnailReady(int,QImage)));
+        connect(d->control, SIGNAL(failed(int,QString)), SIGNAL(error(int,QString)));
+        connect(d->control, SIGNAL(finished()), SIGNAL(finished()));
+    }
+}
+
+/*!
+    Destroys the thumbnailer. Requests still queued are dropped.
+*/
+QMediaThumbnailer::~QMediaThumbnailer()
+{
+    if (d->service) {
+        if (d->control) {
+            d->control->cancel();
+            d->service->releaseControl(d->control);
+        }
+        d->provider->releaseService(d->service);
+    }
+    delete d;
+}
+
+/*!
+    Returns true if a backend able to extract frames is available.
+*/
+bool QMediaThumbnailer::isAvailable() const
+{
+    return d->control != nullptr;
+}
+
+/*!
+    \property QMediaThumbnailer::pendingCount
+    \brief the number of requests that have not been answered yet.
+*/
+int QMediaThumbnailer::pendingCount() const
+{
+    return d->control ? d->control->pendingCount() : 0;
+}
+
+/*!
+    \property QMediaThumbnailer::maximumWorkerCount
+    \brief the maximum number of requests processed in parallel.
+
+    By default this is the number of processor cores.
+*/
+int QMediaThumbnailer::maximumWorkerCount() const
+{
+    return d->control ? d->control->maximumWorkerCount() : 0;
+}
+
+void QMediaThumbnailer::setMaximumWorkerCount(int count)
+{
+    if (d->control)
+        d->control->setMaximumWorkerCount(qMax(1, count));
+}
+
+/*!
+    Requests the frame of \a url at \a position, in milliseconds.
+
+    The frame is scaled down to fit within \a size, keeping its aspect
+    ratio. If \a size is not valid, the frame keeps the size of the video.
+
+    Returns the id that thumbnailReady() or error() will carry for this
+    request. Neither signal is emitted before this function returns.
+*/
+int QMediaThumbnailer::requestThumbnail(const QUrl &url, qint64 position, const QSize &size)
+{
+    const int id = d->nextId++;
+
+    if (d->control) {
+        d->control->request(id, url, qMax<qint64>(0, position), size);
+    } else {
+        // Reported after returning to the event loop, as the backends do
+        QMetaObject::invokeMethod(this, "error", Qt::QueuedConnection,
+                                  Q_ARG(int, id),
+                                  Q_ARG(QString, tr("The QMediaThumbnailer object does not have a valid service")));
+        QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
+    }
+
+    return id;
+}
+
+/*!
+    Drops all requests that are still queued. Results of requests that
+    are already being processed are discarded.
+*/
+void QMediaThumbnailer::cancel()
+{
+    if (d->control)
+        d->control->cancel();
+}
+
+/*!
+    \fn QMediaThumbnailer::thumbnailReady(int id, const QImage &image)
+
+    Signals that the frame for request \a id is available as \a image.
+*/
+
+/*!
+    \fn QMediaThumbnailer::error(int id, const QString &errorString)
+
+    Signals that request \a id failed, with \a errorString describing
+    the reason.
+*/
+
+/*!
+    \fn QMediaThumbnailer::finished()
+
+    Signals that every queued request has been answered.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qmediathumbnailer.cpp"
@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMEDIATHUMBNAILER_H
+#define QMEDIATHUMBNAILER_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qsize.h>
+#include <QtCore/qurl.h>
+#include <QtGui/qimage.h>
+#include <QtMultimedia/qtmultimediaglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QMediaThumbnailerPrivate;
+class Q_MULTIMEDIA_EXPORT QMediaThumbnailer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int pendingCount READ pendingCount)
+    Q_PROPERTY(int maximumWorkerCount READ maximumWorkerCount WRITE setMaximumWorkerCount)
+public:
+    explicit QMediaThumbnailer(QObject *parent = nullptr);
+    ~QMediaThumbnailer();
+
+    bool isAvailable() const;
+
+    int pendingCount() const;
+
+    int maximumWorkerCount() const;
+    void setMaximumWorkerCount(int count);
+
+    Q_INVOKABLE int requestThumbnail(const QUrl &url, qint64 position, const QSize &size = QSize());
+
+public Q_SLOTS:
+    void cancel();
+
+Q_SIGNALS:
+    void thumbnailReady(int id, const QImage &image);
+    void error(int id, const QString &errorString);
+    void finished();
+
+private:
+    Q_DISABLE_COPY(QMediaThumbnailer)
+    QMediaThumbnailerPrivate *d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMEDIATHUMBNAILER_H
@@ -101,10 +101,20 @@ protected:
         return url;
     }
 
-    void newItemFound(const QVariant& content) { Q_EMIT m_parent->newItem(content); }
+    void newItemFound(const QVariant& content) { m_items.append(content); }
+
+public:
+    // Items found since the last call, they are reported in batches
+    QVariantList takeItems()
+    {
+        QVariantList items;
+        items.swap(m_items);
+        return items;
+    }
 
 private:
     QPlaylistFileParser *m_parent;
+    QVariantList m_items;
     bool m_aborted;
 };
 
@@ -279,6 +289,8 @@ public:
         , m_lineIndex(-1)
         , m_utf8(false)
         , m_aborted(false)
+        , m_streamFinished(false)
+        , m_handlingData(false)
     {
     }
 
@@ -286,6 +298,9 @@ public:
     void handleParserFinished();
     void abort();
     void reset();
+    void flushItems();
+    bool isSourceFinished() const;
+    bool isBusy() const;
 
     QScopedPointer<QNetworkReply, QScopedPointerDeleteLater> m_source;
     QScopedPointer<ParserBase> m_currentParser;
@@ -308,13 +323,18 @@ public:
     int m_lineIndex;
     bool m_utf8;
     bool m_aborted;
+    bool m_streamFinished;
+    bool m_handlingData;
 
 private:
+    bool parseData();
     bool processLine(int startIndex, int length);
 };
 
 #define LINE_LIMIT  4096
-#define READ_LIMIT  64
+#define READ_LIMIT  65536
+// Huge playlists are parsed in slices, so that the event loop keeps running
+#define SLICE_LIMIT (4 * READ_LIMIT)
 
 bool QPlaylistFileParserPrivate::processLine(int startIndex, int length)
 {
@@ -324,7 +344,7 @@ bool QPlaylistFileParserPrivate::processLine(int startIndex, int length)
     if (!m_currentParser) {
         const QString urlString = m_root.toString();
         const QString &suffix = !urlString.isEmpty() ? QFileInfo(urlString).suffix() : urlString;
-        const QString &mimeType = m_source->header(QNetworkRequest::ContentTypeHeader).toString();
+        const QString &mimeType = m_source ? m_source->header(QNetworkRequest::ContentTypeHeader).toString() : QString();
         m_type = QPlaylistFileParser::findPlaylistType(suffix, !mimeType.isEmpty() ?  mimeType : m_mimeType, m_buffer.constData(), quint32(m_buffer.size()));
 
         switch (m_type) {
@@ -362,61 +382,110 @@ bool QPlaylistFileParserPrivate::processLine(int startIndex, int length)
     return m_currentParser->parseLine(m_lineIndex, line, m_root);
 }
 
+bool QPlaylistFileParserPrivate::isSourceFinished() const
+{
+    if (m_source) {
+        // Local file replies have all of their data available right away
+        return m_source->isFinished() || (m_root.isLocalFile() && !m_source->bytesAvailable());
+    }
+    if (!m_stream)
+        return false;
+    // Data of a sequential stream may still be on its way
+    return m_stream->isSequential() ? m_streamFinished && !m_stream->bytesAvailable()
+                                    : m_stream->atEnd();
+}
+
+void QPlaylistFileParserPrivate::flushItems()
+{
+    Q_Q(QPlaylistFileParser);
+    if (m_aborted || !m_currentParser)
+        return;
+
+    const QVariantList items = m_currentParser->takeItems();
+    if (!items.isEmpty())
+        emit q->newItems(items);
+}
+
 void QPlaylistFileParserPrivate::handleData()
+{
+    QIODevice *device = m_source ? m_source.data() : m_stream;
+    if (!device || m_aborted || m_handlingData)
+        return;
+
+    m_handlingData = true;
+    const bool finished = parseData();
+    m_handlingData = false;
+
+    // Every way out of parsing, including the aborted ones, releases the
+    // source and starts a pending job
+    if (finished || m_aborted)
+        handleParserFinished();
+}
+
+// Returns true once all of the input has been parsed
+bool QPlaylistFileParserPrivate::parseData()
 {
     Q_Q(QPlaylistFileParser);
-    while (m_source->bytesAvailable() && !m_aborted) {
-        int expectedBytes = qMin(READ_LIMIT, int(qMin(m_source->bytesAvailable(),
-                                                      qint64(LINE_LIMIT - m_buffer.size()))));
-        m_buffer.push_back(m_source->read(expectedBytes));
-        int processedBytes = 0;
-        while (m_scanIndex < m_buffer.length() && !m_aborted) {
-            char s = m_buffer[m_scanIndex];
-            if (s == '\r' || s == '\n') {
-                int l = m_scanIndex - processedBytes;
-                if (l > 0) {
-                    if (!processLine(processedBytes, l))
-                        break;
-                }
-                processedBytes = m_scanIndex + 1;
-                if (!m_source) {
-                    //some error happened, so exit parsing
-                    return;
-                }
-            }
-            m_scanIndex++;
-        }
+    QIODevice *device = m_source ? m_source.data() : m_stream;
 
-        if (m_aborted)
+    qint64 sliceBytes = 0;
+    while (!m_aborted && sliceBytes < SLICE_LIMIT) {
+        const qint64 available = device->bytesAvailable();
+        if (available <= 0)
             break;
 
-        if (m_buffer.length() - processedBytes >= LINE_LIMIT) {
-            emit q->error(QPlaylistFileParser::FormatError, QPlaylistFileParser::tr("invalid line in playlist file"));
-            q->abort();
+        const int bufferSize = m_buffer.size();
+        m_buffer.resize(bufferSize + int(qMin(available, qint64(READ_LIMIT))));
+        const qint64 read = device->read(m_buffer.data() + bufferSize, m_buffer.size() - bufferSize);
+        m_buffer.resize(bufferSize + int(qMax(read, qint64(0))));
+        if (read <= 0)
             break;
+        sliceBytes += read;
+
+        // Lines are parsed in place, only the incomplete last line is kept
+        const char *data = m_buffer.constData();
+        const int size = m_buffer.size();
+        int lineStart = 0;
+        for (int i = m_scanIndex; i < size && !m_aborted; ++i) {
+            if (data[i] != '\r' && data[i] != '\n')
+                continue;
+
+            if (i > lineStart && !processLine(lineStart, i - lineStart))
+                break;
+            lineStart = i + 1;
         }
 
-        if (m_source->isFinished() && !m_source->bytesAvailable()) {
-            //last line
-            processLine(processedBytes, -1);
-            break;
-        }
+        if (m_aborted)
+            return false;
 
-        Q_ASSERT(m_buffer.length() == m_scanIndex);
-        if (processedBytes == 0)
-            continue;
+        if (lineStart > 0)
+            m_buffer.remove(0, lineStart);
+        m_scanIndex = m_buffer.size();
 
-        int copyLength = m_buffer.length() - processedBytes;
-        if (copyLength > 0) {
-            Q_ASSERT(copyLength <= READ_LIMIT);
-            m_buffer = m_buffer.right(copyLength);
-        } else {
-            m_buffer.clear();
+        if (m_buffer.size() >= LINE_LIMIT) {
+            emit q->error(QPlaylistFileParser::FormatError, QPlaylistFileParser::tr("invalid line in playlist file"));
+            q->abort();
+            return false;
         }
-        m_scanIndex = 0;
     }
 
-    handleParserFinished();
+    if (m_aborted)
+        return false;
+
+    if (isSourceFinished() && !device->bytesAvailable()) {
+        //last line
+        if (!m_buffer.isEmpty())
+            processLine(0, m_buffer.size());
+        flushItems();
+        return true;
+    }
+
+    flushItems();
+
+    // Let the event loop run before parsing the rest
+    if (sliceBytes >= SLICE_LIMIT)
+        QMetaObject::invokeMethod(q, "handleData", Qt::QueuedConnection);
+    return false;
 }
 
 QPlaylistFileParser::QPlaylistFileParser(QObject *parent)
@@ -517,16 +586,19 @@ void QPlaylistFileParser::start(QIODevice *stream, const QString &mimeType)
         return;
     }
 
-    if (!d->m_currentParser.isNull()) {
+    if (d->isBusy()) {
         abort();
         d->m_pendingJob = { stream, QUrl(), mimeType };
+        if (!d->m_handlingData)
+            d->handleParserFinished();
         return;
     }
 
     d->reset();
     d->m_mimeType = mimeType;
     d->m_stream = stream;
-    connect(d->m_stream, SIGNAL(readyRead()), this, SLOT(_q_handleData()));
+    connect(d->m_stream, SIGNAL(readyRead()), this, SLOT(handleData()));
+    connect(d->m_stream, SIGNAL(readChannelFinished()), this, SLOT(handleStreamFinished()));
     d->handleData();
 }
 
@@ -540,9 +612,11 @@ void QPlaylistFileParser::start(const QNetworkRequest& request, const QString &m
         return;
     }
 
-    if (!d->m_currentParser.isNull()) {
+    if (d->isBusy()) {
         abort();
         d->m_pendingJob = { nullptr, request, mimeType };
+        if (!d->m_handlingData)
+            d->handleParserFinished();
         return;
     }
 
@@ -566,8 +640,10 @@ void QPlaylistFileParser::abort()
     if (d->m_source)
         d->m_source->disconnect();
 
-    if (d->m_stream)
+    if (d->m_stream) {
         disconnect(d->m_stream, SIGNAL(readyRead()), this, SLOT(handleData()));
+        disconnect(d->m_stream, SIGNAL(readChannelFinished()), this, SLOT(handleStreamFinished()));
+    }
 }
 
 void QPlaylistFileParser::handleData()
@@ -576,26 +652,42 @@ void QPlaylistFileParser::handleData()
     d->handleData();
 }
 
+void QPlaylistFileParser::handleStreamFinished()
+{
+    Q_D(QPlaylistFileParser);
+    d->m_streamFinished = true;
+    d->handleData();
+}
+
 void QPlaylistFileParserPrivate::handleParserFinished()
 {
     Q_Q(QPlaylistFileParser);
     const bool isParserValid = !m_currentParser.isNull();
+    m_currentParser.reset();
+
     if (!isParserValid && !m_aborted)
         emit q->error(QPlaylistFileParser::FormatNotSupportedError, QPlaylistFileParser::tr("Empty file provided"));
 
-    if (isParserValid && !m_aborted) {
-        m_currentParser.reset();
+    if (isParserValid && !m_aborted)
         emit q->finished();
-    }
 
     if (!m_aborted)
         q->abort();
 
     if (!m_source.isNull())
         m_source.reset();
+    m_stream = nullptr;
+
+    if (m_pendingJob.isValid()) {
+        const ParserJob job = m_pendingJob;
+        m_pendingJob.reset();
+        q->start(job.m_media, job.m_stream, job.m_mimeType);
+    }
+}
 
-    if (m_pendingJob.isValid())
-        q->start(m_pendingJob.m_media, m_pendingJob.m_stream, m_pendingJob.m_mimeType);
+bool QPlaylistFileParserPrivate::isBusy() const
+{
+    return !m_currentParser.isNull() || !m_source.isNull() || m_stream;
 }
 
 void QPlaylistFileParserPrivate::abort()
@@ -618,6 +710,7 @@ void QPlaylistFileParserPrivate::reset()
     m_lineIndex = -1;
     m_utf8 = false;
     m_aborted = false;
+    m_streamFinished = false;
     m_pendingJob.reset();
 }
 
@@ -627,6 +720,8 @@ void QPlaylistFileParser::handleError()
     const QString &errorString = d->m_source->errorString();
     Q_EMIT error(QPlaylistFileParser::NetworkError, errorString);
     abort();
+    if (!d->m_handlingData)
+        d->handleParserFinished();
 }
 
 QT_END_NAMESPACE
@@ -53,6 +53,7 @@
 
 #include "qtmultimediaglobal.h"
 #include <QtCore/qobject.h>
+#include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -91,12 +92,13 @@ public:
     void abort();
 
 Q_SIGNALS:
-    void newItem(const QVariant& content);
+    void newItems(const QVariantList &items);
     void finished();
     void error(QPlaylistFileParser::ParserError err, const QString& errorMsg);
 
 private Q_SLOTS:
     void handleData();
+    void handleStreamFinished();
     void handleError();
 
 private:
@@ -83,18 +83,11 @@ QObject* QMediaPluginLoader::instance(QString const &key)
 
 QList<QObject*> QMediaPluginLoader::instances(QString const &key)
 {
-    if (!m_metadata.contains(key))
-        return QList<QObject*>();
-
-    QList<QString> keys;
+    QStringList keys;
     QList<QObject *> objects;
-    const auto list = m_metadata.value(key);
+    const auto list = metaData(key);
     for (const QJsonObject &jsonobj : list) {
-        int idx = jsonobj.value(QStringLiteral("index")).toDouble();
-        if (idx < 0)
-            continue;
-
-        QObject *object = m_factoryLoader->instance(idx);
+        QObject *object = instance(jsonobj);
         if (!objects.contains(object)) {
             QJsonArray arr = jsonobj.value(QStringLiteral("Keys")).toArray();
             keys.append(!arr.isEmpty() ? arr.at(0).toString() : QStringLiteral(""));
@@ -102,6 +95,33 @@ QList<QObject*> QMediaPluginLoader::instances(QString const &key)
         }
     }
 
+    static const bool showDebug = qEnvironmentVariableIntValue("QT_DEBUG_PLUGINS");
+    if (showDebug)
+        qDebug() << "QMediaPluginLoader: loaded plugins for key" << key << ":" << keys;
+
+    return objects;
+}
+
+/*
+    Returns the metadata of the plugins providing \a key, one entry per
+    plugin, in the order they should be tried. Nothing is loaded, so
+    callers can pick a plugin from its metadata and only instantiate that
+    one with instance().
+*/
+QList<QJsonObject> QMediaPluginLoader::metaData(QString const &key) const
+{
+    QList<QJsonObject> list;
+    QStringList keys;
+    const auto entries = m_metadata.value(key);
+    for (const QJsonObject &jsonobj : entries) {
+        if (jsonobj.value(QStringLiteral("index")).toInt(-1) < 0 || list.contains(jsonobj))
+            continue;
+
+        const QJsonArray arr = jsonobj.value(QStringLiteral("Keys")).toArray();
+        keys.append(!arr.isEmpty() ? arr.at(0).toString() : QStringLiteral(""));
+        list.append(jsonobj);
+    }
+
     static const bool showDebug = qEnvironmentVariableIntValue("QT_DEBUG_PLUGINS");
     static const QStringList preferredPlugins =
         qEnvironmentVariable("QT_MULTIMEDIA_PREFERRED_PLUGINS").split(QLatin1Char(','), Qt::SkipEmptyParts);
@@ -112,24 +132,26 @@ QList<QObject*> QMediaPluginLoader::instances(QString const &key)
             if (!keys[j].startsWith(name))
                 continue;
 
-            auto obj = objects[j];
-            objects.removeAt(j);
-            objects.prepend(obj);
-            auto k = keys[j];
-            keys.removeAt(j);
-            keys.prepend(k);
+            list.move(j, 0);
+            keys.move(j, 0);
             found = true;
             break;
         }
 
         if (showDebug && !found)
-            qWarning() << "QMediaPluginLoader: pattern" << name << "did not match any loaded plugin";
+            qWarning() << "QMediaPluginLoader: pattern" << name << "did not match any plugin";
     }
 
-    if (showDebug)
-        qDebug() << "QMediaPluginLoader: loaded plugins for key" << key << ":" << keys;
+    return list;
+}
 
-    return objects;
+QObject* QMediaPluginLoader::instance(const QJsonObject &metaData)
+{
+    int idx = metaData.value(QStringLiteral("index")).toInt(-1);
+    if (idx < 0)
+        return nullptr;
+
+    return m_factoryLoader->instance(idx);
 }
 
 void QMediaPluginLoader::loadMetadata()
@@ -76,6 +76,9 @@ public:
     QObject* instance(QString const &key);
     QList<QObject*> instances(QString const &key);
 
+    QList<QJsonObject> metaData(QString const &key) const;
+    QObject* instance(const QJsonObject &metaData);
+
 private:
     void loadMetadata();
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qjsonarray.h>
 #include <QtCore/qmap.h>
 
 #include "qmediaservice.h"
@@ -304,6 +305,45 @@ Q_GLOBAL_STATIC_WITH_ARGS(QMediaPluginLoader, loader,
         (QMediaServiceProviderFactoryInterface_iid, QLatin1String("mediaservice"), Qt::CaseInsensitive))
 
 
+/*
+    Plugins can describe themselves in their JSON metadata, next to
+    "Services", so that a provider can be picked without loading them:
+
+    "Features":  { "<service>": ["LowLatencyPlayback", "RecordingSupport",
+                                  "StreamPlayback", "VideoSurface"] }
+    "Devices":   { "<service>": ["<device>", ...] }
+    "MimeTypes": ["<mime type>", ...]
+
+    Whatever is not declared is asked from the loaded plugin, as before.
+*/
+static bool metaDataFeatures(const QJsonObject &metaData, const QByteArray &serviceType,
+                             QMediaServiceProviderHint::Features *features)
+{
+    const QJsonValue declared = metaData.value(QStringLiteral("Features"));
+    if (!declared.isObject())
+        return false;
+
+    static const struct {
+        const char *name;
+        QMediaServiceProviderHint::Feature feature;
+    } names[] = {
+        { "LowLatencyPlayback", QMediaServiceProviderHint::LowLatencyPlayback },
+        { "RecordingSupport", QMediaServiceProviderHint::RecordingSupport },
+        { "StreamPlayback", QMediaServiceProviderHint::StreamPlayback },
+        { "VideoSurface", QMediaServiceProviderHint::VideoSurface }
+    };
+
+    *features = QMediaServiceProviderHint::Features();
+    const QJsonArray list = declared.toObject().value(QLatin1String(serviceType)).toArray();
+    for (const QJsonValue &value : list) {
+        for (const auto &name : names) {
+            if (value.toString() == QLatin1String(name.name))
+                *features |= name.feature;
+        }
+    }
+    return true;
+}
+
 class QPluginServiceProvider : public QMediaServiceProvider
 {
     struct MediaServiceData {
@@ -315,126 +355,195 @@ class QPluginServiceProvider : public QMediaServiceProvider
 
     QMap<const QMediaService*, MediaServiceData> mediaServiceData;
 
+    // Returns false if the features are neither declared nor reported by the plugin.
+    static bool pluginFeatures(const QJsonObject &metaData, const QByteArray &serviceType,
+                               QMediaServiceProviderHint::Features *features)
+    {
+        if (metaDataFeatures(metaData, serviceType, features))
+            return true;
+
+        QMediaServiceFeaturesInterface *iface =
+                qobject_cast<QMediaServiceFeaturesInterface*>(loader()->instance(metaData));
+        if (!iface)
+            return false;
+
+        *features = iface->supportedFeatures(serviceType);
+        return true;
+    }
+
+    static QList<QByteArray> pluginDevices(const QJsonObject &metaData, const QByteArray &serviceType)
+    {
+        const QJsonValue declared = metaData.value(QStringLiteral("Devices"));
+        if (declared.isObject()) {
+            QList<QByteArray> devices;
+            const QJsonArray list = declared.toObject().value(QLatin1String(serviceType)).toArray();
+            for (const QJsonValue &value : list)
+                devices.append(value.toString().toUtf8());
+            return devices;
+        }
+
+        QMediaServiceSupportedDevicesInterface *iface =
+                qobject_cast<QMediaServiceSupportedDevicesInterface*>(loader()->instance(metaData));
+        return iface ? iface->devices(serviceType) : QList<QByteArray>();
+    }
+
+    // Returns false if the MIME types are neither declared nor reported by the plugin.
+    static bool pluginSupport(const QJsonObject &metaData, const QString &mimeType,
+                              const QStringList &codecs, QMultimedia::SupportEstimate *estimate)
+    {
+        const QJsonValue declared = metaData.value(QStringLiteral("MimeTypes"));
+        if (declared.isArray()) {
+            *estimate = declared.toArray().contains(mimeType)
+                    ? QMultimedia::ProbablySupported
+                    : QMultimedia::NotSupported;
+            return true;
+        }
+
+        QMediaServiceSupportedFormatsInterface *iface =
+                qobject_cast<QMediaServiceSupportedFormatsInterface*>(loader()->instance(metaData));
+        if (!iface)
+            return false;
+
+        *estimate = iface->hasSupport(mimeType, codecs);
+        return true;
+    }
+
+    // Skips plugins which do not provide what the QMediaPlayer flags ask for.
+    static bool matchesPlayerFlags(const QJsonObject &metaData, const QByteArray &serviceType, int flags)
+    {
+        QMediaServiceProviderHint::Features features;
+        if (!flags || !pluginFeatures(metaData, serviceType, &features))
+            return true;
+
+        if ((flags & QMediaPlayer::LowLatency) &&
+            !(features & QMediaServiceProviderHint::LowLatencyPlayback))
+            return false;
+
+        if ((flags & QMediaPlayer::StreamPlayback) &&
+            !(features & QMediaServiceProviderHint::StreamPlayback))
+            return false;
+
+        if ((flags & QMediaPlayer::VideoSurface) &&
+            !(features & QMediaServiceProviderHint::VideoSurface))
+            return false;
+
+        return true;
+    }
+
+    static QMediaServiceProviderPlugin *providerPlugin(const QJsonObject &metaData)
+    {
+        return qobject_cast<QMediaServiceProviderPlugin*>(loader()->instance(metaData));
+    }
+
 public:
     QMediaService* requestService(const QByteArray &type, const QMediaServiceProviderHint &hint) override
     {
         QString key(QLatin1String(type.constData()));
 
-        QList<QMediaServiceProviderPlugin *>plugins;
-        const auto instances = loader()->instances(key);
-        for (QObject *obj : instances) {
-            QMediaServiceProviderPlugin *plugin =
-                qobject_cast<QMediaServiceProviderPlugin*>(obj);
-            if (plugin)
-                plugins << plugin;
-        }
-
-        if (!plugins.isEmpty()) {
-            QMediaServiceProviderPlugin *plugin = nullptr;
-
-            switch (hint.type()) {
-            case QMediaServiceProviderHint::Null:
-                plugin = plugins[0];
-                //special case for media player, if low latency was not asked,
-                //prefer services not offering it, since they are likely to support
-                //more formats
-                if (type == QByteArray(Q_MEDIASERVICE_MEDIAPLAYER)) {
-                    for (QMediaServiceProviderPlugin *currentPlugin : qAsConst(plugins)) {
-                        QMediaServiceFeaturesInterface *iface =
-                                qobject_cast<QMediaServiceFeaturesInterface*>(currentPlugin);
-
-                        if (!iface || !(iface->supportedFeatures(type) &
-                                        QMediaServiceProviderHint::LowLatencyPlayback)) {
-                            plugin = currentPlugin;
+        // The candidates are ranked by their metadata, and a plugin is only
+        // loaded when the metadata cannot answer for it or once it is picked.
+        const QList<QJsonObject> candidates = loader()->metaData(key);
+        QMediaServiceProviderPlugin *plugin = nullptr;
+        bool fallbackToFirst = true;
+
+        switch (hint.type()) {
+        case QMediaServiceProviderHint::Null:
+            //special case for media player, if low latency was not asked,
+            //prefer services not offering it, since they are likely to support
+            //more formats
+            if (type == QByteArray(Q_MEDIASERVICE_MEDIAPLAYER)) {
+                for (const QJsonObject &candidate : candidates) {
+                    QMediaServiceProviderHint::Features features;
+                    if (!pluginFeatures(candidate, type, &features)
+                            || !(features & QMediaServiceProviderHint::LowLatencyPlayback)) {
+                        if ((plugin = providerPlugin(candidate)))
                             break;
-                        }
-
                     }
                 }
-                break;
-            case QMediaServiceProviderHint::SupportedFeatures:
-                plugin = plugins[0];
-                for (QMediaServiceProviderPlugin *currentPlugin : qAsConst(plugins)) {
-                    QMediaServiceFeaturesInterface *iface =
-                            qobject_cast<QMediaServiceFeaturesInterface*>(currentPlugin);
-
-                    if (iface) {
-                        if ((iface->supportedFeatures(type) & hint.features()) == hint.features()) {
-                            plugin = currentPlugin;
-                            break;
-                        }
-                    }
+            }
+            break;
+        case QMediaServiceProviderHint::SupportedFeatures:
+            for (const QJsonObject &candidate : candidates) {
+                QMediaServiceProviderHint::Features features;
+                if (pluginFeatures(candidate, type, &features)
+                        && (features & hint.features()) == hint.features()) {
+                    if ((plugin = providerPlugin(candidate)))
+                        break;
                 }
-                break;
-            case QMediaServiceProviderHint::Device: {
-                    plugin = plugins[0];
-                    for (QMediaServiceProviderPlugin *currentPlugin : qAsConst(plugins)) {
-                        QMediaServiceSupportedDevicesInterface *iface =
-                                qobject_cast<QMediaServiceSupportedDevicesInterface*>(currentPlugin);
-
-                        if (iface && iface->devices(type).contains(hint.device())) {
-                            plugin = currentPlugin;
-                            break;
-                        }
-                    }
+            }
+            break;
+        case QMediaServiceProviderHint::Device:
+            for (const QJsonObject &candidate : candidates) {
+                if (pluginDevices(candidate, type).contains(hint.device())) {
+                    if ((plugin = providerPlugin(candidate)))
+                        break;
                 }
-                break;
-            case QMediaServiceProviderHint::CameraPosition: {
-                    plugin = plugins[0];
-                    if (type == QByteArray(Q_MEDIASERVICE_CAMERA)
-                            && hint.cameraPosition() != QCamera::UnspecifiedPosition) {
-                        for (QMediaServiceProviderPlugin *currentPlugin : qAsConst(plugins)) {
-                            const QMediaServiceSupportedDevicesInterface *deviceIface =
-                                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(currentPlugin);
-                            const QMediaServiceCameraInfoInterface *cameraIface =
-                                    qobject_cast<QMediaServiceCameraInfoInterface*>(currentPlugin);
-
-                            if (deviceIface && cameraIface) {
-                                const QList<QByteArray> cameras = deviceIface->devices(type);
-                                for (const QByteArray &camera : cameras) {
-                                    if (cameraIface->cameraPosition(camera) == hint.cameraPosition()) {
-                                        plugin = currentPlugin;
-                                        break;
-                                    }
-                                }
+            }
+            break;
+        case QMediaServiceProviderHint::CameraPosition:
+            if (type == QByteArray(Q_MEDIASERVICE_CAMERA)
+                    && hint.cameraPosition() != QCamera::UnspecifiedPosition) {
+                for (const QJsonObject &candidate : candidates) {
+                    QObject *object = loader()->instance(candidate);
+                    const QMediaServiceSupportedDevicesInterface *deviceIface =
+                            qobject_cast<QMediaServiceSupportedDevicesInterface*>(object);
+                    const QMediaServiceCameraInfoInterface *cameraIface =
+                            qobject_cast<QMediaServiceCameraInfoInterface*>(object);
+
+                    if (deviceIface && cameraIface) {
+                        const QList<QByteArray> cameras = deviceIface->devices(type);
+                        for (const QByteArray &camera : cameras) {
+                            if (cameraIface->cameraPosition(camera) == hint.cameraPosition()) {
+                                plugin = qobject_cast<QMediaServiceProviderPlugin*>(object);
+                                break;
                             }
                         }
                     }
+                    if (plugin)
+                        break;
                 }
-                break;
-            case QMediaServiceProviderHint::ContentType: {
-                    QMultimedia::SupportEstimate estimate = QMultimedia::NotSupported;
-                    for (QMediaServiceProviderPlugin *currentPlugin : qAsConst(plugins)) {
-                        QMultimedia::SupportEstimate currentEstimate = QMultimedia::MaybeSupported;
-                        QMediaServiceSupportedFormatsInterface *iface =
-                                qobject_cast<QMediaServiceSupportedFormatsInterface*>(currentPlugin);
-
-                        if (iface)
-                            currentEstimate = iface->hasSupport(hint.mimeType(), hint.codecs());
-
-                        if (currentEstimate > estimate) {
-                            estimate = currentEstimate;
-                            plugin = currentPlugin;
-
-                            if (currentEstimate == QMultimedia::PreferredService)
-                                break;
-                        }
+            }
+            break;
+        case QMediaServiceProviderHint::ContentType: {
+                fallbackToFirst = false;
+                QMultimedia::SupportEstimate estimate = QMultimedia::NotSupported;
+                for (const QJsonObject &candidate : candidates) {
+                    QMultimedia::SupportEstimate currentEstimate = QMultimedia::MaybeSupported;
+                    pluginSupport(candidate, hint.mimeType(), hint.codecs(), &currentEstimate);
+
+                    if (currentEstimate > estimate) {
+                        QMediaServiceProviderPlugin *currentPlugin = providerPlugin(candidate);
+                        if (!currentPlugin)
+                            continue;
+
+                        estimate = currentEstimate;
+                        plugin = currentPlugin;
+
+                        if (currentEstimate == QMultimedia::PreferredService)
+                            break;
                     }
                 }
-                break;
             }
+            break;
+        }
 
-            if (plugin != nullptr) {
-                QMediaService *service = plugin->create(key);
-                if (service != nullptr) {
-                    MediaServiceData d;
-                    d.type = type;
-                    d.plugin = plugin;
-                    mediaServiceData.insert(service, d);
-                }
+        if (!plugin && fallbackToFirst) {
+            for (const QJsonObject &candidate : candidates) {
+                if ((plugin = providerPlugin(candidate)))
+                    break;
+            }
+        }
 
-                return service;
+        if (plugin != nullptr) {
+            QMediaService *service = plugin->create(key);
+            if (service != nullptr) {
+                MediaServiceData d;
+                d.type = type;
+                d.plugin = plugin;
+                mediaServiceData.insert(service, d);
             }
+
+            return service;
         }
 
         qWarning() << "defaultServiceProvider::requestService(): no service found for -" << key;
@@ -473,41 +582,24 @@ public:
                                      const QStringList& codecs,
                                      int flags) const override
     {
-        const QList<QObject*> instances = loader()->instances(QLatin1String(serviceType));
+        const QList<QJsonObject> candidates = loader()->metaData(QLatin1String(serviceType));
 
-        if (instances.isEmpty())
+        if (candidates.isEmpty())
             return QMultimedia::NotSupported;
 
         bool allServicesProvideInterface = true;
         QMultimedia::SupportEstimate supportEstimate = QMultimedia::NotSupported;
 
-        for (QObject *obj : instances) {
-            QMediaServiceSupportedFormatsInterface *iface =
-                    qobject_cast<QMediaServiceSupportedFormatsInterface*>(obj);
-
+        for (const QJsonObject &candidate : candidates) {
+            //if low latency playback or QIODevice based streams were asked,
+            //skip services known not to provide them
+            if (!matchesPlayerFlags(candidate, serviceType,
+                                    flags & (QMediaPlayer::LowLatency | QMediaPlayer::StreamPlayback)))
+                continue;
 
-            if (flags) {
-                QMediaServiceFeaturesInterface *iface =
-                        qobject_cast<QMediaServiceFeaturesInterface*>(obj);
-
-                if (iface) {
-                    QMediaServiceProviderHint::Features features = iface->supportedFeatures(serviceType);
-
-                    //if low latency playback was asked, skip services known
-                    //not to provide low latency playback
-                    if ((flags & QMediaPlayer::LowLatency) &&
-                        !(features & QMediaServiceProviderHint::LowLatencyPlayback))
-                            continue;
-
-                    //the same for QIODevice based streams support
-                    if ((flags & QMediaPlayer::StreamPlayback) &&
-                        !(features & QMediaServiceProviderHint::StreamPlayback))
-                            continue;
-                }
-            }
-
-            if (iface)
-                supportEstimate = qMax(supportEstimate, iface->hasSupport(mimeType, codecs));
+            QMultimedia::SupportEstimate estimate;
+            if (pluginSupport(candidate, mimeType, codecs, &estimate))
+                supportEstimate = qMax(supportEstimate, estimate);
             else
                 allServicesProvideInterface = false;
         }
@@ -525,43 +617,28 @@ public:
 
     QStringList supportedMimeTypes(const QByteArray &serviceType, int flags) const override
     {
-        const QList<QObject*> instances = loader()->instances(QLatin1String(serviceType));
+        const QList<QJsonObject> candidates = loader()->metaData(QLatin1String(serviceType));
 
         QStringList supportedTypes;
 
-        for (QObject *obj : instances) {
-            QMediaServiceSupportedFormatsInterface *iface =
-                    qobject_cast<QMediaServiceSupportedFormatsInterface*>(obj);
-
-
-            if (flags) {
-                QMediaServiceFeaturesInterface *iface =
-                        qobject_cast<QMediaServiceFeaturesInterface*>(obj);
-
-                if (iface) {
-                    QMediaServiceProviderHint::Features features = iface->supportedFeatures(serviceType);
-
-                    // If low latency playback was asked for, skip MIME types from services known
-                    // not to provide low latency playback
-                    if ((flags & QMediaPlayer::LowLatency) &&
-                        !(features & QMediaServiceProviderHint::LowLatencyPlayback))
-                        continue;
-
-                    //the same for QIODevice based streams support
-                    if ((flags & QMediaPlayer::StreamPlayback) &&
-                        !(features & QMediaServiceProviderHint::StreamPlayback))
-                            continue;
-
-                    //the same for QAbstractVideoSurface support
-                    if ((flags & QMediaPlayer::VideoSurface) &&
-                        !(features & QMediaServiceProviderHint::VideoSurface))
-                            continue;
-                }
+        for (const QJsonObject &candidate : candidates) {
+            // If low latency playback, QIODevice based streams or QAbstractVideoSurface
+            // support were asked for, skip MIME types from services known not to provide them
+            if (!matchesPlayerFlags(candidate, serviceType, flags))
+                continue;
+
+            const QJsonValue declared = candidate.value(QStringLiteral("MimeTypes"));
+            if (declared.isArray()) {
+                const QJsonArray list = declared.toArray();
+                for (const QJsonValue &value : list)
+                    supportedTypes << value.toString();
+                continue;
             }
 
-            if (iface) {
+            QMediaServiceSupportedFormatsInterface *iface =
+                    qobject_cast<QMediaServiceSupportedFormatsInterface*>(loader()->instance(candidate));
+            if (iface)
                 supportedTypes << iface->supportedMimeTypes();
-            }
         }
 
         // Multiple services may support the same MIME type
@@ -572,10 +649,17 @@ public:
 
     QByteArray defaultDevice(const QByteArray &serviceType) const override
     {
-        const auto instances = loader()->instances(QLatin1String(serviceType));
-        for (QObject *obj : instances) {
+        const auto candidates = loader()->metaData(QLatin1String(serviceType));
+        for (const QJsonObject &candidate : candidates) {
+            // A plugin declaring its devices lists the default one first
+            const QList<QByteArray> declared = candidate.contains(QStringLiteral("Devices"))
+                    ? pluginDevices(candidate, serviceType)
+                    : QList<QByteArray>();
+            if (!declared.isEmpty())
+                return declared.first();
+
             const QMediaServiceDefaultDeviceInterface *iface =
-                    qobject_cast<QMediaServiceDefaultDeviceInterface*>(obj);
+                    qobject_cast<QMediaServiceDefaultDeviceInterface*>(loader()->instance(candidate));
 
             if (iface) {
                 QByteArray name = iface->defaultDevice(serviceType);
@@ -597,30 +681,25 @@ public:
     {
         QList<QByteArray> res;
 
-        const auto instances = loader()->instances(QLatin1String(serviceType));
-        for (QObject *obj : instances) {
-            QMediaServiceSupportedDevicesInterface *iface =
-                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(obj);
-
-            if (iface) {
-                res.append(iface->devices(serviceType));
-            }
-        }
+        const auto candidates = loader()->metaData(QLatin1String(serviceType));
+        for (const QJsonObject &candidate : candidates)
+            res.append(pluginDevices(candidate, serviceType));
 
         return res;
     }
 
     QString deviceDescription(const QByteArray &serviceType, const QByteArray &device) override
     {
-        const auto instances = loader()->instances(QLatin1String(serviceType));
-        for (QObject *obj : instances) {
+        const auto candidates = loader()->metaData(QLatin1String(serviceType));
+        for (const QJsonObject &candidate : candidates) {
+            if (!pluginDevices(candidate, serviceType).contains(device))
+                continue;
+
             QMediaServiceSupportedDevicesInterface *iface =
-                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(obj);
+                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(loader()->instance(candidate));
 
-            if (iface) {
-                if (iface->devices(serviceType).contains(device))
-                    return iface->deviceDescription(serviceType, device);
-            }
+            if (iface)
+                return iface->deviceDescription(serviceType, device);
         }
 
         return QString();
@@ -629,12 +708,17 @@ public:
     QCamera::Position cameraPosition(const QByteArray &device) const override
     {
         const QByteArray serviceType(Q_MEDIASERVICE_CAMERA);
-        const auto instances = loader()->instances(QString::fromLatin1(serviceType));
-        for (QObject *obj : instances) {
+        const auto candidates = loader()->metaData(QString::fromLatin1(serviceType));
+        for (const QJsonObject &candidate : candidates) {
+            if (candidate.contains(QStringLiteral("Devices"))
+                    && !pluginDevices(candidate, serviceType).contains(device))
+                continue;
+
+            QObject *object = loader()->instance(candidate);
             const QMediaServiceSupportedDevicesInterface *deviceIface =
-                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(obj);
+                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(object);
             const QMediaServiceCameraInfoInterface *cameraIface =
-                    qobject_cast<QMediaServiceCameraInfoInterface*>(obj);
+                    qobject_cast<QMediaServiceCameraInfoInterface*>(object);
 
             if (cameraIface) {
                 if (deviceIface && !deviceIface->devices(serviceType).contains(device))
@@ -649,12 +733,17 @@ public:
     int cameraOrientation(const QByteArray &device) const override
     {
         const QByteArray serviceType(Q_MEDIASERVICE_CAMERA);
-        const auto instances = loader()->instances(QString::fromLatin1(serviceType));
-        for (QObject *obj : instances) {
+        const auto candidates = loader()->metaData(QString::fromLatin1(serviceType));
+        for (const QJsonObject &candidate : candidates) {
+            if (candidate.contains(QStringLiteral("Devices"))
+                    && !pluginDevices(candidate, serviceType).contains(device))
+                continue;
+
+            QObject *object = loader()->instance(candidate);
             const QMediaServiceSupportedDevicesInterface *deviceIface =
-                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(obj);
+                    qobject_cast<QMediaServiceSupportedDevicesInterface*>(object);
             const QMediaServiceCameraInfoInterface *cameraIface =
-                    qobject_cast<QMediaServiceCameraInfoInterface*>(obj);
+                    qobject_cast<QMediaServiceCameraInfoInterface*>(object);
 
             if (cameraIface) {
                 if (deviceIface && !deviceIface->devices(serviceType).contains(device))
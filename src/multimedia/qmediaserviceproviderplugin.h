@@ -250,6 +250,19 @@ public:
 */
 #define Q_MEDIASERVICE_AUDIODECODER "org.qt-project.qt.audiodecode"
 
+/*!
+    Service with support for reading the meta-data of media files without
+    playing them.
+    Required Controls: QMetaDataScannerControl
+*/
+#define Q_MEDIASERVICE_METADATASCANNER "org.qt-project.qt.metadatascanner"
+
+/*!
+    Service with support for extracting still frames from media files.
+    Required Controls: QMediaThumbnailerControl
+*/
+#define Q_MEDIASERVICE_THUMBNAILER "org.qt-project.qt.thumbnailer"
+
 QT_END_NAMESPACE
 
 #endif  // QMEDIASERVICEPROVIDERPLUGIN_H
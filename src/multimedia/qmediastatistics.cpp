@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmediastatistics_p.h"
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Upper bounds of the latency buckets in microseconds; the last bucket is
+// open ended.
+const int bucketBounds[QMediaStatistics::BucketCount] = {
+    100, 250, 500, 1000, 2000, 4000, 8000, 16000, 33000, 66000, 133000, 250000, 500000,
+    std::numeric_limits<int>::max()
+};
+
+const char * const counterNames[QMediaStatistics::CounterCount] = {
+    "decodedFrames",
+    "renderedFrames",
+    "droppedFrames",
+    "lateFrames",
+    "audioUnderruns",
+    "seeks",
+    "encodedFrames"
+};
+
+const char * const latencyNames[QMediaStatistics::LatencyCount] = {
+    "sinkToPresentLatency",
+    "presentToRenderLatency",
+    "seekLatency"
+};
+
+} // namespace
+
+/*
+    QMediaStatistics collects the performance counters reported by the
+    statistics controls of the media backends.
+
+    All updates are relaxed atomic operations, so the counters can be fed
+    from streaming and render threads without locking. A snapshot taken by
+    toMap() is therefore not guaranteed to be consistent across counters,
+    which is acceptable for monitoring.
+
+    Latencies are kept in fixed histograms with roughly logarithmic
+    buckets, from which toMap() derives approximate percentiles.
+*/
+
+QMediaStatistics::QMediaStatistics()
+{
+    reset();
+}
+
+int QMediaStatistics::bucketUpperBound(int bucket)
+{
+    return bucketBounds[bucket];
+}
+
+void QMediaStatistics::recordLatency(Latency latency, qint64 usecs)
+{
+    const int value = int(qBound<qint64>(0, usecs, std::numeric_limits<int>::max()));
+    Histogram &histogram = m_latencies[latency];
+
+    int bucket = 0;
+    while (value > bucketBounds[bucket])
+        ++bucket;
+    histogram.buckets[bucket].fetchAndAddRelaxed(1);
+    histogram.count.fetchAndAddRelaxed(1);
+
+    int max = histogram.max.loadRelaxed();
+    while (value > max && !histogram.max.testAndSetRelaxed(max, value, max)) {}
+}
+
+void QMediaStatistics::reset()
+{
+    for (QAtomicInt &counter : m_counters)
+        counter.storeRelaxed(0);
+    m_bufferFill.storeRelaxed(-1);
+    for (Histogram &histogram : m_latencies) {
+        for (QAtomicInt &bucket : histogram.buckets)
+            bucket.storeRelaxed(0);
+        histogram.count.storeRelaxed(0);
+        histogram.max.storeRelaxed(0);
+    }
+}
+
+QVariantMap QMediaStatistics::histogramToMap(const Histogram &histogram) const
+{
+    int counts[BucketCount];
+    int total = 0;
+    QVariantList buckets;
+    QVariantList bounds;
+    for (int i = 0; i < BucketCount; ++i) {
+        counts[i] = histogram.buckets[i].loadRelaxed();
+        total += counts[i];
+        buckets.append(counts[i]);
+        if (i < BucketCount - 1)
+            bounds.append(bucketBounds[i]);
+    }
+
+    const int max = histogram.max.loadRelaxed();
+    const auto percentile = [&](int percent) {
+        const qint64 rank = (qint64(total) * percent + 99) / 100;
+        qint64 seen = 0;
+        for (int i = 0; i < BucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank && seen > 0)
+                return qMin(bucketBounds[i], max);
+        }
+        return 0;
+    };
+
+    QVariantMap map;
+    map.insert(QStringLiteral("count"), total);
+    map.insert(QStringLiteral("max"), max);
+    map.insert(QStringLiteral("p50"), percentile(50));
+    map.insert(QStringLiteral("p95"), percentile(95));
+    map.insert(QStringLiteral("p99"), percentile(99));
+    map.insert(QStringLiteral("histogram"), buckets);
+    map.insert(QStringLiteral("bucketBounds"), bounds);
+    return map;
+}
+
+QVariantMap QMediaStatistics::toMap() const
+{
+    QVariantMap map;
+    for (int i = 0; i < CounterCount; ++i)
+        map.insert(QLatin1String(counterNames[i]), m_counters[i].loadRelaxed());
+
+    const int fill = m_bufferFill.loadRelaxed();
+    if (fill >= 0)
+        map.insert(QStringLiteral("bufferFill"), fill);
+
+    for (int i = 0; i < LatencyCount; ++i) {
+        if (m_latencies[i].count.loadRelaxed() > 0)
+            map.insert(QLatin1String(latencyNames[i]), histogramToMap(m_latencies[i]));
+    }
+    return map;
+}
+
+QT_END_NAMESPACE
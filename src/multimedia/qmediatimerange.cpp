@@ -38,9 +38,12 @@
 ****************************************************************************/
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qvector.h>
 
 #include "qmediatimerange.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -213,10 +216,12 @@ public:
     QMediaTimeRangePrivate(const QMediaTimeRangePrivate &other);
     QMediaTimeRangePrivate(const QMediaTimeInterval &interval);
 
-    QList<QMediaTimeInterval> intervals;
+    // Sorted by start time, disjoint and non-adjacent.
+    QVector<QMediaTimeInterval> intervals;
 
     void addInterval(const QMediaTimeInterval &interval);
     void removeInterval(const QMediaTimeInterval &interval);
+    bool contains(qint64 time) const;
 };
 
 QMediaTimeRangePrivate::QMediaTimeRangePrivate()
@@ -245,30 +250,29 @@ void QMediaTimeRangePrivate::addInterval(const QMediaTimeInterval &interval)
     if(!interval.isNormal())
         return;
 
-    // Find a place to insert the interval
-    int i;
-    for (i = 0; i < intervals.count(); i++) {
-        // Insert before this element
-        if(interval.s < intervals[i].s) {
-            intervals.insert(i, interval);
-            break;
-        }
-    }
-
-    // Interval needs to be added to the end of the list
-    if (i == intervals.count())
+    // Fast path for the common case of appending after the last interval,
+    // e.g. when a download buffer grows forward.
+    if (intervals.isEmpty() || intervals.last().e < interval.s - 1) {
         intervals.append(interval);
+        return;
+    }
 
-    // Do we need to correct the element before us?
-    if(i > 0 && intervals[i - 1].e >= interval.s - 1)
-        i--;
+    // First interval which overlaps or touches the new one
+    auto first = std::lower_bound(intervals.begin(), intervals.end(), interval.s,
+                                  [](const QMediaTimeInterval &r, qint64 s) { return r.e < s - 1; });
+    // First interval which starts after the new one, without touching it
+    auto last = std::upper_bound(first, intervals.end(), interval.e,
+                                 [](qint64 e, const QMediaTimeInterval &r) { return e < r.s - 1; });
 
-    // Merge trailing ranges
-    while (i < intervals.count() - 1
-          && intervals[i].e >= intervals[i + 1].s - 1) {
-        intervals[i].e = qMax(intervals[i].e, intervals[i + 1].e);
-        intervals.removeAt(i + 1);
+    if (first == last) {
+        intervals.insert(first, interval);
+        return;
     }
+
+    // Merge [first, last) with the new interval into *first
+    first->s = qMin(first->s, interval.s);
+    first->e = qMax((last - 1)->e, interval.e);
+    intervals.erase(first + 1, last);
 }
 
 void QMediaTimeRangePrivate::removeInterval(const QMediaTimeInterval &interval)
@@ -277,33 +281,46 @@ void QMediaTimeRangePrivate::removeInterval(const QMediaTimeInterval &interval)
     if(!interval.isNormal())
         return;
 
-    for (int i = 0; i < intervals.count(); i++) {
-        QMediaTimeInterval r = intervals[i];
-
-        if (r.e < interval.s) {
-            // Before the removal interval
-            continue;
-        } else if (interval.e < r.s) {
-            // After the removal interval - stop here
-            break;
-        } else if (r.s < interval.s && interval.e < r.e) {
-            // Split case - a single range has a chunk removed
-            intervals[i].e = interval.s -1;
-            addInterval(QMediaTimeInterval(interval.e + 1, r.e));
-            break;
-        } else if (r.s < interval.s) {
-            // Trimming Tail Case
-            intervals[i].e = interval.s - 1;
-        } else if (interval.e < r.e) {
-            // Trimming Head Case - we can stop after this
-            intervals[i].s = interval.e + 1;
-            break;
-        } else {
-            // Complete coverage case
-            intervals.removeAt(i);
-            --i;
-        }
+    // First interval which ends at or after the removal interval start
+    auto first = std::lower_bound(intervals.begin(), intervals.end(), interval.s,
+                                  [](const QMediaTimeInterval &r, qint64 s) { return r.e < s; });
+    // First interval which starts after the removal interval end
+    auto last = std::upper_bound(first, intervals.end(), interval.e,
+                                 [](qint64 e, const QMediaTimeInterval &r) { return e < r.s; });
+
+    if (first == last)
+        return;
+
+    const QMediaTimeInterval head = *first;
+    const QMediaTimeInterval tail = *(last - 1);
+
+    // What is left of the affected intervals; never more than two pieces
+    QMediaTimeInterval remainders[2];
+    int remainderCount = 0;
+    if (head.s < interval.s)
+        remainders[remainderCount++] = QMediaTimeInterval(head.s, interval.s - 1);
+    if (interval.e < tail.e)
+        remainders[remainderCount++] = QMediaTimeInterval(interval.e + 1, tail.e);
+
+    const int index = int(first - intervals.begin());
+    const int count = int(last - first);
+    if (remainderCount > count) {
+        // Split case - a single range has a chunk removed
+        intervals[index] = remainders[0];
+        intervals.insert(index + 1, remainders[1]);
+        return;
     }
+
+    for (int i = 0; i < remainderCount; ++i)
+        intervals[index + i] = remainders[i];
+    intervals.remove(index + remainderCount, count - remainderCount);
+}
+
+bool QMediaTimeRangePrivate::contains(qint64 time) const
+{
+    auto it = std::lower_bound(intervals.cbegin(), intervals.cend(), time,
+                               [](const QMediaTimeInterval &r, qint64 t) { return r.e < t; });
+    return it != intervals.cend() && it->s <= time;
 }
 
 /*!
@@ -442,7 +459,7 @@ qint64 QMediaTimeRange::earliestTime() const
 qint64 QMediaTimeRange::latestTime() const
 {
     if (!d->intervals.isEmpty())
-        return d->intervals[d->intervals.count() - 1].e;
+        return d->intervals.last().e;
 
     return 0;
 }
@@ -472,7 +489,10 @@ void QMediaTimeRange::addInterval(qint64 start, qint64 end)
     If the specified interval is adjacent to, or overlaps existing
     intervals within the time range, these intervals will be merged.
 
-    This operation takes linear time.
+    The position of the interval is found with a binary search, so
+    appending or extending intervals takes logarithmic time; inserting
+    a new disjoint interval in the middle of the range additionally has
+    to move the intervals that follow it.
 
     \sa removeInterval()
 */
@@ -488,7 +508,12 @@ void QMediaTimeRange::addInterval(const QMediaTimeInterval &interval)
 */
 void QMediaTimeRange::addTimeRange(const QMediaTimeRange &range)
 {
-    const auto intervals = range.intervals();
+    if (d->intervals.isEmpty()) {
+        d = range.d;
+        return;
+    }
+
+    const auto intervals = range.d->intervals;
     for (const QMediaTimeInterval &i : intervals) {
         d->addInterval(i);
     }
@@ -520,7 +545,7 @@ void QMediaTimeRange::removeInterval(qint64 start, qint64 end)
     such that no intervals within the time range include any part of the
     target interval.
 
-    This operation takes linear time.
+    The affected intervals are found with a binary search.
 
     \sa addInterval()
 */
@@ -536,7 +561,7 @@ void QMediaTimeRange::removeInterval(const QMediaTimeInterval &interval)
 */
 void QMediaTimeRange::removeTimeRange(const QMediaTimeRange &range)
 {
-    const auto intervals = range.intervals();
+    const auto intervals = range.d->intervals;
     for (const QMediaTimeInterval &i : intervals) {
         d->removeInterval(i);
     }
@@ -597,7 +622,7 @@ void QMediaTimeRange::clear()
 */
 QList<QMediaTimeInterval> QMediaTimeRange::intervals() const
 {
-    return d->intervals;
+    return d->intervals.toList();
 }
 
 /*!
@@ -627,18 +652,12 @@ bool QMediaTimeRange::isContinuous() const
     \fn QMediaTimeRange::contains(qint64 time) const
 
     Returns true if the specified \a time lies within the time range.
+
+    This operation takes logarithmic time.
 */
 bool QMediaTimeRange::contains(qint64 time) const
 {
-    for (int i = 0; i < d->intervals.count(); i++) {
-        if (d->intervals[i].contains(time))
-            return true;
-
-        if (time < d->intervals[i].s)
-            break;
-    }
-
-    return false;
+    return d->contains(time);
 }
 
 /*!
@@ -60,6 +60,7 @@ static void qRegisterMultimediaMetaTypes()
     qRegisterMetaType<QMultimedia::SupportEstimate>();
     qRegisterMetaType<QMultimedia::EncodingMode>();
     qRegisterMetaType<QMultimedia::EncodingQuality>();
+    qRegisterMetaType<QMultimedia::EncodingProfile>();
 }
 
 Q_CONSTRUCTOR_FUNCTION(qRegisterMultimediaMetaTypes)
@@ -102,6 +103,26 @@ Q_CONSTRUCTOR_FUNCTION(qRegisterMultimediaMetaTypes)
             that need it.
 */
 
+/*!
+    \enum QMultimedia::EncodingProfile
+    \since 5.15
+
+    Enumerates encoding profiles, which trade encoding speed and latency
+    against compression efficiency.
+
+    \value DefaultEncodingProfile The defaults of the encoder are used.
+    \value LowLatencyEncodingProfile Encoding adds as little delay as possible,
+            for example for video calls or remote viewing. Frames are not
+            reordered and key frames are frequent.
+    \value RealtimeEncodingProfile Encoding keeps up with live capture at a
+            moderate delay, favoring speed over compression efficiency.
+    \value ThroughputEncodingProfile Encoding processes as many frames per
+            second as possible, for example when transcoding files, without
+            regard to latency.
+    \value ArchiveEncodingProfile Encoding favors compression efficiency over
+            speed, for recordings that are stored for a long time.
+*/
+
 /*!
     \enum QMultimedia::AvailabilityStatus
 
@@ -75,6 +75,15 @@ namespace QMultimedia
         TwoPassEncoding
     };
 
+    enum EncodingProfile
+    {
+        DefaultEncodingProfile,
+        LowLatencyEncodingProfile,
+        RealtimeEncodingProfile,
+        ThroughputEncodingProfile,
+        ArchiveEncodingProfile
+    };
+
     enum AvailabilityStatus
     {
         Available,
@@ -91,6 +100,7 @@ Q_DECLARE_METATYPE(QMultimedia::AvailabilityStatus)
 Q_DECLARE_METATYPE(QMultimedia::SupportEstimate)
 Q_DECLARE_METATYPE(QMultimedia::EncodingMode)
 Q_DECLARE_METATYPE(QMultimedia::EncodingQuality)
+Q_DECLARE_METATYPE(QMultimedia::EncodingProfile)
 
 
 #endif
@@ -374,7 +374,8 @@ public:
         encodingMode(QMultimedia::ConstantQualityEncoding),
         bitrate(-1),
         frameRate(0),
-        quality(QMultimedia::NormalQuality)
+        quality(QMultimedia::NormalQuality),
+        profile(QMultimedia::DefaultEncodingProfile)
     {
     }
 
@@ -387,6 +388,7 @@ public:
         resolution(other.resolution),
         frameRate(other.frameRate),
         quality(other.quality),
+        profile(other.profile),
         encodingOptions(other.encodingOptions)
     {
     }
@@ -398,6 +400,7 @@ public:
     QSize resolution;
     qreal frameRate;
     QMultimedia::EncodingQuality quality;
+    QMultimedia::EncodingProfile profile;
     QVariantMap encodingOptions;
 
 private:
@@ -475,6 +478,7 @@ bool QVideoEncoderSettings::operator==(const QVideoEncoderSettings &other) const
             d->codec == other.d->codec &&
             d->resolution == other.d->resolution &&
             qFuzzyCompare(d->frameRate, other.d->frameRate) &&
+            d->profile == other.d->profile &&
             d->encodingOptions == other.d->encodingOptions);
 }
 
@@ -647,6 +651,39 @@ void QVideoEncoderSettings::setQuality(QMultimedia::EncodingQuality quality)
     d->quality = quality;
 }
 
+/*!
+    \since 5.15
+
+    Returns the video encoding profile.
+
+    \sa setEncodingProfile()
+*/
+
+QMultimedia::EncodingProfile QVideoEncoderSettings::encodingProfile() const
+{
+    return d->profile;
+}
+
+/*!
+    \since 5.15
+
+    Sets the video encoding \a profile.
+
+    The profile lets the backend tune the speed and latency related
+    parameters of the encoder, such as its speed preset, frame reordering,
+    key frame interval and number of threads, independently of the quality
+    or bit rate. Encoding options set with setEncodingOption() take precedence
+    over the parameters chosen for the profile.
+
+    \sa QMultimedia::EncodingProfile
+*/
+
+void QVideoEncoderSettings::setEncodingProfile(QMultimedia::EncodingProfile profile)
+{
+    d->isNull = false;
+    d->profile = profile;
+}
+
 /*!
     Returns the value of encoding \a option.
 
@@ -127,6 +127,9 @@ public:
     QMultimedia::EncodingQuality quality() const;
     void setQuality(QMultimedia::EncodingQuality quality);
 
+    QMultimedia::EncodingProfile encodingProfile() const;
+    void setEncodingProfile(QMultimedia::EncodingProfile profile);
+
     QVariant encodingOption(const QString &option) const;
     QVariantMap encodingOptions() const;
     void setEncodingOption(const QString &option, const QVariant &value);
@@ -49,6 +49,8 @@
 #include <qvideoencodersettingscontrol.h>
 #include <qmediacontainercontrol.h>
 #include <qmediaavailabilitycontrol.h>
+#include <private/qmediarecordersegmentcontrol_p.h>
+#include <private/qmediastatisticscontrol_p.h>
 #include <qcamera.h>
 #include <qcameracontrol.h>
 
@@ -96,7 +98,11 @@ QMediaRecorderPrivate::QMediaRecorderPrivate():
      videoControl(nullptr),
      metaDataControl(nullptr),
      availabilityControl(nullptr),
+     segmentControl(nullptr),
+     statisticsControl(nullptr),
      settingsChanged(false),
+     maxSegmentDuration(0),
+     maxSegmentSize(0),
      notifyTimer(nullptr),
      state(QMediaRecorder::StoppedState),
      error(QMediaRecorder::NoError)
@@ -142,6 +148,8 @@ void QMediaRecorderPrivate::_q_serviceDestroyed()
     videoControl = nullptr;
     metaDataControl = nullptr;
     availabilityControl = nullptr;
+    segmentControl = nullptr;
+    statisticsControl = nullptr;
     settingsChanged = true;
 }
 
@@ -325,6 +333,13 @@ bool QMediaRecorder::setMediaObject(QMediaObject *object)
                            this, SLOT(_q_availabilityChanged(QMultimedia::AvailabilityStatus)));
                 service->releaseControl(d->availabilityControl);
             }
+            if (d->segmentControl) {
+                disconnect(d->segmentControl, SIGNAL(segmentFinalized(QUrl,qint64,qint64)),
+                           this, SIGNAL(segmentFinalized(QUrl,qint64,qint64)));
+                service->releaseControl(d->segmentControl);
+            }
+            if (d->statisticsControl)
+                service->releaseControl(d->statisticsControl);
         }
     }
 
@@ -334,6 +349,8 @@ bool QMediaRecorder::setMediaObject(QMediaObject *object)
     d->videoControl = nullptr;
     d->metaDataControl = nullptr;
     d->availabilityControl = nullptr;
+    d->segmentControl = nullptr;
+    d->statisticsControl = nullptr;
 
     d->mediaObject = object;
 
@@ -377,6 +394,16 @@ bool QMediaRecorder::setMediaObject(QMediaObject *object)
                             this, SLOT(_q_availabilityChanged(QMultimedia::AvailabilityStatus)));
                 }
 
+                d->segmentControl = service->requestControl<QMediaRecorderSegmentControl *>();
+                if (d->segmentControl) {
+                    d->segmentControl->setMaxSegmentDuration(d->maxSegmentDuration);
+                    d->segmentControl->setMaxSegmentSize(d->maxSegmentSize);
+                    connect(d->segmentControl, SIGNAL(segmentFinalized(QUrl,qint64,qint64)),
+                            this, SIGNAL(segmentFinalized(QUrl,qint64,qint64)));
+                }
+
+                d->statisticsControl = service->requestControl<QMediaStatisticsControl *>();
+
                 connect(d->control, SIGNAL(stateChanged(QMediaRecorder::State)),
                         this, SLOT(_q_stateChanged(QMediaRecorder::State)));
 
@@ -848,6 +875,106 @@ void QMediaRecorder::setEncodingSettings(const QAudioEncoderSettings &audio,
     d->applySettingsLater();
 }
 
+/*!
+    \property QMediaRecorder::maxSegmentDuration
+    \brief the maximum duration of a recorded segment in milliseconds.
+    \since 5.15
+
+    When set to a positive value the recording is split into consecutive
+    files while the capture pipeline keeps running, so no frames are lost
+    and the encoders are not restarted at the boundaries. A new segment
+    starts at the first key frame after the current segment reached this
+    duration. Each completed segment is reported with segmentFinalized().
+
+    Segments are named after outputLocation() with a running number appended
+    to the base name.
+
+    The value is applied when recording starts. The default value is 0,
+    which records a single file. Segmented recording is only available if
+    the service supports it.
+
+    \sa maxSegmentSize, segmentFinalized()
+*/
+qint64 QMediaRecorder::maxSegmentDuration() const
+{
+    return d_func()->maxSegmentDuration;
+}
+
+void QMediaRecorder::setMaxSegmentDuration(qint64 duration)
+{
+    Q_D(QMediaRecorder);
+
+    d->maxSegmentDuration = qMax<qint64>(0, duration);
+    if (d->segmentControl)
+        d->segmentControl->setMaxSegmentDuration(d->maxSegmentDuration);
+}
+
+/*!
+    \property QMediaRecorder::maxSegmentSize
+    \brief the maximum size of a recorded segment in bytes.
+    \since 5.15
+
+    When set to a positive value the recording is split into consecutive
+    files, starting a new segment at the first key frame after the current
+    one reached this size. It can be combined with maxSegmentDuration, in
+    which case whichever limit is reached first starts the next segment.
+
+    The value is applied when recording starts. The default value is 0,
+    meaning no size limit.
+
+    \sa maxSegmentDuration, segmentFinalized()
+*/
+qint64 QMediaRecorder::maxSegmentSize() const
+{
+    return d_func()->maxSegmentSize;
+}
+
+void QMediaRecorder::setMaxSegmentSize(qint64 size)
+{
+    Q_D(QMediaRecorder);
+
+    d->maxSegmentSize = qMax<qint64>(0, size);
+    if (d->segmentControl)
+        d->segmentControl->setMaxSegmentSize(d->maxSegmentSize);
+}
+
+/*!
+    Returns a snapshot of the recording performance counters.
+
+    The map is empty if the backend does not collect statistics. It uses
+    the same keys as QMediaPlayer::statistics(). For a recorder
+    \c encodedFrames counts the video frames that reached the encoder and
+    \c lateFrames counts quality of service reports from any element of
+    the capture pipeline. The other frame counters and the latencies
+    describe the viewfinder, if there is one.
+
+    \since 5.15
+    \sa resetStatistics()
+*/
+QVariantMap QMediaRecorder::statistics() const
+{
+    Q_D(const QMediaRecorder);
+
+    if (d->statisticsControl)
+        return d->statisticsControl->statistics();
+
+    return QVariantMap();
+}
+
+/*!
+    Sets all recording performance counters back to zero.
+
+    \since 5.15
+    \sa statistics()
+*/
+void QMediaRecorder::resetStatistics()
+{
+    Q_D(QMediaRecorder);
+
+    if (d->statisticsControl)
+        d->statisticsControl->resetStatistics();
+}
+
 /*!
     Start recording.
 
@@ -983,6 +1110,17 @@ void QMediaRecorder::stop()
     This signal is usually emitted when recording starts.
 */
 
+/*!
+    \fn QMediaRecorder::segmentFinalized(const QUrl &location, qint64 startTime, qint64 endTime)
+    \since 5.15
+
+    Signals that a segment of a segmented recording was completely written
+    to \a location. \a startTime and \a endTime give the range of the
+    recording covered by the segment in milliseconds.
+
+    \sa maxSegmentDuration, maxSegmentSize
+*/
+
 /*!
     \fn QMediaRecorder::error(QMediaRecorder::Error error)
 
@@ -78,6 +78,8 @@ class Q_MULTIMEDIA_EXPORT QMediaRecorder : public QObject, public QMediaBindable
     Q_PROPERTY(qreal volume READ volume WRITE setVolume NOTIFY volumeChanged)
     Q_PROPERTY(bool metaDataAvailable READ isMetaDataAvailable NOTIFY metaDataAvailableChanged)
     Q_PROPERTY(bool metaDataWritable READ isMetaDataWritable NOTIFY metaDataWritableChanged)
+    Q_PROPERTY(qint64 maxSegmentDuration READ maxSegmentDuration WRITE setMaxSegmentDuration)
+    Q_PROPERTY(qint64 maxSegmentSize READ maxSegmentSize WRITE setMaxSegmentSize)
 public:
 
     enum State
@@ -160,6 +162,15 @@ public:
                              const QVideoEncoderSettings &videoSettings = QVideoEncoderSettings(),
                              const QString &containerMimeType = QString());
 
+    qint64 maxSegmentDuration() const;
+    void setMaxSegmentDuration(qint64 duration);
+
+    qint64 maxSegmentSize() const;
+    void setMaxSegmentSize(qint64 size);
+
+    Q_INVOKABLE QVariantMap statistics() const;
+    Q_INVOKABLE void resetStatistics();
+
     bool isMetaDataAvailable() const;
     bool isMetaDataWritable() const;
 
@@ -181,6 +192,7 @@ Q_SIGNALS:
     void mutedChanged(bool muted);
     void volumeChanged(qreal volume);
     void actualLocationChanged(const QUrl &location);
+    void segmentFinalized(const QUrl &location, qint64 startTime, qint64 endTime);
 
     void error(QMediaRecorder::Error error);
 
@@ -63,6 +63,8 @@ class QAudioEncoderSettingsControl;
 class QVideoEncoderSettingsControl;
 class QMetaDataWriterControl;
 class QMediaAvailabilityControl;
+class QMediaRecorderSegmentControl;
+class QMediaStatisticsControl;
 class QTimer;
 
 class QMediaRecorderPrivate
@@ -84,9 +86,14 @@ public:
     QVideoEncoderSettingsControl *videoControl;
     QMetaDataWriterControl *metaDataControl;
     QMediaAvailabilityControl *availabilityControl;
+    QMediaRecorderSegmentControl *segmentControl;
+    QMediaStatisticsControl *statisticsControl;
 
     bool settingsChanged;
 
+    qint64 maxSegmentDuration;
+    qint64 maxSegmentSize;
+
     QTimer* notifyTimer;
 
     QMediaRecorder::State state;
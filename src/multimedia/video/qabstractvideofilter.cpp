@@ -221,7 +221,9 @@ QT_BEGIN_NAMESPACE
   writing may become problematic.
 
   \note Avoid time consuming operations in this function as they block the
-  entire rendering of the application.
+  entire rendering of the application. Filters that only work on frames in
+  system memory can set QAbstractVideoFilter::cpuOnly to have this function
+  called on a worker thread instead.
 
   \note The handleType() and pixelFormat() of \a input is completely up to the
   video decoding backend on the platform in use. On some platforms different
@@ -251,10 +253,12 @@ class QAbstractVideoFilterPrivate
 {
 public:
     QAbstractVideoFilterPrivate() :
-        active(true)
+        active(true),
+        cpuOnly(false)
     { }
 
     bool active;
+    bool cpuOnly;
 };
 
 /*!
@@ -305,6 +309,51 @@ void QAbstractVideoFilter::setActive(bool v)
     }
 }
 
+/*!
+    \property QAbstractVideoFilter::cpuOnly
+    \brief whether the filter only operates on video frames in system memory.
+    \since 5.15
+
+    By default this is false and the filter runnable is invoked on the render
+    thread with the OpenGL context bound.
+
+    When set to \c true, the filter declares that it neither needs an OpenGL
+    context nor handles frames backed by textures. VideoOutput then runs the
+    leading CPU-only filters of its \l{QtMultimedia::VideoOutput::filters}{filters}
+    list on a pipeline of worker threads, one per filter, ahead of the render
+    thread. Consecutive frames are processed by the different filters in
+    parallel, while the order of the frames is preserved. The pipeline is
+    bounded: when a filter cannot keep up with the video source, the oldest
+    frame waiting for it is dropped. The render thread only uploads and draws
+    the resulting frame. Frames that carry a handle, such as an OpenGL texture,
+    are still processed on the render thread.
+
+    For such filters, the QVideoFilterRunnable is created on the gui thread
+    when the filter is added to the VideoOutput, and it is invoked and
+    destroyed on its worker thread. The worker thread does not access the
+    QAbstractVideoFilter itself, changes of the \l active property are
+    forwarded to it. Because the gui thread is not blocked while a worker
+    runs, a runnable that refers back to its QAbstractVideoFilter must access
+    it in a thread safe manner from QVideoFilterRunnable::run().
+
+    The property should be set before the filter is assigned to a VideoOutput,
+    changes take effect when the \c filters list is assigned the next time.
+ */
+bool QAbstractVideoFilter::isCpuOnly() const
+{
+    Q_D(const QAbstractVideoFilter);
+    return d->cpuOnly;
+}
+
+void QAbstractVideoFilter::setCpuOnly(bool v)
+{
+    Q_D(QAbstractVideoFilter);
+    if (d->cpuOnly != v) {
+        d->cpuOnly = v;
+        emit cpuOnlyChanged();
+    }
+}
+
 /*!
   \fn QVideoFilterRunnable *QAbstractVideoFilter::createFilterRunnable()
 
@@ -66,6 +66,7 @@ class Q_MULTIMEDIA_EXPORT QAbstractVideoFilter : public QObject
 {
     Q_OBJECT
     Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(bool cpuOnly READ isCpuOnly WRITE setCpuOnly NOTIFY cpuOnlyChanged)
 
 public:
     explicit QAbstractVideoFilter(QObject *parent = nullptr);
@@ -74,10 +75,14 @@ public:
     bool isActive() const;
     void setActive(bool v);
 
+    bool isCpuOnly() const;
+    void setCpuOnly(bool v);
+
     virtual QVideoFilterRunnable *createFilterRunnable() = 0;
 
 Q_SIGNALS:
     void activeChanged();
+    void cpuOnlyChanged();
 
 private:
     Q_DECLARE_PRIVATE(QAbstractVideoFilter)
@@ -39,6 +39,12 @@
 
 #include "qvideoframeconversionhelper_p.h"
 
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtGui/qimage.h>
+
 QT_BEGIN_NAMESPACE
 
 #define CLAMP(n) (n > 255 ? 255 : (n < 0 ? 0 : n))
@@ -351,4 +357,211 @@ void QT_FASTCALL qt_convert_BGR555_to_ARGB32(const QVideoFrame &frame, uchar *ou
     }
 }
 
+void QT_FASTCALL qt_convert_YUV_row_to_ARGB32(const uchar *y, const uchar *u, const uchar *v,
+                                              quint32 *argb, int width)
+{
+    for (int i = 0; i < width; ++i) {
+        EXPAND_UV(u[i], v[i]);
+        argb[i] = qYUVToARGB32(y[i], rv, guv, bu);
+    }
+}
+
+namespace {
+
+// One plane of samples, which for packed and semi-planar formats is interleaved with others
+struct YUVPlane
+{
+    const uchar *bits;
+    int stride;
+    int pixelStride;
+    int xShift;
+    int yShift;
+};
+
+// Offsets of the two nearest samples and the 8 bit weight of the second one
+struct ScaleStep
+{
+    int offset0;
+    int offset1;
+    int weight;
+};
+
+}
+
+static bool qt_yuv_planes(const QVideoFrame &frame, YUVPlane *planes)
+{
+    switch (frame.pixelFormat()) {
+    case QVideoFrame::Format_YUV420P:
+        planes[0] = { frame.bits(0), frame.bytesPerLine(0), 1, 0, 0 };
+        planes[1] = { frame.bits(1), frame.bytesPerLine(1), 1, 1, 1 };
+        planes[2] = { frame.bits(2), frame.bytesPerLine(2), 1, 1, 1 };
+        return true;
+    case QVideoFrame::Format_YV12:
+        planes[0] = { frame.bits(0), frame.bytesPerLine(0), 1, 0, 0 };
+        planes[1] = { frame.bits(2), frame.bytesPerLine(2), 1, 1, 1 };
+        planes[2] = { frame.bits(1), frame.bytesPerLine(1), 1, 1, 1 };
+        return true;
+    case QVideoFrame::Format_NV12:
+        planes[0] = { frame.bits(0), frame.bytesPerLine(0), 1, 0, 0 };
+        planes[1] = { frame.bits(1), frame.bytesPerLine(1), 2, 1, 1 };
+        planes[2] = { frame.bits(1) + 1, frame.bytesPerLine(1), 2, 1, 1 };
+        return true;
+    case QVideoFrame::Format_NV21:
+        planes[0] = { frame.bits(0), frame.bytesPerLine(0), 1, 0, 0 };
+        planes[1] = { frame.bits(1) + 1, frame.bytesPerLine(1), 2, 1, 1 };
+        planes[2] = { frame.bits(1), frame.bytesPerLine(1), 2, 1, 1 };
+        return true;
+    case QVideoFrame::Format_UYVY:
+        planes[0] = { frame.bits() + 1, frame.bytesPerLine(), 2, 0, 0 };
+        planes[1] = { frame.bits(), frame.bytesPerLine(), 4, 1, 0 };
+        planes[2] = { frame.bits() + 2, frame.bytesPerLine(), 4, 1, 0 };
+        return true;
+    case QVideoFrame::Format_YUYV:
+        planes[0] = { frame.bits(), frame.bytesPerLine(), 2, 0, 0 };
+        planes[1] = { frame.bits() + 1, frame.bytesPerLine(), 4, 1, 0 };
+        planes[2] = { frame.bits() + 3, frame.bytesPerLine(), 4, 1, 0 };
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Maps each of count output samples to the samples of a plane subsampled by shift,
+// for the source range [from, from + length) in full resolution coordinates.
+static void qt_scale_steps(int from, int length, int count, int shift, int planeLength,
+                           int byteStride, bool smooth, ScaleStep *steps)
+{
+    const qint64 scale = (qint64(length) << 16) / count;
+    // Centre of the first output sample, in 16.16 fixed point
+    qint64 position = (qint64(from) << 16) + scale / 2;
+
+    for (int i = 0; i < count; ++i, position += scale) {
+        const qint64 planePosition = (position >> shift) - 0x8000;
+
+        if (smooth) {
+            const qint64 clamped = qBound<qint64>(0, planePosition, qint64(planeLength - 1) << 16);
+            const int index = int(clamped >> 16);
+            steps[i].offset0 = index * byteStride;
+            steps[i].offset1 = qMin(index + 1, planeLength - 1) * byteStride;
+            steps[i].weight = int(clamped >> 8) & 0xff;
+        } else {
+            const int index = qBound(0, int((planePosition + 0x8000) >> 16), planeLength - 1);
+            steps[i].offset0 = index * byteStride;
+            steps[i].offset1 = steps[i].offset0;
+            steps[i].weight = 0;
+        }
+    }
+}
+
+static inline int qt_blend_samples(int a, int b, int weight)
+{
+    return (a * (256 - weight) + b * weight + 128) >> 8;
+}
+
+static void qt_sample_row(const YUVPlane &plane, const ScaleStep &row, const ScaleStep *columns,
+                          uchar *samples, int width, bool smooth)
+{
+    const uchar *line0 = plane.bits + row.offset0;
+
+    if (!smooth) {
+        for (int i = 0; i < width; ++i)
+            samples[i] = line0[columns[i].offset0];
+    } else if (row.weight == 0) {
+        for (int i = 0; i < width; ++i) {
+            const ScaleStep &column = columns[i];
+            samples[i] = qt_blend_samples(line0[column.offset0], line0[column.offset1], column.weight);
+        }
+    } else {
+        const uchar *line1 = plane.bits + row.offset1;
+        for (int i = 0; i < width; ++i) {
+            const ScaleStep &column = columns[i];
+            const int top = qt_blend_samples(line0[column.offset0], line0[column.offset1], column.weight);
+            const int bottom = qt_blend_samples(line1[column.offset0], line1[column.offset1], column.weight);
+            samples[i] = qt_blend_samples(top, bottom, row.weight);
+        }
+    }
+}
+
+static YUVRowConvertFunc qt_yuv_row_convert_func()
+{
+#ifdef QT_COMPILER_SUPPORTS_SSE2
+    extern void QT_FASTCALL qt_convert_YUV_row_to_ARGB32_sse2(const uchar*, const uchar*, const uchar*, quint32*, int);
+    if (qCpuHasFeature(SSE2))
+        return qt_convert_YUV_row_to_ARGB32_sse2;
+#endif
+    return qt_convert_YUV_row_to_ARGB32;
+}
+
+bool qt_convert_scaled_YUV_to_ARGB32(const QVideoFrame &frame, const QRect &source,
+                                     QImage *output, bool smooth)
+{
+    YUVPlane planes[3];
+    if (!qt_yuv_planes(frame, planes) || source.isEmpty() || output->isNull())
+        return false;
+
+    static const YUVRowConvertFunc convertRow = qt_yuv_row_convert_func();
+
+    const int width = output->width();
+    const int height = output->height();
+
+    // Sample positions are the same for every row and column, work them out once
+    QVarLengthArray<ScaleStep, 768> columns(3 * width);
+    QVarLengthArray<ScaleStep, 768> rows(3 * height);
+    for (int p = 0; p < 3; ++p) {
+        const YUVPlane &plane = planes[p];
+        qt_scale_steps(source.x(), source.width(), width, plane.xShift,
+                       frame.width() >> plane.xShift, plane.pixelStride, smooth,
+                       columns.data() + p * width);
+        qt_scale_steps(source.y(), source.height(), height, plane.yShift,
+                       frame.height() >> plane.yShift, plane.stride, smooth,
+                       rows.data() + p * height);
+    }
+
+    uchar *bits = output->bits();
+    const int bytesPerLine = output->bytesPerLine();
+
+    auto convertRows = [&](int from, int to) {
+        QVarLengthArray<uchar, 3 * 1024> samples(3 * width);
+        uchar *y = samples.data();
+        uchar *u = y + width;
+        uchar *v = u + width;
+
+        for (int line = from; line < to; ++line) {
+            qt_sample_row(planes[0], rows[line], columns.constData(), y, width, smooth);
+            qt_sample_row(planes[1], rows[height + line], columns.constData() + width, u, width, smooth);
+            qt_sample_row(planes[2], rows[2 * height + line], columns.constData() + 2 * width, v, width, smooth);
+
+            convertRow(y, u, v, reinterpret_cast<quint32 *>(bits + line * bytesPerLine), width);
+        }
+    };
+
+    // Large outputs are split into bands of rows, converted on the global thread pool
+    // while this thread takes the last band. Bands the pool can't take run here as well.
+    const int segments = qMin(QThread::idealThreadCount(), int((qint64(width) * height) >> 16));
+    if (segments <= 1) {
+        convertRows(0, height);
+        return true;
+    }
+
+    QSemaphore done;
+    int started = 0;
+    int line = 0;
+    for (int i = 0; i < segments - 1; ++i) {
+        const int end = line + (height - line) / (segments - i);
+        if (QThreadPool::globalInstance()->tryStart([&convertRows, &done, line, end]() {
+                convertRows(line, end);
+                done.release();
+            })) {
+            ++started;
+        } else {
+            convertRows(line, end);
+        }
+        line = end;
+    }
+    convertRows(line, height);
+    done.acquire(started);
+
+    return true;
+}
+
 QT_END_NAMESPACE
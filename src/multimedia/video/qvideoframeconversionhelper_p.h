@@ -119,5 +119,20 @@ inline quint32 qConvertBGR555ToARGB32(quint16 bgr)
 #define ALIGN(boundary, ptr, x, length) \
     for (; ((reinterpret_cast<qintptr>(ptr) & (boundary - 1)) != 0) && x < length; ++x)
 
+QT_BEGIN_NAMESPACE
+
+class QImage;
+class QRect;
+
+typedef void (QT_FASTCALL *YUVRowConvertFunc)(const uchar *y, const uchar *u, const uchar *v,
+                                              quint32 *argb, int width);
+
+// Converts the source rectangle of a mapped YUV frame to the size of output in a single pass.
+// Handles YUV420P, YV12, NV12, NV21, UYVY and YUYV and returns false for anything else.
+Q_MULTIMEDIA_EXPORT bool qt_convert_scaled_YUV_to_ARGB32(const QVideoFrame &frame, const QRect &source,
+                                                         QImage *output, bool smooth);
+
+QT_END_NAMESPACE
+
 #endif // QVIDEOFRAMECONVERSIONHELPER_P_H
 
@@ -84,6 +84,78 @@ void QT_FASTCALL qt_convert_BGRA32_to_ARGB32_sse2(const QVideoFrame &frame, ucha
     }
 }
 
+// Same arithmetic as the generic qYUVToARGB32(), eight pixels at a time
+void QT_FASTCALL qt_convert_YUV_row_to_ARGB32_sse2(const uchar *y, const uchar *u, const uchar *v,
+                                                   quint32 *argb, int width)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi8(char(0xff));
+    const __m128i lumaOffset = _mm_set1_epi16(16);
+    const __m128i chromaOffset = _mm_set1_epi16(128);
+    const __m128i rounding = _mm_set1_epi32(128);
+    // 16 bit pairs for _mm_madd_epi16, the upper factor only matters for the UV pairs
+    const __m128i yFactor = _mm_set1_epi32(298);
+    const __m128i rvFactor = _mm_set1_epi32(409);
+    const __m128i buFactor = _mm_set1_epi32(516);
+    const __m128i guvFactor = _mm_set1_epi32(100 | (208 << 16));
+
+    int x = 0;
+    for (; x < width - 7; x += 8) {
+        const __m128i yy = _mm_sub_epi16(
+                    _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + x)), zero),
+                    lumaOffset);
+        const __m128i uu = _mm_sub_epi16(
+                    _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x)), zero),
+                    chromaOffset);
+        const __m128i vv = _mm_sub_epi16(
+                    _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x)), zero),
+                    chromaOffset);
+
+        __m128i r[2];
+        __m128i g[2];
+        __m128i b[2];
+        for (int half = 0; half < 2; ++half) {
+            const __m128i y32 = half ? _mm_unpackhi_epi16(yy, zero) : _mm_unpacklo_epi16(yy, zero);
+            const __m128i u32 = half ? _mm_unpackhi_epi16(uu, zero) : _mm_unpacklo_epi16(uu, zero);
+            const __m128i v32 = half ? _mm_unpackhi_epi16(vv, zero) : _mm_unpacklo_epi16(vv, zero);
+            const __m128i uv = half ? _mm_unpackhi_epi16(uu, vv) : _mm_unpacklo_epi16(uu, vv);
+
+            const __m128i luma = _mm_madd_epi16(y32, yFactor);
+            const __m128i rv = _mm_add_epi32(_mm_madd_epi16(v32, rvFactor), rounding);
+            const __m128i guv = _mm_add_epi32(_mm_madd_epi16(uv, guvFactor), rounding);
+            const __m128i bu = _mm_add_epi32(_mm_madd_epi16(u32, buFactor), rounding);
+
+            r[half] = _mm_srai_epi32(_mm_add_epi32(luma, rv), 8);
+            g[half] = _mm_srai_epi32(_mm_sub_epi32(luma, guv), 8);
+            b[half] = _mm_srai_epi32(_mm_add_epi32(luma, bu), 8);
+        }
+
+        // Saturating packs clamp to 0..255 like CLAMP() does
+        const __m128i r8 = _mm_packus_epi16(_mm_packs_epi32(r[0], r[1]), zero);
+        const __m128i g8 = _mm_packus_epi16(_mm_packs_epi32(g[0], g[1]), zero);
+        const __m128i b8 = _mm_packus_epi16(_mm_packs_epi32(b[0], b[1]), zero);
+
+        const __m128i bg = _mm_unpacklo_epi8(b8, g8);
+        const __m128i ra = _mm_unpacklo_epi8(r8, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(argb + x), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(argb + x + 4), _mm_unpackhi_epi16(bg, ra));
+    }
+
+    // leftovers
+    for (; x < width; ++x) {
+        const int uu = u[x] - 128;
+        const int vv = v[x] - 128;
+        const int yy = (y[x] - 16) * 298;
+        const int r = (yy + 409 * vv + 128) >> 8;
+        const int g = (yy - 100 * uu - 208 * vv - 128) >> 8;
+        const int b = (yy + 516 * uu + 128) >> 8;
+        argb[x] = 0xff000000
+                | qBound(0, r, 255) << 16
+                | qBound(0, g, 255) << 8
+                | qBound(0, b, 255);
+    }
+}
+
 QT_END_NAMESPACE
 
 #endif
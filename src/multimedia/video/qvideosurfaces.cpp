@@ -39,8 +39,262 @@
 
 #include "qvideosurfaces_p.h"
 
+#include <QtCore/qdebug.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtGui/qimage.h>
+
 QT_BEGIN_NAMESPACE
 
+// Frames waiting to be presented on the thread of a surface. Shared with the
+// queued invocations, which may still run after the sink is gone.
+struct QVideoSurfaceDelivery
+{
+    QPointer<QAbstractVideoSurface> surface;
+    QMutex mutex;
+    QQueue<QVideoFrame> frames;
+    int queueDepth = 2;
+    bool scheduled = false;
+    bool failed = false;
+};
+
+static void presentQueuedFrame(const QSharedPointer<QVideoSurfaceDelivery> &delivery);
+
+static void scheduleDelivery(const QSharedPointer<QVideoSurfaceDelivery> &delivery)
+{
+    if (QAbstractVideoSurface *surface = delivery->surface.data()) {
+        QMetaObject::invokeMethod(surface, [delivery]() { presentQueuedFrame(delivery); },
+                                  Qt::QueuedConnection);
+    }
+}
+
+static void postFrame(const QSharedPointer<QVideoSurfaceDelivery> &delivery, const QVideoFrame &frame)
+{
+    {
+        QMutexLocker locker(&delivery->mutex);
+        while (delivery->frames.count() >= delivery->queueDepth)
+            delivery->frames.dequeue();
+        delivery->frames.enqueue(frame);
+        if (delivery->scheduled)
+            return;
+        delivery->scheduled = true;
+    }
+
+    scheduleDelivery(delivery);
+}
+
+// Runs on the thread of the surface, one frame per event
+static void presentQueuedFrame(const QSharedPointer<QVideoSurfaceDelivery> &delivery)
+{
+    QVideoFrame frame;
+    bool more = false;
+    {
+        QMutexLocker locker(&delivery->mutex);
+        if (delivery->frames.isEmpty()) {
+            delivery->scheduled = false;
+            return;
+        }
+        frame = delivery->frames.dequeue();
+        more = !delivery->frames.isEmpty();
+        delivery->scheduled = more;
+    }
+
+    if (more)
+        scheduleDelivery(delivery);
+
+    QAbstractVideoSurface *surface = delivery->surface.data();
+    if (surface && surface->isActive()) {
+        const bool presented = surface->present(frame);
+        QMutexLocker locker(&delivery->mutex);
+        delivery->failed = !presented;
+    }
+}
+
+// Feeds a single surface. Frames are always queued to the thread of the
+// surface, even when that is the presenting thread, so that a slow surface
+// only drops its own frames. Frames the surface can't take are converted on
+// a dedicated thread, which is only started when needed.
+class QVideoSurfaceSink : public QThread
+{
+public:
+    enum { DefaultQueueDepth = 2 };
+
+    QVideoSurfaceSink(QAbstractVideoSurface *surface)
+        : m_surface(surface)
+        , m_delivery(new QVideoSurfaceDelivery)
+    {
+        setObjectName(QStringLiteral("QVideoSurfaceSink"));
+        m_delivery->surface = surface;
+    }
+
+    ~QVideoSurfaceSink()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_quit = true;
+            m_frames.clear();
+            m_condition.wakeAll();
+        }
+        wait();
+
+        QMutexLocker locker(&m_delivery->mutex);
+        m_delivery->frames.clear();
+        m_delivery->surface.clear();
+    }
+
+    bool startSurface(const QVideoSurfaceFormat &format)
+    {
+        flush();
+
+        // Optional per surface settings, given as dynamic properties
+        const qreal maximumFrameRate = m_surface->property("maximumFrameRate").toReal();
+        m_minimumInterval = maximumFrameRate > 0 ? qint64(1000000000 / maximumFrameRate) : 0;
+        const int queueDepth = m_surface->property("maximumQueuedFrames").toInt();
+        m_frameClock.invalidate();
+
+        QImage::Format imageFormat = QImage::Format_Invalid;
+        QVideoSurfaceFormat surfaceFormat = format;
+        const auto formats = m_surface->supportedPixelFormats(format.handleType());
+        if (!formats.contains(format.pixelFormat())) {
+            // Convert to the first RGB format the surface takes
+            const auto rgbFormats = m_surface->supportedPixelFormats(QAbstractVideoBuffer::NoHandle);
+            for (QVideoFrame::PixelFormat pixelFormat : rgbFormats) {
+                imageFormat = QVideoFrame::imageFormatFromPixelFormat(pixelFormat);
+                if (imageFormat != QImage::Format_Invalid) {
+                    surfaceFormat = QVideoSurfaceFormat(format.frameSize(), pixelFormat);
+                    surfaceFormat.setViewport(format.viewport());
+                    surfaceFormat.setFrameRate(format.frameRate());
+                    surfaceFormat.setPixelAspectRatio(format.pixelAspectRatio());
+                    surfaceFormat.setScanLineDirection(format.scanLineDirection());
+                    break;
+                }
+            }
+
+            if (imageFormat == QImage::Format_Invalid) {
+                qWarning() << "QVideoSurfaces: no common or convertible pixel format for surface"
+                           << m_surface << format.pixelFormat();
+                return false;
+            }
+        }
+
+        {
+            QMutexLocker locker(&m_mutex);
+            m_imageFormat = imageFormat;
+            m_queueDepth = queueDepth > 0 ? queueDepth : DefaultQueueDepth;
+        }
+        {
+            QMutexLocker locker(&m_delivery->mutex);
+            m_delivery->queueDepth = queueDepth > 0 ? queueDepth : DefaultQueueDepth;
+            m_delivery->failed = false;
+        }
+
+        if (imageFormat != QImage::Format_Invalid && !isRunning())
+            start();
+
+        return m_surface->start(surfaceFormat);
+    }
+
+    void stopSurface()
+    {
+        flush();
+        m_surface->stop();
+    }
+
+    // Returns false when the surface rejected the last frame delivered to it
+    bool present(const QVideoFrame &frame)
+    {
+        {
+            QMutexLocker locker(&m_delivery->mutex);
+            if (m_delivery->failed)
+                return false;
+        }
+
+        if (m_minimumInterval > 0) {
+            if (m_frameClock.isValid() && m_frameClock.nsecsElapsed() < m_minimumInterval)
+                return true;
+            m_frameClock.start();
+        }
+
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_imageFormat != QImage::Format_Invalid) {
+                while (m_frames.count() >= m_queueDepth)
+                    m_frames.dequeue();
+                m_frames.enqueue(frame);
+                m_condition.wakeOne();
+                return true;
+            }
+        }
+
+        postFrame(m_delivery, frame);
+        return true;
+    }
+
+    // Drops frames not yet converted or presented and waits for a
+    // conversion in progress
+    void flush()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_frames.clear();
+            while (m_converting)
+                m_idle.wait(&m_mutex);
+        }
+
+        QMutexLocker locker(&m_delivery->mutex);
+        m_delivery->frames.clear();
+    }
+
+protected:
+    void run() override
+    {
+        forever {
+            QVideoFrame frame;
+            QImage::Format imageFormat;
+            {
+                QMutexLocker locker(&m_mutex);
+                while (!m_quit && m_frames.isEmpty())
+                    m_condition.wait(&m_mutex);
+                if (m_quit)
+                    break;
+                frame = m_frames.dequeue();
+                imageFormat = m_imageFormat;
+                m_converting = true;
+            }
+
+            const QImage image = frame.image();
+            if (!image.isNull()) {
+                postFrame(m_delivery, QVideoFrame(image.format() == imageFormat
+                                                  ? image : image.convertToFormat(imageFormat)));
+            }
+
+            QMutexLocker locker(&m_mutex);
+            m_converting = false;
+            m_idle.wakeAll();
+        }
+    }
+
+private:
+    QAbstractVideoSurface *m_surface;
+    QSharedPointer<QVideoSurfaceDelivery> m_delivery;
+    qint64 m_minimumInterval = 0;
+    QElapsedTimer m_frameClock;
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    QWaitCondition m_idle;
+    QQueue<QVideoFrame> m_frames;
+    QImage::Format m_imageFormat = QImage::Format_Invalid;
+    int m_queueDepth = DefaultQueueDepth;
+    bool m_converting = false;
+    bool m_quit = false;
+};
+
 QVideoSurfaces::QVideoSurfaces(const QVector<QAbstractVideoSurface *> &s, QObject *parent)
     : QAbstractVideoSurface(parent)
     , m_surfaces(s)
@@ -53,20 +307,25 @@ QVideoSurfaces::QVideoSurfaces(const QVector<QAbstractVideoSurface *> &s, QObjec
 
             emit supportedFormatsChanged();
         });
+
+        m_sinks.append(new QVideoSurfaceSink(a));
     }
 }
 
 QVideoSurfaces::~QVideoSurfaces()
 {
+    qDeleteAll(m_sinks);
 }
 
 QList<QVideoFrame::PixelFormat> QVideoSurfaces::supportedPixelFormats(QAbstractVideoBuffer::HandleType type) const
 {
+    // Offer the formats of the first surface first, so that it is served
+    // without conversion, followed by the formats only other surfaces take.
+    // Surfaces not supporting the negotiated format get converted frames.
     QList<QVideoFrame::PixelFormat> result;
-    QMap<QVideoFrame::PixelFormat, int> formats;
     for (auto &s : m_surfaces) {
         for (auto &p : s->supportedPixelFormats(type)) {
-            if (++formats[p] == m_surfaces.size())
+            if (!result.contains(p))
                 result << p;
         }
     }
@@ -76,28 +335,47 @@ QList<QVideoFrame::PixelFormat> QVideoSurfaces::supportedPixelFormats(QAbstractV
 
 bool QVideoSurfaces::start(const QVideoSurfaceFormat &format)
 {
-    bool result = true;
-    for (auto &s : m_surfaces)
-        result &= s->start(format);
+    // Every surface has to accept the format, otherwise none is started
+    for (int i = 0; i < m_sinks.size(); ++i) {
+        if (!m_sinks[i]->startSurface(format)) {
+            qWarning() << "QVideoSurfaces: surface" << m_surfaces[i] << "failed to start with" << format;
+            for (int j = 0; j < i; ++j)
+                m_sinks[j]->stopSurface();
+            setError(UnsupportedFormatError);
+            return false;
+        }
+    }
 
-    return result && QAbstractVideoSurface::start(format);
+    return QAbstractVideoSurface::start(format);
 }
 
 void QVideoSurfaces::stop()
 {
-    for (auto &s : m_surfaces)
-        s->stop();
+    for (auto &sink : m_sinks)
+        sink->stopSurface();
 
     QAbstractVideoSurface::stop();
 }
 
 bool QVideoSurfaces::present(const QVideoFrame &frame)
 {
-    bool result = true;
-    for (auto &s : m_surfaces)
-        result &= s->present(frame);
+    if (!isActive()) {
+        setError(StoppedError);
+        return false;
+    }
 
-    return result;
+    // Surfaces report failures asynchronously, from their own thread. Keep
+    // feeding the others as long as at least one still takes frames.
+    bool presented = false;
+    for (auto &sink : m_sinks)
+        presented |= sink->present(frame);
+
+    if (!presented) {
+        setError(ResourceError);
+        return false;
+    }
+
+    return true;
 }
 
 QT_END_NAMESPACE
@@ -56,7 +56,13 @@
 
 QT_BEGIN_NAMESPACE
 
-class QVideoSurfaces : public QAbstractVideoSurface
+class QVideoSurfaceSink;
+
+// Fans out video frames to several surfaces. Frames are always presented on
+// the thread of each surface, through a bounded queue per surface, so that a
+// slow surface does not hold back the others. Surfaces that do not support the negotiated pixel format
+// receive frames converted to a format they support on a worker thread.
+class Q_AUTOTEST_EXPORT QVideoSurfaces : public QAbstractVideoSurface
 {
 public:
     QVideoSurfaces(const QVector<QAbstractVideoSurface *> &surfaces, QObject *parent = nullptr);
@@ -69,6 +75,7 @@ public:
 
 private:
     QVector<QAbstractVideoSurface *> m_surfaces;
+    QVector<QVideoSurfaceSink *> m_sinks;
     Q_DISABLE_COPY(QVideoSurfaces)
 };
 
@@ -45,6 +45,7 @@
 #include <qvariant.h>
 #include <qvideosurfaceformat.h>
 #include <private/qmediaopenglhelper_p.h>
+#include <private/qvideoframeconversionhelper_p.h>
 
 #if QT_CONFIG(opengl)
 #include <QOpenGLContext>
@@ -88,17 +89,21 @@ public:
 
 private:
     QList<QVideoFrame::PixelFormat> m_imagePixelFormats;
+    QList<QVideoFrame::PixelFormat> m_yuvPixelFormats;
     QVideoFrame m_frame;
     QSize m_imageSize;
     QImage::Format m_imageFormat;
+    QImage m_convertedImage;
     QVideoSurfaceFormat::Direction m_scanLineDirection;
     bool m_mirrored;
+    bool m_yuv;
 };
 
 QVideoSurfaceGenericPainter::QVideoSurfaceGenericPainter()
     : m_imageFormat(QImage::Format_Invalid)
     , m_scanLineDirection(QVideoSurfaceFormat::TopToBottom)
     , m_mirrored(false)
+    , m_yuv(false)
 {
     m_imagePixelFormats << QVideoFrame::Format_RGB32;
 
@@ -110,6 +115,14 @@ QVideoSurfaceGenericPainter::QVideoSurfaceGenericPainter()
 
      m_imagePixelFormats << QVideoFrame::Format_ARGB32
                          << QVideoFrame::Format_RGB565;
+
+    // Converted to RGB32 while painting, only for frames in memory
+    m_yuvPixelFormats << QVideoFrame::Format_YUV420P
+                      << QVideoFrame::Format_YV12
+                      << QVideoFrame::Format_NV12
+                      << QVideoFrame::Format_NV21
+                      << QVideoFrame::Format_UYVY
+                      << QVideoFrame::Format_YUYV;
 }
 
 QList<QVideoFrame::PixelFormat> QVideoSurfaceGenericPainter::supportedPixelFormats(
@@ -117,8 +130,9 @@ QList<QVideoFrame::PixelFormat> QVideoSurfaceGenericPainter::supportedPixelForma
 {
     switch (handleType) {
     case QAbstractVideoBuffer::QPixmapHandle:
-    case QAbstractVideoBuffer::NoHandle:
         return m_imagePixelFormats;
+    case QAbstractVideoBuffer::NoHandle:
+        return m_imagePixelFormats + m_yuvPixelFormats;
     default:
         ;
     }
@@ -131,7 +145,8 @@ bool QVideoSurfaceGenericPainter::isFormatSupported(const QVideoSurfaceFormat &f
     case QAbstractVideoBuffer::QPixmapHandle:
         return true;
     case QAbstractVideoBuffer::NoHandle:
-        return m_imagePixelFormats.contains(format.pixelFormat())
+        return (m_imagePixelFormats.contains(format.pixelFormat())
+                || m_yuvPixelFormats.contains(format.pixelFormat()))
                && !format.frameSize().isEmpty();
     default:
         ;
@@ -142,12 +157,18 @@ bool QVideoSurfaceGenericPainter::isFormatSupported(const QVideoSurfaceFormat &f
 QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::start(const QVideoSurfaceFormat &format)
 {
     m_frame = QVideoFrame();
+    m_convertedImage = QImage();
     m_imageFormat = QVideoFrame::imageFormatFromPixelFormat(format.pixelFormat());
     // Do not render into ARGB32 images using QPainter.
     // Using QImage::Format_ARGB32_Premultiplied is significantly faster.
     if (m_imageFormat == QImage::Format_ARGB32)
         m_imageFormat = QImage::Format_ARGB32_Premultiplied;
 
+    m_yuv = format.handleType() == QAbstractVideoBuffer::NoHandle
+            && m_yuvPixelFormats.contains(format.pixelFormat());
+    if (m_yuv)
+        m_imageFormat = QImage::Format_RGB32;
+
     m_imageSize = format.frameSize();
     m_scanLineDirection = format.scanLineDirection();
     m_mirrored = format.property("mirrored").toBool();
@@ -170,6 +191,7 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::start(const QVideoSurf
 void QVideoSurfaceGenericPainter::stop()
 {
     m_frame = QVideoFrame();
+    m_convertedImage = QImage();
 }
 
 QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::setCurrentFrame(const QVideoFrame &frame)
@@ -190,12 +212,35 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::paint(
     if (m_frame.handleType() == QAbstractVideoBuffer::QPixmapHandle) {
         painter->drawPixmap(target, m_frame.handle().value<QPixmap>(), source);
     } else if (m_frame.map(QAbstractVideoBuffer::ReadOnly)) {
-        QImage image(
-                m_frame.bits(),
-                m_imageSize.width(),
-                m_imageSize.height(),
-                m_frame.bytesPerLine(),
-                m_imageFormat);
+        QImage image;
+        QRectF imageSource = source;
+        if (m_yuv) {
+            // Convert straight to the size the frame covers on the device, so that
+            // drawImage() below only has to blit. Rotated painters get the source size.
+            const QRect frameSource = source.toAlignedRect() & QRect(QPoint(0, 0), m_imageSize);
+            const QTransform &deviceTransform = painter->deviceTransform();
+            const QSize outputSize = deviceTransform.type() <= QTransform::TxScale
+                    ? deviceTransform.mapRect(target).size().toSize()
+                    : frameSource.size();
+
+            if (!outputSize.isEmpty() && !frameSource.isEmpty()) {
+                if (m_convertedImage.size() != outputSize)
+                    m_convertedImage = QImage(outputSize, QImage::Format_RGB32);
+                if (qt_convert_scaled_YUV_to_ARGB32(
+                            m_frame, frameSource, &m_convertedImage,
+                            painter->testRenderHint(QPainter::SmoothPixmapTransform))) {
+                    image = m_convertedImage;
+                    imageSource = m_convertedImage.rect();
+                }
+            }
+        } else {
+            image = QImage(
+                    m_frame.bits(),
+                    m_imageSize.width(),
+                    m_imageSize.height(),
+                    m_frame.bytesPerLine(),
+                    m_imageFormat);
+        }
 
         const QTransform oldTransform = painter->transform();
         QTransform transform = oldTransform;
@@ -212,7 +257,7 @@ QAbstractVideoSurface::Error QVideoSurfaceGenericPainter::paint(
             targetRect = QRectF(0, targetRect.y(), target.width(), target.height());
         }
         painter->setTransform(transform);
-        painter->drawImage(targetRect, image, source);
+        painter->drawImage(targetRect, image, imageSource);
         painter->setTransform(oldTransform);
 
         m_frame.unmap();
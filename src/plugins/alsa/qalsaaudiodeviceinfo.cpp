@@ -50,23 +50,326 @@
 
 #include "qalsaaudiodeviceinfo.h"
 
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+
 #include <alsa/version.h>
 
 QT_BEGIN_NAMESPACE
 
-QAlsaAudioDeviceInfo::QAlsaAudioDeviceInfo(const QByteArray &dev, QAudio::Mode mode)
+namespace {
+
+struct QAlsaFormatInfo
+{
+    snd_pcm_format_t format;
+    int sampleSize;
+    QAudioFormat::SampleType sampleType;
+    QAudioFormat::Endian byteOrder;
+};
+
+// The 8 bit formats have no byte order, every other entry matches exactly.
+const QAlsaFormatInfo alsaFormats[] = {
+    { SND_PCM_FORMAT_S8, 8, QAudioFormat::SignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_U8, 8, QAudioFormat::UnSignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_S16_LE, 16, QAudioFormat::SignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_S16_BE, 16, QAudioFormat::SignedInt, QAudioFormat::BigEndian },
+    { SND_PCM_FORMAT_U16_LE, 16, QAudioFormat::UnSignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_U16_BE, 16, QAudioFormat::UnSignedInt, QAudioFormat::BigEndian },
+    { SND_PCM_FORMAT_S32_LE, 32, QAudioFormat::SignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_S32_BE, 32, QAudioFormat::SignedInt, QAudioFormat::BigEndian },
+    { SND_PCM_FORMAT_U32_LE, 32, QAudioFormat::UnSignedInt, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_U32_BE, 32, QAudioFormat::UnSignedInt, QAudioFormat::BigEndian },
+    { SND_PCM_FORMAT_FLOAT_LE, 32, QAudioFormat::Float, QAudioFormat::LittleEndian },
+    { SND_PCM_FORMAT_FLOAT_BE, 32, QAudioFormat::Float, QAudioFormat::BigEndian }
+};
+
+snd_pcm_format_t alsaFormat(const QAudioFormat &format)
+{
+    for (const QAlsaFormatInfo &info : alsaFormats) {
+        if (info.sampleSize == format.sampleSize()
+                && info.sampleType == format.sampleType()
+                && (info.sampleSize == 8 || info.byteOrder == format.byteOrder())) {
+            return info.format;
+        }
+    }
+    return SND_PCM_FORMAT_UNKNOWN;
+}
+
+QString pcmName(const QString &device)
+{
+#if SND_LIB_VERSION < 0x1000e  // 1.0.14
+    if (device.compare(QLatin1String("default")) != 0)
+        return QAlsaAudioDeviceInfo::deviceFromCardName(device);
+#endif
+    return device;
+}
+
+// Changes whenever a sound card is added or removed.
+QByteArray cardSignature()
+{
+    QFile cards(QStringLiteral("/proc/asound/cards"));
+    if (cards.open(QIODevice::ReadOnly))
+        return cards.readAll();
+
+    QByteArray signature;
+    int card = -1;
+    while (snd_card_next(&card) == 0 && card >= 0)
+        signature += QByteArray::number(card) + ' ';
+    return signature;
+}
+
+struct QAlsaDeviceCapabilities
+{
+    bool valid = false;
+    bool busy = false;
+    unsigned int minRate = 0;
+    unsigned int maxRate = 0;
+    unsigned int minChannels = 0;
+    unsigned int maxChannels = 0;
+    QList<int> sampleRates;
+    QVector<snd_pcm_format_t> formats;
+};
+
+// Probed once and kept until the set of sound cards changes. All members
+// are guarded by mutex.
+struct QAlsaDeviceCache
+{
+    // The card list is checked at most this often
+    enum { RefreshInterval = 1000 };
+
+    void refresh();
+    void scanDevices();
+    QAlsaDeviceCapabilities capabilities(const QString &device, QAudio::Mode mode);
+    bool negotiate(const QString &device, QAudio::Mode mode, const QAudioFormat &format,
+                   snd_pcm_format_t pcmFormat);
+
+    QMutex mutex;
+    QByteArray cards;
+    QElapsedTimer cardsChecked;
+    bool scanned = false;
+    QList<QByteArray> devices[2];
+    bool surround40 = false;
+    bool surround51 = false;
+    bool surround71 = false;
+    QHash<QString, QAlsaDeviceCapabilities> probed[2];
+    QHash<QString, bool> negotiated[2];
+    // Answers from before the last change of cards, used for devices
+    // which are busy when they are asked about again.
+    QHash<QString, QAlsaDeviceCapabilities> previousProbed[2];
+    QHash<QString, bool> previousNegotiated[2];
+};
+
+void QAlsaDeviceCache::refresh()
 {
-    handle = 0;
+    if (scanned && cardsChecked.isValid() && cardsChecked.elapsed() < RefreshInterval)
+        return;
+
+    QByteArray current = cardSignature();
+    cardsChecked.start();
+    if (scanned && current == cards)
+        return;
 
+    cards = current;
+    for (int mode = 0; mode < 2; ++mode) {
+        for (auto it = probed[mode].cbegin(); it != probed[mode].cend(); ++it)
+            previousProbed[mode].insert(it.key(), it.value());
+        for (auto it = negotiated[mode].cbegin(); it != negotiated[mode].cend(); ++it)
+            previousNegotiated[mode].insert(it.key(), it.value());
+        probed[mode].clear();
+        negotiated[mode].clear();
+    }
+    scanDevices();
+    scanned = true;
+}
+
+void QAlsaDeviceCache::scanDevices()
+{
+    surround40 = false;
+    surround51 = false;
+    surround71 = false;
+
+    QList<QByteArray> &input = devices[QAudio::AudioInput];
+    QList<QByteArray> &output = devices[QAudio::AudioOutput];
+    input.clear();
+    output.clear();
+
+#if SND_LIB_VERSION >= 0x1000e  // 1.0.14
+    // Create the lists of all current audio devices for both modes at once
+    void **hints, **n;
+    char *name, *descr, *io;
+
+    if (snd_device_name_hint(-1, "pcm", &hints) < 0) {
+        qWarning() << "no alsa devices available";
+        return;
+    }
+
+    for (n = hints; *n != NULL; ++n) {
+        name = snd_device_name_get_hint(*n, "NAME");
+        if (name != 0 && qstrcmp(name, "null") != 0) {
+            descr = snd_device_name_get_hint(*n, "DESC");
+            io = snd_device_name_get_hint(*n, "IOID");
+
+            if (descr != NULL) {
+                if (io == NULL || qstrcmp(io, "Input") == 0)
+                    input.append(name);
+                if (io == NULL || qstrcmp(io, "Output") == 0)
+                    output.append(name);
+
+                if (strstr(name, "surround40"))
+                    surround40 = true;
+                if (strstr(name, "surround51"))
+                    surround51 = true;
+                if (strstr(name, "surround71"))
+                    surround71 = true;
+            }
+
+            free(descr);
+            free(io);
+        }
+        free(name);
+    }
+    snd_device_name_free_hint(hints);
+#else
+    int idx = 0;
+    char* name;
+
+    while(snd_card_get_name(idx,&name) == 0) {
+        input.append(name);
+        output.append(name);
+        free(name);
+        idx++;
+    }
+#endif
+
+    for (QList<QByteArray> &list : devices) {
+        if (!list.isEmpty() && !list.contains("default"))
+            list.prepend("default");
+    }
+}
+
+QAlsaDeviceCapabilities QAlsaDeviceCache::capabilities(const QString &device, QAudio::Mode mode)
+{
+    refresh();
+
+    auto it = probed[mode].constFind(device);
+    if (it != probed[mode].constEnd())
+        return *it;
+
+    QAlsaDeviceCapabilities caps;
+    snd_pcm_t *handle;
+    snd_pcm_hw_params_t *params;
+
+    snd_pcm_stream_t stream = mode == QAudio::AudioOutput
+                            ? SND_PCM_STREAM_PLAYBACK : SND_PCM_STREAM_CAPTURE;
+
+    // Don't wait for a device that is in use, and don't remember it as
+    // unusable either; it is probed again once it has been released.
+    int err = snd_pcm_open(&handle, pcmName(device).toLocal8Bit().constData(),
+                           stream, SND_PCM_NONBLOCK);
+    if (err == -EBUSY || err == -EAGAIN) {
+        it = previousProbed[mode].constFind(device);
+        if (it != previousProbed[mode].constEnd())
+            return *it;
+        caps.busy = true;
+        return caps;
+    }
+
+    if (err >= 0) {
+        snd_pcm_hw_params_alloca(&params);
+        if (snd_pcm_hw_params_any(handle, params) >= 0) {
+            int dir = 0;
+            caps.valid = snd_pcm_hw_params_get_rate_min(params, &caps.minRate, &dir) >= 0
+                    && snd_pcm_hw_params_get_rate_max(params, &caps.maxRate, &dir) >= 0
+                    && snd_pcm_hw_params_get_channels_min(params, &caps.minChannels) >= 0
+                    && snd_pcm_hw_params_get_channels_max(params, &caps.maxChannels) >= 0;
+
+            for (int i = 0; caps.valid && i < (int)MAX_SAMPLE_RATES; i++) {
+                if (snd_pcm_hw_params_test_rate(handle, params, SAMPLE_RATES[i], 0) == 0)
+                    caps.sampleRates.append(SAMPLE_RATES[i]);
+            }
+            for (const QAlsaFormatInfo &info : alsaFormats) {
+                if (caps.valid && snd_pcm_hw_params_test_format(handle, params, info.format) == 0)
+                    caps.formats.append(info.format);
+            }
+        }
+        snd_pcm_close(handle);
+    }
+
+    probed[mode].insert(device, caps);
+    return caps;
+}
+
+// Runs a full hw_params negotiation, since the hardware may not be able to
+// configure a combination of settings that are each supported on their own.
+bool QAlsaDeviceCache::negotiate(const QString &device, QAudio::Mode mode,
+                                 const QAudioFormat &format, snd_pcm_format_t pcmFormat)
+{
+    refresh();
+
+    const QString key = QStringLiteral("%1|%2|%3|%4").arg(device).arg(format.sampleRate())
+            .arg(format.channelCount()).arg(int(pcmFormat));
+    auto it = negotiated[mode].constFind(key);
+    if (it != negotiated[mode].constEnd())
+        return *it;
+
+    snd_pcm_t *handle;
+    snd_pcm_hw_params_t *params;
+
+    snd_pcm_stream_t stream = mode == QAudio::AudioOutput
+                            ? SND_PCM_STREAM_PLAYBACK : SND_PCM_STREAM_CAPTURE;
+
+    // A device that is in use, typically by this application, can't be
+    // negotiated with. Keep an earlier answer if there is one, otherwise go
+    // by the probed ranges, which the caller has already checked.
+    int err = snd_pcm_open(&handle, pcmName(device).toLocal8Bit().constData(),
+                           stream, SND_PCM_NONBLOCK);
+    if (err == -EBUSY || err == -EAGAIN)
+        return previousNegotiated[mode].value(key, true);
+
+    if (err >= 0) {
+        snd_pcm_hw_params_alloca(&params);
+        err = snd_pcm_hw_params_any(handle, params);
+
+        if (err >= 0)
+            err = snd_pcm_hw_params_set_format(handle, params, pcmFormat);
+
+        if (err >= 0 && format.channelCount() != -1) {
+            err = snd_pcm_hw_params_test_channels(handle, params, format.channelCount());
+            if (err >= 0)
+                err = snd_pcm_hw_params_set_channels(handle, params, format.channelCount());
+        }
+
+        if (err >= 0 && format.sampleRate() != -1) {
+            err = snd_pcm_hw_params_test_rate(handle, params, format.sampleRate(), 0);
+            if (err >= 0)
+                err = snd_pcm_hw_params_set_rate(handle, params, format.sampleRate(), 0);
+        }
+
+        if (err >= 0)
+            err = snd_pcm_hw_params(handle, params);
+
+        snd_pcm_close(handle);
+    }
+
+    negotiated[mode].insert(key, err == 0);
+    return err == 0;
+}
+
+} // namespace
+
+Q_GLOBAL_STATIC(QAlsaDeviceCache, deviceCache)
+
+QAlsaAudioDeviceInfo::QAlsaAudioDeviceInfo(const QByteArray &dev, QAudio::Mode mode)
+{
     device = QLatin1String(dev);
     this->mode = mode;
-
-    checkSurround();
 }
 
 QAlsaAudioDeviceInfo::~QAlsaAudioDeviceInfo()
 {
-    close();
 }
 
 bool QAlsaAudioDeviceInfo::isFormatSupported(const QAudioFormat& format) const
@@ -149,128 +452,45 @@ QByteArray QAlsaAudioDeviceInfo::defaultDevice(QAudio::Mode mode)
     return devices.first();
 }
 
-bool QAlsaAudioDeviceInfo::open()
+bool QAlsaAudioDeviceInfo::testSettings(const QAudioFormat& format) const
 {
-    int err = 0;
-    QString dev;
-
-    if (!availableDevices(mode).contains(device.toLocal8Bit()))
+    // For now, just accept only audio/pcm codec
+    if (!format.codec().startsWith(QLatin1String("audio/pcm")))
         return false;
 
-#if SND_LIB_VERSION < 0x1000e  // 1.0.14
-    if (device.compare(QLatin1String("default")) != 0)
-        dev = deviceFromCardName(device);
-    else
-#endif
-        dev = device;
-
-    if(mode == QAudio::AudioOutput) {
-        err=snd_pcm_open( &handle,dev.toLocal8Bit().constData(),SND_PCM_STREAM_PLAYBACK,0);
-    } else {
-        err=snd_pcm_open( &handle,dev.toLocal8Bit().constData(),SND_PCM_STREAM_CAPTURE,0);
-    }
-    if(err < 0) {
-        handle = 0;
+    const snd_pcm_format_t pcmFormat = alsaFormat(format);
+    if (pcmFormat == SND_PCM_FORMAT_UNKNOWN)
         return false;
-    }
-    return true;
-}
 
-void QAlsaAudioDeviceInfo::close()
-{
-    if(handle)
-        snd_pcm_close(handle);
-    handle = 0;
-}
-
-bool QAlsaAudioDeviceInfo::testSettings(const QAudioFormat& format) const
-{
-    // Set nearest to closest settings that do work.
-    // See if what is in settings will work (return value).
-    int err = -1;
-    snd_pcm_t* pcmHandle;
-    snd_pcm_hw_params_t *params;
-    QString dev;
+    QMutexLocker locker(&deviceCache()->mutex);
+    QAlsaDeviceCache *cache = deviceCache();
 
-#if SND_LIB_VERSION < 0x1000e  // 1.0.14
-    if (device.compare(QLatin1String("default")) != 0)
-        dev = deviceFromCardName(device);
-    else
-#endif
-        dev = device;
+    // The probed ranges rule out most formats without opening the device
+    const QAlsaDeviceCapabilities caps = cache->capabilities(device, mode);
 
-    snd_pcm_stream_t stream = mode == QAudio::AudioOutput
-                            ? SND_PCM_STREAM_PLAYBACK : SND_PCM_STREAM_CAPTURE;
+    // Nothing is known about a device which has been busy ever since it
+    // appeared, so leave the decision to opening it.
+    if (caps.busy)
+        return true;
 
-    if (snd_pcm_open(&pcmHandle, dev.toLocal8Bit().constData(), stream, 0) < 0)
+    if (!caps.valid || !caps.formats.contains(pcmFormat))
         return false;
 
-    snd_pcm_nonblock(pcmHandle, 0);
-    snd_pcm_hw_params_alloca(&params);
-    snd_pcm_hw_params_any(pcmHandle, params);
-
-    // set the values!
-    snd_pcm_hw_params_set_channels(pcmHandle, params, format.channelCount());
-    snd_pcm_hw_params_set_rate(pcmHandle, params, format.sampleRate(), 0);
-
-    snd_pcm_format_t pcmFormat = SND_PCM_FORMAT_UNKNOWN;
-    switch (format.sampleSize()) {
-    case 8:
-        if (format.sampleType() == QAudioFormat::SignedInt)
-            pcmFormat = SND_PCM_FORMAT_S8;
-        else if (format.sampleType() == QAudioFormat::UnSignedInt)
-            pcmFormat = SND_PCM_FORMAT_U8;
-        break;
-    case 16:
-        if (format.sampleType() == QAudioFormat::SignedInt) {
-            pcmFormat = format.byteOrder() == QAudioFormat::LittleEndian
-                      ? SND_PCM_FORMAT_S16_LE : SND_PCM_FORMAT_S16_BE;
-        } else if (format.sampleType() == QAudioFormat::UnSignedInt) {
-            pcmFormat = format.byteOrder() == QAudioFormat::LittleEndian
-                      ? SND_PCM_FORMAT_U16_LE : SND_PCM_FORMAT_U16_BE;
-        }
-        break;
-    case 32:
-        if (format.sampleType() == QAudioFormat::SignedInt) {
-            pcmFormat = format.byteOrder() == QAudioFormat::LittleEndian
-                      ? SND_PCM_FORMAT_S32_LE : SND_PCM_FORMAT_S32_BE;
-        } else if (format.sampleType() == QAudioFormat::UnSignedInt) {
-            pcmFormat = format.byteOrder() == QAudioFormat::LittleEndian
-                      ? SND_PCM_FORMAT_U32_LE : SND_PCM_FORMAT_U32_BE;
-        } else if (format.sampleType() == QAudioFormat::Float) {
-            pcmFormat = format.byteOrder() == QAudioFormat::LittleEndian
-                      ? SND_PCM_FORMAT_FLOAT_LE : SND_PCM_FORMAT_FLOAT_BE;
-        }
-    }
-
-    if (pcmFormat != SND_PCM_FORMAT_UNKNOWN)
-        err = snd_pcm_hw_params_set_format(pcmHandle, params, pcmFormat);
-
-    // For now, just accept only audio/pcm codec
-    if (!format.codec().startsWith(QLatin1String("audio/pcm")))
-        err = -1;
-
-    if (err >= 0 && format.channelCount() != -1) {
-        err = snd_pcm_hw_params_test_channels(pcmHandle, params, format.channelCount());
-        if (err >= 0)
-            err = snd_pcm_hw_params_set_channels(pcmHandle, params, format.channelCount());
+    if (format.channelCount() != -1
+            && (format.channelCount() < 0
+                || uint(format.channelCount()) < caps.minChannels
+                || uint(format.channelCount()) > caps.maxChannels)) {
+        return false;
     }
 
-    if (err >= 0 && format.sampleRate() != -1) {
-        err = snd_pcm_hw_params_test_rate(pcmHandle, params, format.sampleRate(), 0);
-        if (err >= 0)
-            err = snd_pcm_hw_params_set_rate(pcmHandle, params, format.sampleRate(), 0);
+    if (format.sampleRate() != -1
+            && (format.sampleRate() < 0
+                || uint(format.sampleRate()) < caps.minRate
+                || uint(format.sampleRate()) > caps.maxRate)) {
+        return false;
     }
 
-    if (err >= 0 && pcmFormat != SND_PCM_FORMAT_UNKNOWN)
-        err = snd_pcm_hw_params_set_format(pcmHandle, params, pcmFormat);
-
-    if (err >= 0)
-        err = snd_pcm_hw_params(pcmHandle, params);
-
-    snd_pcm_close(pcmHandle);
-
-    return (err == 0);
+    return cache->negotiate(device, mode, format, pcmFormat);
 }
 
 void QAlsaAudioDeviceInfo::updateLists()
@@ -283,132 +503,63 @@ void QAlsaAudioDeviceInfo::updateLists()
     typez.clear();
     codecz.clear();
 
-    if(!handle)
-        open();
-
-    if(!handle)
-        return;
-
-    for(int i=0; i<(int)MAX_SAMPLE_RATES; i++) {
-        //if(snd_pcm_hw_params_test_rate(handle, params, SAMPLE_RATES[i], dir) == 0)
-        sampleRatez.append(SAMPLE_RATES[i]);
-    }
-    channelz.append(1);
-    channelz.append(2);
-    if (surround40) channelz.append(4);
-    if (surround51) channelz.append(6);
-    if (surround71) channelz.append(8);
-    sizez.append(8);
-    sizez.append(16);
-    sizez.append(32);
-    byteOrderz.append(QAudioFormat::LittleEndian);
-    byteOrderz.append(QAudioFormat::BigEndian);
-    typez.append(QAudioFormat::SignedInt);
-    typez.append(QAudioFormat::UnSignedInt);
-    typez.append(QAudioFormat::Float);
-    codecz.append(QLatin1String("audio/pcm"));
-    close();
-}
-
-QList<QByteArray> QAlsaAudioDeviceInfo::availableDevices(QAudio::Mode mode)
-{
-    QList<QByteArray> devices;
-    bool hasDefault = false;
-
-#if SND_LIB_VERSION >= 0x1000e  // 1.0.14
-    QByteArray filter;
-
-    // Create a list of all current audio devices that support mode
-    void **hints, **n;
-    char *name, *descr, *io;
-
-    if(snd_device_name_hint(-1, "pcm", &hints) < 0) {
-        qWarning() << "no alsa devices available";
-        return devices;
-    }
-    n = hints;
-
-    if(mode == QAudio::AudioInput) {
-        filter = "Input";
-    } else {
-        filter = "Output";
+    QAlsaDeviceCapabilities caps;
+    bool surround[3] = { false, false, false };
+    {
+        QMutexLocker locker(&deviceCache()->mutex);
+        QAlsaDeviceCache *cache = deviceCache();
+        cache->refresh();
+        if (!cache->devices[mode].contains(device.toLocal8Bit()))
+            return;
+        caps = cache->capabilities(device, mode);
+        if (mode == QAudio::AudioOutput) {
+            surround[0] = cache->surround40;
+            surround[1] = cache->surround51;
+            surround[2] = cache->surround71;
+        }
     }
 
-    while (*n != NULL) {
-        name = snd_device_name_get_hint(*n, "NAME");
-        if (name != 0 && qstrcmp(name, "null") != 0) {
-            descr = snd_device_name_get_hint(*n, "DESC");
-            io = snd_device_name_get_hint(*n, "IOID");
+    if (!caps.valid)
+        return;
 
-            if ((descr != NULL) && ((io == NULL) || (io == filter))) {
-                devices.append(name);
-                if (strcmp(name, "default") == 0)
-                    hasDefault = true;
-            }
+    sampleRatez = caps.sampleRates;
 
-            free(descr);
-            free(io);
+    // Plugin devices accept almost any channel count, so only advertise
+    // multichannel layouts when a matching surround device is configured.
+    const int channelCounts[] = { 1, 2, 4, 6, 8 };
+    for (int i = 0; i < 5; i++) {
+        const uint count = channelCounts[i];
+        if (count >= caps.minChannels && count <= caps.maxChannels
+                && (count <= 2 || surround[i - 2])) {
+            channelz.append(count);
         }
-        free(name);
-        ++n;
     }
-    snd_device_name_free_hint(hints);
-#else
-    int idx = 0;
-    char* name;
 
-    while(snd_card_get_name(idx,&name) == 0) {
-        devices.append(name);
-        if (strcmp(name, "default") == 0)
-            hasDefault = true;
-        idx++;
+    for (const QAlsaFormatInfo &info : alsaFormats) {
+        if (!caps.formats.contains(info.format))
+            continue;
+        if (!sizez.contains(info.sampleSize))
+            sizez.append(info.sampleSize);
+        if (!typez.contains(info.sampleType))
+            typez.append(info.sampleType);
+        if (info.sampleSize == 8) {
+            if (!byteOrderz.contains(QAudioFormat::LittleEndian))
+                byteOrderz.append(QAudioFormat::LittleEndian);
+            if (!byteOrderz.contains(QAudioFormat::BigEndian))
+                byteOrderz.append(QAudioFormat::BigEndian);
+        } else if (!byteOrderz.contains(info.byteOrder)) {
+            byteOrderz.append(info.byteOrder);
+        }
     }
-#endif
 
-    if (!hasDefault && devices.size() > 0)
-        devices.prepend("default");
-
-    return devices;
+    codecz.append(QLatin1String("audio/pcm"));
 }
 
-void QAlsaAudioDeviceInfo::checkSurround()
+QList<QByteArray> QAlsaAudioDeviceInfo::availableDevices(QAudio::Mode mode)
 {
-    surround40 = false;
-    surround51 = false;
-    surround71 = false;
-
-    void **hints, **n;
-    char *name, *descr, *io;
-
-    if(snd_device_name_hint(-1, "pcm", &hints) < 0)
-        return;
-
-    n = hints;
-
-    while (*n != NULL) {
-        name = snd_device_name_get_hint(*n, "NAME");
-        descr = snd_device_name_get_hint(*n, "DESC");
-        io = snd_device_name_get_hint(*n, "IOID");
-        if((name != NULL) && (descr != NULL)) {
-            QString deviceName = QLatin1String(name);
-            if (mode == QAudio::AudioOutput) {
-                if(deviceName.contains(QLatin1String("surround40")))
-                    surround40 = true;
-                if(deviceName.contains(QLatin1String("surround51")))
-                    surround51 = true;
-                if(deviceName.contains(QLatin1String("surround71")))
-                    surround71 = true;
-            }
-        }
-        if(name != NULL)
-            free(name);
-        if(descr != NULL)
-            free(descr);
-        if(io != NULL)
-            free(io);
-        ++n;
-    }
-    snd_device_name_free_hint(hints);
+    QMutexLocker locker(&deviceCache()->mutex);
+    deviceCache()->refresh();
+    return deviceCache()->devices[mode];
 }
 
 QString QAlsaAudioDeviceInfo::deviceFromCardName(const QString &card)
@@ -93,14 +93,6 @@ public:
     static QString deviceFromCardName(const QString &card);
 
 private:
-    bool open();
-    void close();
-
-    void checkSurround();
-    bool surround40;
-    bool surround51;
-    bool surround71;
-
     QString device;
     QAudio::Mode mode;
     QAudioFormat nearest;
@@ -110,8 +102,6 @@ private:
     QList<QAudioFormat::Endian> byteOrderz;
     QStringList codecz;
     QList<QAudioFormat::SampleType> typez;
-    snd_pcm_t* handle;
-    snd_pcm_hw_params_t *params;
 };
 
 QT_END_NAMESPACE
@@ -666,6 +666,10 @@ QCameraImageCapture::DriveMode QAndroidCameraSession::driveMode() const
 
 void QAndroidCameraSession::setDriveMode(QCameraImageCapture::DriveMode mode)
 {
+    // Only single image capture is implemented
+    if (mode != QCameraImageCapture::SingleImageCapture)
+        return;
+
     m_captureImageDriveMode = mode;
 }
 
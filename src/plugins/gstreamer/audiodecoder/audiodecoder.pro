@@ -6,12 +6,14 @@ INCLUDEPATH += $$PWD
 
 HEADERS += \
     $$PWD/qgstreameraudiodecodercontrol.h \
+    $$PWD/qgstreameraudiodecoderconsumercontrol.h \
     $$PWD/qgstreameraudiodecoderservice.h \
     $$PWD/qgstreameraudiodecodersession.h \
     $$PWD/qgstreameraudiodecoderserviceplugin.h
 
 SOURCES += \
     $$PWD/qgstreameraudiodecodercontrol.cpp \
+    $$PWD/qgstreameraudiodecoderconsumercontrol.cpp \
     $$PWD/qgstreameraudiodecoderservice.cpp \
     $$PWD/qgstreameraudiodecodersession.cpp \
     $$PWD/qgstreameraudiodecoderserviceplugin.cpp
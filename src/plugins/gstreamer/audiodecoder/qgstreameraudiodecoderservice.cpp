@@ -42,6 +42,7 @@
 
 #include "qgstreameraudiodecoderservice.h"
 #include "qgstreameraudiodecodercontrol.h"
+#include "qgstreameraudiodecoderconsumercontrol.h"
 #include "qgstreameraudiodecodersession.h"
 
 QT_BEGIN_NAMESPACE
@@ -51,6 +52,7 @@ QGstreamerAudioDecoderService::QGstreamerAudioDecoderService(QObject *parent)
 {
     m_session = new QGstreamerAudioDecoderSession(this);
     m_control = new QGstreamerAudioDecoderControl(m_session, this);
+    m_consumerControl = new QGstreamerAudioDecoderConsumerControl(m_session, this);
 }
 
 QGstreamerAudioDecoderService::~QGstreamerAudioDecoderService()
@@ -62,6 +64,9 @@ QMediaControl *QGstreamerAudioDecoderService::requestControl(const char *name)
     if (qstrcmp(name, QAudioDecoderControl_iid) == 0)
         return m_control;
 
+    if (qstrcmp(name, QAudioDecoderConsumerControl_iid) == 0)
+        return m_consumerControl;
+
     return 0;
 }
 
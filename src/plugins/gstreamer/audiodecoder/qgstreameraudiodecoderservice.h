@@ -47,6 +47,7 @@
 
 QT_BEGIN_NAMESPACE
 class QGstreamerAudioDecoderControl;
+class QGstreamerAudioDecoderConsumerControl;
 class QGstreamerAudioDecoderSession;
 
 class QGstreamerAudioDecoderService : public QMediaService
@@ -61,6 +62,7 @@ public:
 
 private:
     QGstreamerAudioDecoderControl *m_control;
+    QGstreamerAudioDecoderConsumerControl *m_consumerControl;
     QGstreamerAudioDecoderSession *m_session;
 };
 
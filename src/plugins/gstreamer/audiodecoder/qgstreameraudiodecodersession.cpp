@@ -42,6 +42,7 @@
 #include <private/qgstreamerbushelper_p.h>
 
 #include <private/qgstutils_p.h>
+#include <private/qaudiodecoderconsumer_p.h>
 
 #include <gst/gstvalue.h>
 #include <gst/base/gstbasesrc.h>
@@ -86,6 +87,7 @@ QGstreamerAudioDecoderSession::QGstreamerAudioDecoderSession(QObject *parent)
 #endif
      mDevice(0),
      m_buffersAvailable(0),
+     m_bufferQueueDepth(MAX_BUFFERS_IN_QUEUE),
      m_position(-1),
      m_duration(-1),
      m_durationQueries(0)
@@ -389,6 +391,13 @@ void QGstreamerAudioDecoderSession::start()
 void QGstreamerAudioDecoderSession::stop()
 {
     if (m_playbin) {
+        // The streaming thread might be waiting for the consumer
+        {
+            QMutexLocker locker(&m_buffersMutex);
+            if (m_consumer)
+                m_consumer->cancel();
+        }
+
         gst_element_set_state(m_playbin, GST_STATE_NULL);
         removeAppSink();
 
@@ -448,42 +457,58 @@ QAudioBuffer QGstreamerAudioDecoderSession::read()
         if (buffersAvailable == 1)
             emit bufferAvailableChanged(false);
 
-        const char* bufferData = 0;
-        int bufferSize = 0;
-
-#if GST_CHECK_VERSION(1,0,0)
-        GstSample *sample = gst_app_sink_pull_sample(m_appSink);
-        GstBuffer *buffer = gst_sample_get_buffer(sample);
-        GstMapInfo mapInfo;
-        gst_buffer_map(buffer, &mapInfo, GST_MAP_READ);
-        bufferData = (const char*)mapInfo.data;
-        bufferSize = mapInfo.size;
-        QAudioFormat format = QGstUtils::audioFormatForSample(sample);
-#else
-        GstBuffer *buffer = gst_app_sink_pull_buffer(m_appSink);
-        bufferData = (const char*)buffer->data;
-        bufferSize = buffer->size;
-        QAudioFormat format = QGstUtils::audioFormatForBuffer(buffer);
-#endif
-
-        if (format.isValid()) {
-            // XXX At the moment we have to copy data from GstBuffer into QAudioBuffer.
-            // We could improve performance by implementing QAbstractAudioBuffer for GstBuffer.
-            qint64 position = getPositionFromBuffer(buffer);
-            audioBuffer = QAudioBuffer(QByteArray((const char*)bufferData, bufferSize), format, position);
+        audioBuffer = pullBuffer(m_appSink);
+        if (audioBuffer.isValid()) {
+            qint64 position = audioBuffer.startTime();
             position /= 1000; // convert to milliseconds
             if (position != m_position) {
                 m_position = position;
                 emit positionChanged(m_position);
             }
         }
+    }
+
+    return audioBuffer;
+}
+
+QAudioBuffer QGstreamerAudioDecoderSession::pullBuffer(GstAppSink *appSink)
+{
+    QAudioBuffer audioBuffer;
+
+    const char* bufferData = 0;
+    int bufferSize = 0;
+
 #if GST_CHECK_VERSION(1,0,0)
-        gst_buffer_unmap(buffer, &mapInfo);
-        gst_sample_unref(sample);
+    GstSample *sample = gst_app_sink_pull_sample(appSink);
+    if (!sample)
+        return audioBuffer;
+    GstBuffer *buffer = gst_sample_get_buffer(sample);
+    GstMapInfo mapInfo;
+    gst_buffer_map(buffer, &mapInfo, GST_MAP_READ);
+    bufferData = (const char*)mapInfo.data;
+    bufferSize = mapInfo.size;
+    QAudioFormat format = QGstUtils::audioFormatForSample(sample);
 #else
-        gst_buffer_unref(buffer);
+    GstBuffer *buffer = gst_app_sink_pull_buffer(appSink);
+    if (!buffer)
+        return audioBuffer;
+    bufferData = (const char*)buffer->data;
+    bufferSize = buffer->size;
+    QAudioFormat format = QGstUtils::audioFormatForBuffer(buffer);
 #endif
+
+    if (format.isValid()) {
+        // XXX At the moment we have to copy data from GstBuffer into QAudioBuffer.
+        // We could improve performance by implementing QAbstractAudioBuffer for GstBuffer.
+        qint64 position = getPositionFromBuffer(buffer);
+        audioBuffer = QAudioBuffer(QByteArray((const char*)bufferData, bufferSize), format, position);
     }
+#if GST_CHECK_VERSION(1,0,0)
+    gst_buffer_unmap(buffer, &mapInfo);
+    gst_sample_unref(sample);
+#else
+    gst_buffer_unref(buffer);
+#endif
 
     return audioBuffer;
 }
@@ -510,17 +535,28 @@ void QGstreamerAudioDecoderSession::processInvalidMedia(QAudioDecoder::Error err
     emit error(int(errorCode), errorString);
 }
 
-GstFlowReturn QGstreamerAudioDecoderSession::new_sample(GstAppSink *, gpointer user_data)
+GstFlowReturn QGstreamerAudioDecoderSession::new_sample(GstAppSink *sink, gpointer user_data)
 {
     // "Note that the preroll buffer will also be returned as the first buffer when calling gst_app_sink_pull_buffer()."
     QGstreamerAudioDecoderSession *session = reinterpret_cast<QGstreamerAudioDecoderSession*>(user_data);
 
-    int buffersAvailable;
+    int buffersAvailable = 0;
+    QSharedPointer<QAudioDecoderConsumer> consumer;
     {
         QMutexLocker locker(&session->m_buffersMutex);
-        buffersAvailable = session->m_buffersAvailable;
-        session->m_buffersAvailable++;
-        Q_ASSERT(session->m_buffersAvailable <= MAX_BUFFERS_IN_QUEUE);
+        consumer = session->m_consumer;
+        if (!consumer) {
+            buffersAvailable = session->m_buffersAvailable;
+            session->m_buffersAvailable++;
+            Q_ASSERT(session->m_buffersAvailable <= session->m_bufferQueueDepth);
+        }
+    }
+
+    if (consumer) {
+        // Hand the buffer over on this thread, the consumer throttles
+        // decoding by blocking once its queue is full.
+        consumer->push(pullBuffer(sink));
+        return GST_FLOW_OK;
     }
 
     if (!buffersAvailable)
@@ -529,6 +565,39 @@ GstFlowReturn QGstreamerAudioDecoderSession::new_sample(GstAppSink *, gpointer u
     return GST_FLOW_OK;
 }
 
+void QGstreamerAudioDecoderSession::eos(GstAppSink *, gpointer user_data)
+{
+    QGstreamerAudioDecoderSession *session = reinterpret_cast<QGstreamerAudioDecoderSession*>(user_data);
+
+    QSharedPointer<QAudioDecoderConsumer> consumer;
+    {
+        QMutexLocker locker(&session->m_buffersMutex);
+        consumer = session->m_consumer;
+    }
+
+    // Deliver what is left of a block or the whole file before EOS reaches the bus
+    if (consumer)
+        consumer->finish();
+}
+
+int QGstreamerAudioDecoderSession::bufferQueueDepth() const
+{
+    return m_bufferQueueDepth;
+}
+
+void QGstreamerAudioDecoderSession::setBufferQueueDepth(int depth)
+{
+    m_bufferQueueDepth = qMax(1, depth);
+    if (m_appSink)
+        gst_app_sink_set_max_buffers(m_appSink, m_bufferQueueDepth);
+}
+
+void QGstreamerAudioDecoderSession::setConsumer(const QSharedPointer<QAudioDecoderConsumer> &consumer)
+{
+    QMutexLocker locker(&m_buffersMutex);
+    m_consumer = consumer;
+}
+
 void QGstreamerAudioDecoderSession::setAudioFlags(bool wantNativeAudio)
 {
     int flags = 0;
@@ -558,8 +627,9 @@ void QGstreamerAudioDecoderSession::addAppSink()
 #else
     callbacks.new_buffer = &new_sample;
 #endif
+    callbacks.eos = &eos;
     gst_app_sink_set_callbacks(m_appSink, &callbacks, this, NULL);
-    gst_app_sink_set_max_buffers(m_appSink, MAX_BUFFERS_IN_QUEUE);
+    gst_app_sink_set_max_buffers(m_appSink, m_bufferQueueDepth);
     gst_base_sink_set_sync(GST_BASE_SINK(m_appSink), FALSE);
 
     gst_bin_add(GST_BIN(m_outputBin), GST_ELEMENT(m_appSink));
@@ -43,6 +43,7 @@
 #include <QtMultimedia/private/qtmultimediaglobal_p.h>
 #include <QObject>
 #include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
 #include "qgstreameraudiodecodercontrol.h"
 #include <private/qgstreamerbushelper_p.h>
 #include "qaudiodecoder.h"
@@ -56,6 +57,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QAudioDecoderConsumer;
 class QGstreamerBusHelper;
 class QGstreamerMessage;
 
@@ -99,7 +101,12 @@ public:
     qint64 position() const;
     qint64 duration() const;
 
+    int bufferQueueDepth() const;
+    void setBufferQueueDepth(int depth);
+    void setConsumer(const QSharedPointer<QAudioDecoderConsumer> &consumer);
+
     static GstFlowReturn new_sample(GstAppSink *sink, gpointer user_data);
+    static void eos(GstAppSink *sink, gpointer user_data);
 
 signals:
     void stateChanged(QAudioDecoder::State newState);
@@ -125,6 +132,7 @@ private:
 
     void processInvalidMedia(QAudioDecoder::Error errorCode, const QString& errorString);
     static qint64 getPositionFromBuffer(GstBuffer* buffer);
+    static QAudioBuffer pullBuffer(GstAppSink *appSink);
 
     QAudioDecoder::State m_state;
     QAudioDecoder::State m_pendingState;
@@ -145,6 +153,8 @@ private:
 
     mutable QMutex m_buffersMutex;
     int m_buffersAvailable;
+    int m_bufferQueueDepth;
+    QSharedPointer<QAudioDecoderConsumer> m_consumer;
 
     qint64 m_position;
     qint64 m_duration;
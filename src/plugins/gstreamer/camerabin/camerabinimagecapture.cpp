@@ -41,6 +41,7 @@
 #include "camerabincontrol.h"
 #include "camerabincapturedestination.h"
 #include "camerabincapturebufferformat.h"
+#include "camerabinimageencoder.h"
 #include "camerabinsession.h"
 #include "camerabinresourcepolicy.h"
 #include <private/qgstvideobuffer_p.h>
@@ -49,7 +50,8 @@
 #include <QtMultimedia/qmediametadata.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qbuffer.h>
-#include <QtGui/qimagereader.h>
+#include <QtCore/qthread.h>
+#include <QtGui/qimagewriter.h>
 
 //#define DEBUG_CAPTURE
 
@@ -57,6 +59,56 @@
 
 QT_BEGIN_NAMESPACE
 
+// Reads the image size from the frame header of a JPEG stream,
+// without decoding or copying the data.
+static QSize jpegResolution(const uchar *data, size_t size)
+{
+    if (size < 4 || data[0] != 0xff || data[1] != 0xd8)
+        return QSize();
+
+    size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xff)
+            return QSize();
+
+        const uchar marker = data[pos + 1];
+        if (marker == 0xff) {
+            // fill byte
+            ++pos;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd8)) {
+            // markers without a segment
+            pos += 2;
+            continue;
+        }
+
+        const size_t length = (size_t(data[pos + 2]) << 8) | data[pos + 3];
+
+        // SOF0 - SOF15, except DHT, JPG and DAC which share the range
+        if (marker >= 0xc0 && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc) {
+            if (pos + 9 > size)
+                return QSize();
+            const int height = (data[pos + 5] << 8) | data[pos + 6];
+            const int width = (data[pos + 7] << 8) | data[pos + 8];
+            return QSize(width, height);
+        }
+
+        if (marker == 0xda || length < 2)
+            return QSize();
+
+        pos += 2 + length;
+    }
+
+    return QSize();
+}
+
+static int jpegQuality(QMultimedia::EncodingQuality quality)
+{
+    static const int qualities[] = { 25, 50, 75, 85, 95 };
+    return qualities[qBound(0, int(quality), 4)];
+}
+
 CameraBinImageCapture::CameraBinImageCapture(CameraBinSession *session)
     :QCameraImageCaptureControl(session)
     , m_encoderProbe(this)
@@ -64,9 +116,18 @@ CameraBinImageCapture::CameraBinImageCapture(CameraBinSession *session)
     , m_session(session)
     , m_jpegEncoderElement(0)
     , m_metadataMuxerElement(0)
+    , m_burstProbe(this)
     , m_requestId(0)
     , m_ready(false)
+    , m_driveMode(QCameraImageCapture::SingleImageCapture)
+#if !GST_CHECK_VERSION(1,0,0)
+    , m_burstBytesPerLine(0)
+#endif
+    , m_burstFramesInFlight(0)
+    , m_maxBurstFramesInFlight(qBound(2, QThread::idealThreadCount(), 4))
 {
+    m_burstPool.setMaxThreadCount(m_maxBurstFramesInFlight);
+
     connect(m_session, SIGNAL(statusChanged(QCamera::Status)), SLOT(updateState()));
     connect(m_session, SIGNAL(imageExposed(int)), this, SIGNAL(imageExposed(int)));
     connect(m_session, SIGNAL(imageCaptured(int,QImage)), this, SIGNAL(imageCaptured(int,QImage)));
@@ -77,6 +138,7 @@ CameraBinImageCapture::CameraBinImageCapture(CameraBinSession *session)
 
 CameraBinImageCapture::~CameraBinImageCapture()
 {
+    m_burstPool.waitForDone();
 }
 
 bool CameraBinImageCapture::isReadyForCapture() const
@@ -96,12 +158,44 @@ int CameraBinImageCapture::capture(const QString &fileName)
 #ifdef DEBUG_CAPTURE
     qDebug() << Q_FUNC_INFO << m_requestId << fileName;
 #endif
+
+    if (m_driveMode == QCameraImageCapture::BurstImageCapture) {
+        BurstRequest request;
+        request.id = m_requestId;
+        request.destination = m_session->captureDestinationControl()->captureDestination();
+        if (request.destination & QCameraImageCapture::CaptureToFile)
+            request.fileName = m_session->imageFileName(fileName);
+        request.bufferFormat = m_session->captureBufferFormatControl()->bufferFormat();
+        request.quality = jpegQuality(m_session->imageEncodeControl()->imageSettings().quality());
+
+        QMutexLocker locker(&m_burstMutex);
+        m_burstRequests.enqueue(request);
+        return m_requestId;
+    }
+
     m_session->captureImage(m_requestId, fileName);
     return m_requestId;
 }
 
 void CameraBinImageCapture::cancelCapture()
 {
+    QMutexLocker locker(&m_burstMutex);
+    m_burstRequests.clear();
+}
+
+void CameraBinImageCapture::setDriveMode(QCameraImageCapture::DriveMode mode)
+{
+    if (m_driveMode == mode)
+        return;
+
+    m_driveMode = mode;
+
+    if (m_driveMode == QCameraImageCapture::BurstImageCapture) {
+        m_session->setViewfinderBufferProbe(&m_burstProbe);
+    } else {
+        m_session->setViewfinderBufferProbe(0);
+        cancelCapture();
+    }
 }
 
 void CameraBinImageCapture::updateState()
@@ -221,6 +315,117 @@ bool CameraBinImageCapture::EncoderProbe::probeBuffer(GstBuffer *buffer)
     return keepBuffer;
 }
 
+void CameraBinImageCapture::BurstProbe::probeCaps(GstCaps *caps)
+{
+    QMutexLocker locker(&capture->m_burstMutex);
+#if GST_CHECK_VERSION(1,0,0)
+    capture->m_burstFormat = QGstUtils::formatForCaps(caps, &capture->m_burstVideoInfo);
+#else
+    capture->m_burstFormat = QGstUtils::formatForCaps(caps, &capture->m_burstBytesPerLine);
+#endif
+}
+
+bool CameraBinImageCapture::BurstProbe::probeBuffer(GstBuffer *buffer)
+{
+    QMutexLocker locker(&capture->m_burstMutex);
+
+    // Requests wait for a later frame while the workers are saturated,
+    // this also limits the number of viewfinder buffers held.
+    if (capture->m_burstRequests.isEmpty()
+            || capture->m_burstFramesInFlight >= capture->m_maxBurstFramesInFlight
+            || !capture->m_burstFormat.isValid()) {
+        return true;
+    }
+
+    const BurstRequest request = capture->m_burstRequests.dequeue();
+    ++capture->m_burstFramesInFlight;
+
+#if GST_CHECK_VERSION(1,0,0)
+    QGstVideoBuffer *videoBuffer = new QGstVideoBuffer(buffer, capture->m_burstVideoInfo);
+#else
+    QGstVideoBuffer *videoBuffer = new QGstVideoBuffer(buffer, capture->m_burstBytesPerLine);
+#endif
+    QVideoFrame frame(videoBuffer,
+                      capture->m_burstFormat.frameSize(),
+                      capture->m_burstFormat.pixelFormat());
+    QGstUtils::setFrameTimeStamps(&frame, buffer);
+
+    locker.unlock();
+
+#ifdef DEBUG_CAPTURE
+    qDebug() << "Burst frame for request" << request.id;
+#endif
+
+    QMetaObject::invokeMethod(capture, "imageExposed",
+                              Qt::QueuedConnection,
+                              Q_ARG(int, request.id));
+
+    capture->m_burstPool.start(QRunnable::create([this, request, frame]() {
+        capture->processBurstFrame(request, frame);
+    }));
+
+    return true;
+}
+
+void CameraBinImageCapture::processBurstFrame(const BurstRequest &request, const QVideoFrame &frame)
+{
+    const QImage image = frame.image();
+
+    if (image.isNull()) {
+        QMetaObject::invokeMethod(this, "error",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(int, request.id),
+                                  Q_ARG(int, int(QCameraImageCapture::FormatError)),
+                                  Q_ARG(QString, tr("Could not convert the captured frame")));
+    } else {
+        QMetaObject::invokeMethod(this, "imageCaptured",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(int, request.id),
+                                  Q_ARG(QImage, image));
+
+        if (request.destination & QCameraImageCapture::CaptureToBuffer) {
+            QVideoFrame bufferFrame = frame;
+            if (request.bufferFormat == QVideoFrame::Format_Jpeg) {
+                QByteArray jpeg;
+                QBuffer data(&jpeg);
+                data.open(QIODevice::WriteOnly);
+                image.save(&data, "JPEG", request.quality);
+
+                bufferFrame = QVideoFrame(jpeg.size(), image.size(), 0, QVideoFrame::Format_Jpeg);
+                if (bufferFrame.map(QAbstractVideoBuffer::WriteOnly)) {
+                    memcpy(bufferFrame.bits(), jpeg.constData(), jpeg.size());
+                    bufferFrame.unmap();
+                }
+            }
+
+            QMetaObject::invokeMethod(this, "imageAvailable",
+                                      Qt::QueuedConnection,
+                                      Q_ARG(int, request.id),
+                                      Q_ARG(QVideoFrame, bufferFrame));
+        }
+
+        if (request.destination & QCameraImageCapture::CaptureToFile) {
+            QImageWriter writer(request.fileName, "JPEG");
+            writer.setQuality(request.quality);
+            if (writer.write(image)) {
+                QMetaObject::invokeMethod(this, "imageSaved",
+                                          Qt::QueuedConnection,
+                                          Q_ARG(int, request.id),
+                                          Q_ARG(QString, request.fileName));
+            } else {
+                QMetaObject::invokeMethod(this, "error",
+                                          Qt::QueuedConnection,
+                                          Q_ARG(int, request.id),
+                                          Q_ARG(int, int(QCameraImageCapture::ResourceError)),
+                                          Q_ARG(QString, writer.errorString()));
+            }
+        }
+    }
+
+    QMutexLocker locker(&m_burstMutex);
+    --m_burstFramesInFlight;
+}
+
 void CameraBinImageCapture::MuxerProbe::probeCaps(GstCaps *caps)
 {
     capture->m_jpegResolution = QGstUtils::capsCorrectedResolution(caps);
@@ -241,12 +446,7 @@ bool CameraBinImageCapture::MuxerProbe::probeBuffer(GstBuffer *buffer)
 #if GST_CHECK_VERSION(1,0,0)
         GstMapInfo mapInfo;
         if (resolution.isEmpty() && gst_buffer_map(buffer, &mapInfo, GST_MAP_READ)) {
-            QBuffer data;
-            data.setData(reinterpret_cast<const char*>(mapInfo.data), mapInfo.size);
-
-            QImageReader reader(&data, "JPEG");
-            resolution = reader.size();
-
+            resolution = jpegResolution(mapInfo.data, mapInfo.size);
             gst_buffer_unmap(buffer, &mapInfo);
         }
 
@@ -255,12 +455,8 @@ bool CameraBinImageCapture::MuxerProbe::probeBuffer(GstBuffer *buffer)
                     &info, GST_VIDEO_FORMAT_ENCODED, resolution.width(), resolution.height());
         QGstVideoBuffer *videoBuffer = new QGstVideoBuffer(buffer, info);
 #else
-        if (resolution.isEmpty()) {
-            QBuffer data;
-            data.setData(reinterpret_cast<const char*>(GST_BUFFER_DATA(buffer)), GST_BUFFER_SIZE(buffer));
-            QImageReader reader(&data, "JPEG");
-            resolution = reader.size();
-        }
+        if (resolution.isEmpty())
+            resolution = jpegResolution(GST_BUFFER_DATA(buffer), GST_BUFFER_SIZE(buffer));
 
         QGstVideoBuffer *videoBuffer = new QGstVideoBuffer(buffer,
                                                            -1); //bytesPerLine is not available for jpegs
@@ -46,6 +46,10 @@
 
 #include <qvideosurfaceformat.h>
 
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
+
 #include <private/qgstreamerbufferprobe_p.h>
 
 #if GST_CHECK_VERSION(1,0,0)
@@ -62,8 +66,8 @@ public:
     CameraBinImageCapture(CameraBinSession *session);
     virtual ~CameraBinImageCapture();
 
-    QCameraImageCapture::DriveMode driveMode() const override { return QCameraImageCapture::SingleImageCapture; }
-    void setDriveMode(QCameraImageCapture::DriveMode) override {}
+    QCameraImageCapture::DriveMode driveMode() const override { return m_driveMode; }
+    void setDriveMode(QCameraImageCapture::DriveMode mode) override;
 
     bool isReadyForCapture() const override;
     int capture(const QString &fileName) override;
@@ -104,6 +108,30 @@ private:
 
     } m_muxerProbe;
 
+    struct BurstRequest
+    {
+        int id;
+        QString fileName;
+        QCameraImageCapture::CaptureDestinations destination;
+        QVideoFrame::PixelFormat bufferFormat;
+        int quality;
+    };
+
+    void processBurstFrame(const BurstRequest &request, const QVideoFrame &frame);
+
+    // Serves queued burst requests from viewfinder frames, the frames are
+    // encoded and saved on m_burstPool while the viewfinder keeps running.
+    class BurstProbe : public QGstreamerBufferProbe
+    {
+    public:
+        BurstProbe(CameraBinImageCapture *capture) : capture(capture) {}
+        void probeCaps(GstCaps *caps) override;
+        bool probeBuffer(GstBuffer *buffer) override;
+
+    private:
+        CameraBinImageCapture * const capture;
+    } m_burstProbe;
+
     QVideoSurfaceFormat m_bufferFormat;
     QSize m_jpegResolution;
     CameraBinSession *m_session;
@@ -116,6 +144,19 @@ private:
 #endif
     int m_requestId;
     bool m_ready;
+    QCameraImageCapture::DriveMode m_driveMode;
+
+    QMutex m_burstMutex;
+    QQueue<BurstRequest> m_burstRequests;
+    QVideoSurfaceFormat m_burstFormat;
+#if GST_CHECK_VERSION(1,0,0)
+    GstVideoInfo m_burstVideoInfo;
+#else
+    int m_burstBytesPerLine;
+#endif
+    int m_burstFramesInFlight;
+    int m_maxBurstFramesInFlight;
+    QThreadPool m_burstPool;
 };
 
 QT_END_NAMESPACE
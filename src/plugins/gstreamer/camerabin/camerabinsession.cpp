@@ -145,6 +145,7 @@ CameraBinSession::CameraBinSession(GstElementFactory *sourceFactory, QObject *pa
      m_inputDeviceHasChanged(true),
      m_usingWrapperCameraBinSrc(false),
      m_viewfinderProbe(this),
+     m_viewfinderBufferProbe(0),
      m_audioSrc(0),
      m_audioConvert(0),
      m_capsFilter(0),
@@ -275,6 +276,8 @@ bool CameraBinSession::setupCameraBin()
         if (m_viewfinderElement) {
             GstPad *pad = gst_element_get_static_pad(m_viewfinderElement, "sink");
             m_viewfinderProbe.removeProbeFromPad(pad);
+            if (m_viewfinderBufferProbe)
+                m_viewfinderBufferProbe->removeProbeFromPad(pad);
             gst_object_unref(GST_OBJECT(pad));
             gst_object_unref(GST_OBJECT(m_viewfinderElement));
         }
@@ -292,6 +295,8 @@ bool CameraBinSession::setupCameraBin()
 
         GstPad *pad = gst_element_get_static_pad(m_viewfinderElement, "sink");
         m_viewfinderProbe.addProbeToPad(pad);
+        if (m_viewfinderBufferProbe)
+            m_viewfinderBufferProbe->addProbeToPad(pad);
         gst_object_unref(GST_OBJECT(pad));
 
         g_object_set(G_OBJECT(m_viewfinderElement), "sync", FALSE, NULL);
@@ -591,12 +596,40 @@ GstElement *CameraBinSession::buildCameraSource()
     return m_cameraSrc;
 }
 
+QString CameraBinSession::imageFileName(const QString &fileName)
+{
+    return m_mediaStorageLocation.generateFileName(fileName,
+                                                   QMediaStorageLocation::Pictures,
+                                                   QLatin1String("IMG_"),
+                                                   QLatin1String("jpg"));
+}
+
+/*
+    Installs an additional buffer probe on the viewfinder sink pad,
+    following the viewfinder when it is replaced.
+*/
+void CameraBinSession::setViewfinderBufferProbe(QGstreamerBufferProbe *probe)
+{
+    if (m_viewfinderBufferProbe == probe)
+        return;
+
+    GstPad *pad = m_viewfinderElement ? gst_element_get_static_pad(m_viewfinderElement, "sink") : 0;
+
+    if (m_viewfinderBufferProbe && pad)
+        m_viewfinderBufferProbe->removeProbeFromPad(pad);
+
+    m_viewfinderBufferProbe = probe;
+
+    if (m_viewfinderBufferProbe && pad)
+        m_viewfinderBufferProbe->addProbeToPad(pad);
+
+    if (pad)
+        gst_object_unref(GST_OBJECT(pad));
+}
+
 void CameraBinSession::captureImage(int requestId, const QString &fileName)
 {
-    const QString actualFileName = m_mediaStorageLocation.generateFileName(fileName,
-                                                                           QMediaStorageLocation::Pictures,
-                                                                           QLatin1String("IMG_"),
-                                                                           QLatin1String("jpg"));
+    const QString actualFileName = imageFileName(fileName);
 
     m_requestId = requestId;
 
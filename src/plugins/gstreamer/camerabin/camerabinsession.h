@@ -148,6 +148,9 @@ public:
     void setViewfinderSettings(const QCameraViewfinderSettings &settings) { m_viewfinderSettings = settings; }
 
     void captureImage(int requestId, const QString &fileName);
+    QString imageFileName(const QString &fileName);
+
+    void setViewfinderBufferProbe(QGstreamerBufferProbe *probe);
 
     QCamera::Status status() const;
     QCamera::State pendingState() const;
@@ -272,6 +275,7 @@ private:
     private:
         CameraBinSession * const session;
     } m_viewfinderProbe;
+    QGstreamerBufferProbe *m_viewfinderBufferProbe;
 
     GstElement *m_audioSrc;
     GstElement *m_audioConvert;
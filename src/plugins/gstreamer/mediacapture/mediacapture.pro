@@ -9,6 +9,7 @@ HEADERS += $$PWD/qgstreamercaptureservice.h \
     $$PWD/qgstreameraudioencode.h \
     $$PWD/qgstreamervideoencode.h \
     $$PWD/qgstreamerrecordercontrol.h \
+    $$PWD/qgstreamerrecordersegmentcontrol.h \
     $$PWD/qgstreamermediacontainercontrol.h \
     $$PWD/qgstreamercameracontrol.h \
     $$PWD/qgstreamercapturemetadatacontrol.h \
@@ -21,6 +22,7 @@ SOURCES += $$PWD/qgstreamercaptureservice.cpp \
     $$PWD/qgstreameraudioencode.cpp \
     $$PWD/qgstreamervideoencode.cpp \
     $$PWD/qgstreamerrecordercontrol.cpp \
+    $$PWD/qgstreamerrecordersegmentcontrol.cpp \
     $$PWD/qgstreamermediacontainercontrol.cpp \
     $$PWD/qgstreamercameracontrol.cpp \
     $$PWD/qgstreamercapturemetadatacontrol.cpp \
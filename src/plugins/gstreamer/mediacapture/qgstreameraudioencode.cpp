@@ -208,6 +208,11 @@ GstElement *QGstreamerAudioEncode::createEncoder()
             const QString &option = it.key();
             const QVariant &value = it.value();
 
+            if (m_codecs.codecOption(codec, option).name.isEmpty()) {
+                qWarning() << "unsupported option:" << option;
+                continue;
+            }
+
             switch (value.type()) {
             case QVariant::Int:
                 g_object_set(G_OBJECT(encoderElement), option.toLatin1(), value.toInt(), NULL);
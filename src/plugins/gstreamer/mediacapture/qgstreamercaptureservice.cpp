@@ -41,6 +41,7 @@
 #include "qgstreamercapturesession.h"
 #include "qgstreamerrecordercontrol.h"
 #include "qgstreamermediacontainercontrol.h"
+#include "qgstreamerrecordersegmentcontrol.h"
 #include "qgstreameraudioencode.h"
 #include "qgstreamervideoencode.h"
 #include "qgstreamerimageencode.h"
@@ -56,6 +57,8 @@
 #include <private/qgstreameraudioinputselector_p.h>
 #include <private/qgstreamervideoinputdevicecontrol_p.h>
 #include <private/qgstreameraudioprobecontrol_p.h>
+#include <private/qgstreamerstatisticscontrol_p.h>
+#include <private/qmediastatisticscontrol_p.h>
 
 #include <private/qgstreamervideorenderer_p.h>
 #include <private/qgstreamervideowindow_p.h>
@@ -171,6 +174,12 @@ QMediaControl *QGstreamerCaptureService::requestControl(const char *name)
     if (qstrcmp(name,QMediaContainerControl_iid) == 0)
         return m_captureSession->mediaContainerControl();
 
+    if (qstrcmp(name,QMediaRecorderSegmentControl_iid) == 0)
+        return m_captureSession->segmentControl();
+
+    if (qstrcmp(name,QMediaStatisticsControl_iid) == 0)
+        return m_captureSession->statisticsControl();
+
     if (qstrcmp(name,QCameraControl_iid) == 0)
         return m_cameraControl;
 
@@ -39,6 +39,7 @@
 
 #include "qgstreamercapturesession.h"
 #include "qgstreamerrecordercontrol.h"
+#include "qgstreamerrecordersegmentcontrol.h"
 #include "qgstreamermediacontainercontrol.h"
 #include "qgstreameraudioencode.h"
 #include "qgstreamervideoencode.h"
@@ -47,7 +48,11 @@
 #include <private/qgstreamervideorendererinterface_p.h>
 #include <private/qgstreameraudioprobecontrol_p.h>
 #include <private/qgstreamerbushelper_p.h>
+#include <private/qgstreamerstatisticscontrol_p.h>
 #include <private/qgstutils_p.h>
+#if GST_CHECK_VERSION(1,0,0)
+#include <private/qgstvideorenderersink_p.h>
+#endif
 
 #include <gst/gsttagsetter.h>
 #include <gst/gstversion.h>
@@ -59,10 +64,31 @@
 #include <QCoreApplication>
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
 #include <QtGui/qimage.h>
 
 QT_BEGIN_NAMESPACE
 
+class QGstreamerEncoderFrameCounter : public QGstreamerBufferProbe
+{
+public:
+    explicit QGstreamerEncoderFrameCounter(QMediaStatistics *statistics)
+        : QGstreamerBufferProbe(ProbeBuffers)
+        , m_statistics(statistics)
+    {
+    }
+
+protected:
+    bool probeBuffer(GstBuffer *) override
+    {
+        m_statistics->increment(QMediaStatistics::EncodedFrames);
+        return true;
+    }
+
+private:
+    QMediaStatistics *m_statistics;
+};
+
 QGstreamerCaptureSession::QGstreamerCaptureSession(QGstreamerCaptureSession::CaptureMode captureMode, QObject *parent)
     :QObject(parent),
      m_state(StoppedState),
@@ -89,6 +115,8 @@ QGstreamerCaptureSession::QGstreamerCaptureSession(QGstreamerCaptureSession::Cap
      m_videoPreview(0),
      m_imageCaptureBin(0),
      m_encodeBin(0),
+     m_segmentSink(0),
+     m_segmentStartTime(0),
      m_passImage(false),
      m_passPrerollImage(false)
 {
@@ -107,6 +135,9 @@ QGstreamerCaptureSession::QGstreamerCaptureSession(QGstreamerCaptureSession::Cap
         qWarning() << QMediaRecorder::Error(e) << ":" << str.toLatin1().constData();
     });
     m_mediaContainerControl = new QGstreamerMediaContainerControl(this);
+    m_segmentControl = new QGstreamerRecorderSegmentControl(this);
+    m_statisticsControl = new QGstreamerStatisticsControl(&m_statistics, this);
+    m_encoderProbe.reset(new QGstreamerEncoderFrameCounter(&m_statistics));
 }
 
 QGstreamerCaptureSession::~QGstreamerCaptureSession()
@@ -122,6 +153,82 @@ void QGstreamerCaptureSession::setCaptureMode(CaptureMode mode)
     m_captureMode = mode;
 }
 
+static bool linkToMuxer(GstElement *encoder, GstElement *muxer, GstElement *segmentSink, const char *segmentPad)
+{
+    if (!segmentSink)
+        return gst_element_link(encoder, muxer);
+
+    GstPad *sinkPad = gst_element_get_request_pad(segmentSink, segmentPad);
+    if (!sinkPad)
+        return false;
+
+    GstPad *srcPad = gst_element_get_static_pad(encoder, "src");
+    const bool ok = srcPad && GST_PAD_LINK_SUCCESSFUL(gst_pad_link(srcPad, sinkPad));
+    if (srcPad)
+        gst_object_unref(GST_OBJECT(srcPad));
+    gst_object_unref(GST_OBJECT(sinkPad));
+    return ok;
+}
+
+GstElement *QGstreamerCaptureSession::buildSegmentSink(GstElement *muxer, const QUrl &location)
+{
+#if GST_CHECK_VERSION(1,6,0)
+    GstElement *segmentSink = gst_element_factory_make("splitmuxsink", "segment-sink");
+    if (!segmentSink) {
+        qWarning() << "Could not create a splitmuxsink element, recording a single file";
+        return 0;
+    }
+
+    // splitmuxsink expects a printf style pattern for the segment file names
+    auto escaped = [](QString str) { return str.replace(QLatin1Char('%'), QLatin1String("%%")); };
+    const QFileInfo info(location.toLocalFile());
+    QString pattern = escaped(info.path()) + QLatin1Char('/')
+            + escaped(info.completeBaseName()) + QLatin1String("_%05d");
+    if (!info.suffix().isEmpty())
+        pattern += QLatin1Char('.') + escaped(info.suffix());
+
+    g_object_set(G_OBJECT(segmentSink),
+                 "location", QFile::encodeName(pattern).constData(),
+                 "muxer", muxer,
+                 NULL);
+
+    const qint64 maxDuration = m_segmentControl->maxSegmentDuration();
+    const qint64 maxSize = m_segmentControl->maxSegmentSize();
+    if (maxDuration > 0)
+        g_object_set(G_OBJECT(segmentSink), "max-size-time", guint64(maxDuration) * GST_MSECOND, NULL);
+    if (maxSize > 0)
+        g_object_set(G_OBJECT(segmentSink), "max-size-bytes", guint64(maxSize), NULL);
+
+    // Request a key frame from the encoder when a segment is due, instead of
+    // waiting for the next scheduled one. Only supported for time based splitting.
+    if (maxSize <= 0 && g_object_class_find_property(G_OBJECT_GET_CLASS(segmentSink), "send-keyframe-requests"))
+        g_object_set(G_OBJECT(segmentSink), "send-keyframe-requests", TRUE, NULL);
+
+    return segmentSink;
+#else
+    Q_UNUSED(muxer);
+    Q_UNUSED(location);
+    qWarning() << "Segmented recording requires GStreamer 1.6 or later, recording a single file";
+    return 0;
+#endif
+}
+
+void QGstreamerCaptureSession::processSegmentMessage(const GstStructure *structure)
+{
+    GstClockTime runningTime = GST_CLOCK_TIME_NONE;
+    gst_structure_get_clock_time(structure, "running-time", &runningTime);
+    const qint64 time = GST_CLOCK_TIME_IS_VALID(runningTime) ? qint64(runningTime / GST_MSECOND) : 0;
+
+    if (gst_structure_has_name(structure, "splitmuxsink-fragment-opened")) {
+        m_segmentStartTime = time;
+    } else if (gst_structure_has_name(structure, "splitmuxsink-fragment-closed")) {
+        const gchar *location = gst_structure_get_string(structure, "location");
+        if (location)
+            emit segmentFinalized(QUrl::fromLocalFile(QFile::decodeName(location)), m_segmentStartTime, time);
+        m_segmentStartTime = time;
+    }
+}
+
 GstElement *QGstreamerCaptureSession::buildEncodeBin()
 {
     GstElement *encodeBin = gst_bin_new("encode-bin");
@@ -135,13 +242,25 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
 
     // Output location was rejected in setOutputlocation() if not a local file
     QUrl actualSink = QUrl::fromLocalFile(QDir::currentPath()).resolved(m_sink);
-    GstElement *fileSink = gst_element_factory_make("filesink", "filesink");
-    g_object_set(G_OBJECT(fileSink), "location", QFile::encodeName(actualSink.toLocalFile()).constData(), NULL);
-    gst_bin_add_many(GST_BIN(encodeBin), muxer, fileSink,  NULL);
 
-    if (!gst_element_link(muxer, fileSink)) {
-        gst_object_unref(encodeBin);
-        return 0;
+    // In segmented mode the muxer and file sink are owned by splitmuxsink,
+    // which starts new files on key frames while the pipeline keeps running.
+    m_segmentSink = 0;
+    m_segmentStartTime = 0;
+    if (m_segmentControl->isSegmented())
+        m_segmentSink = buildSegmentSink(muxer, actualSink);
+
+    if (m_segmentSink) {
+        gst_bin_add(GST_BIN(encodeBin), m_segmentSink);
+    } else {
+        GstElement *fileSink = gst_element_factory_make("filesink", "filesink");
+        g_object_set(G_OBJECT(fileSink), "location", QFile::encodeName(actualSink.toLocalFile()).constData(), NULL);
+        gst_bin_add_many(GST_BIN(encodeBin), muxer, fileSink,  NULL);
+
+        if (!gst_element_link(muxer, fileSink)) {
+            gst_object_unref(encodeBin);
+            return 0;
+        }
     }
 
     if (m_captureMode & Audio) {
@@ -152,6 +271,7 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
 
         GstElement *audioEncoder = m_audioEncodeControl->createEncoder();
         if (!audioEncoder) {
+            m_segmentSink = 0;
             gst_object_unref(encodeBin);
             qWarning() << "Could not create an audio encoder element:" << m_audioEncodeControl->audioSettings().codec();
             return 0;
@@ -159,8 +279,10 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
 
         gst_bin_add(GST_BIN(encodeBin), audioEncoder);
 
-        if (!gst_element_link_many(audioConvert, audioQueue, m_audioVolume, audioEncoder, muxer, NULL)) {
+        if (!gst_element_link_many(audioConvert, audioQueue, m_audioVolume, audioEncoder, NULL)
+                || !linkToMuxer(audioEncoder, muxer, m_segmentSink, "audio_%u")) {
             m_audioVolume = 0;
+            m_segmentSink = 0;
             gst_object_unref(encodeBin);
             return 0;
         }
@@ -182,6 +304,7 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
 
         GstElement *videoEncoder = m_videoEncodeControl->createEncoder();
         if (!videoEncoder) {
+            m_segmentSink = 0;
             gst_object_unref(encodeBin);
             qWarning() << "Could not create a video encoder element:" << m_videoEncodeControl->videoSettings().codec();
             return 0;
@@ -189,7 +312,9 @@ GstElement *QGstreamerCaptureSession::buildEncodeBin()
 
         gst_bin_add(GST_BIN(encodeBin), videoEncoder);
 
-        if (!gst_element_link_many(videoQueue, colorspace, videoscale, videoEncoder, muxer, NULL)) {
+        if (!gst_element_link_many(videoQueue, colorspace, videoscale, videoEncoder, NULL)
+                || !linkToMuxer(videoEncoder, muxer, m_segmentSink, "video")) {
+            m_segmentSink = 0;
             gst_object_unref(encodeBin);
             return 0;
         }
@@ -290,6 +415,9 @@ GstElement *QGstreamerCaptureSession::buildVideoPreview()
         GstElement *colorspace = gst_element_factory_make(QT_GSTREAMER_COLORCONVERSION_ELEMENT_NAME, "videoconvert-preview");
         GstElement *capsFilter = gst_element_factory_make("capsfilter", "capsfilter-video-preview");
         GstElement *preview = m_viewfinderInterface->videoSink();
+#if GST_CHECK_VERSION(1,0,0)
+        QGstVideoRendererSink::setStatistics(preview, &m_statistics);
+#endif
 
         gst_bin_add_many(GST_BIN(bin), colorspace, capsFilter, preview,  NULL);
         gst_element_link(colorspace,capsFilter);
@@ -485,6 +613,7 @@ void QGstreamerCaptureSession::captureImage(int requestId, const QString &fileNa
 bool QGstreamerCaptureSession::rebuildGraph(QGstreamerCaptureSession::PipelineMode newMode)
 {
     removeAudioBufferProbe();
+    removeEncoderBufferProbe();
     REMOVE_ELEMENT(m_audioSrc);
     REMOVE_ELEMENT(m_audioPreview);
     REMOVE_ELEMENT(m_audioPreviewQueue);
@@ -496,6 +625,7 @@ bool QGstreamerCaptureSession::rebuildGraph(QGstreamerCaptureSession::PipelineMo
     REMOVE_ELEMENT(m_encodeBin);
     REMOVE_ELEMENT(m_imageCaptureBin);
     m_audioVolume = 0;
+    m_segmentSink = 0;
 
     bool ok = true;
 
@@ -644,6 +774,7 @@ bool QGstreamerCaptureSession::rebuildGraph(QGstreamerCaptureSession::PipelineMo
 
     if (ok) {
         addAudioBufferProbe();
+        addEncoderBufferProbe();
         m_pipelineMode = newMode;
     } else {
         m_pipelineMode = EmptyPipeline;
@@ -657,6 +788,7 @@ bool QGstreamerCaptureSession::rebuildGraph(QGstreamerCaptureSession::PipelineMo
         REMOVE_ELEMENT(m_videoPreviewQueue);
         REMOVE_ELEMENT(m_videoTee);
         REMOVE_ELEMENT(m_encodeBin);
+        m_segmentSink = 0;
     }
 
     return ok;
@@ -867,6 +999,14 @@ bool QGstreamerCaptureSession::processBusMessage(const QGstreamerMessage &messag
             g_free (debug);
         }
 
+        if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_QOS)
+            m_statistics.increment(QMediaStatistics::LateFrames);
+
+#if GST_CHECK_VERSION(1,6,0)
+        if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_ELEMENT && gst_message_get_structure(gm))
+            processSegmentMessage(gst_message_get_structure(gm));
+#endif
+
         if (GST_MESSAGE_SRC(gm) == GST_OBJECT_CAST(m_pipeline)) {
             switch (GST_MESSAGE_TYPE(gm))  {
             case GST_MESSAGE_DURATION:
@@ -1029,4 +1169,28 @@ void QGstreamerCaptureSession::addAudioBufferProbe()
     }
 }
 
+void QGstreamerCaptureSession::removeEncoderBufferProbe()
+{
+    if (!m_encodeBin)
+        return;
+
+    GstPad *pad = gst_element_get_static_pad(m_encodeBin, "videosink");
+    if (pad) {
+        m_encoderProbe->removeProbeFromPad(pad);
+        gst_object_unref(GST_OBJECT(pad));
+    }
+}
+
+void QGstreamerCaptureSession::addEncoderBufferProbe()
+{
+    if (!m_encodeBin)
+        return;
+
+    GstPad *pad = gst_element_get_static_pad(m_encodeBin, "videosink");
+    if (pad) {
+        m_encoderProbe->addProbeToPad(pad);
+        gst_object_unref(GST_OBJECT(pad));
+    }
+}
+
 QT_END_NAMESPACE
@@ -51,6 +51,9 @@
 
 #include <private/qgstreamerbushelper_p.h>
 #include <private/qgstreamerbufferprobe_p.h>
+#include <private/qmediastatistics_p.h>
+
+#include <QtCore/qscopedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -60,6 +63,8 @@ class QGstreamerAudioEncode;
 class QGstreamerVideoEncode;
 class QGstreamerImageEncode;
 class QGstreamerRecorderControl;
+class QGstreamerRecorderSegmentControl;
+class QGstreamerStatisticsControl;
 class QGstreamerMediaContainerControl;
 class QGstreamerVideoRendererInterface;
 class QGstreamerAudioProbeControl;
@@ -114,6 +119,8 @@ public:
 
     QGstreamerRecorderControl *recorderControl() const { return m_recorderControl; }
     QGstreamerMediaContainerControl *mediaContainerControl() const { return m_mediaContainerControl; }
+    QGstreamerRecorderSegmentControl *segmentControl() const { return m_segmentControl; }
+    QGstreamerStatisticsControl *statisticsControl() const { return m_statisticsControl; }
 
     QGstreamerElementFactory *audioInput() const { return m_audioInputFactory; }
     void setAudioInput(QGstreamerElementFactory *audioInput);
@@ -154,6 +161,7 @@ signals:
     void volumeChanged(qreal);
     void readyChanged(bool);
     void viewfinderChanged();
+    void segmentFinalized(const QUrl &location, qint64 startTime, qint64 endTime);
 
 public slots:
     void setState(QGstreamerCaptureSession::State);
@@ -172,6 +180,8 @@ private:
     enum PipelineMode { EmptyPipeline, PreviewPipeline, RecordingPipeline, PreviewAndRecordingPipeline };
 
     GstElement *buildEncodeBin();
+    GstElement *buildSegmentSink(GstElement *muxer, const QUrl &location);
+    void processSegmentMessage(const GstStructure *structure);
     GstElement *buildAudioSrc();
     GstElement *buildAudioPreview();
     GstElement *buildVideoSrc();
@@ -184,6 +194,9 @@ private:
     void removeAudioBufferProbe();
     void addAudioBufferProbe();
 
+    void removeEncoderBufferProbe();
+    void addEncoderBufferProbe();
+
     QUrl m_sink;
     QString m_captureDevice;
     State m_state;
@@ -206,6 +219,11 @@ private:
     QGstreamerImageEncode *m_imageEncodeControl;
     QGstreamerRecorderControl *m_recorderControl;
     QGstreamerMediaContainerControl *m_mediaContainerControl;
+    QGstreamerRecorderSegmentControl *m_segmentControl;
+    QGstreamerStatisticsControl *m_statisticsControl;
+
+    QMediaStatistics m_statistics;
+    QScopedPointer<QGstreamerBufferProbe> m_encoderProbe;
 
     QGstreamerBusHelper *m_busHelper;
     GstBus* m_bus;
@@ -227,6 +245,8 @@ private:
     GstElement *m_imageCaptureBin;
 
     GstElement *m_encodeBin;
+    GstElement *m_segmentSink;
+    qint64 m_segmentStartTime;
 
 #if GST_CHECK_VERSION(1,0,0)
     GstVideoInfo m_previewInfo;
@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGSTREAMERRECORDERSEGMENTCONTROL_H
+#define QGSTREAMERRECORDERSEGMENTCONTROL_H
+
+#include <private/qmediarecordersegmentcontrol_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QGstreamerCaptureSession;
+
+class QGstreamerRecorderSegmentControl : public QMediaRecorderSegmentControl
+{
+    Q_OBJECT
+public:
+    QGstreamerRecorderSegmentControl(QGstreamerCaptureSession *session);
+    ~QGstreamerRecorderSegmentControl() {}
+
+    qint64 maxSegmentDuration() const override { return m_maxDuration; }
+    void setMaxSegmentDuration(qint64 duration) override { m_maxDuration = duration; }
+
+    qint64 maxSegmentSize() const override { return m_maxSize; }
+    void setMaxSegmentSize(qint64 size) override { m_maxSize = size; }
+
+    bool isSegmented() const { return m_maxDuration > 0 || m_maxSize > 0; }
+
+private:
+    qint64 m_maxDuration = 0;
+    qint64 m_maxSize = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGSTREAMERRECORDERSEGMENTCONTROL_H
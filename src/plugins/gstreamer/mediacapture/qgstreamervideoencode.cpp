@@ -42,8 +42,114 @@
 #include "qgstreamermediacontainercontrol.h"
 #include <private/qgstutils_p.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qthread.h>
 
 #include <math.h>
+#include <limits>
+
+namespace {
+
+struct EncoderProfileProperty
+{
+    const char *element;
+    QMultimedia::EncodingProfile profile;
+    const char *property;
+    const char *value;
+};
+
+// Speed and latency knobs per encoder element and profile.
+// Values are given as strings, they are parsed according to the property type.
+const EncoderProfileProperty encoderProfileProperties[] = {
+    { "x264enc", QMultimedia::LowLatencyEncodingProfile, "speed-preset", "ultrafast" },
+    { "x264enc", QMultimedia::LowLatencyEncodingProfile, "tune", "zerolatency" },
+    { "x264enc", QMultimedia::LowLatencyEncodingProfile, "sliced-threads", "true" },
+    { "x264enc", QMultimedia::LowLatencyEncodingProfile, "b-frames", "0" },
+    { "x264enc", QMultimedia::LowLatencyEncodingProfile, "rc-lookahead", "0" },
+    { "x264enc", QMultimedia::RealtimeEncodingProfile, "speed-preset", "veryfast" },
+    { "x264enc", QMultimedia::RealtimeEncodingProfile, "b-frames", "0" },
+    { "x264enc", QMultimedia::RealtimeEncodingProfile, "rc-lookahead", "10" },
+    { "x264enc", QMultimedia::ThroughputEncodingProfile, "speed-preset", "faster" },
+    { "x264enc", QMultimedia::ArchiveEncodingProfile, "speed-preset", "slow" },
+
+    { "x265enc", QMultimedia::LowLatencyEncodingProfile, "speed-preset", "ultrafast" },
+    { "x265enc", QMultimedia::LowLatencyEncodingProfile, "tune", "zerolatency" },
+    { "x265enc", QMultimedia::RealtimeEncodingProfile, "speed-preset", "veryfast" },
+    { "x265enc", QMultimedia::ThroughputEncodingProfile, "speed-preset", "faster" },
+    { "x265enc", QMultimedia::ArchiveEncodingProfile, "speed-preset", "slow" },
+
+    // deadline is in microseconds per frame, 1 means realtime and 0 best quality
+    { "vp8enc", QMultimedia::LowLatencyEncodingProfile, "deadline", "1" },
+    { "vp8enc", QMultimedia::LowLatencyEncodingProfile, "cpu-used", "16" },
+    { "vp8enc", QMultimedia::LowLatencyEncodingProfile, "lag-in-frames", "0" },
+    { "vp8enc", QMultimedia::RealtimeEncodingProfile, "deadline", "1" },
+    { "vp8enc", QMultimedia::RealtimeEncodingProfile, "cpu-used", "8" },
+    { "vp8enc", QMultimedia::RealtimeEncodingProfile, "lag-in-frames", "0" },
+    { "vp8enc", QMultimedia::ThroughputEncodingProfile, "deadline", "1000000" },
+    { "vp8enc", QMultimedia::ThroughputEncodingProfile, "cpu-used", "4" },
+    { "vp8enc", QMultimedia::ArchiveEncodingProfile, "deadline", "0" },
+    { "vp8enc", QMultimedia::ArchiveEncodingProfile, "cpu-used", "0" },
+    { "vp8enc", QMultimedia::ArchiveEncodingProfile, "lag-in-frames", "25" },
+    { "vp8enc", QMultimedia::ArchiveEncodingProfile, "auto-alt-ref", "true" },
+
+    { "vp9enc", QMultimedia::LowLatencyEncodingProfile, "deadline", "1" },
+    { "vp9enc", QMultimedia::LowLatencyEncodingProfile, "cpu-used", "8" },
+    { "vp9enc", QMultimedia::LowLatencyEncodingProfile, "lag-in-frames", "0" },
+    { "vp9enc", QMultimedia::RealtimeEncodingProfile, "deadline", "1" },
+    { "vp9enc", QMultimedia::RealtimeEncodingProfile, "cpu-used", "6" },
+    { "vp9enc", QMultimedia::RealtimeEncodingProfile, "lag-in-frames", "0" },
+    { "vp9enc", QMultimedia::ThroughputEncodingProfile, "deadline", "1000000" },
+    { "vp9enc", QMultimedia::ThroughputEncodingProfile, "cpu-used", "4" },
+    { "vp9enc", QMultimedia::ArchiveEncodingProfile, "deadline", "0" },
+    { "vp9enc", QMultimedia::ArchiveEncodingProfile, "cpu-used", "0" },
+    { "vp9enc", QMultimedia::ArchiveEncodingProfile, "lag-in-frames", "25" },
+
+    // speed-level from 0 (slowest) to 3 (fastest)
+    { "theoraenc", QMultimedia::LowLatencyEncodingProfile, "speed-level", "3" },
+    { "theoraenc", QMultimedia::RealtimeEncodingProfile, "speed-level", "2" },
+    { "theoraenc", QMultimedia::ThroughputEncodingProfile, "speed-level", "2" },
+    { "theoraenc", QMultimedia::ArchiveEncodingProfile, "speed-level", "0" },
+};
+
+struct EncoderKeyFrameProperty
+{
+    const char *element;
+    const char *property;
+};
+
+// Maximum distance between key frames, in frames
+const EncoderKeyFrameProperty encoderKeyFrameProperties[] = {
+    { "x264enc", "key-int-max" },
+    { "x265enc", "key-int-max" },
+    { "vp8enc", "keyframe-max-dist" },
+    { "vp9enc", "keyframe-max-dist" },
+    { "theoraenc", "keyframe-max-distance" },
+    { "avenc_mpeg4", "gop-size" },
+    { "avenc_h263p", "gop-size" },
+};
+
+void setEncoderProperty(GstElement *element, const char *property, const char *value)
+{
+    if (g_object_class_find_property(G_OBJECT_GET_CLASS(element), property))
+        gst_util_set_object_arg(G_OBJECT(element), property, value);
+}
+
+void setEncoderThreads(GstElement *element, int threads)
+{
+    GParamSpec *spec = g_object_class_find_property(G_OBJECT_GET_CLASS(element), "threads");
+    if (!spec)
+        return;
+
+    if (G_IS_PARAM_SPEC_INT(spec))
+        threads = qBound(G_PARAM_SPEC_INT(spec)->minimum, threads, G_PARAM_SPEC_INT(spec)->maximum);
+    else if (G_IS_PARAM_SPEC_UINT(spec))
+        threads = qBound(int(G_PARAM_SPEC_UINT(spec)->minimum), threads, int(qMin<guint>(G_PARAM_SPEC_UINT(spec)->maximum, guint(std::numeric_limits<int>::max()))));
+    else
+        return;
+
+    gst_util_set_object_arg(G_OBJECT(element), "threads", QByteArray::number(threads).constData());
+}
+
+}
 
 QGstreamerVideoEncode::QGstreamerVideoEncode(QGstreamerCaptureSession *session)
     :QVideoEncoderSettingsControl(session), m_session(session)
@@ -136,6 +242,8 @@ GstElement *QGstreamerVideoEncode::createEncoder()
     gst_object_unref(GST_OBJECT(pad));
 
     if (encoderElement) {
+        applyEncodingProfile(encoderElement);
+
         if (m_videoSettings.encodingMode() == QMultimedia::ConstantQualityEncoding) {
             QMultimedia::EncodingQuality qualityValue = m_videoSettings.quality();
 
@@ -199,6 +307,11 @@ GstElement *QGstreamerVideoEncode::createEncoder()
             const QString &option = it.key();
             const QVariant &value = it.value();
 
+            if (m_codecs.codecOption(codec, option).name.isEmpty()) {
+                qWarning() << "unsupported option:" << option;
+                continue;
+            }
+
             switch (value.type()) {
             case QVariant::Int:
                 g_object_set(G_OBJECT(encoderElement), option.toLatin1(), value.toInt(), NULL);
@@ -256,6 +369,40 @@ GstElement *QGstreamerVideoEncode::createEncoder()
     return GST_ELEMENT(encoderBin);
 }
 
+void QGstreamerVideoEncode::applyEncodingProfile(GstElement *encoderElement)
+{
+    const QMultimedia::EncodingProfile profile = m_videoSettings.encodingProfile();
+    if (profile == QMultimedia::DefaultEncodingProfile)
+        return;
+
+    GstElementFactory *factory = gst_element_get_factory(encoderElement);
+    const QByteArray element = factory ? QByteArray(GST_OBJECT_NAME(factory)) : QByteArray();
+
+    for (const EncoderProfileProperty &p : encoderProfileProperties) {
+        if (p.profile == profile && element == p.element)
+            setEncoderProperty(encoderElement, p.property, p.value);
+    }
+
+    // Low latency needs frequent key frames for receivers to join or recover,
+    // the other profiles keep the encoder's default interval.
+    int keyFrameSeconds = 0;
+    if (profile == QMultimedia::LowLatencyEncodingProfile)
+        keyFrameSeconds = 1;
+    else if (profile == QMultimedia::RealtimeEncodingProfile)
+        keyFrameSeconds = 2;
+
+    if (keyFrameSeconds > 0) {
+        const qreal frameRate = m_videoSettings.frameRate() > 0.001 ? m_videoSettings.frameRate() : 30;
+        const int keyFrameDistance = qMax(1, qRound(frameRate * keyFrameSeconds));
+        for (const EncoderKeyFrameProperty &p : encoderKeyFrameProperties) {
+            if (element == p.element)
+                setEncoderProperty(encoderElement, p.property, QByteArray::number(keyFrameDistance).constData());
+        }
+    }
+
+    setEncoderThreads(encoderElement, QThread::idealThreadCount());
+}
+
 QPair<int,int> QGstreamerVideoEncode::rateAsRational() const
 {
     qreal frameRate = m_videoSettings.frameRate();
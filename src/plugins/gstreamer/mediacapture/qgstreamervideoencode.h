@@ -84,6 +84,8 @@ public:
     QSet<QString> supportedStreamTypes(const QString &codecName) const;
 
 private:
+    void applyEncodingProfile(GstElement *encoderElement);
+
     QGstreamerCaptureSession *m_session;
 
     QGstCodecsInfo m_codecs;
@@ -8,15 +8,23 @@ HEADERS += \
     $$PWD/qgstreamerplayerservice.h \
     $$PWD/qgstreamerstreamscontrol.h \
     $$PWD/qgstreamermetadataprovider.h \
+    $$PWD/qgstreamerjobpool.h \
+    $$PWD/qgstreamerjobservice.h \
+    $$PWD/qgstreamermetadatascannercontrol.h \
     $$PWD/qgstreameravailabilitycontrol.h \
-    $$PWD/qgstreamerplayerserviceplugin.h
+    $$PWD/qgstreamerplayerserviceplugin.h \
+    $$PWD/qgstreamerthumbnailercontrol.h
 
 SOURCES += \
     $$PWD/qgstreamerplayerservice.cpp \
     $$PWD/qgstreamerstreamscontrol.cpp \
     $$PWD/qgstreamermetadataprovider.cpp \
+    $$PWD/qgstreamerjobpool.cpp \
+    $$PWD/qgstreamerjobservice.cpp \
+    $$PWD/qgstreamermetadatascannercontrol.cpp \
     $$PWD/qgstreameravailabilitycontrol.cpp \
-    $$PWD/qgstreamerplayerserviceplugin.cpp
+    $$PWD/qgstreamerplayerserviceplugin.cpp \
+    $$PWD/qgstreamerthumbnailercontrol.cpp
 
 OTHER_FILES += \
     mediaplayer.json
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qgstreamerjobpool.h"
+
+#include <QtCore/qthread.h>
+
+QT_BEGIN_NAMESPACE
+
+QGstreamerJobPool::QGstreamerJobPool(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+QGstreamerJobPool::~QGstreamerJobPool()
+{
+    // Reports still queued to this object are dropped with it
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void QGstreamerJobPool::start(const Job &job)
+{
+    ++m_pendingCount;
+
+    const int generation = m_generation;
+    m_pool.start(QRunnable::create([this, generation, job]() {
+        const Report result = job();
+        QMetaObject::invokeMethod(this, [this, generation, result]() {
+            report(generation, result);
+        }, Qt::QueuedConnection);
+    }));
+}
+
+void QGstreamerJobPool::cancel()
+{
+    m_pool.clear();
+
+    // Reports of jobs that were already running are dropped when they arrive
+    ++m_generation;
+    m_pendingCount = 0;
+}
+
+int QGstreamerJobPool::maximumWorkerCount() const
+{
+    return m_pool.maxThreadCount();
+}
+
+void QGstreamerJobPool::setMaximumWorkerCount(int count)
+{
+    m_pool.setMaxThreadCount(count);
+}
+
+void QGstreamerJobPool::report(int generation, const Report &report)
+{
+    if (generation != m_generation)
+        return;
+
+    --m_pendingCount;
+    report();
+
+    // The receiver may have queued more requests or cancelled in the meantime
+    if (generation == m_generation && m_pendingCount == 0)
+        emit finished();
+}
+
+QT_END_NAMESPACE
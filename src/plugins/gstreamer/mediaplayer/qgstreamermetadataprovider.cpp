@@ -41,96 +41,102 @@
 #include <private/qgstreamerplayersession_p.h>
 #include <QDebug>
 #include <QtMultimedia/qmediametadata.h>
+#include <QtGui/qimage.h>
 
 #include <gst/gstversion.h>
 #include <private/qgstutils_p.h>
 
 QT_BEGIN_NAMESPACE
 
-typedef QMap<QByteArray, QString> QGstreamerMetaDataKeyLookup;
-Q_GLOBAL_STATIC(QGstreamerMetaDataKeyLookup, metadataKeys)
-
-static const QGstreamerMetaDataKeyLookup *qt_gstreamerMetaDataKeys()
+// Built once by Q_GLOBAL_STATIC, so the lookup is safe from the scanner's worker threads
+class QGstreamerMetaDataKeyLookup : public QMap<QByteArray, QString>
 {
-    if (metadataKeys->isEmpty()) {
-        metadataKeys->insert(GST_TAG_TITLE, QMediaMetaData::Title);
-        //metadataKeys->insert(0, QMediaMetaData::SubTitle);
-        //metadataKeys->insert(0, QMediaMetaData::Author);
-        metadataKeys->insert(GST_TAG_COMMENT, QMediaMetaData::Comment);
-        metadataKeys->insert(GST_TAG_DESCRIPTION, QMediaMetaData::Description);
-        //metadataKeys->insert(0, QMediaMetaData::Category);
-        metadataKeys->insert(GST_TAG_GENRE, QMediaMetaData::Genre);
-        metadataKeys->insert("year", QMediaMetaData::Year);
-        //metadataKeys->insert(0, QMediaMetaData::UserRating);
-
-        metadataKeys->insert(GST_TAG_LANGUAGE_CODE, QMediaMetaData::Language);
-
-        metadataKeys->insert(GST_TAG_ORGANIZATION, QMediaMetaData::Publisher);
-        metadataKeys->insert(GST_TAG_COPYRIGHT, QMediaMetaData::Copyright);
-        //metadataKeys->insert(0, QMediaMetaData::ParentalRating);
-        //metadataKeys->insert(0, QMediaMetaData::RatingOrganisation);
+public:
+    QGstreamerMetaDataKeyLookup()
+    {
+        insert(GST_TAG_TITLE, QMediaMetaData::Title);
+        //insert(0, QMediaMetaData::SubTitle);
+        //insert(0, QMediaMetaData::Author);
+        insert(GST_TAG_COMMENT, QMediaMetaData::Comment);
+        insert(GST_TAG_DESCRIPTION, QMediaMetaData::Description);
+        //insert(0, QMediaMetaData::Category);
+        insert(GST_TAG_GENRE, QMediaMetaData::Genre);
+        insert("year", QMediaMetaData::Year);
+        //insert(0, QMediaMetaData::UserRating);
+
+        insert(GST_TAG_LANGUAGE_CODE, QMediaMetaData::Language);
+
+        insert(GST_TAG_ORGANIZATION, QMediaMetaData::Publisher);
+        insert(GST_TAG_COPYRIGHT, QMediaMetaData::Copyright);
+        //insert(0, QMediaMetaData::ParentalRating);
+        //insert(0, QMediaMetaData::RatingOrganisation);
 
         // Media
-        //metadataKeys->insert(0, QMediaMetaData::Size);
-        //metadataKeys->insert(0,QMediaMetaData::MediaType );
-        metadataKeys->insert(GST_TAG_DURATION, QMediaMetaData::Duration);
+        //insert(0, QMediaMetaData::Size);
+        //insert(0,QMediaMetaData::MediaType );
+        insert(GST_TAG_DURATION, QMediaMetaData::Duration);
 
         // Audio
-        metadataKeys->insert(GST_TAG_BITRATE, QMediaMetaData::AudioBitRate);
-        metadataKeys->insert(GST_TAG_AUDIO_CODEC, QMediaMetaData::AudioCodec);
-        //metadataKeys->insert(0, QMediaMetaData::ChannelCount);
-        //metadataKeys->insert(0, QMediaMetaData::SampleRate);
+        insert(GST_TAG_BITRATE, QMediaMetaData::AudioBitRate);
+        insert(GST_TAG_AUDIO_CODEC, QMediaMetaData::AudioCodec);
+        //insert(0, QMediaMetaData::ChannelCount);
+        //insert(0, QMediaMetaData::SampleRate);
 
         // Music
-        metadataKeys->insert(GST_TAG_ALBUM, QMediaMetaData::AlbumTitle);
+        insert(GST_TAG_ALBUM, QMediaMetaData::AlbumTitle);
 #if GST_CHECK_VERSION(0, 10, 25)
-        metadataKeys->insert(GST_TAG_ALBUM_ARTIST, QMediaMetaData::AlbumArtist);
+        insert(GST_TAG_ALBUM_ARTIST, QMediaMetaData::AlbumArtist);
 #endif
-        metadataKeys->insert(GST_TAG_ARTIST, QMediaMetaData::ContributingArtist);
-        //metadataKeys->insert(0, QMediaMetaData::Conductor);
-        //metadataKeys->insert(0, QMediaMetaData::Lyrics);
-        //metadataKeys->insert(0, QMediaMetaData::Mood);
-        metadataKeys->insert(GST_TAG_TRACK_NUMBER, QMediaMetaData::TrackNumber);
+        insert(GST_TAG_ARTIST, QMediaMetaData::ContributingArtist);
+        //insert(0, QMediaMetaData::Conductor);
+        //insert(0, QMediaMetaData::Lyrics);
+        //insert(0, QMediaMetaData::Mood);
+        insert(GST_TAG_TRACK_NUMBER, QMediaMetaData::TrackNumber);
 
-        //metadataKeys->insert(0, QMediaMetaData::CoverArtUrlSmall);
-        //metadataKeys->insert(0, QMediaMetaData::CoverArtUrlLarge);
-        metadataKeys->insert(GST_TAG_PREVIEW_IMAGE, QMediaMetaData::ThumbnailImage);
-        metadataKeys->insert(GST_TAG_IMAGE, QMediaMetaData::CoverArtImage);
+        //insert(0, QMediaMetaData::CoverArtUrlSmall);
+        //insert(0, QMediaMetaData::CoverArtUrlLarge);
+        insert(GST_TAG_PREVIEW_IMAGE, QMediaMetaData::ThumbnailImage);
+        insert(GST_TAG_IMAGE, QMediaMetaData::CoverArtImage);
 
         // Image/Video
-        metadataKeys->insert("resolution", QMediaMetaData::Resolution);
-        metadataKeys->insert("pixel-aspect-ratio", QMediaMetaData::PixelAspectRatio);
+        insert("resolution", QMediaMetaData::Resolution);
+        insert("pixel-aspect-ratio", QMediaMetaData::PixelAspectRatio);
 #if GST_CHECK_VERSION(0,10,30)
-        metadataKeys->insert(GST_TAG_IMAGE_ORIENTATION, QMediaMetaData::Orientation);
+        insert(GST_TAG_IMAGE_ORIENTATION, QMediaMetaData::Orientation);
 #endif
 
         // Video
-        //metadataKeys->insert(0, QMediaMetaData::VideoFrameRate);
-        //metadataKeys->insert(0, QMediaMetaData::VideoBitRate);
-        metadataKeys->insert(GST_TAG_VIDEO_CODEC, QMediaMetaData::VideoCodec);
+        //insert(0, QMediaMetaData::VideoFrameRate);
+        //insert(0, QMediaMetaData::VideoBitRate);
+        insert(GST_TAG_VIDEO_CODEC, QMediaMetaData::VideoCodec);
 
-        //metadataKeys->insert(0, QMediaMetaData::PosterUrl);
+        //insert(0, QMediaMetaData::PosterUrl);
 
         // Movie
-        //metadataKeys->insert(0, QMediaMetaData::ChapterNumber);
-        //metadataKeys->insert(0, QMediaMetaData::Director);
-        metadataKeys->insert(GST_TAG_PERFORMER, QMediaMetaData::LeadPerformer);
-        //metadataKeys->insert(0, QMediaMetaData::Writer);
+        //insert(0, QMediaMetaData::ChapterNumber);
+        //insert(0, QMediaMetaData::Director);
+        insert(GST_TAG_PERFORMER, QMediaMetaData::LeadPerformer);
+        //insert(0, QMediaMetaData::Writer);
 
         // Photos
-        //metadataKeys->insert(0, QMediaMetaData::CameraManufacturer);
-        //metadataKeys->insert(0, QMediaMetaData::CameraModel);
-        //metadataKeys->insert(0, QMediaMetaData::Event);
-        //metadataKeys->insert(0, QMediaMetaData::Subject);
+        //insert(0, QMediaMetaData::CameraManufacturer);
+        //insert(0, QMediaMetaData::CameraModel);
+        //insert(0, QMediaMetaData::Event);
+        //insert(0, QMediaMetaData::Subject);
     }
+};
 
+Q_GLOBAL_STATIC(QGstreamerMetaDataKeyLookup, metadataKeys)
+
+static const QGstreamerMetaDataKeyLookup *qt_gstreamerMetaDataKeys()
+{
     return metadataKeys;
 }
 
 QGstreamerMetaDataProvider::QGstreamerMetaDataProvider(QGstreamerPlayerSession *session, QObject *parent)
     :QMetaDataReaderControl(parent), m_session(session)
 {
-    connect(m_session, SIGNAL(tagsChanged()), SLOT(updateTags()));
+    connect(m_session, SIGNAL(tagsChanged(QList<QByteArray>)), SLOT(updateTags(QList<QByteArray>)));
 }
 
 QGstreamerMetaDataProvider::~QGstreamerMetaDataProvider()
@@ -153,7 +159,12 @@ QVariant QGstreamerMetaDataProvider::metaData(const QString &key) const
     if (key == QMediaMetaData::Orientation)
         return QGstUtils::fromGStreamerOrientation(m_tags.value(key));
 #endif
-    return m_tags.value(key);
+    const QVariant value = m_tags.value(key);
+#if GST_CHECK_VERSION(1,0,0)
+    if (value.userType() == qMetaTypeId<QGstTagImage>())
+        return value.value<QGstTagImage>().image();
+#endif
+    return value;
 }
 
 QStringList QGstreamerMetaDataProvider::availableMetaData() const
@@ -161,24 +172,35 @@ QStringList QGstreamerMetaDataProvider::availableMetaData() const
     return m_tags.keys();
 }
 
-void QGstreamerMetaDataProvider::updateTags()
+QString QGstreamerMetaDataProvider::metaDataKey(const QByteArray &tag)
+{
+    //use gstreamer native keys for elements not in our key map
+    return qt_gstreamerMetaDataKeys()->value(tag, QString::fromLatin1(tag));
+}
+
+void QGstreamerMetaDataProvider::updateTags(const QList<QByteArray> &keys)
 {
-    QVariantMap oldTags = m_tags;
-    m_tags.clear();
+    const bool wasAvailable = !m_tags.isEmpty();
     bool changed = false;
 
     const auto tags = m_session->tags();
-    for (auto i = tags.cbegin(), end = tags.cend(); i != end; ++i) {
-         //use gstreamer native keys for elements not in our key map
-         QString key = qt_gstreamerMetaDataKeys()->value(i.key(), i.key());
-         m_tags.insert(key, i.value());
-         if (i.value() != oldTags.value(key)) {
-             changed = true;
-             emit metaDataChanged(key, i.value());
-         }
+    for (const QByteArray &tag : keys) {
+        const QString key = metaDataKey(tag);
+        const QVariant value = tags.value(tag);
+        if (value == m_tags.value(key))
+            continue;
+
+        if (value.isValid())
+            m_tags.insert(key, value);
+        else
+            m_tags.remove(key);
+
+        changed = true;
+        // Same value as metaData(), the image is decoded once and kept by the tag
+        emit metaDataChanged(key, metaData(key));
     }
 
-    if (oldTags.isEmpty() != m_tags.isEmpty()) {
+    if (wasAvailable != !m_tags.isEmpty()) {
         emit metaDataAvailableChanged(isMetaDataAvailable());
         changed = true;
     }
@@ -59,8 +59,10 @@ public:
     QVariant metaData(const QString &key) const override;
     QStringList availableMetaData() const override;
 
+    static QString metaDataKey(const QByteArray &tag);
+
 private slots:
-    void updateTags();
+    void updateTags(const QList<QByteArray> &keys);
 
 private:
     QGstreamerPlayerSession *m_session = nullptr;
@@ -0,0 +1,273 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamermetadatascannercontrol.h"
+#include "qgstreamermetadataprovider.h"
+
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qthreadstorage.h>
+#include <QtMultimedia/qmediametadata.h>
+#include <QtGui/qimage.h>
+
+#include <private/qgstutils_p.h>
+
+#include <gst/pbutils/pbutils.h>
+
+QT_BEGIN_NAMESPACE
+
+// Give up on files that take longer than this to parse
+static const GstClockTime discovererTimeout = 5 * GST_SECOND;
+
+// Each worker thread keeps its own discoverer, created on its first job
+class QGstreamerThreadDiscoverer
+{
+public:
+    ~QGstreamerThreadDiscoverer()
+    {
+        if (discoverer)
+            g_object_unref(discoverer);
+    }
+
+    GstDiscoverer *discoverer = nullptr;
+};
+
+static QThreadStorage<QGstreamerThreadDiscoverer *> threadDiscoverer;
+
+static GstDiscoverer *qt_gst_thread_discoverer(QString *errorString)
+{
+    if (!threadDiscoverer.hasLocalData())
+        threadDiscoverer.setLocalData(new QGstreamerThreadDiscoverer);
+
+    QGstreamerThreadDiscoverer *holder = threadDiscoverer.localData();
+    if (!holder->discoverer) {
+        GError *error = nullptr;
+        holder->discoverer = gst_discoverer_new(discovererTimeout, &error);
+        if (error) {
+            *errorString = QString::fromUtf8(error->message);
+            g_error_free(error);
+        }
+    }
+    return holder->discoverer;
+}
+
+static QString qt_gst_codec_description(GstDiscovererStreamInfo *stream)
+{
+    QString description;
+    if (GstCaps *caps = gst_discoverer_stream_info_get_caps(stream)) {
+        if (gchar *codec = gst_pb_utils_get_codec_description(caps)) {
+            description = QString::fromUtf8(codec);
+            g_free(codec);
+        }
+        gst_caps_unref(caps);
+    }
+    return description;
+}
+
+static void qt_gst_read_video_stream(GstDiscovererVideoInfo *video, QVariantMap *metaData)
+{
+    GstDiscovererStreamInfo *stream = GST_DISCOVERER_STREAM_INFO(video);
+
+    if (GstCaps *caps = gst_discoverer_stream_info_get_caps(stream)) {
+        const QSize resolution = QGstUtils::capsResolution(caps);
+        if (!resolution.isEmpty())
+            metaData->insert(QMediaMetaData::Resolution, resolution);
+        gst_caps_unref(caps);
+    }
+
+    const QSize aspectRatio(gst_discoverer_video_info_get_par_num(video),
+                            gst_discoverer_video_info_get_par_denom(video));
+    if (!aspectRatio.isEmpty())
+        metaData->insert(QMediaMetaData::PixelAspectRatio, aspectRatio);
+
+    const guint rateNum = gst_discoverer_video_info_get_framerate_num(video);
+    const guint rateDenom = gst_discoverer_video_info_get_framerate_denom(video);
+    if (rateNum > 0 && rateDenom > 0)
+        metaData->insert(QMediaMetaData::VideoFrameRate, qreal(rateNum) / rateDenom);
+
+    if (const guint bitRate = gst_discoverer_video_info_get_bitrate(video))
+        metaData->insert(QMediaMetaData::VideoBitRate, int(bitRate));
+
+    if (!metaData->contains(QMediaMetaData::VideoCodec)) {
+        const QString codec = qt_gst_codec_description(stream);
+        if (!codec.isEmpty())
+            metaData->insert(QMediaMetaData::VideoCodec, codec);
+    }
+}
+
+static void qt_gst_read_audio_stream(GstDiscovererAudioInfo *audio, QVariantMap *metaData)
+{
+    if (const guint channels = gst_discoverer_audio_info_get_channels(audio))
+        metaData->insert(QMediaMetaData::ChannelCount, int(channels));
+
+    if (const guint sampleRate = gst_discoverer_audio_info_get_sample_rate(audio))
+        metaData->insert(QMediaMetaData::SampleRate, int(sampleRate));
+
+    if (!metaData->contains(QMediaMetaData::AudioBitRate)) {
+        if (const guint bitRate = gst_discoverer_audio_info_get_bitrate(audio))
+            metaData->insert(QMediaMetaData::AudioBitRate, int(bitRate));
+    }
+
+    if (!metaData->contains(QMediaMetaData::AudioCodec)) {
+        const QString codec = qt_gst_codec_description(GST_DISCOVERER_STREAM_INFO(audio));
+        if (!codec.isEmpty())
+            metaData->insert(QMediaMetaData::AudioCodec, codec);
+    }
+}
+
+static bool qt_gst_discover(const QUrl &url, QVariantMap *metaData, QString *errorString)
+{
+    GstDiscoverer *discoverer = qt_gst_thread_discoverer(errorString);
+    if (!discoverer)
+        return false;
+
+    GError *error = nullptr;
+    GstDiscovererInfo *info = gst_discoverer_discover_uri(
+                discoverer, url.toEncoded().constData(), &error);
+
+    // Missing decoders still leave the container's duration and tags readable
+    const GstDiscovererResult result = info
+            ? gst_discoverer_info_get_result(info)
+            : GST_DISCOVERER_ERROR;
+    const bool ok = result == GST_DISCOVERER_OK || result == GST_DISCOVERER_MISSING_PLUGINS;
+
+    if (!ok) {
+        if (error)
+            *errorString = QString::fromUtf8(error->message);
+        else if (result == GST_DISCOVERER_TIMEOUT)
+            *errorString = QGstreamerMetaDataScannerControl::tr("Timed out reading the media");
+        else
+            *errorString = QGstreamerMetaDataScannerControl::tr("Unable to read the media");
+    }
+    if (error)
+        g_error_free(error);
+
+    if (!ok) {
+        if (info)
+            gst_discoverer_info_unref(info);
+        return false;
+    }
+
+    metaData->insert(QMediaMetaData::Size, QFileInfo(url.toLocalFile()).size());
+
+    const GstClockTime duration = gst_discoverer_info_get_duration(info);
+    if (GST_CLOCK_TIME_IS_VALID(duration))
+        metaData->insert(QMediaMetaData::Duration, qint64(duration / GST_MSECOND));
+
+    if (const GstTagList *tags = gst_discoverer_info_get_tags(info)) {
+        const QMap<QByteArray, QVariant> tagMap = QGstUtils::gstTagListToMap(tags);
+        for (auto it = tagMap.cbegin(); it != tagMap.cend(); ++it) {
+            const QString key = QGstreamerMetaDataProvider::metaDataKey(it.key());
+            QVariant value = it.value();
+#if GST_CHECK_VERSION(1,0,0)
+            // Decode cover art here rather than on the receiver's thread
+            if (value.userType() == qMetaTypeId<QGstTagImage>())
+                value = value.value<QGstTagImage>().image();
+#endif
+#if GST_CHECK_VERSION(0,10,30)
+            if (key == QMediaMetaData::Orientation)
+                value = QGstUtils::fromGStreamerOrientation(value);
+#endif
+            metaData->insert(key, value);
+        }
+    }
+
+    if (GList *streams = gst_discoverer_info_get_video_streams(info)) {
+        qt_gst_read_video_stream(GST_DISCOVERER_VIDEO_INFO(streams->data), metaData);
+        gst_discoverer_stream_info_list_free(streams);
+    }
+
+    if (GList *streams = gst_discoverer_info_get_audio_streams(info)) {
+        qt_gst_read_audio_stream(GST_DISCOVERER_AUDIO_INFO(streams->data), metaData);
+        gst_discoverer_stream_info_list_free(streams);
+    }
+
+    gst_discoverer_info_unref(info);
+    return true;
+}
+
+QGstreamerMetaDataScannerControl::QGstreamerMetaDataScannerControl(QObject *parent)
+    : QMetaDataScannerControl(parent)
+{
+    gst_pb_utils_init();
+
+    connect(&m_pool, SIGNAL(finished()), SIGNAL(finished()));
+}
+
+QGstreamerMetaDataScannerControl::~QGstreamerMetaDataScannerControl()
+{
+}
+
+void QGstreamerMetaDataScannerControl::scan(const QList<QUrl> &urls)
+{
+    for (const QUrl &url : urls) {
+        m_pool.start([this, url]() -> QGstreamerJobPool::Report {
+            QVariantMap metaData;
+            QString errorString;
+
+            if (!url.isLocalFile())
+                errorString = tr("Only local files can be scanned");
+            else if (qt_gst_discover(url, &metaData, &errorString))
+                return [this, url, metaData]() { emit scanned(url, metaData); };
+
+            return [this, url, errorString]() { emit failed(url, errorString); };
+        });
+    }
+}
+
+void QGstreamerMetaDataScannerControl::cancel()
+{
+    m_pool.cancel();
+}
+
+int QGstreamerMetaDataScannerControl::pendingCount() const
+{
+    return m_pool.pendingCount();
+}
+
+int QGstreamerMetaDataScannerControl::maximumWorkerCount() const
+{
+    return m_pool.maximumWorkerCount();
+}
+
+void QGstreamerMetaDataScannerControl::setMaximumWorkerCount(int count)
+{
+    m_pool.setMaximumWorkerCount(count);
+}
+
+QT_END_NAMESPACE
@@ -60,6 +60,8 @@
 #include <private/qgstreamervideoprobecontrol_p.h>
 #include <private/qgstreamerplayersession_p.h>
 #include <private/qgstreamerplayercontrol_p.h>
+#include <private/qgstreamerstatisticscontrol_p.h>
+#include <private/qgstreamerpreloadcontrol_p.h>
 
 #include <private/qmediaplaylistnavigator_p.h>
 #include <qmediaplaylist.h>
@@ -75,6 +77,8 @@ QGstreamerPlayerService::QGstreamerPlayerService(QObject *parent)
     m_metaData = new QGstreamerMetaDataProvider(m_session, this);
     m_streamsControl = new QGstreamerStreamsControl(m_session,this);
     m_availabilityControl = new QGStreamerAvailabilityControl(m_control->resources(), this);
+    m_statisticsControl = new QGstreamerStatisticsControl(m_session->statistics(), this);
+    m_preloadControl = new QGstreamerPreloadControl(m_session, this);
     m_videoRenderer = new QGstreamerVideoRenderer(this);
     m_videoWindow = new QGstreamerVideoWindow(this);
    // If the GStreamer video sink is not available, don't provide the video window control since
@@ -115,6 +119,12 @@ QMediaControl *QGstreamerPlayerService::requestControl(const char *name)
     if (qstrcmp(name, QMediaAvailabilityControl_iid) == 0)
         return m_availabilityControl;
 
+    if (qstrcmp(name, QMediaStatisticsControl_iid) == 0)
+        return m_statisticsControl;
+
+    if (qstrcmp(name, QMediaPlayerPreloadControl_iid) == 0)
+        return m_preloadControl;
+
     if (qstrcmp(name, QMediaVideoProbeControl_iid) == 0) {
         if (!m_videoProbeControl) {
             increaseVideoRef();
@@ -61,6 +61,8 @@ class QGstreamerVideoWidgetControl;
 class QGStreamerAvailabilityControl;
 class QGstreamerAudioProbeControl;
 class QGstreamerVideoProbeControl;
+class QGstreamerStatisticsControl;
+class QGstreamerPreloadControl;
 
 class QGstreamerPlayerService : public QMediaService
 {
@@ -81,6 +83,8 @@ private:
 
     QGstreamerAudioProbeControl *m_audioProbeControl = nullptr;
     QGstreamerVideoProbeControl *m_videoProbeControl = nullptr;
+    QGstreamerStatisticsControl *m_statisticsControl = nullptr;
+    QGstreamerPreloadControl *m_preloadControl = nullptr;
 
     QMediaControl *m_videoOutput = nullptr;
     QMediaControl *m_videoRenderer = nullptr;
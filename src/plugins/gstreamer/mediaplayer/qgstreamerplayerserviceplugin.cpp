@@ -48,6 +48,9 @@
 //#define QT_SUPPORTEDMIMETYPES_DEBUG
 
 #include "qgstreamerplayerservice.h"
+#include "qgstreamerjobservice.h"
+#include "qgstreamermetadatascannercontrol.h"
+#include "qgstreamerthumbnailercontrol.h"
 #include <private/qgstutils_p.h>
 
 QMediaService* QGstreamerPlayerServicePlugin::create(const QString &key)
@@ -56,6 +59,10 @@ QMediaService* QGstreamerPlayerServicePlugin::create(const QString &key)
 
     if (key == QLatin1String(Q_MEDIASERVICE_MEDIAPLAYER))
         return new QGstreamerPlayerService;
+    if (key == QLatin1String(Q_MEDIASERVICE_METADATASCANNER))
+        return new QGstreamerJobService(new QGstreamerMetaDataScannerControl, QMetaDataScannerControl_iid);
+    if (key == QLatin1String(Q_MEDIASERVICE_THUMBNAILER))
+        return new QGstreamerJobService(new QGstreamerThumbnailerControl, QMediaThumbnailerControl_iid);
 
     qWarning() << "Gstreamer service plugin: unsupported key:" << key;
     return 0;
@@ -0,0 +1,343 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgstreamerthumbnailercontrol.h"
+
+#include <QtCore/qthreadstorage.h>
+
+#include <private/qgstutils_p.h>
+
+#include <gst/app/gstappsink.h>
+
+QT_BEGIN_NAMESPACE
+
+#if GST_CHECK_VERSION(1,0,0)
+
+// Give up on a file when prerolling or seeking takes longer than this
+static const GstClockTime thumbnailerTimeout = 5 * GST_SECOND;
+
+// uridecodebin ! videoconvert ! videoscale ! capsfilter ! appsink, kept paused between
+// requests. Each worker thread owns one, so seeks within the same file skip the setup.
+class QGstreamerThumbnailPipeline
+{
+public:
+    QGstreamerThumbnailPipeline();
+    ~QGstreamerThumbnailPipeline();
+
+    QImage extract(const QUrl &url, qint64 position, const QSize &size, QString *errorString);
+
+private:
+    void reset();
+    bool waitForPreroll(QString *errorString);
+
+    static gboolean autoplugContinue(GstElement *bin, GstPad *pad, GstCaps *caps, gpointer userData);
+    static void padAdded(GstElement *bin, GstPad *pad, gpointer userData);
+    static void noMorePads(GstElement *bin, gpointer userData);
+
+    GstElement *m_pipeline = nullptr;
+    GstElement *m_decodeBin = nullptr;
+    GstElement *m_convert = nullptr;
+    GstElement *m_capsFilter = nullptr;
+    GstElement *m_sink = nullptr;
+    GstBus *m_bus = nullptr;
+
+    QUrl m_url;
+    QSize m_size;
+    qint64 m_position = -1;
+};
+
+QGstreamerThumbnailPipeline::QGstreamerThumbnailPipeline()
+{
+    GstElement *pipeline = gst_pipeline_new(nullptr);
+    GstElement *decodeBin = gst_element_factory_make("uridecodebin", nullptr);
+    GstElement *convert = gst_element_factory_make("videoconvert", nullptr);
+    GstElement *scale = gst_element_factory_make("videoscale", nullptr);
+    GstElement *capsFilter = gst_element_factory_make("capsfilter", nullptr);
+    GstElement *sink = gst_element_factory_make("appsink", nullptr);
+
+    if (!pipeline || !decodeBin || !convert || !scale || !capsFilter || !sink) {
+        for (GstElement *element : { pipeline, decodeBin, convert, scale, capsFilter, sink }) {
+            if (element)
+                gst_object_unref(GST_OBJECT(element));
+        }
+        return;
+    }
+
+    m_pipeline = pipeline;
+    m_decodeBin = decodeBin;
+    m_convert = convert;
+    m_capsFilter = capsFilter;
+    m_sink = sink;
+    m_bus = gst_element_get_bus(m_pipeline);
+
+    gst_bin_add_many(GST_BIN(m_pipeline), m_decodeBin, m_convert, scale, m_capsFilter, m_sink, NULL);
+    gst_element_link_many(m_convert, scale, m_capsFilter, m_sink, NULL);
+
+    g_signal_connect(G_OBJECT(m_decodeBin), "autoplug-continue", G_CALLBACK(autoplugContinue), nullptr);
+    g_signal_connect(G_OBJECT(m_decodeBin), "pad-added", G_CALLBACK(padAdded), m_convert);
+    g_signal_connect(G_OBJECT(m_decodeBin), "no-more-pads", G_CALLBACK(noMorePads), m_convert);
+
+    gst_app_sink_set_max_buffers(GST_APP_SINK(m_sink), 1);
+    gst_app_sink_set_drop(GST_APP_SINK(m_sink), TRUE);
+    gst_base_sink_set_sync(GST_BASE_SINK(m_sink), FALSE);
+}
+
+QGstreamerThumbnailPipeline::~QGstreamerThumbnailPipeline()
+{
+    if (m_pipeline) {
+        gst_element_set_state(m_pipeline, GST_STATE_NULL);
+        gst_object_unref(GST_OBJECT(m_bus));
+        gst_object_unref(GST_OBJECT(m_pipeline));
+    }
+}
+
+QImage QGstreamerThumbnailPipeline::extract(
+        const QUrl &url, qint64 position, const QSize &size, QString *errorString)
+{
+    if (!m_pipeline) {
+        *errorString = QGstreamerThumbnailerControl::tr("Could not create the decoding pipeline");
+        return QImage();
+    }
+
+    if (url != m_url || size != m_size || m_position < 0) {
+        reset();
+
+        g_object_set(G_OBJECT(m_decodeBin), "uri", url.toEncoded().constData(), NULL);
+
+        // videoscale keeps the display aspect ratio when fitting into the ranges
+        GstCaps *caps = gst_caps_new_simple(
+                    "video/x-raw",
+                    "format", G_TYPE_STRING, "RGBx",
+                    "pixel-aspect-ratio", GST_TYPE_FRACTION, 1, 1,
+                    NULL);
+        if (!size.isEmpty()) {
+            gst_caps_set_simple(
+                        caps,
+                        "width", GST_TYPE_INT_RANGE, 1, size.width(),
+                        "height", GST_TYPE_INT_RANGE, 1, size.height(),
+                        NULL);
+        }
+        g_object_set(G_OBJECT(m_capsFilter), "caps", caps, NULL);
+        gst_caps_unref(caps);
+
+        if (gst_element_set_state(m_pipeline, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE
+                || !waitForPreroll(errorString)) {
+            if (errorString->isEmpty())
+                *errorString = QGstreamerThumbnailerControl::tr("Could not open the media");
+            reset();
+            return QImage();
+        }
+
+        m_url = url;
+        m_size = size;
+        m_position = 0;
+    }
+
+    if (position != m_position) {
+        // Snapping to a key frame only decodes a single frame after the seek
+        if (gst_element_seek_simple(
+                    m_pipeline,
+                    GST_FORMAT_TIME,
+                    GstSeekFlags(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_NEAREST),
+                    position * GST_MSECOND)) {
+            if (!waitForPreroll(errorString)) {
+                reset();
+                return QImage();
+            }
+            m_position = position;
+        }
+        // Media that cannot seek only offers the frame it prerolled
+    }
+
+    QImage image;
+    if (GstSample *sample = gst_app_sink_pull_preroll(GST_APP_SINK(m_sink))) {
+        GstVideoInfo info;
+        if (gst_video_info_from_caps(&info, gst_sample_get_caps(sample)))
+            image = QGstUtils::bufferToImage(gst_sample_get_buffer(sample), info);
+        gst_sample_unref(sample);
+    }
+
+    if (image.isNull()) {
+        *errorString = QGstreamerThumbnailerControl::tr("No frame at the requested position");
+        return image;
+    }
+
+    // The format QPainter draws and scales fastest
+    return image.convertToFormat(QImage::Format_RGB32);
+}
+
+void QGstreamerThumbnailPipeline::reset()
+{
+    gst_element_set_state(m_pipeline, GST_STATE_NULL);
+
+    // Drop messages left from the previous media
+    gst_bus_set_flushing(m_bus, TRUE);
+    gst_bus_set_flushing(m_bus, FALSE);
+
+    m_url.clear();
+    m_size = QSize();
+    m_position = -1;
+}
+
+bool QGstreamerThumbnailPipeline::waitForPreroll(QString *errorString)
+{
+    GstMessage *message = gst_bus_timed_pop_filtered(
+                m_bus,
+                thumbnailerTimeout,
+                GstMessageType(GST_MESSAGE_ASYNC_DONE | GST_MESSAGE_ERROR));
+    if (!message) {
+        *errorString = QGstreamerThumbnailerControl::tr("Timed out decoding the media");
+        return false;
+    }
+
+    bool prerolled = true;
+    if (GST_MESSAGE_TYPE(message) == GST_MESSAGE_ERROR) {
+        GError *error = nullptr;
+        gchar *debug = nullptr;
+        gst_message_parse_error(message, &error, &debug);
+        *errorString = QString::fromUtf8(error->message);
+        g_error_free(error);
+        g_free(debug);
+        prerolled = false;
+    }
+    gst_message_unref(message);
+    return prerolled;
+}
+
+gboolean QGstreamerThumbnailPipeline::autoplugContinue(
+        GstElement *, GstPad *, GstCaps *caps, gpointer)
+{
+    if (gst_caps_is_empty(caps) || gst_caps_is_any(caps))
+        return TRUE;
+
+    // Audio is never linked, don't spend time decoding it
+    const GstStructure *structure = gst_caps_get_structure(caps, 0);
+    return !g_str_has_prefix(gst_structure_get_name(structure), "audio/");
+}
+
+void QGstreamerThumbnailPipeline::padAdded(GstElement *, GstPad *pad, gpointer userData)
+{
+    GstElement *convert = static_cast<GstElement *>(userData);
+    GstPad *sinkPad = gst_element_get_static_pad(convert, "sink");
+
+    if (!gst_pad_is_linked(sinkPad)) {
+        if (GstCaps *caps = qt_gst_pad_get_current_caps(pad)) {
+            const GstStructure *structure = gst_caps_get_structure(caps, 0);
+            if (g_str_has_prefix(gst_structure_get_name(structure), "video/x-raw"))
+                gst_pad_link(pad, sinkPad);
+            gst_caps_unref(caps);
+        }
+    }
+
+    gst_object_unref(GST_OBJECT(sinkPad));
+}
+
+void QGstreamerThumbnailPipeline::noMorePads(GstElement *bin, gpointer userData)
+{
+    GstElement *convert = static_cast<GstElement *>(userData);
+    GstPad *sinkPad = gst_element_get_static_pad(convert, "sink");
+
+    // Otherwise the sink would wait for a frame until the timeout
+    if (!gst_pad_is_linked(sinkPad)) {
+        GST_ELEMENT_ERROR(bin, STREAM, WRONG_TYPE,
+                          ("%s", QGstreamerThumbnailerControl::tr("The media has no video").toUtf8().constData()),
+                          (NULL));
+    }
+
+    gst_object_unref(GST_OBJECT(sinkPad));
+}
+
+static QThreadStorage<QGstreamerThumbnailPipeline *> threadPipeline;
+
+#endif
+
+QGstreamerThumbnailerControl::QGstreamerThumbnailerControl(QObject *parent)
+    : QMediaThumbnailerControl(parent)
+{
+    connect(&m_pool, SIGNAL(finished()), SIGNAL(finished()));
+}
+
+QGstreamerThumbnailerControl::~QGstreamerThumbnailerControl()
+{
+}
+
+void QGstreamerThumbnailerControl::request(int id, const QUrl &url, qint64 position, const QSize &size)
+{
+    m_pool.start([this, id, url, position, size]() -> QGstreamerJobPool::Report {
+        QString errorString;
+
+#if GST_CHECK_VERSION(1,0,0)
+        if (!threadPipeline.hasLocalData())
+            threadPipeline.setLocalData(new QGstreamerThumbnailPipeline);
+
+        const QImage image = threadPipeline.localData()->extract(url, position, size, &errorString);
+        if (!image.isNull())
+            return [this, id, image]() { emit thumbnailReady(id, image); };
+#else
+        Q_UNUSED(url);
+        Q_UNUSED(position);
+        Q_UNUSED(size);
+        errorString = tr("Thumbnails require GStreamer 1.0");
+#endif
+
+        return [this, id, errorString]() { emit failed(id, errorString); };
+    });
+}
+
+void QGstreamerThumbnailerControl::cancel()
+{
+    m_pool.cancel();
+}
+
+int QGstreamerThumbnailerControl::pendingCount() const
+{
+    return m_pool.pendingCount();
+}
+
+int QGstreamerThumbnailerControl::maximumWorkerCount() const
+{
+    return m_pool.maximumWorkerCount();
+}
+
+void QGstreamerThumbnailerControl::setMaximumWorkerCount(int count)
+{
+    m_pool.setMaximumWorkerCount(count);
+}
+
+QT_END_NAMESPACE
@@ -302,6 +302,10 @@ QCameraImageCapture::DriveMode BbCameraSession::driveMode() const
 
 void BbCameraSession::setDriveMode(QCameraImageCapture::DriveMode mode)
 {
+    // Only single image capture is implemented
+    if (mode != QCameraImageCapture::SingleImageCapture)
+        return;
+
     m_captureImageDriveMode = mode;
 }
 
@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qdeclarativevideofilterpipeline_p.h"
+#include "qdeclarativevideooutput_render_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QDeclarativeVideoFilterStage::QDeclarativeVideoFilterStage(QDeclarativeVideoFilterPipeline *pipeline,
+                                                           QVideoFilterRunnable *runnable,
+                                                           bool active,
+                                                           QVideoFilterRunnable::RunFlags flags,
+                                                           QDeclarativeVideoFilterStage *next)
+    : m_pipeline(pipeline)
+    , m_runnable(runnable)
+    , m_active(active)
+    , m_flags(int(flags))
+    , m_next(next)
+{
+    setObjectName(QStringLiteral("VideoFilterStage"));
+}
+
+QDeclarativeVideoFilterStage::~QDeclarativeVideoFilterStage()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_quit = true;
+        m_jobs.clear();
+        m_condition.wakeAll();
+    }
+    wait();
+}
+
+void QDeclarativeVideoFilterStage::enqueue(const QDeclarativeVideoFilterJob &job)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_jobs.count() >= QDeclarativeVideoFilterPipeline::MaxQueuedFrames)
+        m_jobs.dequeue();
+    m_jobs.enqueue(job);
+    m_condition.wakeOne();
+}
+
+void QDeclarativeVideoFilterStage::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    m_jobs.clear();
+}
+
+void QDeclarativeVideoFilterStage::run()
+{
+    forever {
+        QDeclarativeVideoFilterJob job;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_quit && m_jobs.isEmpty())
+                m_condition.wait(&m_mutex);
+            if (m_quit)
+                break;
+            job = m_jobs.dequeue();
+        }
+
+        // Frames of a flushed generation are not shown anymore
+        if (job.generation != m_pipeline->generation())
+            continue;
+
+        if (m_runnable && m_active.loadAcquire()) {
+            const QVideoFilterRunnable::RunFlags flags(QFlag(m_flags.loadAcquire()));
+            QVideoFrame newFrame = m_runnable->run(&job.frame, job.surfaceFormat, flags);
+            if (newFrame.isValid() && newFrame != job.frame) {
+                job.modified = true;
+                job.frame = newFrame;
+            }
+        }
+        ++job.filterCount;
+
+        if (QDeclarativeVideoFilterStage *next = m_next.loadAcquire())
+            next->enqueue(job);
+        else
+            m_pipeline->deliver(job);
+    }
+
+    delete m_runnable;
+    m_runnable = nullptr;
+}
+
+QDeclarativeVideoFilterPipeline::QDeclarativeVideoFilterPipeline(QDeclarativeVideoRendererBackend *backend,
+                                                                 const QList<QAbstractVideoFilter *> &filters,
+                                                                 bool lastInChain)
+    : m_backend(backend)
+{
+    // Create the stages back to front so that each one knows its successor
+    QDeclarativeVideoFilterStage *next = nullptr;
+    for (int i = filters.count() - 1; i >= 0; --i) {
+        next = createStage(filters.at(i), lastInChain && !next, next);
+        m_stages.prepend(next);
+    }
+
+    for (QDeclarativeVideoFilterStage *stage : qAsConst(m_stages))
+        stage->start();
+}
+
+QDeclarativeVideoFilterStage *QDeclarativeVideoFilterPipeline::createStage(QAbstractVideoFilter *filter,
+                                                                          bool lastInChain,
+                                                                          QDeclarativeVideoFilterStage *next)
+{
+    QVideoFilterRunnable::RunFlags flags;
+    if (lastInChain)
+        flags |= QVideoFilterRunnable::LastInChain;
+    QDeclarativeVideoFilterStage *stage = new QDeclarativeVideoFilterStage(
+            this, filter->createFilterRunnable(), filter->isActive(), flags, next);
+    // Disconnected when the pipeline is destroyed, or with the filter
+    connect(filter, &QAbstractVideoFilter::activeChanged, this, [stage, filter]() {
+        stage->setActive(filter->isActive());
+    });
+    return stage;
+}
+
+void QDeclarativeVideoFilterPipeline::append(QAbstractVideoFilter *filter, bool lastInChain)
+{
+    QDeclarativeVideoFilterStage *stage = createStage(filter, lastInChain, nullptr);
+    stage->start();
+
+    // Frames which already left the previous last stage are delivered with
+    // a lower filterCount, the render thread runs the new filter on them.
+    QDeclarativeVideoFilterStage *last = m_stages.last();
+    last->setFlags(QVideoFilterRunnable::RunFlags());
+    last->setNext(stage);
+    m_stages.append(stage);
+}
+
+void QDeclarativeVideoFilterPipeline::setLastInChain(bool lastInChain)
+{
+    QVideoFilterRunnable::RunFlags flags;
+    if (lastInChain)
+        flags |= QVideoFilterRunnable::LastInChain;
+    m_stages.last()->setFlags(flags);
+}
+
+QDeclarativeVideoFilterPipeline::~QDeclarativeVideoFilterPipeline()
+{
+    // Stop front to back, so that no stage feeds one that is already gone
+    qDeleteAll(m_stages);
+}
+
+void QDeclarativeVideoFilterPipeline::enqueue(const QVideoFrame &frame, const QVideoSurfaceFormat &surfaceFormat)
+{
+    QDeclarativeVideoFilterJob job;
+    job.frame = frame;
+    job.surfaceFormat = surfaceFormat;
+    job.generation = generation();
+    m_stages.first()->enqueue(job);
+}
+
+void QDeclarativeVideoFilterPipeline::flush()
+{
+    m_generation.ref();
+    for (QDeclarativeVideoFilterStage *stage : qAsConst(m_stages))
+        stage->flush();
+}
+
+void QDeclarativeVideoFilterPipeline::deliver(const QDeclarativeVideoFilterJob &job)
+{
+    m_backend->presentFiltered(job.frame, job.modified, job.filterCount, job.generation);
+}
+
+QT_END_NAMESPACE
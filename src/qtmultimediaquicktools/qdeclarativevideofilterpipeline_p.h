@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QDECLARATIVEVIDEOFILTERPIPELINE_P_H
+#define QDECLARATIVEVIDEOFILTERPIPELINE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtMultimedia/qabstractvideofilter.h>
+
+QT_BEGIN_NAMESPACE
+
+class QDeclarativeVideoRendererBackend;
+class QDeclarativeVideoFilterPipeline;
+
+struct QDeclarativeVideoFilterJob
+{
+    QVideoFrame frame;
+    QVideoSurfaceFormat surfaceFormat;
+    bool modified = false;
+    int generation = 0;
+    // Number of stages the frame went through
+    int filterCount = 0;
+};
+
+// Runs a single CPU-only filter on its own thread. The runnable is created
+// on the gui thread together with the stage, it is invoked and destroyed
+// on the stage thread. The stage never touches the filter object itself.
+// The flags and the next stage change when a filter is appended.
+class QDeclarativeVideoFilterStage : public QThread
+{
+public:
+    QDeclarativeVideoFilterStage(QDeclarativeVideoFilterPipeline *pipeline,
+                                 QVideoFilterRunnable *runnable,
+                                 bool active,
+                                 QVideoFilterRunnable::RunFlags flags,
+                                 QDeclarativeVideoFilterStage *next);
+    ~QDeclarativeVideoFilterStage();
+
+    void setActive(bool active) { m_active.storeRelease(active); }
+    void setFlags(QVideoFilterRunnable::RunFlags flags) { m_flags.storeRelease(int(flags)); }
+    void setNext(QDeclarativeVideoFilterStage *next) { m_next.storeRelease(next); }
+
+    void enqueue(const QDeclarativeVideoFilterJob &job);
+    void flush();
+
+protected:
+    void run() override;
+
+private:
+    QDeclarativeVideoFilterPipeline *m_pipeline;
+    QVideoFilterRunnable *m_runnable;
+    QAtomicInt m_active;
+    QAtomicInt m_flags;
+    QAtomicPointer<QDeclarativeVideoFilterStage> m_next;
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    QQueue<QDeclarativeVideoFilterJob> m_jobs;
+    bool m_quit = false;
+};
+
+// Bounded, in-order pipeline running the leading CPU-only filters of a
+// VideoOutput ahead of the render thread. Filtered frames are handed back to
+// the backend, which then only has to upload and draw them.
+//
+// The pipeline is created, extended and destroyed on the gui thread, which
+// owns the filters. It follows their active property from there.
+class QDeclarativeVideoFilterPipeline : public QObject
+{
+public:
+    // Maximum number of frames waiting in front of a single filter. When a
+    // filter falls behind, the oldest waiting frame is dropped.
+    enum { MaxQueuedFrames = 2 };
+
+    QDeclarativeVideoFilterPipeline(QDeclarativeVideoRendererBackend *backend,
+                                    const QList<QAbstractVideoFilter *> &filters,
+                                    bool lastInChain);
+    ~QDeclarativeVideoFilterPipeline();
+
+    int filterCount() const { return m_stages.count(); }
+    int generation() const { return m_generation.loadAcquire(); }
+
+    // Adds a stage behind the last one while frames keep flowing
+    void append(QAbstractVideoFilter *filter, bool lastInChain);
+    // Whether the last stage runs the last filter of the VideoOutput
+    void setLastInChain(bool lastInChain);
+
+    void enqueue(const QVideoFrame &frame, const QVideoSurfaceFormat &surfaceFormat);
+    void flush();
+
+private:
+    friend class QDeclarativeVideoFilterStage;
+    QDeclarativeVideoFilterStage *createStage(QAbstractVideoFilter *filter, bool lastInChain,
+                                              QDeclarativeVideoFilterStage *next);
+    void deliver(const QDeclarativeVideoFilterJob &job);
+
+    QDeclarativeVideoRendererBackend *m_backend;
+    QList<QDeclarativeVideoFilterStage *> m_stages;
+    QAtomicInt m_generation;
+};
+
+QT_END_NAMESPACE
+
+#endif
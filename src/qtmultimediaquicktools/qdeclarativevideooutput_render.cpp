@@ -40,6 +40,7 @@
 
 #include "qdeclarativevideooutput_render_p.h"
 #include "qdeclarativevideooutput_p.h"
+#include "qdeclarativevideofilterpipeline_p.h"
 #include <QtMultimedia/qabstractvideofilter.h>
 #include <QtMultimedia/qvideorenderercontrol.h>
 #include <QtMultimedia/qmediaservice.h>
@@ -61,7 +62,10 @@ Q_GLOBAL_STATIC_WITH_ARGS(QMediaPluginLoader, videoNodeFactoryLoader,
 QDeclarativeVideoRendererBackend::QDeclarativeVideoRendererBackend(QDeclarativeVideoOutput *parent)
     : QDeclarativeVideoBackend(parent),
       m_glContext(0),
-      m_frameChanged(false)
+      m_frameChanged(false),
+      m_filterPipeline(nullptr),
+      m_frameFilterOffset(0),
+      m_frameFiltered(false)
 {
     m_surface = new QSGVideoItemSurface(this);
     QObject::connect(m_surface, SIGNAL(surfaceFormatChanged(QVideoSurfaceFormat)),
@@ -93,6 +97,7 @@ QDeclarativeVideoRendererBackend::~QDeclarativeVideoRendererBackend()
 {
     releaseSource();
     releaseControl();
+    delete takeFilterPipeline();
     delete m_surface;
 }
 
@@ -115,15 +120,76 @@ bool QDeclarativeVideoRendererBackend::init(QMediaService *service)
 
 void QDeclarativeVideoRendererBackend::appendFilter(QAbstractVideoFilter *filter)
 {
+    // Called on the gui thread, which owns the filters. The pipeline keeps
+    // running, a new filter is only added behind what is already there, so
+    // frames filtered so far stay valid.
     QMutexLocker lock(&m_frameMutex);
+    const bool allCpuOnly = m_filterPipeline
+            ? m_filterPipeline->filterCount() == m_filters.count()
+            : m_filters.isEmpty();
     m_filters.append(Filter(filter));
+
+    // Filters behind one that is not CPU-only run on the render thread
+    if (!allCpuOnly || !filter)
+        return;
+
+    if (!filter->isCpuOnly()) {
+        if (m_filterPipeline)
+            m_filterPipeline->setLastInChain(false);
+    } else if (m_filterPipeline) {
+        m_filterPipeline->append(filter, true);
+    } else {
+        m_filterPipeline = createFilterPipeline();
+    }
 }
 
 void QDeclarativeVideoRendererBackend::clearFilters()
 {
+    delete takeFilterPipeline();
+
     QMutexLocker lock(&m_frameMutex);
     scheduleDeleteFilterResources();
     m_filters.clear();
+    discardFilteredFrame();
+}
+
+QDeclarativeVideoFilterPipeline *QDeclarativeVideoRendererBackend::takeFilterPipeline()
+{
+    QMutexLocker lock(&m_frameMutex);
+    QDeclarativeVideoFilterPipeline *pipeline = m_filterPipeline;
+    m_filterPipeline = nullptr;
+    return pipeline;
+}
+
+QDeclarativeVideoFilterPipeline *QDeclarativeVideoRendererBackend::createFilterPipeline()
+{
+    // Called on the gui thread with m_frameMutex locked. The pipeline takes
+    // what it needs from the filters here, its threads never access them.
+    QList<QAbstractVideoFilter *> cpuFilters;
+    for (const Filter &filter : qAsConst(m_filters)) {
+        if (!filter.filter || !filter.filter->isCpuOnly())
+            break;
+        cpuFilters.append(filter.filter);
+    }
+
+    if (cpuFilters.isEmpty())
+        return nullptr;
+
+    return new QDeclarativeVideoFilterPipeline(this, cpuFilters,
+                                               cpuFilters.count() == m_filters.count());
+}
+
+void QDeclarativeVideoRendererBackend::discardFilteredFrame()
+{
+    // Called with m_frameMutex locked when the filter list changes. A frame
+    // that already went through the previous pipeline cannot be matched
+    // against the new list, the item keeps showing the previous frame.
+    if (m_frameFilterOffset > 0) {
+        m_frame = QVideoFrame();
+        m_frameChanged = false;
+    }
+    m_frameFilterOffset = 0;
+    m_frameFiltered = false;
 }
 
 class FilterRunnableDeleter : public QRunnable
@@ -289,11 +355,12 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
         }
     }
 
-    bool isFrameModified = false;
+    bool isFrameModified = m_frameFiltered;
     if (m_frameChanged) {
         // Run the VideoFilter if there is one. This must be done before potentially changing the videonode below.
         if (m_frame.isValid() && !m_filters.isEmpty()) {
-            for (int i = 0; i < m_filters.count(); ++i) {
+            // Filters before m_frameFilterOffset already ran in the filter pipeline
+            for (int i = m_frameFilterOffset; i < m_filters.count(); ++i) {
                 QAbstractVideoFilter *filter = m_filters[i].filter;
                 QVideoFilterRunnable *&runnable = m_filters[i].runnable;
                 if (filter && filter->isActive()) {
@@ -354,6 +421,8 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
 
     if (!videoNode) {
         m_frameChanged = false;
+        m_frameFilterOffset = 0;
+        m_frameFiltered = false;
         m_frame = QVideoFrame();
         return 0;
     }
@@ -376,6 +445,8 @@ QSGNode *QDeclarativeVideoRendererBackend::updatePaintNode(QSGNode *oldNode,
 
         //don't keep the frame for more than really necessary
         m_frameChanged = false;
+        m_frameFilterOffset = 0;
+        m_frameFiltered = false;
         m_frame = QVideoFrame();
     }
     return videoNode;
@@ -410,13 +481,46 @@ QOpenGLContext *QDeclarativeVideoRendererBackend::glContext() const
 void QDeclarativeVideoRendererBackend::present(const QVideoFrame &frame)
 {
     m_frameMutex.lock();
+    if (frame.isValid() && frame.handleType() == QAbstractVideoBuffer::NoHandle
+            && m_filterPipeline) {
+        // Shown once the CPU-only filters are done with it
+        m_filterPipeline->enqueue(frame, m_surfaceFormat);
+        m_frameMutex.unlock();
+        return;
+    }
+
+    // Frames still in the pipeline must not overwrite a flush
+    if (!frame.isValid() && m_filterPipeline)
+        m_filterPipeline->flush();
+
     m_frame = frame.isValid() ? frame : m_frameOnFlush;
     m_frameChanged = true;
+    m_frameFilterOffset = 0;
+    m_frameFiltered = false;
     m_frameMutex.unlock();
 
     q->update();
 }
 
+void QDeclarativeVideoRendererBackend::presentFiltered(const QVideoFrame &frame, bool modified, int filterCount, int generation)
+{
+    // Called on the last thread of the filter pipeline
+    m_frameMutex.lock();
+    if (!m_filterPipeline || m_filterPipeline->generation() != generation) {
+        m_frameMutex.unlock();
+        return;
+    }
+
+    m_frame = frame;
+    m_frameChanged = true;
+    m_frameFilterOffset = filterCount;
+    m_frameFiltered = modified;
+    m_frameMutex.unlock();
+
+    // Items must only be updated from the gui thread
+    QMetaObject::invokeMethod(q, "update", Qt::QueuedConnection);
+}
+
 void QDeclarativeVideoRendererBackend::stop()
 {
     present(QVideoFrame());
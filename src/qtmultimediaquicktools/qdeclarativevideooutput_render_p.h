@@ -58,6 +58,8 @@
 #include <private/qsgvideonode_texture_p.h>
 
 #include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtMultimedia/qabstractvideofilter.h>
 #include <QtMultimedia/qabstractvideosurface.h>
 
 QT_BEGIN_NAMESPACE
@@ -65,8 +67,8 @@ QT_BEGIN_NAMESPACE
 class QSGVideoItemSurface;
 class QVideoRendererControl;
 class QOpenGLContext;
-class QAbstractVideoFilter;
 class QVideoFilterRunnable;
+class QDeclarativeVideoFilterPipeline;
 
 class QDeclarativeVideoRendererBackend : public QDeclarativeVideoBackend
 {
@@ -87,6 +89,7 @@ public:
 
     friend class QSGVideoItemSurface;
     void present(const QVideoFrame &frame);
+    void presentFiltered(const QVideoFrame &frame, bool modified, int filterCount, int generation);
     void stop();
 
     void appendFilter(QAbstractVideoFilter *filter) override;
@@ -96,6 +99,9 @@ public:
 
 private:
     void scheduleDeleteFilterResources();
+    QDeclarativeVideoFilterPipeline *takeFilterPipeline();
+    QDeclarativeVideoFilterPipeline *createFilterPipeline();
+    void discardFilteredFrame();
 
     QPointer<QVideoRendererControl> m_rendererControl;
     QList<QSGVideoNodeFactoryInterface*> m_videoNodeFactories;
@@ -113,12 +119,17 @@ private:
     QRectF m_sourceTextureRect;    // Source texture coordinates
 
     struct Filter {
-        Filter() : filter(0), runnable(0) { }
+        Filter() : runnable(0) { }
         Filter(QAbstractVideoFilter *filter) : filter(filter), runnable(0) { }
-        QAbstractVideoFilter *filter;
+        QPointer<QAbstractVideoFilter> filter;
         QVideoFilterRunnable *runnable;
     };
     QList<Filter> m_filters;
+
+    // Leading CPU-only filters, run ahead of the render thread
+    QDeclarativeVideoFilterPipeline *m_filterPipeline;
+    int m_frameFilterOffset;       // Number of filters already applied to m_frame
+    bool m_frameFiltered;
 };
 
 class QSGVideoItemSurface : public QAbstractVideoSurface
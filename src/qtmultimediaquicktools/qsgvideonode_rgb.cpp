@@ -37,6 +37,7 @@
 **
 ****************************************************************************/
 #include "qsgvideonode_rgb_p.h"
+#include "qsgvideotextureuploader_p.h"
 #include <QtQuick/qsgtexturematerial.h>
 #include <QtQuick/qsgmaterial.h>
 #include <QtCore/qmutex.h>
@@ -143,8 +144,10 @@ public:
 
     ~QSGVideoMaterial_RGB()
     {
-        if (m_textureId)
+        if (m_textureId) {
             QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_textureId);
+            m_uploader.release();
+        }
     }
 
     QSGMaterialType *type() const override {
@@ -197,12 +200,9 @@ public:
                 m_width = qreal(m_frame.width()) / stride;
                 textureSize.setWidth(stride);
 
-                if (m_textureSize != textureSize) {
-                    if (!m_textureSize.isEmpty())
-                        functions->glDeleteTextures(1, &m_textureId);
+                if (!m_textureId)
                     functions->glGenTextures(1, &m_textureId);
-                    m_textureSize = textureSize;
-                }
+                m_textureSize = textureSize;
 
                 GLint dataType = GL_UNSIGNED_BYTE;
                 GLint dataFormat = GL_RGBA;
@@ -217,18 +217,11 @@ public:
                 functions->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
                 functions->glActiveTexture(GL_TEXTURE0);
-                functions->glBindTexture(GL_TEXTURE_2D, m_textureId);
-                functions->glTexImage2D(GL_TEXTURE_2D, 0, dataFormat,
-                                        m_textureSize.width(), m_textureSize.height(),
-                                        0, dataFormat, dataType, m_frame.bits());
+                m_uploader.upload(0, m_textureId, m_textureSize.width(), m_textureSize.height(),
+                                  dataFormat, dataType, m_frame.bits());
 
                 functions->glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
 
-                functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
                 m_frame.unmap();
             }
             m_frame = QVideoFrame();
@@ -243,6 +236,7 @@ public:
     QSize m_textureSize;
     QVideoSurfaceFormat m_format;
     GLuint m_textureId;
+    QSGVideoTextureUploader m_uploader;
     qreal m_opacity;
     GLfloat m_width;
 
@@ -37,6 +37,7 @@
 **
 ****************************************************************************/
 #include "qsgvideonode_yuv_p.h"
+#include "qsgvideotextureuploader_p.h"
 #include <QtCore/qmutex.h>
 #include <QtQuick/qsgtexturematerial.h>
 #include <QtQuick/qsgmaterial.h>
@@ -47,24 +48,9 @@
 #ifndef GL_RED
 #define GL_RED 0x1903
 #endif
-#ifndef GL_GREEN
-#define GL_GREEN 0x1904
-#endif
 #ifndef GL_RG
 #define GL_RG 0x8227
 #endif
-#ifndef GL_TEXTURE_SWIZZLE_R
-#define GL_TEXTURE_SWIZZLE_R 0x8E42
-#endif
-#ifndef GL_TEXTURE_SWIZZLE_G
-#define GL_TEXTURE_SWIZZLE_G 0x8E43
-#endif
-#ifndef GL_TEXTURE_SWIZZLE_B
-#define GL_TEXTURE_SWIZZLE_B 0x8E44
-#endif
-#ifndef GL_TEXTURE_SWIZZLE_A
-#define GL_TEXTURE_SWIZZLE_A 0x8E45
-#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -279,7 +265,7 @@ public:
     }
 
     void bind();
-    void bindTexture(int id, int w, int h, const uchar *bits, GLenum format);
+    void bindTexture(int plane, int w, int h, const uchar *bits, GLenum format);
 
     QVideoSurfaceFormat m_format;
     QSize m_textureSize;
@@ -293,6 +279,8 @@ public:
 
     QVideoFrame m_frame;
     QMutex m_frameMutex;
+
+    QSGVideoTextureUploader m_uploader;
 };
 
 QSGVideoMaterial_YUV::QSGVideoMaterial_YUV(const QVideoSurfaceFormat &format) :
@@ -348,9 +336,10 @@ QSGVideoMaterial_YUV::QSGVideoMaterial_YUV(const QVideoSurfaceFormat &format) :
 QSGVideoMaterial_YUV::~QSGVideoMaterial_YUV()
 {
     if (!m_textureSize.isEmpty()) {
-        if (QOpenGLContext *current = QOpenGLContext::currentContext())
+        if (QOpenGLContext *current = QOpenGLContext::currentContext()) {
             current->functions()->glDeleteTextures(m_planeCount, m_textureIds);
-        else
+            m_uploader.release();
+        } else
             qWarning() << "QSGVideoMaterial_YUV: Cannot obtain GL context, unable to delete textures";
     }
 }
@@ -366,13 +355,11 @@ void QSGVideoMaterial_YUV::bind()
             int fw = m_frame.width();
             int fh = m_frame.height();
 
-            // Frame has changed size, recreate textures...
-            if (m_textureSize != m_frame.size()) {
-                if (!m_textureSize.isEmpty())
-                    functions->glDeleteTextures(m_planeCount, m_textureIds);
+            // Texture objects are created once, their storage is only
+            // reallocated by the uploader when the frame size changes.
+            if (m_textureSize.isEmpty())
                 functions->glGenTextures(m_planeCount, m_textureIds);
-                m_textureSize = m_frame.size();
-            }
+            m_textureSize = m_frame.size();
 
             GLint previousAlignment;
             const GLenum texFormat1 = (profile == QSurfaceFormat::CoreProfile) ? GL_RED : GL_LUMINANCE;
@@ -393,10 +380,10 @@ void QSGVideoMaterial_YUV::bind()
                 // Additionally U and V are set per 2 pixels hence only 1/2 of image width is used.
                 // Interpreting this properly in shaders allows to not copy or not make conditionals inside shaders,
                 // only interpretation of data changes.
-                bindTexture(m_textureIds[1], m_planeWidth[1], m_frame.height(), m_frame.bits(), GL_RGBA);
+                bindTexture(1, m_planeWidth[1], m_frame.height(), m_frame.bits(), GL_RGBA);
                 functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
                 // Either red (YUYV) or alpha (UYVY) values are used as source of Y
-                bindTexture(m_textureIds[0], m_planeWidth[0], m_frame.height(), m_frame.bits(), texFormat2);
+                bindTexture(0, m_planeWidth[0], m_frame.height(), m_frame.bits(), texFormat2);
             } else if (m_format.pixelFormat() == QVideoFrame::Format_NV12
                     || m_format.pixelFormat() == QVideoFrame::Format_NV21) {
                 const int y = 0;
@@ -405,9 +392,9 @@ void QSGVideoMaterial_YUV::bind()
                 m_planeWidth[0] = m_planeWidth[1] = qreal(fw) / m_frame.bytesPerLine(y);
 
                 functions->glActiveTexture(GL_TEXTURE1);
-                bindTexture(m_textureIds[1], m_frame.bytesPerLine(uv) / 2, fh / 2, m_frame.bits(uv), texFormat2);
+                bindTexture(1, m_frame.bytesPerLine(uv) / 2, fh / 2, m_frame.bits(uv), texFormat2);
                 functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
-                bindTexture(m_textureIds[0], m_frame.bytesPerLine(y), fh, m_frame.bits(y), texFormat1);
+                bindTexture(0, m_frame.bytesPerLine(y), fh, m_frame.bits(y), texFormat1);
 
             } else { // YUV420P || YV12 || YUV422P
                 const int y = 0;
@@ -420,11 +407,11 @@ void QSGVideoMaterial_YUV::bind()
                 const int uvHeight = m_frame.pixelFormat() == QVideoFrame::Format_YUV422P ? fh : fh / 2;
 
                 functions->glActiveTexture(GL_TEXTURE1);
-                bindTexture(m_textureIds[1], m_frame.bytesPerLine(u), uvHeight, m_frame.bits(u), texFormat1);
+                bindTexture(1, m_frame.bytesPerLine(u), uvHeight, m_frame.bits(u), texFormat1);
                 functions->glActiveTexture(GL_TEXTURE2);
-                bindTexture(m_textureIds[2], m_frame.bytesPerLine(v), uvHeight, m_frame.bits(v), texFormat1);
+                bindTexture(2, m_frame.bytesPerLine(v), uvHeight, m_frame.bits(v), texFormat1);
                 functions->glActiveTexture(GL_TEXTURE0); // Finish with 0 as default texture unit
-                bindTexture(m_textureIds[0], m_frame.bytesPerLine(y), fh, m_frame.bits(y), texFormat1);
+                bindTexture(0, m_frame.bytesPerLine(y), fh, m_frame.bits(y), texFormat1);
             }
 
             functions->glPixelStorei(GL_UNPACK_ALIGNMENT, previousAlignment);
@@ -441,22 +428,9 @@ void QSGVideoMaterial_YUV::bind()
     }
 }
 
-void QSGVideoMaterial_YUV::bindTexture(int id, int w, int h, const uchar *bits, GLenum format)
+void QSGVideoMaterial_YUV::bindTexture(int plane, int w, int h, const uchar *bits, GLenum format)
 {
-    QOpenGLFunctions *functions = QOpenGLContext::currentContext()->functions();
-    functions->glBindTexture(GL_TEXTURE_2D, id);
-    functions->glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, bits);
-    // replacement for GL_LUMINANCE_ALPHA in core profile
-    if (format == GL_RG) {
-        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
-        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
-        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
-        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_GREEN);
-    }
-    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    m_uploader.upload(plane, m_textureIds[plane], w, h, format, GL_UNSIGNED_BYTE, bits);
 }
 
 QSGVideoNode_YUV::QSGVideoNode_YUV(const QVideoSurfaceFormat &format) :
@@ -0,0 +1,204 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgvideotextureuploader_p.h"
+
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLExtraFunctions>
+
+#include <string.h>
+
+#ifndef GL_RG
+#define GL_RG 0x8227
+#endif
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+#ifndef GL_GREEN
+#define GL_GREEN 0x1904
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_R
+#define GL_TEXTURE_SWIZZLE_R 0x8E42
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_G
+#define GL_TEXTURE_SWIZZLE_G 0x8E43
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_B
+#define GL_TEXTURE_SWIZZLE_B 0x8E44
+#endif
+#ifndef GL_TEXTURE_SWIZZLE_A
+#define GL_TEXTURE_SWIZZLE_A 0x8E45
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+
+QT_BEGIN_NAMESPACE
+
+QSGVideoTextureUploader::QSGVideoTextureUploader()
+    : m_pixelBufferSupport(-1)
+{
+}
+
+QSGVideoTextureUploader::~QSGVideoTextureUploader()
+{
+    release();
+}
+
+bool QSGVideoTextureUploader::usePixelBuffers(QOpenGLContext *context)
+{
+    if (m_pixelBufferSupport < 0) {
+        static const bool requested = qEnvironmentVariableIntValue("QT_VIDEONODE_PBO_UPLOAD");
+        // Mapping buffer ranges needs OpenGL (ES) 3
+        m_pixelBufferSupport = requested && context->format().majorVersion() >= 3;
+    }
+    return m_pixelBufferSupport > 0;
+}
+
+static int bytesPerPixel(GLenum format, GLenum type)
+{
+    if (type == GL_UNSIGNED_SHORT_5_6_5)
+        return 2;
+
+    switch (format) {
+    case GL_RGBA:
+        return 4;
+    case GL_RGB:
+        return 3;
+    case GL_RG:
+    case GL_LUMINANCE_ALPHA:
+        return 2;
+    default: // GL_RED, GL_LUMINANCE
+        return 1;
+    }
+}
+
+void QSGVideoTextureUploader::upload(int plane, GLuint textureId, int width, int height,
+                                     GLenum format, GLenum type, const uchar *bits)
+{
+    Q_ASSERT(plane >= 0 && plane < MaxPlanes);
+
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    QOpenGLFunctions *functions = context->functions();
+    Plane &p = m_planes[plane];
+
+    functions->glBindTexture(GL_TEXTURE_2D, textureId);
+
+    const QSize size(width, height);
+    const bool reallocate = p.textureId != textureId || p.size != size
+            || p.format != format || p.type != type;
+
+    const uchar *pixels = bits;
+    bool pixelBufferBound = false;
+    if (usePixelBuffers(context)) {
+        QOpenGLExtraFunctions *extra = context->extraFunctions();
+        const int dataSize = width * height * bytesPerPixel(format, type);
+        const int index = p.nextPixelBuffer;
+        p.nextPixelBuffer ^= 1;
+
+        if (!p.pixelBuffers[index])
+            extra->glGenBuffers(1, &p.pixelBuffers[index]);
+        extra->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, p.pixelBuffers[index]);
+        if (p.pixelBufferSizes[index] != dataSize) {
+            extra->glBufferData(GL_PIXEL_UNPACK_BUFFER, dataSize, nullptr, GL_STREAM_DRAW);
+            p.pixelBufferSizes[index] = dataSize;
+        }
+
+        // Invalidating the buffer lets the driver hand out fresh memory while
+        // the previous upload from it may still be in flight.
+        void *mapped = extra->glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, dataSize,
+                                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            memcpy(mapped, bits, dataSize);
+            extra->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            pixels = nullptr; // offset into the bound buffer
+            pixelBufferBound = true;
+        } else {
+            extra->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+    }
+
+    if (reallocate) {
+        functions->glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, type, pixels);
+
+        // replacement for GL_LUMINANCE_ALPHA in core profile
+        if (format == GL_RG) {
+            functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
+            functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+            functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+            functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_GREEN);
+        }
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        p.textureId = textureId;
+        p.size = size;
+        p.format = format;
+        p.type = type;
+    } else {
+        functions->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, type, pixels);
+    }
+
+    if (pixelBufferBound)
+        context->extraFunctions()->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void QSGVideoTextureUploader::release()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    for (Plane &p : m_planes) {
+        if (context && (p.pixelBuffers[0] || p.pixelBuffers[1]))
+            context->functions()->glDeleteBuffers(2, p.pixelBuffers);
+        p = Plane();
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGVIDEOTEXTUREUPLOADER_P_H
+#define QSGVIDEOTEXTUREUPLOADER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qsize.h>
+#include <QtGui/qopengl.h>
+
+QT_BEGIN_NAMESPACE
+
+class QOpenGLContext;
+
+// Uploads video frame planes into GL textures.
+// Texture storage is allocated once per size and format and updated with
+// glTexSubImage2D afterwards. If QT_VIDEONODE_PBO_UPLOAD is set and the
+// context supports it, the data is streamed through two alternating pixel
+// buffer objects per plane so that the transfer to the texture can overlap
+// with rendering.
+class QSGVideoTextureUploader
+{
+public:
+    enum { MaxPlanes = 3 };
+
+    QSGVideoTextureUploader();
+    ~QSGVideoTextureUploader();
+
+    // Binds textureId to GL_TEXTURE_2D on the active texture unit and uploads
+    // a plane of width x height pixels, rows are expected to be tightly packed.
+    void upload(int plane, GLuint textureId, int width, int height,
+                GLenum format, GLenum type, const uchar *bits);
+
+    // Releases the pixel buffer objects, must be called with the context current.
+    void release();
+
+private:
+    bool usePixelBuffers(QOpenGLContext *context);
+
+    struct Plane
+    {
+        GLuint textureId = 0;
+        QSize size;
+        GLenum format = 0;
+        GLenum type = 0;
+        GLuint pixelBuffers[2] = { 0, 0 };
+        int pixelBufferSizes[2] = { 0, 0 };
+        int nextPixelBuffer = 0;
+    };
+
+    Plane m_planes[MaxPlanes];
+    int m_pixelBufferSupport;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGVIDEOTEXTUREUPLOADER_P_H
@@ -20,13 +20,17 @@ SOURCES += \
 
 qtConfig(opengl) {
     SOURCES += qdeclarativevideooutput_render.cpp \
+               qdeclarativevideofilterpipeline.cpp \
                qsgvideonode_rgb.cpp \
                qsgvideonode_yuv.cpp \
-               qsgvideonode_texture.cpp
+               qsgvideonode_texture.cpp \
+               qsgvideotextureuploader.cpp
     HEADERS += qdeclarativevideooutput_render_p.h \
+               qdeclarativevideofilterpipeline_p.h \
                qsgvideonode_rgb_p.h \
                qsgvideonode_yuv_p.h \
-               qsgvideonode_texture_p.h
+               qsgvideonode_texture_p.h \
+               qsgvideotextureuploader_p.h
 }
 
 RESOURCES += \
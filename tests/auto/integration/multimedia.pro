@@ -5,7 +5,9 @@ SUBDIRS += \
     qaudiodeviceinfo \
     qaudioinput \
     qaudiooutput \
+    qmediametadatascannerbackend \
     qmediaplayerbackend \
+    qmediathumbnailerbackend \
     qcamerabackend \
     qsoundeffect \
     qsound
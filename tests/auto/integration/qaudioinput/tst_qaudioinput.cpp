@@ -103,6 +103,8 @@ private slots:
     void volume_data(){generate_audiofile_testrows();}
     void volume();
 
+    void formatConversion();
+
 private:
     typedef QSharedPointer<QFile> FilePtr;
 
@@ -896,6 +898,57 @@ void tst_QAudioInput::volume()
     audioInput.setVolume(volume);
 }
 
+void tst_QAudioInput::formatConversion()
+{
+    // Find a format the device cannot record but the converter can produce
+    QAudioFormat format;
+    format.setCodec("audio/pcm");
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+
+    const int candidates[][3] = { { 7350, 1, 16 }, { 11025, 3, 16 }, { 8000, 6, 24 }, { 5000, 2, 32 } };
+    bool found = false;
+    for (const auto &candidate : candidates) {
+        format.setSampleRate(candidate[0]);
+        format.setChannelCount(candidate[1]);
+        format.setSampleSize(candidate[2]);
+        if (!audioDevice.isFormatSupported(format)) {
+            found = true;
+            break;
+        }
+    }
+    if (!found)
+        QSKIP("The device supports every candidate format");
+
+    QAudioInput audioInput(audioDevice, format, this);
+    QVERIFY(!audioInput.isFormatConversionEnabled());
+    audioInput.setFormatConversionEnabled(true);
+    QVERIFY(audioInput.isFormatConversionEnabled());
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    audioInput.start(&buffer);
+    QCOMPARE(audioInput.error(), QAudio::NoError);
+    QCOMPARE(audioInput.format(), format);
+
+    QTRY_VERIFY_WITH_TIMEOUT(buffer.size() >= format.bytesForDuration(200000), 5000);
+    audioInput.stop();
+    QCOMPARE(audioInput.state(), QAudio::StoppedState);
+    QCOMPARE(audioInput.error(), QAudio::NoError);
+
+    // Everything recorded arrived in whole frames of the requested format
+    QCOMPARE(buffer.size() % format.bytesPerFrame(), 0);
+
+    // Pull mode hands out converted data as well
+    QIODevice *device = audioInput.start();
+    QVERIFY(device);
+    QVERIFY(audioInput.periodSize() > 0);
+    QByteArray recorded;
+    QTRY_VERIFY_WITH_TIMEOUT((recorded += device->readAll()).size() >= format.bytesForDuration(200000), 5000);
+    audioInput.stop();
+    QCOMPARE(recorded.size() % format.bytesPerFrame(), 0);
+}
+
 QTEST_MAIN(tst_QAudioInput)
 
 #include "tst_qaudioinput.moc"
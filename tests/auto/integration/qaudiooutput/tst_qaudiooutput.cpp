@@ -101,6 +101,8 @@ private slots:
     void volume_data();
     void volume();
 
+    void formatConversion();
+
 private:
     typedef QSharedPointer<QFile> FilePtr;
 
@@ -983,6 +985,71 @@ void tst_QAudioOutput::volume()
     QTRY_VERIFY(qRound(audioOutput.volume()*10.0f) == expectedInt);
 }
 
+void tst_QAudioOutput::formatConversion()
+{
+    // Find a format the device cannot play but the converter can produce
+    QAudioFormat format;
+    format.setCodec("audio/pcm");
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+
+    const int candidates[][3] = { { 7350, 1, 16 }, { 11025, 3, 16 }, { 8000, 6, 24 }, { 5000, 2, 32 } };
+    bool found = false;
+    for (const auto &candidate : candidates) {
+        format.setSampleRate(candidate[0]);
+        format.setChannelCount(candidate[1]);
+        format.setSampleSize(candidate[2]);
+        if (!audioDevice.isFormatSupported(format)) {
+            found = true;
+            break;
+        }
+    }
+    if (!found)
+        QSKIP("The device supports every candidate format");
+
+    QAudioOutput audioOutput(audioDevice, format, this);
+    QVERIFY(!audioOutput.isFormatConversionEnabled());
+    audioOutput.setFormatConversionEnabled(true);
+    QVERIFY(audioOutput.isFormatConversionEnabled());
+    audioOutput.setVolume(0.1f);
+
+    // Half a second of silence in the requested format, pulled to the end
+    QByteArray data(format.bytesForDuration(500000), '\0');
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QSignalSpy stateSignal(&audioOutput, SIGNAL(stateChanged(QAudio::State)));
+    audioOutput.start(&buffer);
+    QCOMPARE(audioOutput.error(), QAudio::NoError);
+    QCOMPARE(audioOutput.format(), format);
+    QTRY_VERIFY(buffer.atEnd());
+    QTRY_COMPARE(audioOutput.state(), QAudio::IdleState);
+    QCOMPARE(audioOutput.error(), QAudio::NoError);
+    QVERIFY(audioOutput.processedUSecs() > 0);
+    audioOutput.stop();
+
+    // Push mode, sizes are reported in the requested format
+    QIODevice *device = audioOutput.start();
+    QVERIFY(device);
+    QCOMPARE(audioOutput.error(), QAudio::NoError);
+    QVERIFY(audioOutput.periodSize() > 0);
+    QCOMPARE(audioOutput.periodSize() % format.bytesPerFrame(), 0);
+
+    buffer.seek(0);
+    for (int i = 0; !buffer.atEnd() && i < 500; ++i) {
+        const int free = audioOutput.bytesFree();
+        if (free >= format.bytesPerFrame())
+            device->write(buffer.read(free - free % format.bytesPerFrame()));
+        else
+            QTest::qWait(20);
+    }
+    QVERIFY(buffer.atEnd());
+    QTRY_COMPARE(audioOutput.state(), QAudio::IdleState);
+    QCOMPARE(audioOutput.error(), QAudio::NoError);
+    audioOutput.stop();
+    QCOMPARE(audioOutput.state(), QAudio::StoppedState);
+}
+
 QTEST_MAIN(tst_QAudioOutput)
 
 #include "tst_qaudiooutput.moc"
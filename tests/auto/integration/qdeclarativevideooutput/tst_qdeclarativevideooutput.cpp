@@ -36,6 +36,7 @@
 
 #include "private/qdeclarativevideooutput_p.h"
 
+#include <qabstractvideofilter.h>
 #include <qabstractvideosurface.h>
 #include <qvideorenderercontrol.h>
 #include <qvideosurfaceformat.h>
@@ -89,6 +90,93 @@ void SurfaceHolder::presentDummyFrame(const QSize &size)
     }
 }
 
+// Shared between a test filter and its runnables, so that it outlives both
+struct FilterRecord
+{
+    QMutex mutex;
+    QThread *createThread = nullptr;
+    QThread *runThread = nullptr;
+    QThread *destroyThread = nullptr;
+    int createCount = 0;
+    QList<int> markers;
+    QVideoFilterRunnable::RunFlags flags;
+
+    int runCount()
+    {
+        QMutexLocker locker(&mutex);
+        return markers.count();
+    }
+
+    int lastMarker()
+    {
+        QMutexLocker locker(&mutex);
+        return markers.value(markers.count() - 1, -1);
+    }
+};
+
+// The first byte of the test frames identifies them
+static QVideoFrame markedFrame(int marker)
+{
+    QVideoFrame frame(2 * 2 * 4, QSize(2, 2), 2 * 4, QVideoFrame::Format_RGB32);
+    if (frame.map(QAbstractVideoBuffer::WriteOnly)) {
+        memset(frame.bits(), 0, frame.mappedBytes());
+        frame.bits()[0] = uchar(marker);
+        frame.unmap();
+    }
+    return frame;
+}
+
+static int frameMarker(QVideoFrame frame)
+{
+    if (!frame.map(QAbstractVideoBuffer::ReadOnly))
+        return -1;
+    const int marker = frame.bits()[0];
+    frame.unmap();
+    return marker;
+}
+
+// Records where it runs and hands on a copy of the frame with the marker incremented
+class TestFilterRunnable : public QVideoFilterRunnable
+{
+public:
+    TestFilterRunnable(const QSharedPointer<FilterRecord> &record) : m_record(record) { }
+
+    ~TestFilterRunnable()
+    {
+        QMutexLocker locker(&m_record->mutex);
+        m_record->destroyThread = QThread::currentThread();
+    }
+
+    QVideoFrame run(QVideoFrame *input, const QVideoSurfaceFormat &, RunFlags flags) override
+    {
+        const int marker = frameMarker(*input);
+        QMutexLocker locker(&m_record->mutex);
+        m_record->runThread = QThread::currentThread();
+        m_record->markers.append(marker);
+        m_record->flags = flags;
+        return markedFrame(marker + 1);
+    }
+
+private:
+    QSharedPointer<FilterRecord> m_record;
+};
+
+class TestFilter : public QAbstractVideoFilter
+{
+public:
+    TestFilter(bool cpuOnly) : record(new FilterRecord) { setCpuOnly(cpuOnly); }
+
+    QVideoFilterRunnable *createFilterRunnable() override
+    {
+        QMutexLocker locker(&record->mutex);
+        record->createThread = QThread::currentThread();
+        ++record->createCount;
+        return new TestFilterRunnable(record);
+    }
+
+    QSharedPointer<FilterRecord> record;
+};
+
 class tst_QDeclarativeVideoOutput : public QObject
 {
     Q_OBJECT
@@ -112,6 +200,11 @@ private slots:
     void surfaceSource();
     void paintSurface();
     void sourceRect();
+    void cpuOnlyFilter();
+    void cpuOnlyFilterActive();
+    void cpuOnlyFilterDestroyed();
+    void cpuOnlyFilterAppend();
+    void cpuOnlyFilterBeforeRenderFilter();
 
     void contentRect();
     void contentRect_data();
@@ -450,6 +543,222 @@ void tst_QDeclarativeVideoOutput::sourceRect()
     delete videoOutput;
 }
 
+void tst_QDeclarativeVideoOutput::cpuOnlyFilter()
+{
+    QQuickView window;
+    window.setSource(QUrl("qrc:/main.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto videoOutput = qobject_cast<QDeclarativeVideoOutput *>(window.rootObject());
+    QVERIFY(videoOutput);
+
+    TestFilter filter(true);
+    QQmlListProperty<QAbstractVideoFilter> filters = videoOutput->filters();
+    filters.append(&filters, &filter);
+
+    // The runnable is created along with the pipeline, on the gui thread
+    QCOMPARE(filter.record->createThread, QThread::currentThread());
+
+    auto surface = videoOutput->property("videoSurface").value<QAbstractVideoSurface *>();
+    QVERIFY(surface);
+    QVERIFY(surface->start(QVideoSurfaceFormat(QSize(2, 2), QVideoFrame::Format_RGB32)));
+
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(surface->present(markedFrame(i)));
+        QTRY_COMPARE(filter.record->runCount(), i + 1);
+    }
+
+    QCOMPARE(filter.record->markers, QList<int>({ 0, 1, 2, 3, 4 }));
+    QVERIFY(filter.record->runThread);
+    QVERIFY(filter.record->runThread != QThread::currentThread());
+    QVERIFY(filter.record->flags & QVideoFilterRunnable::LastInChain);
+
+    // Clearing the filters stops the pipeline, the runnable goes with its thread
+    filters.clear(&filters);
+    QCOMPARE(filter.record->destroyThread, filter.record->runThread);
+
+    surface->stop();
+}
+
+void tst_QDeclarativeVideoOutput::cpuOnlyFilterActive()
+{
+    QQuickView window;
+    window.setSource(QUrl("qrc:/main.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto videoOutput = qobject_cast<QDeclarativeVideoOutput *>(window.rootObject());
+    QVERIFY(videoOutput);
+
+    TestFilter first(true);
+    TestFilter second(true);
+    first.setActive(false);
+
+    QQmlListProperty<QAbstractVideoFilter> filters = videoOutput->filters();
+    filters.append(&filters, &first);
+    filters.append(&filters, &second);
+
+    auto surface = videoOutput->property("videoSurface").value<QAbstractVideoSurface *>();
+    QVERIFY(surface);
+    QVERIFY(surface->start(QVideoSurfaceFormat(QSize(2, 2), QVideoFrame::Format_RGB32)));
+
+    // Frames pass the stages in order, so the inactive first filter has been
+    // skipped once the second one saw the frame
+    QVERIFY(surface->present(markedFrame(10)));
+    QTRY_COMPARE(second.record->runCount(), 1);
+    QCOMPARE(first.record->runCount(), 0);
+    QCOMPARE(second.record->markers, QList<int>({ 10 }));
+
+    // Activating the filter takes effect with the next frame
+    first.setActive(true);
+    QVERIFY(surface->present(markedFrame(20)));
+    QTRY_COMPARE(second.record->runCount(), 2);
+    QCOMPARE(first.record->markers, QList<int>({ 20 }));
+    QCOMPARE(second.record->markers, QList<int>({ 10, 21 }));
+    QVERIFY(!(first.record->flags & QVideoFilterRunnable::LastInChain));
+    QVERIFY(second.record->flags & QVideoFilterRunnable::LastInChain);
+    QVERIFY(first.record->runThread != second.record->runThread);
+
+    filters.clear(&filters);
+    surface->stop();
+}
+
+void tst_QDeclarativeVideoOutput::cpuOnlyFilterDestroyed()
+{
+    QQuickView window;
+    window.setSource(QUrl("qrc:/main.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto videoOutput = qobject_cast<QDeclarativeVideoOutput *>(window.rootObject());
+    QVERIFY(videoOutput);
+
+    TestFilter *filter = new TestFilter(true);
+    QSharedPointer<FilterRecord> record = filter->record;
+
+    QQmlListProperty<QAbstractVideoFilter> filters = videoOutput->filters();
+    filters.append(&filters, filter);
+
+    auto surface = videoOutput->property("videoSurface").value<QAbstractVideoSurface *>();
+    QVERIFY(surface);
+    QVERIFY(surface->start(QVideoSurfaceFormat(QSize(2, 2), QVideoFrame::Format_RGB32)));
+
+    QVERIFY(surface->present(markedFrame(0)));
+    QTRY_COMPARE(record->runCount(), 1);
+
+    // The pipeline does not access the filter, frames keep flowing
+    delete filter;
+    for (int i = 1; i < 5; ++i)
+        QVERIFY(surface->present(markedFrame(i)));
+    QTRY_COMPARE(record->lastMarker(), 4);
+
+    filters.clear(&filters);
+    QVERIFY(record->destroyThread);
+    surface->stop();
+}
+
+void tst_QDeclarativeVideoOutput::cpuOnlyFilterAppend()
+{
+    QQuickView window;
+    window.setSource(QUrl("qrc:/main.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto videoOutput = qobject_cast<QDeclarativeVideoOutput *>(window.rootObject());
+    QVERIFY(videoOutput);
+
+    auto surface = videoOutput->property("videoSurface").value<QAbstractVideoSurface *>();
+    QVERIFY(surface);
+    QVERIFY(surface->start(QVideoSurfaceFormat(QSize(2, 2), QVideoFrame::Format_RGB32)));
+
+    QQmlListProperty<QAbstractVideoFilter> filters = videoOutput->filters();
+    QList<TestFilter *> added;
+
+    // Appending one filter at a time, while frames are flowing, extends the
+    // running pipeline instead of recreating the stages that are there
+    for (int i = 0; i < 4; ++i) {
+        TestFilter *filter = new TestFilter(true);
+        filters.append(&filters, filter);
+        added.append(filter);
+
+        QVERIFY(surface->present(markedFrame(i * 10)));
+        QTRY_COMPARE(filter->record->lastMarker(), i * 10 + i);
+        QVERIFY(filter->record->flags & QVideoFilterRunnable::LastInChain);
+
+        for (int j = 0; j < added.count(); ++j) {
+            QCOMPARE(added.at(j)->record->createCount, 1);
+            QVERIFY(!added.at(j)->record->destroyThread);
+            QCOMPARE(added.at(j)->record->lastMarker(), i * 10 + j);
+            if (j < i)
+                QVERIFY(!(added.at(j)->record->flags & QVideoFilterRunnable::LastInChain));
+        }
+    }
+
+    // A filter which is not CPU-only only changes the flags of the last stage
+    TestFilter renderFilter(false);
+    filters.append(&filters, &renderFilter);
+    QVERIFY(surface->present(markedFrame(100)));
+    QTRY_COMPARE(added.last()->record->lastMarker(), 103);
+    QVERIFY(!(added.last()->record->flags & QVideoFilterRunnable::LastInChain));
+    for (TestFilter *filter : qAsConst(added))
+        QCOMPARE(filter->record->createCount, 1);
+
+    filters.clear(&filters);
+    for (TestFilter *filter : qAsConst(added))
+        QCOMPARE(filter->record->destroyThread, filter->record->runThread);
+    qDeleteAll(added);
+    surface->stop();
+}
+
+void tst_QDeclarativeVideoOutput::cpuOnlyFilterBeforeRenderFilter()
+{
+    if (QGuiApplication::platformName() == QLatin1String("offscreen")
+        || QGuiApplication::platformName() == QLatin1String("minimal"))
+        QSKIP("The render thread filters need a scene graph that renders");
+
+    QQuickView window;
+    window.setSource(QUrl("qrc:/main.qml"));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto videoOutput = qobject_cast<QDeclarativeVideoOutput *>(window.rootObject());
+    QVERIFY(videoOutput);
+
+    TestFilter cpuFilter(true);
+    TestFilter renderFilter(false);
+
+    QQmlListProperty<QAbstractVideoFilter> filters = videoOutput->filters();
+    filters.append(&filters, &cpuFilter);
+    filters.append(&filters, &renderFilter);
+
+    auto surface = videoOutput->property("videoSurface").value<QAbstractVideoSurface *>();
+    QVERIFY(surface);
+    QVERIFY(surface->start(QVideoSurfaceFormat(QSize(2, 2), QVideoFrame::Format_RGB32)));
+
+    // The render thread only runs the filters the pipeline did not apply
+    QVERIFY(surface->present(markedFrame(0)));
+    QTRY_COMPARE(renderFilter.record->runCount(), 1);
+    QCOMPARE(cpuFilter.record->markers, QList<int>({ 0 }));
+    QCOMPARE(renderFilter.record->markers, QList<int>({ 1 }));
+    QVERIFY(!(cpuFilter.record->flags & QVideoFilterRunnable::LastInChain));
+    QVERIFY(renderFilter.record->flags & QVideoFilterRunnable::LastInChain);
+    QVERIFY(cpuFilter.record->runThread != renderFilter.record->runThread);
+
+    // Reassigning the filters starts over with a new pipeline
+    filters.clear(&filters);
+    filters.append(&filters, &cpuFilter);
+    filters.append(&filters, &renderFilter);
+
+    QVERIFY(surface->present(markedFrame(10)));
+    QTRY_COMPARE(renderFilter.record->runCount(), 2);
+    QCOMPARE(cpuFilter.record->markers, QList<int>({ 0, 10 }));
+    QCOMPARE(renderFilter.record->markers, QList<int>({ 1, 11 }));
+
+    filters.clear(&filters);
+    surface->stop();
+}
+
 void tst_QDeclarativeVideoOutput::mappingPoint()
 {
     QFETCH(QPointF, point);
@@ -0,0 +1,10 @@
+TARGET = tst_qmediametadatascannerbackend
+
+QT += multimedia testlib
+
+# This is more of a system test
+CONFIG += testcase
+TESTDATA += testdata/*
+
+SOURCES += \
+    tst_qmediametadatascannerbackend.cpp
@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtMultimedia/qmediametadata.h>
+#include <QtMultimedia/qmediametadatascanner.h>
+
+QT_USE_NAMESPACE
+
+/*
+ This is the backend conformance test.
+
+ Since it relies on platform media framework
+ it may be less stable.
+*/
+
+class tst_QMediaMetaDataScannerBackend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void audioFile();
+    void videoFile();
+    void batch();
+    void invalidFiles();
+
+private:
+    QVariantMap scan(const QUrl &url);
+};
+
+void tst_QMediaMetaDataScannerBackend::initTestCase()
+{
+    QMediaMetaDataScanner scanner;
+    if (!scanner.isAvailable())
+        QSKIP("No meta-data scanner available");
+}
+
+QVariantMap tst_QMediaMetaDataScannerBackend::scan(const QUrl &url)
+{
+    QMediaMetaDataScanner scanner;
+    QSignalSpy scannedSpy(&scanner, SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+    QSignalSpy errorSpy(&scanner, SIGNAL(error(QUrl,QString)));
+    QSignalSpy finishedSpy(&scanner, SIGNAL(finished()));
+
+    scanner.scan(url);
+    if (!finishedSpy.wait(10000) || errorSpy.count() > 0 || scannedSpy.count() != 1)
+        return QVariantMap();
+
+    return scannedSpy.first().value(1).toMap();
+}
+
+void tst_QMediaMetaDataScannerBackend::audioFile()
+{
+    const QVariantMap metaData = scan(QUrl::fromLocalFile(QFINDTESTDATA("testdata/nokia-tune.mp3")));
+    if (metaData.isEmpty())
+        QSKIP("MP3 is not supported");
+
+    QCOMPARE(metaData.value(QMediaMetaData::Title).toString(), QStringLiteral("Nokia Tune"));
+    QCOMPARE(metaData.value(QMediaMetaData::ContributingArtist).toString(), QStringLiteral("TestArtist"));
+    QCOMPARE(metaData.value(QMediaMetaData::AlbumTitle).toString(), QStringLiteral("TestAlbum"));
+
+    QVERIFY(metaData.value(QMediaMetaData::Duration).toLongLong() > 0);
+    QVERIFY(metaData.value(QMediaMetaData::SampleRate).toInt() > 0);
+    QVERIFY(metaData.value(QMediaMetaData::ChannelCount).toInt() > 0);
+    QVERIFY(!metaData.value(QMediaMetaData::AudioCodec).toString().isEmpty());
+    QCOMPARE(metaData.value(QMediaMetaData::Size).toLongLong(),
+             QFileInfo(QFINDTESTDATA("testdata/nokia-tune.mp3")).size());
+
+    QVERIFY(!metaData.contains(QMediaMetaData::Resolution));
+}
+
+void tst_QMediaMetaDataScannerBackend::videoFile()
+{
+    const QVariantMap metaData = scan(QUrl::fromLocalFile(QFINDTESTDATA("testdata/colors.mp4")));
+    if (metaData.isEmpty())
+        QSKIP("MP4 is not supported");
+
+    QCOMPARE(metaData.value(QMediaMetaData::Resolution).toSize(), QSize(160, 120));
+    QVERIFY(qAbs(metaData.value(QMediaMetaData::Duration).toLongLong() - 15019) < 100);
+    QCOMPARE(qRound(metaData.value(QMediaMetaData::VideoFrameRate).toReal()), 25);
+    QVERIFY(!metaData.value(QMediaMetaData::VideoCodec).toString().isEmpty());
+}
+
+void tst_QMediaMetaDataScannerBackend::batch()
+{
+    QMediaMetaDataScanner scanner;
+    scanner.setMaximumWorkerCount(2);
+
+    QSignalSpy scannedSpy(&scanner, SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+    QSignalSpy errorSpy(&scanner, SIGNAL(error(QUrl,QString)));
+    QSignalSpy finishedSpy(&scanner, SIGNAL(finished()));
+
+    QList<QUrl> urls;
+    for (int i = 0; i < 4; ++i) {
+        urls << QUrl::fromLocalFile(QFINDTESTDATA("testdata/nokia-tune.mp3"))
+             << QUrl::fromLocalFile(QFINDTESTDATA("testdata/colors.mp4"));
+    }
+    scanner.scan(urls);
+    QCOMPARE(scanner.pendingCount(), urls.count());
+
+    QVERIFY(finishedSpy.wait(30000));
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(scannedSpy.count() + errorSpy.count(), urls.count());
+    QCOMPARE(scanner.pendingCount(), 0);
+}
+
+void tst_QMediaMetaDataScannerBackend::invalidFiles()
+{
+    QMediaMetaDataScanner scanner;
+
+    QSignalSpy scannedSpy(&scanner, SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+    QSignalSpy errorSpy(&scanner, SIGNAL(error(QUrl,QString)));
+    QSignalSpy finishedSpy(&scanner, SIGNAL(finished()));
+
+    const QUrl missing = QUrl::fromLocalFile(QDir::current().absoluteFilePath(QStringLiteral("missing.mp3")));
+    const QUrl remote(QStringLiteral("http://example.com/remote.mp3"));
+    scanner.scan(QList<QUrl>() << missing << remote);
+
+    // Nothing is reported before returning to the event loop
+    QCOMPARE(errorSpy.count(), 0);
+    QVERIFY(finishedSpy.wait(10000));
+
+    QCOMPARE(scannedSpy.count(), 0);
+    QCOMPARE(errorSpy.count(), 2);
+    QSet<QUrl> failed;
+    for (const QList<QVariant> &arguments : qAsConst(errorSpy)) {
+        failed.insert(arguments.value(0).toUrl());
+        QVERIFY(!arguments.value(1).toString().isEmpty());
+    }
+    QCOMPARE(failed, QSet<QUrl>() << missing << remote);
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaMetaDataScannerBackend)
+
+#include "tst_qmediametadatascannerbackend.moc"
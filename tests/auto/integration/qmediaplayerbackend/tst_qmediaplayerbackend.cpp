@@ -80,8 +80,12 @@ private slots:
     void surfaceTest();
     void multipleSurfaces();
     void metadata();
+    void metadataChangedKeys();
     void playerStateAtEOS();
     void playFromBuffer();
+    void preload();
+    void preloadPlaylist();
+    void sessionOnThreadWithoutEventLoop();
 
 private:
     QMediaContent selectVideoFile(const QStringList& mediaCandidates);
@@ -1415,7 +1419,6 @@ void tst_QMediaPlayerBackend::multipleSurfaces()
     QTRY_VERIFY(player.position() >= 1000);
     QVERIFY2(surface1.m_totalFrames >= 25, qPrintable(QString("Expected >= 25, got %1").arg(surface1.m_totalFrames)));
     QVERIFY2(surface2.m_totalFrames >= 25, qPrintable(QString("Expected >= 25, got %1").arg(surface2.m_totalFrames)));
-    QCOMPARE(surface1.m_totalFrames, surface2.m_totalFrames);
 }
 
 void tst_QMediaPlayerBackend::metadata()
@@ -1451,6 +1454,43 @@ void tst_QMediaPlayerBackend::metadata()
     QVERIFY(player.availableMetaData().isEmpty());
 }
 
+void tst_QMediaPlayerBackend::metadataChangedKeys()
+{
+    if (localFileWithMetadata.isNull())
+        QSKIP("No supported media file");
+
+    QMediaPlayer player;
+
+    QMultiMap<QString, QVariant> changes;
+    connect(&player, static_cast<void (QMediaObject::*)(const QString &, const QVariant &)>(&QMediaObject::metaDataChanged),
+            this, [&](const QString &key, const QVariant &value) {
+        // The signal carries the same value as metaData(), never a backend private type
+        QCOMPARE(value, player.metaData(key));
+        QVERIFY(value.userType() < QMetaType::User);
+        changes.insert(key, value);
+    });
+
+    player.setMedia(localFileWithMetadata);
+    player.play();
+    QTRY_VERIFY(player.isMetaDataAvailable());
+    QTRY_VERIFY_WITH_TIMEOUT(player.position() > 1000, 5000);
+
+    // Tags are resent as the stream plays, unchanged ones are not reported again
+    QCOMPARE(changes.count(QMediaMetaData::Title), 1);
+    QCOMPARE(changes.count(QMediaMetaData::ContributingArtist), 1);
+    QCOMPARE(changes.count(QMediaMetaData::AlbumTitle), 1);
+    QCOMPARE(changes.value(QMediaMetaData::Title).toString(), QStringLiteral("Nokia Tune"));
+
+    // Clearing the media reports each of the keys as removed
+    const QStringList keys = player.availableMetaData();
+    changes.clear();
+    player.setMedia(QMediaContent());
+    for (const QString &key : keys) {
+        QCOMPARE(changes.count(key), 1);
+        QVERIFY(!changes.value(key).isValid());
+    }
+}
+
 void tst_QMediaPlayerBackend::playerStateAtEOS()
 {
     if (!isWavSupported())
@@ -1492,6 +1532,88 @@ void tst_QMediaPlayerBackend::playFromBuffer()
     QVERIFY2(surface.m_totalFrames >= 25, qPrintable(QString("Expected >= 25, got %1").arg(surface.m_totalFrames)));
 }
 
+void tst_QMediaPlayerBackend::preload()
+{
+    if (!isWavSupported())
+        QSKIP("Sound format is not supported");
+
+    QMediaPlayer player;
+    player.preload(localWavFile);
+
+    // the prerolled pipeline is adopted by setMedia() and plays normally
+    player.setMedia(localWavFile);
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::LoadedMedia);
+    QVERIFY(player.isAudioAvailable());
+    QVERIFY(player.duration() > 0);
+
+    player.play();
+    QTRY_COMPARE(player.state(), QMediaPlayer::PlayingState);
+    QTRY_VERIFY(player.position() > 0);
+    QTRY_COMPARE_WITH_TIMEOUT(player.mediaStatus(), QMediaPlayer::EndOfMedia, 5000);
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+
+    // preloading media that is never used must not affect the current one
+    player.preload(localWavFile2);
+    player.setMedia(localWavFile);
+    QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::LoadedMedia);
+    QCOMPARE(player.media(), localWavFile);
+    player.play();
+    QTRY_VERIFY(player.position() > 0);
+    player.stop();
+
+    player.preload(QMediaContent());
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+}
+
+void tst_QMediaPlayerBackend::preloadPlaylist()
+{
+    if (!isWavSupported() || localWavFile2.isNull())
+        QSKIP("Sound format is not supported");
+
+    QMediaPlayer player;
+    QMediaPlaylist playlist;
+    player.setPlaylist(&playlist);
+    playlist.addMedia(localWavFile);
+    playlist.addMedia(localWavFile2);
+
+    QSignalSpy currentMediaSpy(&player, SIGNAL(currentMediaChanged(QMediaContent)));
+
+    // the second item is preloaded while the first one plays
+    player.play();
+    QTRY_COMPARE(player.state(), QMediaPlayer::PlayingState);
+    QTRY_COMPARE_WITH_TIMEOUT(playlist.currentIndex(), 1, 5000);
+    QCOMPARE(player.currentMedia(), localWavFile2);
+    QTRY_VERIFY(player.position() > 0);
+    QCOMPARE(player.error(), QMediaPlayer::NoError);
+
+    QTRY_COMPARE_WITH_TIMEOUT(player.state(), QMediaPlayer::StoppedState, 5000);
+    QCOMPARE(currentMediaSpy.count(), 2);
+    QCOMPARE(currentMediaSpy.last()[0].value<QMediaContent>(), localWavFile2);
+}
+
+void tst_QMediaPlayerBackend::sessionOnThreadWithoutEventLoop()
+{
+    if (!isWavSupported())
+        QSKIP("Sound format is not supported");
+
+    // taking a playbin from the pool schedules a refill, which must still
+    // happen when the taking thread never runs an event loop
+    QScopedPointer<QThread> thread(QThread::create([]() {
+        QMediaPlayer player;
+        QVERIFY(player.isAvailable());
+    }));
+    thread->start();
+    QVERIFY(thread->wait(5000));
+
+    for (int i = 0; i < 3; ++i) {
+        QMediaPlayer player;
+        player.setMedia(localWavFile);
+        QTRY_COMPARE(player.mediaStatus(), QMediaPlayer::LoadedMedia);
+        player.play();
+        QTRY_VERIFY(player.position() > 0);
+    }
+}
+
 TestVideoSurface::TestVideoSurface(bool storeFrames):
     m_totalFrames(0),
     m_storeFrames(storeFrames)
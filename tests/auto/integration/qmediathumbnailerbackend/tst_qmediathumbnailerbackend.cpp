@@ -0,0 +1,173 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtMultimedia/qmediathumbnailer.h>
+
+QT_USE_NAMESPACE
+
+/*
+ This is the backend conformance test.
+
+ Since it relies on platform media framework
+ it may be less stable.
+*/
+
+// colors.mp4 is 160x120 at 25 fps with a 4:3 pixel aspect ratio, key
+// frames every 12 frames, red at 7 s and green at 12 s.
+
+class tst_QMediaThumbnailerBackend : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void decodedFrame();
+    void seekPosition();
+    void aspectFit();
+    void noVideo();
+
+private:
+    QImage thumbnail(QMediaThumbnailer *thumbnailer, qint64 position, const QSize &size = QSize());
+
+    QUrl m_videoFile;
+};
+
+void tst_QMediaThumbnailerBackend::initTestCase()
+{
+    QMediaThumbnailer thumbnailer;
+    if (!thumbnailer.isAvailable())
+        QSKIP("No thumbnailer available");
+
+    m_videoFile = QUrl::fromLocalFile(QFINDTESTDATA("testdata/colors.mp4"));
+
+    if (thumbnail(&thumbnailer, 0).isNull())
+        QSKIP("MP4 is not supported");
+}
+
+QImage tst_QMediaThumbnailerBackend::thumbnail(QMediaThumbnailer *thumbnailer, qint64 position, const QSize &size)
+{
+    QSignalSpy readySpy(thumbnailer, SIGNAL(thumbnailReady(int,QImage)));
+    QSignalSpy finishedSpy(thumbnailer, SIGNAL(finished()));
+
+    const int id = thumbnailer->requestThumbnail(m_videoFile, position, size);
+    if (!finishedSpy.wait(10000) || readySpy.count() != 1 || readySpy.first().value(0).toInt() != id)
+        return QImage();
+
+    return readySpy.first().value(1).value<QImage>();
+}
+
+void tst_QMediaThumbnailerBackend::decodedFrame()
+{
+    QMediaThumbnailer thumbnailer;
+
+    const QImage image = thumbnail(&thumbnailer, 7000);
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.format(), QImage::Format_RGB32);
+    QVERIFY(image.width() > 0 && image.height() > 0);
+
+    // A decoded frame, not a blank image
+    const QRgb pixel = image.pixel(image.width() / 2, image.height() / 2);
+    QVERIFY(qRed(pixel) >= 230);
+    QVERIFY(qGreen(pixel) < 20);
+    QVERIFY(qBlue(pixel) < 20);
+}
+
+void tst_QMediaThumbnailerBackend::seekPosition()
+{
+    QMediaThumbnailer thumbnailer;
+    thumbnailer.setMaximumWorkerCount(1);
+
+    // The same worker seeks its pipeline back and forth
+    const QImage red = thumbnail(&thumbnailer, 7000, QSize(80, 80));
+    const QImage green = thumbnail(&thumbnailer, 12000, QSize(80, 80));
+    const QImage redAgain = thumbnail(&thumbnailer, 7000, QSize(80, 80));
+    QVERIFY(!red.isNull());
+    QVERIFY(!green.isNull());
+    QVERIFY(!redAgain.isNull());
+
+    QVERIFY(qRed(red.pixel(0, 0)) >= 230);
+    QVERIFY(qGreen(red.pixel(0, 0)) < 20);
+
+    QVERIFY(qRed(green.pixel(0, 0)) < 20);
+    QVERIFY(qGreen(green.pixel(0, 0)) >= 230);
+
+    QVERIFY(qRed(redAgain.pixel(0, 0)) >= 230);
+    QVERIFY(qGreen(redAgain.pixel(0, 0)) < 20);
+}
+
+void tst_QMediaThumbnailerBackend::aspectFit()
+{
+    QMediaThumbnailer thumbnailer;
+
+    // 160x120 with 4:3 pixels displays as 16:9
+    const QImage byWidth = thumbnail(&thumbnailer, 0, QSize(80, 80));
+    QVERIFY(!byWidth.isNull());
+    QCOMPARE(byWidth.width(), 80);
+    QVERIFY2(qAbs(byWidth.height() - 45) <= 1, QByteArray::number(byWidth.height()).constData());
+
+    const QImage byHeight = thumbnail(&thumbnailer, 0, QSize(400, 90));
+    QVERIFY(!byHeight.isNull());
+    QCOMPARE(byHeight.height(), 90);
+    QVERIFY2(qAbs(byHeight.width() - 160) <= 1, QByteArray::number(byHeight.width()).constData());
+
+    // Never scaled up beyond the requested bounds
+    const QImage small = thumbnail(&thumbnailer, 0, QSize(32, 32));
+    QVERIFY(!small.isNull());
+    QVERIFY(small.width() <= 32 && small.height() <= 32);
+}
+
+void tst_QMediaThumbnailerBackend::noVideo()
+{
+    QMediaThumbnailer thumbnailer;
+
+    QSignalSpy readySpy(&thumbnailer, SIGNAL(thumbnailReady(int,QImage)));
+    QSignalSpy errorSpy(&thumbnailer, SIGNAL(error(int,QString)));
+    QSignalSpy finishedSpy(&thumbnailer, SIGNAL(finished()));
+
+    const int audio = thumbnailer.requestThumbnail(
+                QUrl::fromLocalFile(QFINDTESTDATA("testdata/nokia-tune.mp3")), 1000);
+    const int missing = thumbnailer.requestThumbnail(
+                QUrl::fromLocalFile(QDir::current().absoluteFilePath(QStringLiteral("missing.mp4"))), 0);
+
+    QVERIFY(finishedSpy.wait(15000));
+    QCOMPARE(readySpy.count(), 0);
+    QCOMPARE(errorSpy.count(), 2);
+
+    QSet<int> failed;
+    for (const QList<QVariant> &arguments : qAsConst(errorSpy)) {
+        failed.insert(arguments.value(0).toInt());
+        QVERIFY(!arguments.value(1).toString().isEmpty());
+    }
+    QCOMPARE(failed, QSet<int>() << audio << missing);
+}
+
+QTEST_MAIN(tst_QMediaThumbnailerBackend)
+
+#include "tst_qmediathumbnailerbackend.moc"
@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtAudioEngine 1.15
+import QtTest 1.0
+
+Item {
+    id: top
+
+    AudioEngine {
+        id: engine
+
+        AudioSample {
+            name: "streamed"
+            source: "../../../integration/qsoundeffect/test.wav"
+            streaming: true
+        }
+
+        Sound {
+            name: "streamedSound"
+            PlayVariation {
+                sample: "streamed"
+            }
+        }
+    }
+
+    SoundInstance {
+        id: instance
+        engine: engine
+        sound: "streamedSound"
+    }
+
+    SignalSpy {
+        id: spyState
+        target: instance
+        signalName: "stateChanged"
+    }
+
+    TestCase {
+        name: "StreamingAudioEngine"
+
+        function initTestCase() {
+            tryCompare(engine, "loading", false, 3000)
+        }
+
+        // The sample is short, so the transitions are counted rather than polled
+        function playToEnd() {
+            spyState.clear()
+            instance.play()
+            tryCompare(spyState, "count", 2, 5000)
+            compare(instance.state, SoundInstance.StoppedState)
+        }
+
+        function test_replayAfterEnd() {
+            playToEnd()
+
+            // A finished stream starts over from the beginning
+            playToEnd()
+            playToEnd()
+
+            // and so does a stream that was stopped before its end
+            spyState.clear()
+            instance.play()
+            compare(instance.state, SoundInstance.PlayingState)
+            instance.stop()
+            compare(instance.state, SoundInstance.StoppedState)
+            playToEnd()
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+import QtAudioEngine 1.15
+import QtTest 1.0
+
+Item {
+    id: top
+
+    AudioEngine {
+        id: engine
+        maxVoices: 2
+        // Attenuation is only updated when the test asks for it
+        updateInterval: 0
+
+        AudioSample {
+            name: "looped"
+            source: "../../../integration/qsoundeffect/test.wav"
+        }
+
+        AttenuationModelLinear {
+            name: "linear"
+            start: 1
+            end: 100
+        }
+
+        AttenuationModelInverse {
+            name: "inverse"
+            start: 1
+            end: 100
+            rolloff: 1
+        }
+
+        Sound {
+            name: "low"
+            priority: 0
+            PlayVariation {
+                sample: "looped"
+                looping: true
+            }
+        }
+
+        Sound {
+            name: "high"
+            priority: 1
+            PlayVariation {
+                sample: "looped"
+                looping: true
+            }
+        }
+
+        Sound {
+            name: "lowLinear"
+            priority: 0
+            attenuationModel: "linear"
+            PlayVariation {
+                sample: "looped"
+                looping: true
+            }
+        }
+
+        Sound {
+            name: "lowInverse"
+            priority: 0
+            attenuationModel: "inverse"
+            PlayVariation {
+                sample: "looped"
+                looping: true
+            }
+        }
+    }
+
+    SoundInstance { id: low1; engine: engine; sound: "low" }
+    SoundInstance { id: low2; engine: engine; sound: "low" }
+    SoundInstance { id: low3; engine: engine; sound: "low" }
+    SoundInstance { id: high1; engine: engine; sound: "high" }
+    SoundInstance { id: high2; engine: engine; sound: "high" }
+    SoundInstance { id: near; engine: engine; sound: "lowLinear" }
+    SoundInstance { id: nearInverse; engine: engine; sound: "lowInverse" }
+    SoundInstance { id: far; engine: engine; sound: "lowLinear" }
+    SoundInstance { id: farInverse; engine: engine; sound: "lowInverse" }
+
+    TestCase {
+        name: "AudioEngineVoiceLimit"
+
+        property var instances: [low1, low2, low3, high1, high2, near, nearInverse, far, farInverse]
+
+        function initTestCase() {
+            tryCompare(engine, "loading", false, 3000)
+        }
+
+        function init() {
+            for (var i = 0; i < instances.length; ++i) {
+                instances[i].stop()
+                instances[i].gain = 1
+                instances[i].position = Qt.vector3d(0, 0, 0)
+            }
+            engine.maxVoices = 2
+        }
+
+        function compareStates(playing, stopped) {
+            for (var i = 0; i < playing.length; ++i)
+                compare(playing[i].state, SoundInstance.PlayingState, "instance " + i + " should play")
+            for (var j = 0; j < stopped.length; ++j)
+                compare(stopped[j].state, SoundInstance.StoppedState, "instance " + j + " should be stopped")
+        }
+
+        function test_belowLimit() {
+            low1.play()
+            low2.play()
+            compareStates([low1, low2], [])
+        }
+
+        function test_stealLowerPriority() {
+            low1.play()
+            high1.play()
+            high2.play()
+            compareStates([high1, high2], [low1])
+        }
+
+        function test_stealQuietest() {
+            low1.gain = 0.2
+            low2.gain = 1
+            low1.play()
+            low2.play()
+
+            low3.gain = 0.5
+            low3.play()
+            compareStates([low2, low3], [low1])
+        }
+
+        function test_noStealFromHigherPriority() {
+            high1.play()
+            high2.play()
+            low1.play()
+            compareStates([high1, high2], [low1])
+        }
+
+        function test_noStealFromLouder() {
+            low1.play()
+            low2.play()
+
+            // Equal priority, but both playing instances are louder
+            low3.gain = 0.5
+            low3.play()
+            compareStates([low1, low2], [low3])
+        }
+
+        function test_lowerMaxVoices() {
+            engine.maxVoices = 3
+            low1.gain = 0.5
+            low1.play()
+            low2.play()
+            high1.play()
+            compareStates([low1, low2, high1], [])
+
+            engine.maxVoices = 2
+            compareStates([low2, high1], [low1])
+
+            engine.maxVoices = 1
+            compareStates([high1], [low1, low2])
+        }
+
+        function test_stealFarthest() {
+            near.position = Qt.vector3d(2, 0, 0)
+            far.position = Qt.vector3d(90, 0, 0)
+            near.play()
+            far.play()
+
+            // Computes the attenuation of all playing instances in one batch
+            engine.update()
+
+            nearInverse.position = Qt.vector3d(2, 0, 0)
+            nearInverse.play()
+            compareStates([near, nearInverse], [far])
+        }
+
+        function test_stealFarthestAcrossModels() {
+            engine.maxVoices = 3
+            near.position = Qt.vector3d(2, 0, 0)
+            farInverse.position = Qt.vector3d(50, 0, 0)
+            nearInverse.position = Qt.vector3d(3, 0, 0)
+            near.play()
+            farInverse.play()
+            nearInverse.play()
+
+            // The instances of both models are in the same batch
+            engine.update()
+
+            far.position = Qt.vector3d(10, 0, 0)
+            far.play()
+            compareStates([near, nearInverse, far], [farInverse])
+        }
+    }
+}
@@ -5,6 +5,8 @@ SUBDIRS += \
     qabstractvideosurface \
     qaudiorecorder \
     qaudioformat \
+    qaudioconverter \
+    qaudioformatadapter \
     qaudionamespace \
     qcamera \
     qcamerainfo \
@@ -15,12 +17,15 @@ SUBDIRS += \
     qmediaobject \
     qmediaplayer \
     qmediaplaylist \
+    qmediametadatascanner \
     qmediaplaylistnavigator \
     qmediapluginloader \
     qmediarecorder \
     qmediaresource \
     qmediaservice \
     qmediaserviceprovider \
+    qmediastatistics \
+    qmediathumbnailer \
     qmediatimerange \
     qmetadatareadercontrol \
     qmetadatawritercontrol \
@@ -29,9 +34,12 @@ SUBDIRS += \
     qvideoencodersettingscontrol \
     qvideoframe \
     qvideosurfaceformat \
+    qvideosurfaces \
     qwavedecoder \
     qaudiobuffer \
     qaudiodecoder \
     qaudioprobe \
     qvideoprobe \
     qsamplecache
+
+qtHaveModule(multimediagsttools): SUBDIRS += qgstutils qgstcodecsinfo
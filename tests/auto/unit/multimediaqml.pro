@@ -3,7 +3,8 @@ TEMPLATE = subdirs
 SUBDIRS += \
     qdeclarativemultimediaglobal \
     qdeclarativeaudio \
-    qdeclarativecamera
+    qdeclarativecamera \
+    qdeclarativecamerapreviewprovider
 
 disabled {
     SUBDIRS += \
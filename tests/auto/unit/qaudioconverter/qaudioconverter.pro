@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qaudioconverter
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_qaudioconverter.cpp
@@ -0,0 +1,293 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qmath.h>
+
+#include <private/qaudioconverter_p.h>
+
+//TESTED_COMPONENT=src/multimedia
+
+static QAudioFormat pcmFormat(int sampleRate, int channels, int sampleSize,
+                              QAudioFormat::SampleType sampleType,
+                              QAudioFormat::Endian byteOrder = QAudioFormat::LittleEndian)
+{
+    QAudioFormat format;
+    format.setCodec(QStringLiteral("audio/pcm"));
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channels);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(byteOrder);
+    return format;
+}
+
+class tst_QAudioConverter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void passthrough();
+    void unsupportedFormats();
+    void sampleFormatRoundTrip_data();
+    void sampleFormatRoundTrip();
+    void channelMixing();
+    void surroundDownmix();
+    void partialFrames();
+    void resample_data();
+    void resample();
+    void byteCounts();
+};
+
+void tst_QAudioConverter::passthrough()
+{
+    const QAudioFormat format = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    QAudioConverter converter(format, format);
+
+    QVERIFY(converter.isValid());
+    QVERIFY(converter.isPassthrough());
+
+    const QByteArray data("0123456789abcdef");
+    QCOMPARE(converter.convert(data), data);
+    QVERIFY(converter.flush().isEmpty());
+    QCOMPARE(converter.outputBytesForInput(400), 400);
+}
+
+void tst_QAudioConverter::unsupportedFormats()
+{
+    QAudioFormat compressed = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    compressed.setCodec(QStringLiteral("audio/mpeg"));
+    QVERIFY(!QAudioConverter::isFormatSupported(compressed));
+    QVERIFY(!QAudioConverter::isFormatSupported(QAudioFormat()));
+    QVERIFY(!QAudioConverter::isFormatSupported(pcmFormat(44100, 2, 64, QAudioFormat::Float)));
+    QVERIFY(QAudioConverter::isFormatSupported(pcmFormat(44100, 2, 24, QAudioFormat::UnSignedInt)));
+
+    QAudioConverter converter(compressed, pcmFormat(44100, 2, 16, QAudioFormat::SignedInt));
+    QVERIFY(!converter.isValid());
+}
+
+void tst_QAudioConverter::sampleFormatRoundTrip_data()
+{
+    QTest::addColumn<QAudioFormat>("format");
+
+    QTest::newRow("s16") << pcmFormat(8000, 1, 16, QAudioFormat::SignedInt);
+    QTest::newRow("s16be") << pcmFormat(8000, 1, 16, QAudioFormat::SignedInt, QAudioFormat::BigEndian);
+    QTest::newRow("u16") << pcmFormat(8000, 1, 16, QAudioFormat::UnSignedInt);
+    QTest::newRow("s24") << pcmFormat(8000, 1, 24, QAudioFormat::SignedInt);
+    QTest::newRow("u24be") << pcmFormat(8000, 1, 24, QAudioFormat::UnSignedInt, QAudioFormat::BigEndian);
+    QTest::newRow("s32") << pcmFormat(8000, 1, 32, QAudioFormat::SignedInt);
+    QTest::newRow("float") << pcmFormat(8000, 1, 32, QAudioFormat::Float);
+    QTest::newRow("floatbe") << pcmFormat(8000, 1, 32, QAudioFormat::Float, QAudioFormat::BigEndian);
+}
+
+void tst_QAudioConverter::sampleFormatRoundTrip()
+{
+    QFETCH(QAudioFormat, format);
+
+    // Every 16 bit sample survives a trip through a wider format unchanged.
+    QVector<qint16> samples;
+    for (int i = -32768; i < 32768; i += 37)
+        samples.append(qint16(i));
+    samples.append(32767);
+    const QByteArray input(reinterpret_cast<const char *>(samples.constData()),
+                           samples.size() * int(sizeof(qint16)));
+
+    const QAudioFormat native = pcmFormat(8000, 1, 16, QAudioFormat::SignedInt,
+                                          QAudioFormat::Endian(QSysInfo::ByteOrder));
+    QAudioConverter forward(native, format);
+    QAudioConverter backward(format, native);
+
+    const QByteArray converted = forward.convert(input);
+    QCOMPARE(converted.size(), samples.size() * format.sampleSize() / 8);
+    QCOMPARE(backward.convert(converted), input);
+}
+
+void tst_QAudioConverter::channelMixing()
+{
+    const QAudioFormat mono = pcmFormat(8000, 1, 32, QAudioFormat::Float);
+    const QAudioFormat stereo = pcmFormat(8000, 2, 32, QAudioFormat::Float);
+    const QAudioFormat surround = pcmFormat(8000, 6, 32, QAudioFormat::Float);
+
+    const float monoSamples[] = { 0.5f, -0.25f };
+    QAudioConverter upmix(mono, surround);
+    const QByteArray upmixed = upmix.convert(reinterpret_cast<const char *>(monoSamples), sizeof(monoSamples));
+    QCOMPARE(upmixed.size(), 2 * 6 * int(sizeof(float)));
+    const float *six = reinterpret_cast<const float *>(upmixed.constData());
+    QCOMPARE(six[0], 0.5f);
+    QCOMPARE(six[1], 0.5f);
+    QCOMPARE(six[2], 0.0f);
+    QCOMPARE(six[6], -0.25f);
+    QCOMPARE(six[7], -0.25f);
+
+    const float stereoSamples[] = { 0.5f, 0.25f, -1.0f, 1.0f };
+    QAudioConverter downmix(stereo, mono);
+    const QByteArray downmixed = downmix.convert(reinterpret_cast<const char *>(stereoSamples), sizeof(stereoSamples));
+    QCOMPARE(downmixed.size(), 2 * int(sizeof(float)));
+    const float *one = reinterpret_cast<const float *>(downmixed.constData());
+    QCOMPARE(one[0], 0.375f);
+    QCOMPARE(one[1], 0.0f);
+}
+
+void tst_QAudioConverter::surroundDownmix()
+{
+    const QAudioFormat surround = pcmFormat(8000, 6, 32, QAudioFormat::Float);
+    const QAudioFormat stereo = pcmFormat(8000, 2, 32, QAudioFormat::Float);
+    const QAudioFormat mono = pcmFormat(8000, 1, 32, QAudioFormat::Float);
+    const float minus3dB = float(M_SQRT1_2);
+
+    // One frame per speaker, FL FR FC LFE BL BR
+    float samples[6 * 6] = {};
+    for (int speaker = 0; speaker < 6; ++speaker)
+        samples[speaker * 6 + speaker] = 0.5f;
+
+    QAudioConverter downmix(surround, stereo);
+    const QByteArray downmixed = downmix.convert(reinterpret_cast<const char *>(samples), sizeof(samples));
+    QCOMPARE(downmixed.size(), 6 * 2 * int(sizeof(float)));
+    const float *two = reinterpret_cast<const float *>(downmixed.constData());
+
+    // Fronts stay on their side
+    QCOMPARE(two[0], 0.5f);
+    QCOMPARE(two[1], 0.0f);
+    QCOMPARE(two[2], 0.0f);
+    QCOMPARE(two[3], 0.5f);
+    // The centre is split to both sides at -3 dB
+    QCOMPARE(two[4], 0.5f * minus3dB);
+    QCOMPARE(two[5], 0.5f * minus3dB);
+    // The LFE is dropped
+    QCOMPARE(two[6], 0.0f);
+    QCOMPARE(two[7], 0.0f);
+    // Surrounds go to their side at -3 dB
+    QCOMPARE(two[8], 0.5f * minus3dB);
+    QCOMPARE(two[9], 0.0f);
+    QCOMPARE(two[10], 0.0f);
+    QCOMPARE(two[11], 0.5f * minus3dB);
+
+    QAudioConverter monoDownmix(surround, mono);
+    const QByteArray monoMixed = monoDownmix.convert(reinterpret_cast<const char *>(samples), sizeof(samples));
+    QCOMPARE(monoMixed.size(), 6 * int(sizeof(float)));
+    const float *one = reinterpret_cast<const float *>(monoMixed.constData());
+    QCOMPARE(one[0], 0.25f);
+    QCOMPARE(one[1], 0.25f);
+    QCOMPARE(one[2], 0.5f);
+    QCOMPARE(one[3], 0.0f);
+    QCOMPARE(one[4], 0.25f * minus3dB);
+    QCOMPARE(one[5], 0.25f * minus3dB);
+}
+
+void tst_QAudioConverter::partialFrames()
+{
+    const QAudioFormat input = pcmFormat(8000, 2, 16, QAudioFormat::SignedInt);
+    const QAudioFormat output = pcmFormat(8000, 2, 32, QAudioFormat::Float);
+    QAudioConverter converter(input, output);
+
+    const qint16 samples[] = { 16384, -16384, 8192, -8192 };
+    const char *data = reinterpret_cast<const char *>(samples);
+
+    // Feed the two frames in odd sized pieces, a frame is only emitted once complete.
+    QByteArray result = converter.convert(data, 3);
+    QVERIFY(result.isEmpty());
+    result += converter.convert(data + 3, 4);
+    QCOMPARE(result.size(), 2 * int(sizeof(float)));
+    result += converter.convert(data + 7, 1);
+    QCOMPARE(result.size(), 4 * int(sizeof(float)));
+
+    const float *floats = reinterpret_cast<const float *>(result.constData());
+    QCOMPARE(floats[0], 0.5f);
+    QCOMPARE(floats[1], -0.5f);
+    QCOMPARE(floats[2], 0.25f);
+    QCOMPARE(floats[3], -0.25f);
+}
+
+void tst_QAudioConverter::resample_data()
+{
+    QTest::addColumn<int>("inputRate");
+    QTest::addColumn<int>("outputRate");
+    QTest::addColumn<int>("quality");
+    QTest::addColumn<double>("tolerance");
+
+    QTest::newRow("44100->48000 fast") << 44100 << 48000 << int(QAudioConverter::FastQuality) << 2e-3;
+    QTest::newRow("44100->48000 medium") << 44100 << 48000 << int(QAudioConverter::MediumQuality) << 5e-4;
+    QTest::newRow("44100->48000 best") << 44100 << 48000 << int(QAudioConverter::BestQuality) << 1e-4;
+    QTest::newRow("48000->16000 medium") << 48000 << 16000 << int(QAudioConverter::MediumQuality) << 5e-4;
+    QTest::newRow("8000->44100 best") << 8000 << 44100 << int(QAudioConverter::BestQuality) << 1e-4;
+}
+
+void tst_QAudioConverter::resample()
+{
+    QFETCH(int, inputRate);
+    QFETCH(int, outputRate);
+    QFETCH(int, quality);
+    QFETCH(double, tolerance);
+
+    const QAudioFormat input = pcmFormat(inputRate, 1, 32, QAudioFormat::Float);
+    const QAudioFormat output = pcmFormat(outputRate, 1, 32, QAudioFormat::Float);
+    QAudioConverter converter(input, output, QAudioConverter::Quality(quality));
+    QVERIFY(!converter.isPassthrough());
+
+    // One second of a 440Hz tone, fed in uneven chunks.
+    const double frequency = 440.0;
+    QVector<float> tone(inputRate);
+    for (int i = 0; i < inputRate; ++i)
+        tone[i] = float(0.5 * qSin(2 * M_PI * frequency * i / inputRate));
+    const QByteArray data(reinterpret_cast<const char *>(tone.constData()), inputRate * int(sizeof(float)));
+
+    QByteArray result;
+    for (int offset = 0; offset < data.size(); offset += 1001)
+        result += converter.convert(data.mid(offset, 1001));
+    result += converter.flush();
+
+    QCOMPARE(result.size(), outputRate * int(sizeof(float)));
+
+    // Skip the first and last 20ms where the filter sees the implicit silence
+    // around the stream.
+    const float *samples = reinterpret_cast<const float *>(result.constData());
+    const int margin = outputRate / 50;
+    double error = 0.0;
+    for (int i = margin; i < outputRate - margin; ++i) {
+        const double expected = 0.5 * qSin(2 * M_PI * frequency * i / outputRate);
+        error = qMax(error, qAbs(samples[i] - expected));
+    }
+    QVERIFY2(error < tolerance, QByteArray::number(error));
+}
+
+void tst_QAudioConverter::byteCounts()
+{
+    const QAudioFormat input = pcmFormat(44100, 2, 16, QAudioFormat::SignedInt);
+    const QAudioFormat output = pcmFormat(48000, 1, 32, QAudioFormat::Float);
+    QAudioConverter converter(input, output);
+
+    QCOMPARE(converter.outputBytesForInput(44100 * 4), 48000 * 4);
+    QCOMPARE(converter.inputBytesForOutput(48000 * 4), 44100 * 4);
+    // Whole frames only, rounding up for output and down for input.
+    QCOMPARE(converter.outputBytesForInput(4), 2 * 4);
+    QCOMPARE(converter.inputBytesForOutput(4), 0);
+}
+
+QTEST_MAIN(tst_QAudioConverter)
+
+#include "tst_qaudioconverter.moc"
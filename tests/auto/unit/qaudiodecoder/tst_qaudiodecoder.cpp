@@ -49,6 +49,13 @@ private Q_SLOTS:
     void format();
     void source();
     void readAll();
+    void bufferCallback();
+    void bufferCallbackBlocks();
+    void bufferCallbackWholeFile();
+    void bufferCallbackMember();
+    void consumerControl();
+    void consumerControlStop();
+    void consumerContextDestroyed();
     void nullControl();
     void nullService();
 
@@ -327,6 +334,216 @@ void tst_QAudioDecoder::readAll()
     }
 }
 
+void tst_QAudioDecoder::bufferCallback()
+{
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    QCOMPARE(d.bufferMode(), QAudioDecoder::NativeBufferMode);
+
+    QList<QAudioBuffer> buffers;
+    d.setBufferCallback(nullptr, [&buffers](const QAudioBuffer &buffer) { buffers.append(buffer); });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+
+    QCOMPARE(buffers.count(), MOCK_DECODER_MAX_BUFFERS);
+    for (int i = 0; i < buffers.count(); ++i) {
+        QCOMPARE(buffers.at(i).byteCount(), 4);
+        QCOMPARE(buffers.at(i).startTime(), qint64(i * 4000));
+    }
+    QVERIFY(!d.bufferAvailable());
+    QVERIFY(!d.read().isValid());
+}
+
+void tst_QAudioDecoder::bufferCallbackBlocks()
+{
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    d.setBufferMode(QAudioDecoder::FixedBlockBufferMode);
+    d.setBufferBlockSize(6);
+    QCOMPARE(d.bufferBlockSize(), 6);
+
+    QList<QAudioBuffer> buffers;
+    d.setBufferCallback(this, [&buffers](const QAudioBuffer &buffer) { buffers.append(buffer); });
+
+    // The callback runs on the thread of the context, finished() follows the last block
+    int buffersAtFinished = -1;
+    connect(&d, &QAudioDecoder::finished, this, [&]() { buffersAtFinished = buffers.count(); });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+
+    // 10 buffers of 4 frames each, the last block holds the remainder
+    QCOMPARE(buffersAtFinished, 7);
+    QCOMPARE(buffers.count(), 7);
+    for (int i = 0; i < 6; ++i) {
+        QCOMPARE(buffers.at(i).frameCount(), 6);
+        QCOMPARE(buffers.at(i).startTime(), qint64(i * 6000));
+    }
+    QCOMPARE(buffers.at(6).frameCount(), 4);
+    QCOMPARE(buffers.at(6).startTime(), qint64(36000));
+}
+
+void tst_QAudioDecoder::bufferCallbackWholeFile()
+{
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    d.setBufferMode(QAudioDecoder::WholeFileBufferMode);
+
+    QList<QAudioBuffer> buffers;
+    d.setBufferCallback(nullptr, [&buffers](const QAudioBuffer &buffer) { buffers.append(buffer); });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+
+    QCOMPARE(buffers.count(), 1);
+    QCOMPARE(buffers.first().byteCount(), MOCK_DECODER_MAX_BUFFERS * 4);
+    QCOMPARE(buffers.first().startTime(), qint64(0));
+
+    // Each decoded buffer holds its serial number
+    const int *serials = buffers.first().constData<int>();
+    for (int i = 0; i < MOCK_DECODER_MAX_BUFFERS; ++i)
+        QCOMPARE(serials[i], i);
+
+    // Clearing the callback restores read()
+    d.clearBufferCallback();
+    d.start();
+    QTRY_VERIFY(d.bufferAvailable());
+    QVERIFY(d.read().isValid());
+    QCOMPARE(buffers.count(), 1);
+}
+
+class BufferReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    void receive(const QAudioBuffer &buffer) { buffers.append(buffer); }
+
+    QList<QAudioBuffer> buffers;
+};
+
+void tst_QAudioDecoder::bufferCallbackMember()
+{
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+
+    BufferReceiver receiver;
+    d.setBufferCallback(&receiver, &BufferReceiver::receive);
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(receiver.buffers.count(), MOCK_DECODER_MAX_BUFFERS);
+    QVERIFY(!d.bufferAvailable());
+}
+
+void tst_QAudioDecoder::consumerControl()
+{
+    mockAudioDecoderService->consumerControlEnabled = true;
+    MockAudioDecoderConsumerControl *control = mockAudioDecoderService->consumerControl;
+
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    QCOMPARE(d.bufferQueueDepth(), 4);
+    d.setBufferQueueDepth(2);
+    QCOMPARE(control->bufferQueueDepth(), 2);
+
+    QList<QAudioBuffer> buffers;
+    bool onContextThread = true;
+    bool withinQueueDepth = true;
+    d.setBufferCallback(this, [&](const QAudioBuffer &buffer) {
+        onContextThread &= QThread::currentThread() == thread();
+        // The decoding thread never gets more than the queue depth ahead
+        if (control->mControl->mThread->mPushed.loadAcquire() > buffers.count() + 2)
+            withinQueueDepth = false;
+        buffers.append(buffer);
+        QThread::msleep(5);
+    });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(d.state(), QAudioDecoder::StoppedState);
+
+    QVERIFY(onContextThread);
+    QVERIFY(withinQueueDepth);
+    QCOMPARE(buffers.count(), MOCK_DECODER_MAX_BUFFERS);
+    for (int i = 0; i < buffers.count(); ++i) {
+        QCOMPARE(buffers.at(i).startTime(), qint64(i * 4000));
+        QCOMPARE(*buffers.at(i).constData<int>(), i);
+    }
+
+    // Nothing is left for read()
+    QVERIFY(!d.bufferAvailable());
+    QVERIFY(!d.read().isValid());
+
+    // Decoding again delivers everything again
+    buffers.clear();
+    d.start();
+    QTRY_COMPARE(finishedSpy.count(), 2);
+    QCOMPARE(buffers.count(), MOCK_DECODER_MAX_BUFFERS);
+}
+
+void tst_QAudioDecoder::consumerControlStop()
+{
+    mockAudioDecoderService->consumerControlEnabled = true;
+    MockAudioDecoderControl *control = mockAudioDecoderService->mockControl;
+
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    d.setBufferQueueDepth(1);
+
+    int count = 0;
+    d.setBufferCallback(this, [&count](const QAudioBuffer &) { ++count; });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_VERIFY(count > 0);
+
+    // Stopping unblocks the decoding thread and drops what is queued
+    d.stop();
+    QVERIFY(control->mThread->isFinished());
+    const int delivered = count;
+    QTest::qWait(50);
+    QCOMPARE(count, delivered);
+    QVERIFY(count < MOCK_DECODER_MAX_BUFFERS);
+    QCOMPARE(finishedSpy.count(), 0);
+}
+
+void tst_QAudioDecoder::consumerContextDestroyed()
+{
+    mockAudioDecoderService->consumerControlEnabled = true;
+    MockAudioDecoderControl *control = mockAudioDecoderService->mockControl;
+
+    QAudioDecoder d;
+    d.setSourceFilename("Foo");
+    d.setBufferQueueDepth(1);
+
+    QObject *context = new QObject;
+    QPointer<QObject> guard(context);
+    int count = 0;
+    d.setBufferCallback(context, [&count, context](const QAudioBuffer &) {
+        if (++count == 2)
+            context->deleteLater();
+    });
+
+    QSignalSpy finishedSpy(&d, SIGNAL(finished()));
+    d.start();
+    QTRY_VERIFY(guard.isNull());
+
+    // The decoding thread does not wait for buffers which can't be delivered
+    QTRY_VERIFY(control->mThread->isFinished());
+    QVERIFY(count >= 2);
+    QVERIFY(count < MOCK_DECODER_MAX_BUFFERS);
+    QCOMPARE(finishedSpy.count(), 0);
+
+    d.stop();
+    QCOMPARE(d.state(), QAudioDecoder::StoppedState);
+}
+
 void tst_QAudioDecoder::nullControl()
 {
     mockAudioDecoderService->setControlNull();
@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qaudioformatadapter
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_qaudioformatadapter.cpp
@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+
+#include <private/qaudioformatadapter_p.h>
+
+static QAudioFormat pcmFormat(int sampleRate, int channels)
+{
+    QAudioFormat format;
+    format.setCodec(QStringLiteral("audio/pcm"));
+    format.setSampleRate(sampleRate);
+    format.setChannelCount(channels);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    return format;
+}
+
+// Accepts at most capacity bytes until more room is made
+class LimitedDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    LimitedDevice() { open(QIODevice::WriteOnly); }
+
+    bool isSequential() const override { return true; }
+
+    QByteArray data;
+    int capacity = 0;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *src, qint64 len) override
+    {
+        const int count = int(qMin<qint64>(len, capacity - data.size()));
+        data.append(src, count);
+        return count;
+    }
+};
+
+class tst_QAudioFormatAdapter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writerConverts();
+    void writerRetriesRefusedData();
+    void writerReturnsConsumedBytes();
+    void writerFinishFlushesResampler();
+    void readerFlushesAtEnd();
+};
+
+void tst_QAudioFormatAdapter::writerConverts()
+{
+    QAudioConverter converter(pcmFormat(8000, 1), pcmFormat(8000, 2));
+    QBuffer sink;
+    sink.open(QIODevice::WriteOnly);
+    QAudioConvertingWriter writer(&sink, &converter);
+
+    const qint16 samples[] = { 100, -200, 300 };
+    QCOMPARE(writer.write(reinterpret_cast<const char *>(samples), sizeof(samples)), qint64(sizeof(samples)));
+
+    QCOMPARE(sink.data().size(), 2 * int(sizeof(samples)));
+    const qint16 *stereo = reinterpret_cast<const qint16 *>(sink.data().constData());
+    QCOMPARE(stereo[0], qint16(100));
+    QCOMPARE(stereo[1], qint16(100));
+    QCOMPARE(stereo[4], qint16(300));
+    QCOMPARE(stereo[5], qint16(300));
+}
+
+void tst_QAudioFormatAdapter::writerRetriesRefusedData()
+{
+    QAudioConverter converter(pcmFormat(8000, 1), pcmFormat(8000, 2));
+    LimitedDevice sink;
+    sink.capacity = 8;
+    QAudioConvertingWriter writer(&sink, &converter);
+
+    const QByteArray input(16, '\1');
+    QCOMPARE(writer.write(input), qint64(16));
+    QCOMPARE(sink.data.size(), 8);
+    QCOMPARE(writer.pendingBytes(), 24);
+
+    // Nothing more is taken while the refused data is waiting
+    QCOMPARE(writer.write(input), qint64(0));
+    QCOMPARE(writer.pendingBytes(), 24);
+
+    // The rest goes out without another write or a notify from the backend
+    sink.capacity = 32;
+    QTRY_COMPARE(writer.pendingBytes(), 0);
+    QCOMPARE(sink.data.size(), 32);
+}
+
+void tst_QAudioFormatAdapter::writerReturnsConsumedBytes()
+{
+    QAudioConverter converter(pcmFormat(8000, 1), pcmFormat(8000, 2));
+    LimitedDevice sink;
+    sink.capacity = 1000;
+    QAudioConvertingWriter writer(&sink, &converter);
+
+    QVector<qint16> samples(4096);
+    for (int i = 0; i < samples.size(); ++i)
+        samples[i] = qint16(i);
+    const QByteArray input(reinterpret_cast<const char *>(samples.constData()), samples.size() * 2);
+
+    // Only whole chunks up to the first one the sink refused are consumed
+    const qint64 consumed = writer.write(input);
+    QVERIFY(consumed > 0);
+    QVERIFY(consumed < input.size());
+    QCOMPARE(consumed % 2, qint64(0));
+    QCOMPARE(sink.data.size(), 1000);
+    QCOMPARE(writer.pendingBytes(), int(consumed) * 2 - 1000);
+
+    // A caller following the return value hands over everything exactly once
+    qint64 offset = consumed;
+    while (offset < input.size()) {
+        sink.capacity += 1000;
+        offset += writer.write(input.constData() + offset, input.size() - offset);
+    }
+    sink.capacity = input.size() * 2;
+    QTRY_COMPARE(writer.pendingBytes(), 0);
+
+    QCOMPARE(sink.data.size(), input.size() * 2);
+    const qint16 *stereo = reinterpret_cast<const qint16 *>(sink.data.constData());
+    for (int i = 0; i < samples.size(); ++i) {
+        QCOMPARE(stereo[2 * i], samples.at(i));
+        QCOMPARE(stereo[2 * i + 1], samples.at(i));
+    }
+}
+
+void tst_QAudioFormatAdapter::writerFinishFlushesResampler()
+{
+    QAudioConverter converter(pcmFormat(8000, 1), pcmFormat(16000, 1));
+    QBuffer sink;
+    sink.open(QIODevice::WriteOnly);
+    QAudioConvertingWriter writer(&sink, &converter);
+
+    const QByteArray input(800 * 2, '\0');
+    writer.write(input);
+    const int written = sink.data().size();
+    QVERIFY(written < 1600 * 2);
+
+    // The resampler holds back the last frames until the stream ends
+    writer.finish();
+    QCOMPARE(sink.data().size(), 1600 * 2);
+    QVERIFY(sink.data().size() > written);
+}
+
+void tst_QAudioFormatAdapter::readerFlushesAtEnd()
+{
+    QAudioConverter converter(pcmFormat(8000, 1), pcmFormat(16000, 1));
+    QByteArray input(800 * 2, '\0');
+    QBuffer source(&input);
+    source.open(QIODevice::ReadOnly);
+    QAudioConvertingReader reader(&source, &converter);
+
+    QByteArray output;
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray chunk = reader.read(256);
+        if (chunk.isEmpty())
+            break;
+        output.append(chunk);
+    }
+    QCOMPARE(output.size(), 1600 * 2);
+}
+
+QTEST_GUILESS_MAIN(tst_QAudioFormatAdapter)
+
+#include "tst_qaudioformatadapter.moc"
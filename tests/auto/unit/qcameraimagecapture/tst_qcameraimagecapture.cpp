@@ -98,6 +98,7 @@ private slots:
     void isReadyForCapture();
     void capture();
     void cancelCapture();
+    void driveMode();
     void encodingSettings();
     void errors();
     void error();
@@ -237,6 +238,19 @@ void tst_QCameraImageCapture::cancelCapture()
     camera.stop();
 }
 
+void tst_QCameraImageCapture::driveMode()
+{
+    QCamera camera;
+    QCameraImageCapture imageCapture(&camera);
+    QCOMPARE(imageCapture.driveMode(), QCameraImageCapture::SingleImageCapture);
+
+    imageCapture.setDriveMode(QCameraImageCapture::BurstImageCapture);
+    QCOMPARE(imageCapture.driveMode(), QCameraImageCapture::BurstImageCapture);
+
+    imageCapture.setDriveMode(QCameraImageCapture::SingleImageCapture);
+    QCOMPARE(imageCapture.driveMode(), QCameraImageCapture::SingleImageCapture);
+}
+
 //MaemoAPI-1828:test encodingSettings
 //MaemoAPI-1829:test set encodingSettings
 void tst_QCameraImageCapture::encodingSettings()
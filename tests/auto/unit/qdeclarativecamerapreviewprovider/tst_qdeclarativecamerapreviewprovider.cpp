@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/imports/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qthread.h>
+#include <QtGui/qimage.h>
+
+#include "qdeclarativecamerapreviewprovider_p.h"
+
+class PreviewRequester : public QThread
+{
+public:
+    PreviewRequester(QDeclarativeCameraPreviewProvider *provider, const QString &id, const QSize &size)
+        : m_provider(provider), m_id(id), m_size(size)
+    {
+    }
+
+    QList<QImage> results;
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < 5; ++i)
+            results.append(m_provider->requestImage(m_id, nullptr, m_size));
+    }
+
+private:
+    QDeclarativeCameraPreviewProvider *m_provider;
+    QString m_id;
+    QSize m_size;
+};
+
+class tst_QDeclarativeCameraPreviewProvider : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void unknownId();
+    void fullSize();
+    void scaledHit();
+    void evictByBytes();
+    void evictScaledVariants();
+    void keepLatestCapture();
+    void concurrentLookup();
+
+private:
+    QDeclarativeCameraPreviewProvider *provider = nullptr;
+};
+
+static QImage previewImage(const QSize &size, QRgb color = qRgb(0x20, 0x80, 0xc0))
+{
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    return image;
+}
+
+void tst_QDeclarativeCameraPreviewProvider::init()
+{
+    provider = new QDeclarativeCameraPreviewProvider;
+}
+
+void tst_QDeclarativeCameraPreviewProvider::cleanup()
+{
+    // Also clears the previews, which are shared by all providers
+    delete provider;
+    provider = nullptr;
+}
+
+void tst_QDeclarativeCameraPreviewProvider::unknownId()
+{
+    QSize size(-1, -1);
+    QVERIFY(provider->requestImage(QLatin1String("unknown"), &size, QSize()).isNull());
+    QCOMPARE(size, QSize(-1, -1));
+}
+
+void tst_QDeclarativeCameraPreviewProvider::fullSize()
+{
+    const QImage image = previewImage(QSize(64, 48));
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("full"), image);
+
+    QSize size;
+    const QImage result = provider->requestImage(QLatin1String("full"), &size, QSize());
+    QCOMPARE(size, QSize(64, 48));
+    QCOMPARE(result.cacheKey(), image.cacheKey());
+}
+
+void tst_QDeclarativeCameraPreviewProvider::scaledHit()
+{
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("hit"), previewImage(QSize(640, 480)));
+
+    QSize size;
+    const QImage first = provider->requestImage(QLatin1String("hit"), &size, QSize(160, 160));
+    QCOMPARE(size, QSize(160, 120));
+    QCOMPARE(first.pixel(80, 60), qRgb(0x20, 0x80, 0xc0));
+
+    // Served from the cache, also when asked with a size giving the same target
+    QCOMPARE(provider->requestImage(QLatin1String("hit"), &size, QSize(160, 120)).cacheKey(), first.cacheKey());
+    QCOMPARE(provider->requestImage(QLatin1String("hit"), &size, QSize(200, 120)).cacheKey(), first.cacheKey());
+    QCOMPARE(size, QSize(160, 120));
+
+    const QImage other = provider->requestImage(QLatin1String("hit"), &size, QSize(320, 240));
+    QCOMPARE(size, QSize(320, 240));
+    QVERIFY(other.cacheKey() != first.cacheKey());
+
+    // A new capture with the same id replaces the cached variants
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("hit"), previewImage(QSize(640, 480), qRgb(0, 0, 0)));
+    const QImage replaced = provider->requestImage(QLatin1String("hit"), &size, QSize(160, 120));
+    QVERIFY(replaced.cacheKey() != first.cacheKey());
+    QCOMPARE(replaced.pixel(80, 60), qRgb(0, 0, 0));
+}
+
+void tst_QDeclarativeCameraPreviewProvider::evictByBytes()
+{
+    // 16 MB each, the cache keeps 64 MB
+    const QSize captureSize(2048, 2048);
+    for (int i = 0; i < 4; ++i)
+        QDeclarativeCameraPreviewProvider::registerPreview(QString::number(i), previewImage(captureSize));
+
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(!provider->requestImage(QString::number(i), nullptr, QSize()).isNull());
+
+    // Looking a capture up makes it the most recently used one
+    QVERIFY(!provider->requestImage(QLatin1String("0"), nullptr, QSize()).isNull());
+
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("4"), previewImage(captureSize));
+    QVERIFY(!provider->requestImage(QLatin1String("0"), nullptr, QSize()).isNull());
+    QVERIFY(provider->requestImage(QLatin1String("1"), nullptr, QSize()).isNull());
+    QVERIFY(!provider->requestImage(QLatin1String("2"), nullptr, QSize()).isNull());
+    QVERIFY(!provider->requestImage(QLatin1String("3"), nullptr, QSize()).isNull());
+    QVERIFY(!provider->requestImage(QLatin1String("4"), nullptr, QSize()).isNull());
+}
+
+void tst_QDeclarativeCameraPreviewProvider::evictScaledVariants()
+{
+    const QSize captureSize(2048, 2048);
+    for (int i = 0; i < 4; ++i)
+        QDeclarativeCameraPreviewProvider::registerPreview(QString::number(i), previewImage(captureSize));
+
+    // Scaled variants count against the cache too
+    QSize size;
+    provider->requestImage(QLatin1String("3"), &size, QSize(1024, 1024));
+    QCOMPARE(size, QSize(1024, 1024));
+
+    QVERIFY(provider->requestImage(QLatin1String("0"), nullptr, QSize()).isNull());
+    QVERIFY(!provider->requestImage(QLatin1String("1"), nullptr, QSize()).isNull());
+    QVERIFY(!provider->requestImage(QLatin1String("3"), nullptr, QSize()).isNull());
+}
+
+void tst_QDeclarativeCameraPreviewProvider::keepLatestCapture()
+{
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("small"), previewImage(QSize(64, 48)));
+
+    // Larger than the whole cache on its own
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("large"), previewImage(QSize(5000, 4000)));
+    QVERIFY(provider->requestImage(QLatin1String("small"), nullptr, QSize()).isNull());
+
+    QSize size;
+    QVERIFY(!provider->requestImage(QLatin1String("large"), &size, QSize(500, 500)).isNull());
+    QCOMPARE(size, QSize(500, 400));
+    QVERIFY(!provider->requestImage(QLatin1String("large"), nullptr, QSize()).isNull());
+}
+
+void tst_QDeclarativeCameraPreviewProvider::concurrentLookup()
+{
+    QDeclarativeCameraPreviewProvider::registerPreview(QLatin1String("shared"), previewImage(QSize(2400, 1800)));
+
+    const QImage cached = provider->requestImage(QLatin1String("shared"), nullptr, QSize(400, 300));
+    QCOMPARE(cached.size(), QSize(400, 300));
+
+    // Half of the threads ask for the cached size while the others scale a new one
+    QList<PreviewRequester *> requesters;
+    for (int i = 0; i < 8; ++i) {
+        const QSize size = i % 2 ? QSize(400, 300) : QSize(1600, 1200);
+        requesters.append(new PreviewRequester(provider, QLatin1String("shared"), size));
+    }
+    for (PreviewRequester *requester : qAsConst(requesters))
+        requester->start();
+    for (PreviewRequester *requester : qAsConst(requesters))
+        QVERIFY(requester->wait(30000));
+
+    qint64 scaledKey = 0;
+    for (int i = 0; i < requesters.size(); ++i) {
+        const QList<QImage> &results = requesters.at(i)->results;
+        QCOMPARE(results.size(), 5);
+        for (const QImage &result : results) {
+            if (i % 2) {
+                QCOMPARE(result.cacheKey(), cached.cacheKey());
+                continue;
+            }
+
+            // Every thread gets the one image that was scaled for this size
+            QCOMPARE(result.size(), QSize(1600, 1200));
+            if (!scaledKey)
+                scaledKey = result.cacheKey();
+            QCOMPARE(result.cacheKey(), scaledKey);
+        }
+    }
+
+    qDeleteAll(requesters);
+}
+
+QTEST_GUILESS_MAIN(tst_QDeclarativeCameraPreviewProvider)
+
+#include "tst_qdeclarativecamerapreviewprovider.moc"
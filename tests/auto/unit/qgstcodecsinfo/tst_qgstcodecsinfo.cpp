@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qgstcodecsinfo_p.h>
+
+#include <gst/gst.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGstCodecsInfo : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void queueOptions();
+    void identityOptions();
+    void fakesrcOptions();
+    void unknownElement();
+    void codecOptions();
+};
+
+void tst_QGstCodecsInfo::initTestCase()
+{
+    gst_init(nullptr, nullptr);
+}
+
+void tst_QGstCodecsInfo::queueOptions()
+{
+    const QStringList names = QGstCodecsInfo::elementOptionNames("queue");
+    QVERIFY(names.contains(QLatin1String("max-size-buffers")));
+    QVERIFY(names.contains(QLatin1String("leaky")));
+    QVERIFY(!names.contains(QLatin1String("name")));
+    QVERIFY(!names.contains(QLatin1String("parent")));
+
+    const QGstCodecsInfo::CodecOption buffers
+            = QGstCodecsInfo::elementOption("queue", QLatin1String("max-size-buffers"));
+    QCOMPARE(buffers.name, QLatin1String("max-size-buffers"));
+    QCOMPARE(buffers.defaultValue, QVariant(200u));
+    QCOMPARE(buffers.minimum, QVariant(0u));
+    QCOMPARE(buffers.maximum, QVariant(uint(G_MAXUINT)));
+
+    const QGstCodecsInfo::CodecOption time
+            = QGstCodecsInfo::elementOption("queue", QLatin1String("max-size-time"));
+    QCOMPARE(time.defaultValue, QVariant(qulonglong(GST_SECOND)));
+    QCOMPARE(time.minimum, QVariant(qulonglong(0)));
+    QCOMPARE(time.maximum, QVariant(qulonglong(G_MAXUINT64)));
+
+    // no, upstream and downstream
+    const QGstCodecsInfo::CodecOption leaky
+            = QGstCodecsInfo::elementOption("queue", QLatin1String("leaky"));
+    QCOMPARE(leaky.defaultValue, QVariant(0));
+    QCOMPARE(leaky.minimum, QVariant(0));
+    QCOMPARE(leaky.maximum, QVariant(2));
+
+    QVERIFY(QGstCodecsInfo::elementOption("queue", QLatin1String("name")).name.isEmpty());
+}
+
+void tst_QGstCodecsInfo::identityOptions()
+{
+    const QStringList names = QGstCodecsInfo::elementOptionNames("identity");
+    QVERIFY(names.contains(QLatin1String("sleep-time")));
+    QVERIFY(names.contains(QLatin1String("error-after")));
+    QVERIFY(names.contains(QLatin1String("drop-probability")));
+
+    const QGstCodecsInfo::CodecOption sleepTime
+            = QGstCodecsInfo::elementOption("identity", QLatin1String("sleep-time"));
+    QCOMPARE(sleepTime.defaultValue, QVariant(0u));
+    QCOMPARE(sleepTime.minimum, QVariant(0u));
+    QCOMPARE(sleepTime.maximum, QVariant(uint(G_MAXUINT)));
+
+    const QGstCodecsInfo::CodecOption errorAfter
+            = QGstCodecsInfo::elementOption("identity", QLatin1String("error-after"));
+    QCOMPARE(errorAfter.defaultValue, QVariant(-1));
+    QCOMPARE(errorAfter.minimum, QVariant(-1));
+    QCOMPARE(errorAfter.maximum, QVariant(int(G_MAXINT)));
+
+    // Float properties are reported as double
+    const QGstCodecsInfo::CodecOption dropProbability
+            = QGstCodecsInfo::elementOption("identity", QLatin1String("drop-probability"));
+    QCOMPARE(dropProbability.defaultValue, QVariant(0.0));
+    QCOMPARE(dropProbability.minimum, QVariant(0.0));
+    QCOMPARE(dropProbability.maximum, QVariant(1.0));
+}
+
+void tst_QGstCodecsInfo::fakesrcOptions()
+{
+    // empty, fixed and random
+    const QGstCodecsInfo::CodecOption sizeType
+            = QGstCodecsInfo::elementOption("fakesrc", QLatin1String("sizetype"));
+    QCOMPARE(sizeType.defaultValue, QVariant(1));
+    QCOMPARE(sizeType.minimum, QVariant(1));
+    QCOMPARE(sizeType.maximum, QVariant(3));
+
+    // nothing, zero, random, pattern and pattern-span-buffers
+    const QGstCodecsInfo::CodecOption fillType
+            = QGstCodecsInfo::elementOption("fakesrc", QLatin1String("filltype"));
+    QCOMPARE(fillType.defaultValue, QVariant(2));
+    QCOMPARE(fillType.minimum, QVariant(1));
+    QCOMPARE(fillType.maximum, QVariant(5));
+
+    const QGstCodecsInfo::CodecOption sizeMax
+            = QGstCodecsInfo::elementOption("fakesrc", QLatin1String("sizemax"));
+    QCOMPARE(sizeMax.defaultValue, QVariant(4096));
+    QCOMPARE(sizeMax.minimum, QVariant(0));
+    QCOMPARE(sizeMax.maximum, QVariant(int(G_MAXINT)));
+
+    // Inherited from GstBaseSrc
+    const QGstCodecsInfo::CodecOption numBuffers
+            = QGstCodecsInfo::elementOption("fakesrc", QLatin1String("num-buffers"));
+    QCOMPARE(numBuffers.defaultValue, QVariant(-1));
+    QCOMPARE(numBuffers.minimum, QVariant(-1));
+    QCOMPARE(numBuffers.maximum, QVariant(int(G_MAXINT)));
+
+    const QGstCodecsInfo::CodecOption silent
+            = QGstCodecsInfo::elementOption("fakesrc", QLatin1String("silent"));
+    QCOMPARE(silent.defaultValue, QVariant(true));
+    QVERIFY(!silent.minimum.isValid());
+    QVERIFY(!silent.maximum.isValid());
+}
+
+void tst_QGstCodecsInfo::unknownElement()
+{
+    QVERIFY(QGstCodecsInfo::elementOptionNames("qt-no-such-element").isEmpty());
+    QVERIFY(QGstCodecsInfo::elementOptionNames(QByteArray()).isEmpty());
+
+    const QGstCodecsInfo::CodecOption option
+            = QGstCodecsInfo::elementOption("qt-no-such-element", QLatin1String("bitrate"));
+    QVERIFY(option.name.isEmpty());
+    QVERIFY(!option.defaultValue.isValid());
+
+    const QGstCodecsInfo info(QGstCodecsInfo::AudioEncoder);
+    QVERIFY(info.codecOptions(QLatin1String("audio/x-qt-unknown")).isEmpty());
+    QVERIFY(info.codecOption(QLatin1String("audio/x-qt-unknown"), QLatin1String("bitrate")).name.isEmpty());
+}
+
+void tst_QGstCodecsInfo::codecOptions()
+{
+    const QGstCodecsInfo info(QGstCodecsInfo::AudioEncoder);
+    const QString codec = QLatin1String("audio/x-vorbis");
+    if (info.codecElement(codec) != "vorbisenc")
+        QSKIP("vorbisenc is not available");
+
+    const QStringList names = info.codecOptions(codec);
+    QVERIFY(names.contains(QLatin1String("quality")));
+    QVERIFY(names.contains(QLatin1String("bitrate")));
+    QVERIFY(names.contains(QLatin1String("managed")));
+    QVERIFY(!names.contains(QLatin1String("name")));
+
+    const QGstCodecsInfo::CodecOption quality = info.codecOption(codec, QLatin1String("quality"));
+    QCOMPARE(quality.name, QLatin1String("quality"));
+    QCOMPARE(quality.defaultValue.toFloat(), 0.3f);
+    QCOMPARE(quality.minimum.toFloat(), -0.1f);
+    QCOMPARE(quality.maximum.toFloat(), 1.0f);
+
+    const QGstCodecsInfo::CodecOption bitrate = info.codecOption(codec, QLatin1String("bitrate"));
+    QCOMPARE(bitrate.defaultValue, QVariant(-1));
+    QCOMPARE(bitrate.minimum, QVariant(-1));
+    QCOMPARE(bitrate.maximum, QVariant(250001));
+
+    const QGstCodecsInfo::CodecOption managed = info.codecOption(codec, QLatin1String("managed"));
+    QCOMPARE(managed.defaultValue, QVariant(false));
+}
+
+QTEST_GUILESS_MAIN(tst_QGstCodecsInfo)
+
+#include "tst_qgstcodecsinfo.moc"
@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qbuffer.h>
+#include <QtGui/qcolor.h>
+#include <QtGui/qimage.h>
+
+#include <private/qgstutils_p.h>
+
+#include <gst/gst.h>
+
+QT_USE_NAMESPACE
+
+class tst_QGstUtils : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void tagImageEquality();
+    void tagImageDecode();
+    void tagListToMap();
+
+private:
+    static QByteArray encodedImage(Qt::GlobalColor color);
+    static GstSample *imageSample(const QByteArray &data);
+};
+
+QByteArray tst_QGstUtils::encodedImage(Qt::GlobalColor color)
+{
+    QImage image(8, 4, QImage::Format_RGB32);
+    image.fill(color);
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return data;
+}
+
+// Each sample gets its own buffer, as tags resent by a stream do
+GstSample *tst_QGstUtils::imageSample(const QByteArray &data)
+{
+    GstBuffer *buffer = gst_buffer_new_allocate(nullptr, data.size(), nullptr);
+    gst_buffer_fill(buffer, 0, data.constData(), data.size());
+
+    GstCaps *caps = gst_caps_new_empty_simple("image/png");
+    GstSample *sample = gst_sample_new(buffer, caps, nullptr, nullptr);
+    gst_caps_unref(caps);
+    gst_buffer_unref(buffer);
+    return sample;
+}
+
+void tst_QGstUtils::initTestCase()
+{
+#if !GST_CHECK_VERSION(1,0,0)
+    QSKIP("Image tags are kept encoded with GStreamer 1.0 only");
+#endif
+    gst_init(nullptr, nullptr);
+}
+
+void tst_QGstUtils::tagImageEquality()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    const QByteArray red = encodedImage(Qt::red);
+    const QByteArray blue = encodedImage(Qt::blue);
+    QCOMPARE(red.size(), blue.size());
+
+    GstSample *redSample = imageSample(red);
+    GstSample *otherRedSample = imageSample(red);
+    GstSample *blueSample = imageSample(blue);
+
+    const QGstTagImage image(redSample);
+    const QGstTagImage sameSample(redSample);
+    const QGstTagImage sameBytes(otherRedSample);
+    const QGstTagImage otherBytes(blueSample);
+
+    gst_sample_unref(redSample);
+    gst_sample_unref(otherRedSample);
+    gst_sample_unref(blueSample);
+
+    QVERIFY(image == image);
+    QVERIFY(image == sameSample);
+    QVERIFY(image == sameBytes);
+    QVERIFY(image != otherBytes);
+    QVERIFY(image != QGstTagImage());
+    QVERIFY(QGstTagImage() == QGstTagImage());
+
+    QVERIFY(!image.isNull());
+    QVERIFY(QGstTagImage().isNull());
+    QCOMPARE(image.mimeType(), QByteArray("image/png"));
+#endif
+}
+
+void tst_QGstUtils::tagImageDecode()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    GstSample *sample = imageSample(encodedImage(Qt::red));
+    const QGstTagImage tag(sample);
+    gst_sample_unref(sample);
+
+    const QImage image = tag.image();
+    QCOMPARE(image.size(), QSize(8, 4));
+    QCOMPARE(image.pixel(0, 0), QColor(Qt::red).rgb());
+
+    // Decoded once and shared by the copies
+    const QGstTagImage copy = tag;
+    QCOMPARE(copy.image().cacheKey(), image.cacheKey());
+
+    QVERIFY(QGstTagImage().image().isNull());
+#endif
+}
+
+void tst_QGstUtils::tagListToMap()
+{
+#if GST_CHECK_VERSION(1,0,0)
+    GstSample *sample = imageSample(encodedImage(Qt::green));
+    GstTagList *tags = gst_tag_list_new(GST_TAG_TITLE, "Title", GST_TAG_IMAGE, sample, nullptr);
+    GstSample *otherSample = imageSample(encodedImage(Qt::green));
+    GstTagList *otherTags = gst_tag_list_new(GST_TAG_IMAGE, otherSample, nullptr);
+    gst_sample_unref(sample);
+    gst_sample_unref(otherSample);
+
+    const QMap<QByteArray, QVariant> map = QGstUtils::gstTagListToMap(tags);
+    const QMap<QByteArray, QVariant> otherMap = QGstUtils::gstTagListToMap(otherTags);
+    gst_tag_list_unref(tags);
+    gst_tag_list_unref(otherTags);
+
+    QCOMPARE(map.value(GST_TAG_TITLE).toString(), QStringLiteral("Title"));
+
+    // Images stay encoded in the map and compare by their bytes
+    const QVariant image = map.value(GST_TAG_IMAGE);
+    QCOMPARE(image.userType(), qMetaTypeId<QGstTagImage>());
+    QVERIFY(image == otherMap.value(GST_TAG_IMAGE));
+
+    QVERIFY(image.canConvert<QImage>());
+    QCOMPARE(image.value<QImage>().pixel(0, 0), QColor(Qt::green).rgb());
+#endif
+}
+
+QTEST_GUILESS_MAIN(tst_QGstUtils)
+
+#include "tst_qgstutils.moc"
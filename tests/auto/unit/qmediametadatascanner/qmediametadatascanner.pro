@@ -0,0 +1,9 @@
+CONFIG += testcase
+TARGET = tst_qmediametadatascanner
+
+QT += multimedia-private testlib
+
+HEADERS += ../qmultimedia_common/mockmetadatascannercontrol.h
+SOURCES += tst_qmediametadatascanner.cpp
+
+include (../qmultimedia_common/mock.pri)
@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qmediametadatascanner.h>
+
+#include "mockmetadatascannercontrol.h"
+#include "mockmediaservice.h"
+#include "mockmediaserviceprovider.h"
+
+QT_USE_NAMESPACE
+
+class tst_QMediaMetaDataScanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void scan();
+    void failure();
+    void cancel();
+    void workerCount();
+    void nullService();
+
+private:
+    MockMetaDataScannerControl *mockControl = nullptr;
+    MockMediaService *mockService = nullptr;
+    MockMediaServiceProvider *mockProvider = nullptr;
+};
+
+void tst_QMediaMetaDataScanner::init()
+{
+    mockControl = new MockMetaDataScannerControl(this);
+    mockService = new MockMediaService(this, mockControl);
+    mockProvider = new MockMediaServiceProvider(mockService);
+
+    QMediaServiceProvider::setDefaultServiceProvider(mockProvider);
+}
+
+void tst_QMediaMetaDataScanner::cleanup()
+{
+    delete mockService;
+    delete mockControl;
+    delete mockProvider;
+}
+
+void tst_QMediaMetaDataScanner::scan()
+{
+    QMediaMetaDataScanner scanner;
+    QVERIFY(scanner.isAvailable());
+    QCOMPARE(scanner.pendingCount(), 0);
+
+    QSignalSpy scannedSpy(&scanner, SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+    QSignalSpy finishedSpy(&scanner, SIGNAL(finished()));
+
+    const QUrl first = QUrl::fromLocalFile(QStringLiteral("/music/first.ogg"));
+    const QUrl second = QUrl::fromLocalFile(QStringLiteral("/music/second.ogg"));
+
+    scanner.scan(first);
+    scanner.scan(QList<QUrl>() << second);
+    QCOMPARE(scanner.pendingCount(), 2);
+    QCOMPARE(mockControl->m_queue, QList<QUrl>() << first << second);
+
+    mockControl->processNext();
+    QCOMPARE(scannedSpy.count(), 1);
+    QCOMPARE(scannedSpy.last().value(0).toUrl(), first);
+    QCOMPARE(scannedSpy.last().value(1).toMap().value(QStringLiteral("Title")).toString(),
+             QStringLiteral("first.ogg"));
+    QCOMPARE(finishedSpy.count(), 0);
+    QCOMPARE(scanner.pendingCount(), 1);
+
+    mockControl->processNext();
+    QCOMPARE(scannedSpy.count(), 2);
+    QCOMPARE(scannedSpy.last().value(0).toUrl(), second);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(scanner.pendingCount(), 0);
+}
+
+void tst_QMediaMetaDataScanner::failure()
+{
+    QMediaMetaDataScanner scanner;
+
+    QSignalSpy scannedSpy(&scanner, SIGNAL(metaDataScanned(QUrl,QVariantMap)));
+    QSignalSpy errorSpy(&scanner, SIGNAL(error(QUrl,QString)));
+
+    const QUrl url(QStringLiteral("http://example.com/remote.ogg"));
+    scanner.scan(url);
+    mockControl->processNext();
+
+    QCOMPARE(scannedSpy.count(), 0);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.last().value(0).toUrl(), url);
+    QVERIFY(!errorSpy.last().value(1).toString().isEmpty());
+}
+
+void tst_QMediaMetaDataScanner::cancel()
+{
+    QMediaMetaDataScanner scanner;
+
+    scanner.scan(QList<QUrl>()
+                 << QUrl::fromLocalFile(QStringLiteral("/music/first.ogg"))
+                 << QUrl::fromLocalFile(QStringLiteral("/music/second.ogg")));
+    QCOMPARE(scanner.pendingCount(), 2);
+
+    scanner.cancel();
+    QCOMPARE(scanner.pendingCount(), 0);
+
+    // An empty batch is not forwarded
+    scanner.scan(QList<QUrl>());
+    QCOMPARE(scanner.pendingCount(), 0);
+}
+
+void tst_QMediaMetaDataScanner::workerCount()
+{
+    QMediaMetaDataScanner scanner;
+    QCOMPARE(scanner.maximumWorkerCount(), 4);
+
+    scanner.setMaximumWorkerCount(2);
+    QCOMPARE(scanner.maximumWorkerCount(), 2);
+    QCOMPARE(mockControl->m_workerCount, 2);
+
+    scanner.setMaximumWorkerCount(0);
+    QCOMPARE(scanner.maximumWorkerCount(), 1);
+}
+
+void tst_QMediaMetaDataScanner::nullService()
+{
+    mockProvider->service = nullptr;
+
+    QMediaMetaDataScanner scanner;
+    QVERIFY(!scanner.isAvailable());
+    QCOMPARE(scanner.pendingCount(), 0);
+    QCOMPARE(scanner.maximumWorkerCount(), 0);
+
+    QSignalSpy errorSpy(&scanner, SIGNAL(error(QUrl,QString)));
+    QSignalSpy finishedSpy(&scanner, SIGNAL(finished()));
+
+    const QUrl url = QUrl::fromLocalFile(QStringLiteral("/music/first.ogg"));
+    scanner.scan(url);
+    // Reported after returning, like the results of a backend
+    QCOMPARE(errorSpy.count(), 0);
+    QCOMPARE(finishedSpy.count(), 0);
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.last().value(0).toUrl(), url);
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaMetaDataScanner)
+
+#include "tst_qmediametadatascanner.moc"
@@ -134,6 +134,9 @@ private slots:
     void testQrc();
     void testAudioRole();
     void testCustomAudioRole();
+    void testStatistics();
+    void testStatisticsLatencies();
+    void testPreload();
 
 private:
     void setupCommonTestData();
@@ -1431,5 +1434,98 @@ void tst_QMediaPlayer::testCustomAudioRole()
     }
 }
 
+void tst_QMediaPlayer::testStatistics()
+{
+    QMediaPlayer player;
+    QVERIFY(player.statistics().isEmpty());
+
+    QVariantMap statistics;
+    statistics.insert(QStringLiteral("decodedFrames"), 120);
+    statistics.insert(QStringLiteral("droppedFrames"), 3);
+    mockService->mockStatisticsControl->m_statistics = statistics;
+
+    QCOMPARE(player.statistics(), statistics);
+
+    player.resetStatistics();
+    QCOMPARE(mockService->mockStatisticsControl->m_resetCount, 1);
+    QVERIFY(player.statistics().isEmpty());
+}
+
+void tst_QMediaPlayer::testPreload()
+{
+    const QMediaContent content1(QUrl("file:///some1.mp3"));
+    const QMediaContent content2(QUrl("file:///some2.mp3"));
+    const QMediaContent content3(QUrl("file:///some3.mp3"));
+
+    QList<QMediaContent> &preloaded = mockService->mockPreloadControl->m_preloaded;
+
+    player->preload(content2);
+    QCOMPARE(preloaded, QList<QMediaContent>() << content2);
+    preloaded.clear();
+
+    QMediaPlaylist playlist;
+    playlist.addMedia(content1);
+    playlist.addMedia(content2);
+    playlist.addMedia(content3);
+
+    // the item following the current one is prepared in the background
+    player->setPlaylist(&playlist);
+    QCOMPARE(player->currentMedia(), content1);
+    QCOMPARE(preloaded, QList<QMediaContent>() << content2);
+
+    playlist.next();
+    QCOMPARE(player->currentMedia(), content2);
+    QCOMPARE(preloaded, QList<QMediaContent>() << content2 << content3);
+
+    // nothing follows the last item
+    playlist.next();
+    QCOMPARE(player->currentMedia(), content3);
+    QCOMPARE(preloaded.count(), 2);
+
+    player->setPlaylist(nullptr);
+}
+
+void tst_QMediaPlayer::testStatisticsLatencies()
+{
+    QMediaPlayer player;
+
+    QMediaStatistics counters;
+    mockService->mockStatisticsControl->m_counters = &counters;
+
+    counters.increment(QMediaStatistics::RenderedFrames, 100);
+    counters.increment(QMediaStatistics::DroppedFrames, 2);
+    counters.increment(QMediaStatistics::AudioUnderruns);
+    for (int i = 0; i < 98; ++i)
+        counters.recordLatency(QMediaStatistics::PresentToRenderLatency, 800);
+    counters.recordLatency(QMediaStatistics::PresentToRenderLatency, 20000);
+    counters.recordLatency(QMediaStatistics::PresentToRenderLatency, 40000);
+
+    const QVariantMap statistics = player.statistics();
+    QCOMPARE(statistics.value(QStringLiteral("renderedFrames")).toInt(), 100);
+    QCOMPARE(statistics.value(QStringLiteral("droppedFrames")).toInt(), 2);
+    QCOMPARE(statistics.value(QStringLiteral("audioUnderruns")).toInt(), 1);
+    QVERIFY(!statistics.contains(QStringLiteral("seekLatency")));
+
+    const QVariantMap latency = statistics.value(QStringLiteral("presentToRenderLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("count")).toInt(), 100);
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), 40000);
+    QCOMPARE(latency.value(QStringLiteral("p50")).toInt(), 1000);
+    QCOMPARE(latency.value(QStringLiteral("p95")).toInt(), 1000);
+    QCOMPARE(latency.value(QStringLiteral("p99")).toInt(), 33000);
+
+    // 800 us falls in the bucket up to 1 ms, 20 and 40 ms in the ones up to 33 and 66 ms
+    const QVariantList buckets = latency.value(QStringLiteral("histogram")).toList();
+    QCOMPARE(buckets.count(), int(QMediaStatistics::BucketCount));
+    QCOMPARE(buckets.at(3).toInt(), 98);
+    QCOMPARE(buckets.at(8).toInt(), 1);
+    QCOMPARE(buckets.at(9).toInt(), 1);
+
+    player.resetStatistics();
+    QCOMPARE(player.statistics().value(QStringLiteral("renderedFrames")).toInt(), 0);
+    QVERIFY(!player.statistics().contains(QStringLiteral("presentToRenderLatency")));
+
+    mockService->mockStatisticsControl->m_counters = nullptr;
+}
+
 QTEST_GUILESS_MAIN(tst_QMediaPlayer)
 #include "tst_qmediaplayer.moc"
@@ -34,6 +34,7 @@
 #include <private/qmediaplaylistsourcecontrol_p.h>
 #include <private/qmediaplaylistnavigator_p.h>
 #include <private/qmediapluginloader_p.h>
+#include <private/qplaylistfileparser_p.h>
 
 #include "qm3uhandler.h"
 
@@ -58,6 +59,38 @@ public:
     MockPlaylistService *mockService;
 };
 
+// A sequential device that gets its data in pieces, like a pipe or a socket
+class SequentialStream : public QIODevice
+{
+public:
+    SequentialStream() { open(QIODevice::ReadOnly); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return m_data.size() + QIODevice::bytesAvailable(); }
+
+    void feed(const QByteArray &data)
+    {
+        m_data += data;
+        emit readyRead();
+    }
+
+    void finish() { emit readChannelFinished(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const qint64 size = qMin(maxSize, qint64(m_data.size()));
+        memcpy(data, m_data.constData(), size_t(size));
+        m_data.remove(0, int(size));
+        return size;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray m_data;
+};
+
 class tst_QMediaPlaylist : public QObject
 {
     Q_OBJECT
@@ -76,6 +109,10 @@ private slots:
     void saveAndLoad();
     void loadM3uFile();
     void loadPLSFile();
+    void loadLargeM3uFile();
+    void loadInvalidThenValidFile_data();
+    void loadInvalidThenValidFile();
+    void parseSequentialStream();
     void playbackMode();
     void playbackMode_data();
     void shuffle();
@@ -564,6 +601,121 @@ void tst_QMediaPlaylist::loadM3uFile()
     QVERIFY(loadFailedSpy.isEmpty());
 }
 
+void tst_QMediaPlaylist::loadLargeM3uFile()
+{
+    const int trackCount = 20000;
+
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/tst_qmediaplaylistXXXXXX.m3u"));
+    QVERIFY(file.open());
+    QByteArray data("#EXTM3U\n");
+    for (int i = 0; i < trackCount; ++i) {
+        data += "#EXTINF:123,Artist - Title " + QByteArray::number(i) + "\n";
+        data += "http://test.host/track" + QByteArray::number(i) + ".mp3\n";
+    }
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+
+    QMediaPlaylist playlist;
+    QSignalSpy loadSpy(&playlist, SIGNAL(loaded()));
+    QSignalSpy loadFailedSpy(&playlist, SIGNAL(loadFailed()));
+    QSignalSpy insertedSpy(&playlist, SIGNAL(mediaInserted(int,int)));
+
+    playlist.load(QUrl::fromLocalFile(file.fileName()));
+
+    // Large files are parsed in slices from the event loop
+    QVERIFY(loadSpy.isEmpty());
+    QVERIFY(playlist.mediaCount() < trackCount);
+
+    QTRY_COMPARE(loadSpy.count(), 1);
+    QVERIFY(loadFailedSpy.isEmpty());
+    QCOMPARE(playlist.mediaCount(), trackCount);
+    QCOMPARE(playlist.media(0).request().url(), QUrl(QLatin1String("http://test.host/track0.mp3")));
+    QCOMPARE(playlist.media(trackCount - 1).request().url(),
+             QUrl(QLatin1String("http://test.host/track19999.mp3")));
+
+    // Entries are inserted in batches, not one by one
+    QVERIFY(insertedSpy.count() > 0);
+    QVERIFY(insertedSpy.count() < 100);
+    int expectedStart = 0;
+    for (const QList<QVariant> &args : qAsConst(insertedSpy)) {
+        QCOMPARE(args.at(0).toInt(), expectedStart);
+        expectedStart = args.at(1).toInt() + 1;
+    }
+    QCOMPARE(expectedStart, trackCount);
+}
+
+void tst_QMediaPlaylist::loadInvalidThenValidFile_data()
+{
+    QTest::addColumn<QString>("suffix");
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("unknown type") << QString::fromLatin1("txt")
+                                  << QByteArray("not a playlist\nhttp://test.host/path\n");
+    QTest::newRow("line too long") << QString::fromLatin1("m3u")
+                                   << QByteArray("#EXTM3U\n") + QByteArray(8192, 'a');
+}
+
+void tst_QMediaPlaylist::loadInvalidThenValidFile()
+{
+    QFETCH(QString, suffix);
+    QFETCH(QByteArray, data);
+
+    QTemporaryFile file(QDir::tempPath() + QLatin1String("/tst_qmediaplaylistXXXXXX.") + suffix);
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+
+    QMediaPlaylist playlist;
+    QSignalSpy loadSpy(&playlist, SIGNAL(loaded()));
+    QSignalSpy loadFailedSpy(&playlist, SIGNAL(loadFailed()));
+
+    playlist.load(QUrl::fromLocalFile(file.fileName()));
+    QTRY_COMPARE(loadFailedSpy.count(), 1);
+    QVERIFY(loadSpy.isEmpty());
+    QCOMPARE(playlist.error(), QMediaPlaylist::FormatError);
+
+    // The aborted load must not keep the parser busy
+    loadFailedSpy.clear();
+    playlist.load(QUrl::fromLocalFile(QFINDTESTDATA("testdata/test.m3u")));
+    QTRY_COMPARE(loadSpy.count(), 1);
+    QVERIFY(loadFailedSpy.isEmpty());
+    QCOMPARE(playlist.error(), QMediaPlaylist::NoError);
+    QCOMPARE(playlist.mediaCount(), 7);
+}
+
+void tst_QMediaPlaylist::parseSequentialStream()
+{
+    QPlaylistFileParser parser;
+    QSignalSpy itemsSpy(&parser, SIGNAL(newItems(QVariantList)));
+    QSignalSpy finishedSpy(&parser, SIGNAL(finished()));
+    QSignalSpy errorSpy(&parser, SIGNAL(error(QPlaylistFileParser::ParserError,QString)));
+
+    // Nothing has arrived yet, which is not the end of the playlist
+    SequentialStream stream;
+    parser.start(QMediaContent(), &stream, QLatin1String("audio/x-mpegurl"));
+    QVERIFY(finishedSpy.isEmpty());
+    QVERIFY(errorSpy.isEmpty());
+
+    stream.feed("#EXTM3U\nhttp://test.host/track1.mp3\nhttp://test.host/tr");
+    QCOMPARE(itemsSpy.count(), 1);
+    QCOMPARE(itemsSpy.at(0).at(0).toList().count(), 1);
+    QVERIFY(finishedSpy.isEmpty());
+
+    stream.feed("ack2.mp3\nhttp://test.host/track3.mp3");
+    QCOMPARE(itemsSpy.count(), 2);
+    QCOMPARE(itemsSpy.at(1).at(0).toList().first().toMap().value(QLatin1String("url")).toUrl(),
+             QUrl(QLatin1String("http://test.host/track2.mp3")));
+    QVERIFY(finishedSpy.isEmpty());
+
+    // The last line is complete once the stream is finished
+    stream.finish();
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(itemsSpy.count(), 3);
+    QCOMPARE(itemsSpy.at(2).at(0).toList().first().toMap().value(QLatin1String("url")).toUrl(),
+             QUrl(QLatin1String("http://test.host/track3.mp3")));
+    QVERIFY(errorSpy.isEmpty());
+}
+
 void tst_QMediaPlaylist::loadPLSFile()
 {
     QMediaPlaylist playlist;
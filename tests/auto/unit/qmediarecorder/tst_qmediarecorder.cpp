@@ -62,6 +62,8 @@ private slots:
     void testDeleteMediaObject();
     void testError();
     void testSink();
+    void testSegments();
+    void testStatistics();
     void testRecord();
     void testMute();
     void testVolume();
@@ -96,6 +98,7 @@ private slots:
 
     void testVideoSettingsQuality();
     void testVideoSettingsEncodingMode();
+    void testVideoSettingsEncodingProfile();
     void testVideoSettingsCopyConstructor();
     void testVideoSettingsOperatorAssignment();
     void testVideoSettingsOperatorNotEqual();
@@ -293,6 +296,53 @@ void tst_QMediaRecorder::testSink()
     QCOMPARE(capture->actualLocation(), QUrl::fromLocalFile("default_name.mp4"));
 }
 
+void tst_QMediaRecorder::testSegments()
+{
+    QCOMPARE(capture->maxSegmentDuration(), qint64(0));
+    QCOMPARE(capture->maxSegmentSize(), qint64(0));
+
+    capture->setMaxSegmentDuration(60000);
+    capture->setMaxSegmentSize(-1);
+    QCOMPARE(capture->maxSegmentDuration(), qint64(60000));
+    QCOMPARE(capture->maxSegmentSize(), qint64(0));
+    QCOMPARE(service->mockSegmentControl->maxSegmentDuration(), qint64(60000));
+    QCOMPARE(service->mockSegmentControl->maxSegmentSize(), qint64(0));
+
+    capture->setMaxSegmentSize(1024 * 1024);
+    QCOMPARE(service->mockSegmentControl->maxSegmentSize(), qint64(1024 * 1024));
+
+    QSignalSpy segmentSignal(capture, SIGNAL(segmentFinalized(QUrl,qint64,qint64)));
+    service->mockSegmentControl->finalizeSegment(QUrl::fromLocalFile("test_00000.mp4"), 0, 60000);
+    QCOMPARE(segmentSignal.count(), 1);
+    QCOMPARE(segmentSignal.at(0).at(0).toUrl(), QUrl::fromLocalFile("test_00000.mp4"));
+    QCOMPARE(segmentSignal.at(0).at(1).toLongLong(), qint64(0));
+    QCOMPARE(segmentSignal.at(0).at(2).toLongLong(), qint64(60000));
+
+    capture->setMaxSegmentDuration(0);
+    capture->setMaxSegmentSize(0);
+}
+
+void tst_QMediaRecorder::testStatistics()
+{
+    QVERIFY(capture->statistics().isEmpty());
+
+    QVariantMap statistics;
+    statistics.insert(QStringLiteral("encodedFrames"), 250);
+    service->mockStatisticsControl->m_statistics = statistics;
+    QCOMPARE(capture->statistics(), statistics);
+
+    capture->resetStatistics();
+    QCOMPARE(service->mockStatisticsControl->m_resetCount, 1);
+    QVERIFY(capture->statistics().isEmpty());
+
+    MockMediaRecorderService recorderService(0, 0);
+    recorderService.hasControls = false;
+    MockMediaObject object(0, &recorderService);
+    QMediaRecorder recorder(&object);
+    QVERIFY(recorder.statistics().isEmpty());
+    recorder.resetStatistics();
+}
+
 void tst_QMediaRecorder::testRecord()
 {
     QSignalSpy stateSignal(capture,SIGNAL(stateChanged(QMediaRecorder::State)));
@@ -1275,6 +1325,26 @@ void tst_QMediaRecorder::testVideoSettingsEncodingMode()
     QCOMPARE(settings.encodingMode(), QMultimedia::TwoPassEncoding);
 }
 
+void tst_QMediaRecorder::testVideoSettingsEncodingProfile()
+{
+    QVideoEncoderSettings settings;
+    QCOMPARE(settings.encodingProfile(), QMultimedia::DefaultEncodingProfile);
+    QVERIFY(settings.isNull());
+
+    settings.setEncodingProfile(QMultimedia::LowLatencyEncodingProfile);
+    QCOMPARE(settings.encodingProfile(), QMultimedia::LowLatencyEncodingProfile);
+    QVERIFY(!settings.isNull());
+
+    QVideoEncoderSettings other = settings;
+    QCOMPARE(other.encodingProfile(), QMultimedia::LowLatencyEncodingProfile);
+    QVERIFY(other == settings);
+
+    other.setEncodingProfile(QMultimedia::ArchiveEncodingProfile);
+    QCOMPARE(other.encodingProfile(), QMultimedia::ArchiveEncodingProfile);
+    QCOMPARE(settings.encodingProfile(), QMultimedia::LowLatencyEncodingProfile);
+    QVERIFY(other != settings);
+}
+
 /* Test QVideoEncoderSettings copy constructor */
 void tst_QMediaRecorder::testVideoSettingsCopyConstructor()
 {
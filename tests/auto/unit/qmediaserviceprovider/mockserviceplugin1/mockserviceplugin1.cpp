@@ -40,7 +40,8 @@ public:
     QStringList keys() const
     {
         return QStringList() <<
-                QLatin1String(Q_MEDIASERVICE_MEDIAPLAYER);
+                QLatin1String(Q_MEDIASERVICE_MEDIAPLAYER) <<
+                QLatin1String(Q_MEDIASERVICE_AUDIODECODER);
     }
 
     QMediaService* create(QString const& key)
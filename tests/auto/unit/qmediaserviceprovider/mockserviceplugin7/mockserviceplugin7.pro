@@ -0,0 +1,22 @@
+QT += multimedia-private
+
+HEADERS += ../mockservice.h
+SOURCES += mockserviceplugin7.cpp
+OTHER_FILES += mockserviceplugin7.json
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
+
+PLUGIN_TYPE = mediaservice
+PLUGIN_CLASS_NAME = MockServicePlugin7
+load(qt_plugin)
+
+DESTDIR = ../$${PLUGIN_TYPE}
+win32:debug_and_release {
+    CONFIG(debug, debug|release) {
+        DESTDIR = ../debug/$${PLUGIN_TYPE}
+    } else {
+        DESTDIR = ../release/$${PLUGIN_TYPE}
+    }
+}
+
+target.path = $$[QT_INSTALL_TESTS]/tst_qmediaserviceprovider/$${PLUGIN_TYPE}
@@ -7,6 +7,8 @@ SUBDIRS += \
     mockserviceplugin3 \
     mockserviceplugin4 \
     mockserviceplugin5 \
+    mockserviceplugin6 \
+    mockserviceplugin7 \
     test
 
 # no special install rule for subdir
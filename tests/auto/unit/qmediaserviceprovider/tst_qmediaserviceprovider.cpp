@@ -32,6 +32,8 @@
 #include <QDebug>
 #include <QStringList>
 
+#include <algorithm>
+
 #include <private/qmediaserviceprovider_p.h>
 #include <qmediaserviceproviderplugin.h>
 #include <private/qmediapluginloader_p.h>
@@ -75,11 +77,22 @@ private slots:
     void testDefaultDevice();
     void testAvailableDevices();
     void testCameraInfo();
+    void testMetaDataQueries();
+    void testMetaDataSelection();
+    void testMetaDataWithoutKeys();
 
 private:
+    static QStringList instantiatedPlugins();
+
     QObjectList plugins;
 };
 
+// MockServicePlugin6 and 7 record when they are instantiated
+QStringList tst_QMediaServiceProvider::instantiatedPlugins()
+{
+    return QCoreApplication::instance()->property("mockPluginInstances").toStringList();
+}
+
 void tst_QMediaServiceProvider::initTestCase()
 {
 //    QMediaPluginLoader::setStaticPlugins(QLatin1String("mediaservice"), plugins);
@@ -376,6 +389,116 @@ void tst_QMediaServiceProvider::testCameraInfo()
     }
 }
 
+void tst_QMediaServiceProvider::testMetaDataQueries()
+{
+    QMediaServiceProvider *provider = QMediaServiceProvider::defaultServiceProvider();
+
+    if (provider == 0)
+        QSKIP("No default provider");
+
+    // Answered from the "Devices" and "MimeTypes" metadata of MockServicePlugin6
+    // and 7, without loading them
+    QList<QByteArray> devices = provider->devices(Q_MEDIASERVICE_AUDIODECODER);
+    std::sort(devices.begin(), devices.end());
+    QCOMPARE(devices, QList<QByteArray>() << "decoder6" << "decoder6b" << "decoder7");
+
+    QCOMPARE(provider->hasSupport(QByteArray(Q_MEDIASERVICE_AUDIODECODER), "audio/x-seven", QStringList()),
+             QMultimedia::ProbablySupported);
+    QCOMPARE(provider->hasSupport(QByteArray(Q_MEDIASERVICE_AUDIODECODER), "audio/x-six", QStringList()),
+             QMultimedia::ProbablySupported);
+
+    const QStringList mimeTypes = provider->supportedMimeTypes(QByteArray(Q_MEDIASERVICE_AUDIODECODER));
+    QVERIFY(mimeTypes.contains("audio/x-six"));
+    QVERIFY(mimeTypes.contains("audio/x-seven"));
+
+    // LowLatency skips MockServicePlugin6, which only declares StreamPlayback
+    const QStringList lowLatencyTypes = provider->supportedMimeTypes(QByteArray(Q_MEDIASERVICE_AUDIODECODER),
+                                                                     QMediaPlayer::LowLatency);
+    QVERIFY(!lowLatencyTypes.contains("audio/x-six"));
+    QVERIFY(lowLatencyTypes.contains("audio/x-seven"));
+
+    QCOMPARE(instantiatedPlugins(), QStringList());
+}
+
+void tst_QMediaServiceProvider::testMetaDataSelection()
+{
+    QMediaServiceProvider *provider = QMediaServiceProvider::defaultServiceProvider();
+
+    if (provider == 0)
+        QSKIP("No default provider");
+
+    // Only the plugin declaring the MIME type is loaded
+    QMediaService *service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                                      QMediaServiceProviderHint("audio/x-seven", QStringList()));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin7"));
+    provider->releaseService(service);
+    QCOMPARE(instantiatedPlugins(), QStringList() << "MockServicePlugin7");
+
+    service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                       QMediaServiceProviderHint(QByteArray("decoder7")));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin7"));
+    provider->releaseService(service);
+
+    service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                       QMediaServiceProviderHint(QMediaServiceProviderHint::LowLatencyPlayback));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin7"));
+    provider->releaseService(service);
+    QCOMPARE(instantiatedPlugins(), QStringList() << "MockServicePlugin7");
+
+    // The declared device selects MockServicePlugin6, which is loaded only now
+    service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                       QMediaServiceProviderHint(QByteArray("decoder6b")));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin6"));
+    provider->releaseService(service);
+    QCOMPARE(instantiatedPlugins(), QStringList() << "MockServicePlugin7" << "MockServicePlugin6");
+
+    service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                       QMediaServiceProviderHint(QMediaServiceProviderHint::StreamPlayback));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin6"));
+    provider->releaseService(service);
+
+    // Plugins are loaded only once
+    QCOMPARE(instantiatedPlugins(), QStringList() << "MockServicePlugin7" << "MockServicePlugin6");
+}
+
+void tst_QMediaServiceProvider::testMetaDataWithoutKeys()
+{
+    QMediaServiceProvider *provider = QMediaServiceProvider::defaultServiceProvider();
+
+    if (provider == 0)
+        QSKIP("No default provider");
+
+    // MockServicePlugin1 declares none of the keys, it is asked through its interfaces
+    QVERIFY(provider->supportedMimeTypes(QByteArray(Q_MEDIASERVICE_AUDIODECODER)).contains("audio/ogg"));
+    QCOMPARE(provider->hasSupport(QByteArray(Q_MEDIASERVICE_AUDIODECODER), "audio/ogg", QStringList()),
+             QMultimedia::ProbablySupported);
+
+    // Not supported by the plugins declaring their MIME types, maybe by MockServicePlugin1
+    QCOMPARE(provider->hasSupport(QByteArray(Q_MEDIASERVICE_AUDIODECODER), "audio/x-unknown", QStringList()),
+             QMultimedia::MaybeSupported);
+    QCOMPARE(provider->hasSupport(QByteArray(Q_MEDIASERVICE_AUDIODECODER), "audio/x-unknown",
+                                  QStringList() << "mpeg4"),
+             QMultimedia::NotSupported);
+
+    QMediaService *service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                                      QMediaServiceProviderHint("audio/ogg", QStringList()));
+    QVERIFY(service);
+    QCOMPARE(service->objectName(), QLatin1String("MockServicePlugin1"));
+    provider->releaseService(service);
+
+    // Without a matching device or features, the first plugin able to
+    // create the service is used, as before
+    service = provider->requestService(Q_MEDIASERVICE_AUDIODECODER,
+                                       QMediaServiceProviderHint(QByteArray("no such device")));
+    QVERIFY(service);
+    provider->releaseService(service);
+}
+
 QTEST_MAIN(tst_QMediaServiceProvider)
 
 #include "tst_qmediaserviceprovider.moc"
@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qmediastatistics
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_qmediastatistics.cpp
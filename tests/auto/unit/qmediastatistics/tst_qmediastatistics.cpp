@@ -0,0 +1,262 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//TESTED_COMPONENT=src/multimedia
+
+#include <QtTest/QtTest>
+#include <QtCore/qthread.h>
+
+#include <private/qmediastatistics_p.h>
+
+#include <limits>
+
+class tst_QMediaStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void counters();
+    void bucketBounds();
+    void buckets_data();
+    void buckets();
+    void percentiles();
+    void percentilesBelowBucketBound();
+    void emptyHistogram();
+    void reset();
+    void concurrentUpdates();
+};
+
+static QVariantList histogram(const QMediaStatistics &statistics, const QString &latency)
+{
+    return statistics.toMap().value(latency).toMap().value(QStringLiteral("histogram")).toList();
+}
+
+void tst_QMediaStatistics::counters()
+{
+    QMediaStatistics statistics;
+    QCOMPARE(statistics.counter(QMediaStatistics::DecodedFrames), 0);
+    QCOMPARE(statistics.bufferFill(), -1);
+
+    statistics.increment(QMediaStatistics::DecodedFrames);
+    statistics.increment(QMediaStatistics::DecodedFrames, 4);
+    statistics.increment(QMediaStatistics::AudioUnderruns);
+    statistics.setBufferFill(42);
+
+    QCOMPARE(statistics.counter(QMediaStatistics::DecodedFrames), 5);
+    QCOMPARE(statistics.counter(QMediaStatistics::AudioUnderruns), 1);
+    QCOMPARE(statistics.counter(QMediaStatistics::DroppedFrames), 0);
+
+    const QVariantMap map = statistics.toMap();
+    QCOMPARE(map.value(QStringLiteral("decodedFrames")).toInt(), 5);
+    QCOMPARE(map.value(QStringLiteral("audioUnderruns")).toInt(), 1);
+    QCOMPARE(map.value(QStringLiteral("droppedFrames")).toInt(), 0);
+    QCOMPARE(map.value(QStringLiteral("bufferFill")).toInt(), 42);
+    QVERIFY(!map.contains(QStringLiteral("sinkToPresentLatency")));
+}
+
+void tst_QMediaStatistics::bucketBounds()
+{
+    for (int i = 1; i < QMediaStatistics::BucketCount; ++i)
+        QVERIFY(QMediaStatistics::bucketUpperBound(i) > QMediaStatistics::bucketUpperBound(i - 1));
+    QCOMPARE(QMediaStatistics::bucketUpperBound(QMediaStatistics::BucketCount - 1),
+             std::numeric_limits<int>::max());
+
+    QMediaStatistics statistics;
+    statistics.recordLatency(QMediaStatistics::SeekLatency, 1);
+    const QVariantList bounds = statistics.toMap().value(QStringLiteral("seekLatency")).toMap()
+            .value(QStringLiteral("bucketBounds")).toList();
+    QCOMPARE(bounds.count(), QMediaStatistics::BucketCount - 1);
+    for (int i = 0; i < bounds.count(); ++i)
+        QCOMPARE(bounds.at(i).toInt(), QMediaStatistics::bucketUpperBound(i));
+}
+
+void tst_QMediaStatistics::buckets_data()
+{
+    QTest::addColumn<qint64>("usecs");
+    QTest::addColumn<int>("bucket");
+    QTest::addColumn<int>("max");
+
+    QTest::newRow("negative") << qint64(-5) << 0 << 0;
+    QTest::newRow("zero") << qint64(0) << 0 << 0;
+    QTest::newRow("first bound") << qint64(100) << 0 << 100;
+    QTest::newRow("above first bound") << qint64(101) << 1 << 101;
+    QTest::newRow("frame at 30 fps") << qint64(33000) << 8 << 33000;
+    QTest::newRow("last bound") << qint64(500000) << 12 << 500000;
+    QTest::newRow("open ended") << qint64(500001) << 13 << 500001;
+    QTest::newRow("beyond int") << (qint64(1) << 40) << 13 << std::numeric_limits<int>::max();
+}
+
+void tst_QMediaStatistics::buckets()
+{
+    QFETCH(qint64, usecs);
+    QFETCH(int, bucket);
+    QFETCH(int, max);
+
+    QMediaStatistics statistics;
+    statistics.recordLatency(QMediaStatistics::PresentToRenderLatency, usecs);
+    QCOMPARE(statistics.latencyCount(QMediaStatistics::PresentToRenderLatency), 1);
+    QCOMPARE(statistics.latencyCount(QMediaStatistics::SeekLatency), 0);
+
+    const QVariantMap latency = statistics.toMap().value(QStringLiteral("presentToRenderLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("count")).toInt(), 1);
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), max);
+
+    const QVariantList buckets = latency.value(QStringLiteral("histogram")).toList();
+    QCOMPARE(buckets.count(), int(QMediaStatistics::BucketCount));
+    for (int i = 0; i < buckets.count(); ++i)
+        QCOMPARE(buckets.at(i).toInt(), i == bucket ? 1 : 0);
+}
+
+void tst_QMediaStatistics::percentiles()
+{
+    QMediaStatistics statistics;
+    for (int i = 0; i < 90; ++i)
+        statistics.recordLatency(QMediaStatistics::SinkToPresentLatency, 50);
+    for (int i = 0; i < 5; ++i)
+        statistics.recordLatency(QMediaStatistics::SinkToPresentLatency, 300);
+    for (int i = 0; i < 4; ++i)
+        statistics.recordLatency(QMediaStatistics::SinkToPresentLatency, 3000);
+    statistics.recordLatency(QMediaStatistics::SinkToPresentLatency, 600000);
+
+    const QVariantMap latency = statistics.toMap().value(QStringLiteral("sinkToPresentLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("count")).toInt(), 100);
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), 600000);
+
+    // Each percentile is the upper bound of the bucket it falls in
+    QCOMPARE(latency.value(QStringLiteral("p50")).toInt(), 100);
+    QCOMPARE(latency.value(QStringLiteral("p95")).toInt(), 500);
+    QCOMPARE(latency.value(QStringLiteral("p99")).toInt(), 4000);
+
+    QVariantList expected;
+    for (int i = 0; i < QMediaStatistics::BucketCount; ++i)
+        expected.append(0);
+    expected[0] = 90;
+    expected[2] = 5;
+    expected[5] = 4;
+    expected[13] = 1;
+    QCOMPARE(histogram(statistics, QStringLiteral("sinkToPresentLatency")), expected);
+
+    // One more slow sample moves p99 into the open ended bucket, bounded by max
+    statistics.recordLatency(QMediaStatistics::SinkToPresentLatency, 700000);
+    const QVariantMap updated = statistics.toMap().value(QStringLiteral("sinkToPresentLatency")).toMap();
+    QCOMPARE(updated.value(QStringLiteral("count")).toInt(), 101);
+    QCOMPARE(updated.value(QStringLiteral("p99")).toInt(), 700000);
+    QCOMPARE(updated.value(QStringLiteral("max")).toInt(), 700000);
+}
+
+void tst_QMediaStatistics::percentilesBelowBucketBound()
+{
+    // No percentile is reported above the largest sample
+    QMediaStatistics statistics;
+    for (int i = 0; i < 10; ++i)
+        statistics.recordLatency(QMediaStatistics::SeekLatency, 120 + i);
+
+    const QVariantMap latency = statistics.toMap().value(QStringLiteral("seekLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), 129);
+    QCOMPARE(latency.value(QStringLiteral("p50")).toInt(), 129);
+    QCOMPARE(latency.value(QStringLiteral("p99")).toInt(), 129);
+}
+
+void tst_QMediaStatistics::emptyHistogram()
+{
+    QMediaStatistics statistics;
+    const QVariantMap map = statistics.toMap();
+    QVERIFY(!map.contains(QStringLiteral("sinkToPresentLatency")));
+    QVERIFY(!map.contains(QStringLiteral("presentToRenderLatency")));
+    QVERIFY(!map.contains(QStringLiteral("seekLatency")));
+    QVERIFY(!map.contains(QStringLiteral("bufferFill")));
+}
+
+void tst_QMediaStatistics::reset()
+{
+    QMediaStatistics statistics;
+    statistics.increment(QMediaStatistics::Seeks, 3);
+    statistics.setBufferFill(80);
+    statistics.recordLatency(QMediaStatistics::SeekLatency, 20000);
+
+    statistics.reset();
+    QCOMPARE(statistics.counter(QMediaStatistics::Seeks), 0);
+    QCOMPARE(statistics.bufferFill(), -1);
+    QCOMPARE(statistics.latencyCount(QMediaStatistics::SeekLatency), 0);
+    QVERIFY(!statistics.toMap().contains(QStringLiteral("seekLatency")));
+
+    // The maximum starts over too
+    statistics.recordLatency(QMediaStatistics::SeekLatency, 10);
+    const QVariantMap latency = statistics.toMap().value(QStringLiteral("seekLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), 10);
+    QCOMPARE(latency.value(QStringLiteral("p50")).toInt(), 10);
+}
+
+class StatisticsFeeder : public QThread
+{
+public:
+    StatisticsFeeder(QMediaStatistics *statistics, int base)
+        : m_statistics(statistics), m_base(base) { }
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < 1000; ++i) {
+            m_statistics->increment(QMediaStatistics::RenderedFrames);
+            m_statistics->recordLatency(QMediaStatistics::PresentToRenderLatency, m_base + i);
+        }
+    }
+
+private:
+    QMediaStatistics *m_statistics;
+    int m_base;
+};
+
+void tst_QMediaStatistics::concurrentUpdates()
+{
+    // Streaming and render threads update without locking, nothing is lost
+    QMediaStatistics statistics;
+    QList<StatisticsFeeder *> feeders;
+    for (int i = 0; i < 4; ++i)
+        feeders.append(new StatisticsFeeder(&statistics, i * 1000));
+    for (StatisticsFeeder *feeder : qAsConst(feeders))
+        feeder->start();
+    for (StatisticsFeeder *feeder : qAsConst(feeders))
+        QVERIFY(feeder->wait(10000));
+    qDeleteAll(feeders);
+
+    QCOMPARE(statistics.counter(QMediaStatistics::RenderedFrames), 4000);
+    QCOMPARE(statistics.latencyCount(QMediaStatistics::PresentToRenderLatency), 4000);
+
+    const QVariantMap latency = statistics.toMap().value(QStringLiteral("presentToRenderLatency")).toMap();
+    QCOMPARE(latency.value(QStringLiteral("max")).toInt(), 3999);
+
+    int total = 0;
+    for (const QVariant &bucket : histogram(statistics, QStringLiteral("presentToRenderLatency")))
+        total += bucket.toInt();
+    QCOMPARE(total, 4000);
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaStatistics)
+
+#include "tst_qmediastatistics.moc"
@@ -0,0 +1,9 @@
+CONFIG += testcase
+TARGET = tst_qmediathumbnailer
+
+QT += multimedia-private testlib
+
+HEADERS += ../qmultimedia_common/mockmediathumbnailercontrol.h
+SOURCES += tst_qmediathumbnailer.cpp
+
+include (../qmultimedia_common/mock.pri)
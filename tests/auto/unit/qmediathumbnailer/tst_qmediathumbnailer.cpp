@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qmediathumbnailer.h>
+
+#include "mockmediathumbnailercontrol.h"
+#include "mockmediaservice.h"
+#include "mockmediaserviceprovider.h"
+
+QT_USE_NAMESPACE
+
+class tst_QMediaThumbnailer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void request();
+    void failure();
+    void cancel();
+    void workerCount();
+    void nullService();
+
+private:
+    MockMediaThumbnailerControl *mockControl = nullptr;
+    MockMediaService *mockService = nullptr;
+    MockMediaServiceProvider *mockProvider = nullptr;
+};
+
+void tst_QMediaThumbnailer::init()
+{
+    mockControl = new MockMediaThumbnailerControl(this);
+    mockService = new MockMediaService(this, mockControl);
+    mockProvider = new MockMediaServiceProvider(mockService);
+
+    QMediaServiceProvider::setDefaultServiceProvider(mockProvider);
+}
+
+void tst_QMediaThumbnailer::cleanup()
+{
+    delete mockService;
+    delete mockControl;
+    delete mockProvider;
+}
+
+void tst_QMediaThumbnailer::request()
+{
+    QMediaThumbnailer thumbnailer;
+    QVERIFY(thumbnailer.isAvailable());
+    QCOMPARE(thumbnailer.pendingCount(), 0);
+
+    QSignalSpy readySpy(&thumbnailer, SIGNAL(thumbnailReady(int,QImage)));
+    QSignalSpy finishedSpy(&thumbnailer, SIGNAL(finished()));
+
+    const QUrl url = QUrl::fromLocalFile(QStringLiteral("/videos/clip.mp4"));
+    const int first = thumbnailer.requestThumbnail(url, 1000, QSize(160, 90));
+    const int second = thumbnailer.requestThumbnail(url, -50, QSize(320, 180));
+    QVERIFY(first != second);
+    QCOMPARE(thumbnailer.pendingCount(), 2);
+
+    const auto &requests = mockControl->m_requests;
+    QCOMPARE(requests.at(0).id, first);
+    QCOMPARE(requests.at(0).url, url);
+    QCOMPARE(requests.at(0).position, qint64(1000));
+    QCOMPARE(requests.at(0).size, QSize(160, 90));
+    // Negative positions are clamped to the start
+    QCOMPARE(requests.at(1).position, qint64(0));
+
+    mockControl->processNext();
+    QCOMPARE(readySpy.count(), 1);
+    QCOMPARE(readySpy.last().value(0).toInt(), first);
+    QCOMPARE(readySpy.last().value(1).value<QImage>().size(), QSize(160, 90));
+    QCOMPARE(finishedSpy.count(), 0);
+
+    mockControl->processNext();
+    QCOMPARE(readySpy.count(), 2);
+    QCOMPARE(readySpy.last().value(0).toInt(), second);
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(thumbnailer.pendingCount(), 0);
+}
+
+void tst_QMediaThumbnailer::failure()
+{
+    QMediaThumbnailer thumbnailer;
+
+    QSignalSpy readySpy(&thumbnailer, SIGNAL(thumbnailReady(int,QImage)));
+    QSignalSpy errorSpy(&thumbnailer, SIGNAL(error(int,QString)));
+
+    const int id = thumbnailer.requestThumbnail(QUrl::fromLocalFile(QStringLiteral("/videos/clip.mp4")), 0);
+    mockControl->processNext();
+
+    QCOMPARE(readySpy.count(), 0);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.last().value(0).toInt(), id);
+    QVERIFY(!errorSpy.last().value(1).toString().isEmpty());
+}
+
+void tst_QMediaThumbnailer::cancel()
+{
+    QMediaThumbnailer thumbnailer;
+
+    const QUrl url = QUrl::fromLocalFile(QStringLiteral("/videos/clip.mp4"));
+    thumbnailer.requestThumbnail(url, 0, QSize(160, 90));
+    thumbnailer.requestThumbnail(url, 5000, QSize(160, 90));
+    QCOMPARE(thumbnailer.pendingCount(), 2);
+
+    thumbnailer.cancel();
+    QCOMPARE(thumbnailer.pendingCount(), 0);
+}
+
+void tst_QMediaThumbnailer::workerCount()
+{
+    QMediaThumbnailer thumbnailer;
+    QCOMPARE(thumbnailer.maximumWorkerCount(), 4);
+
+    thumbnailer.setMaximumWorkerCount(2);
+    QCOMPARE(thumbnailer.maximumWorkerCount(), 2);
+    QCOMPARE(mockControl->m_workerCount, 2);
+
+    thumbnailer.setMaximumWorkerCount(0);
+    QCOMPARE(thumbnailer.maximumWorkerCount(), 1);
+}
+
+void tst_QMediaThumbnailer::nullService()
+{
+    mockProvider->service = nullptr;
+
+    QMediaThumbnailer thumbnailer;
+    QVERIFY(!thumbnailer.isAvailable());
+    QCOMPARE(thumbnailer.pendingCount(), 0);
+    QCOMPARE(thumbnailer.maximumWorkerCount(), 0);
+
+    QSignalSpy errorSpy(&thumbnailer, SIGNAL(error(int,QString)));
+    QSignalSpy finishedSpy(&thumbnailer, SIGNAL(finished()));
+
+    const int id = thumbnailer.requestThumbnail(QUrl::fromLocalFile(QStringLiteral("/videos/clip.mp4")), 0);
+    // The error is only reported once the caller knows the id
+    QCOMPARE(errorSpy.count(), 0);
+    QCOMPARE(finishedSpy.count(), 0);
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(errorSpy.count(), 1);
+    QCOMPARE(errorSpy.last().value(0).toInt(), id);
+}
+
+QTEST_MAIN(tst_QMediaThumbnailer)
+
+#include "tst_qmediathumbnailer.moc"
@@ -59,6 +59,7 @@ private slots:
     void testClear();
     void testComparisons();
     void testArithmetic();
+    void testManyIntervals();
 };
 
 void tst_QMediaTimeRange::testIntervalCtor()
@@ -788,6 +789,53 @@ void tst_QMediaTimeRange::testArithmetic()
     QVERIFY(a.latestTime() == 14);
 }
 
+void tst_QMediaTimeRange::testManyIntervals()
+{
+    // Build a range of disjoint intervals out of order
+    QMediaTimeRange x;
+    for (int i = 99; i >= 0; i -= 2)
+        x.addInterval(i * 10, i * 10 + 4);
+    for (int i = 0; i < 100; i += 2)
+        x.addInterval(i * 10, i * 10 + 4);
+
+    QCOMPARE(x.intervals().count(), 100);
+    QCOMPARE(x.earliestTime(), qint64(0));
+    QCOMPARE(x.latestTime(), qint64(994));
+    QVERIFY(x.contains(502));
+    QVERIFY(!x.contains(507));
+    QVERIFY(!x.contains(-1));
+    QVERIFY(!x.contains(995));
+
+    // Merge a run of intervals in the middle
+    x.addInterval(203, 508);
+    QCOMPARE(x.intervals().count(), 70);
+    QVERIFY(x.contains(300));
+    QCOMPARE(x.intervals().at(20), QMediaTimeInterval(200, 508));
+    QCOMPARE(x.intervals().at(21), QMediaTimeInterval(510, 514));
+
+    // Adjacent intervals are merged
+    x.addInterval(509, 509);
+    QCOMPARE(x.intervals().count(), 69);
+    QCOMPARE(x.intervals().at(20), QMediaTimeInterval(200, 514));
+
+    // Remove across several intervals, trimming both ends
+    x.removeInterval(102, 712);
+    QCOMPARE(x.intervals().at(9), QMediaTimeInterval(90, 94));
+    QCOMPARE(x.intervals().at(10), QMediaTimeInterval(100, 101));
+    QCOMPARE(x.intervals().at(11), QMediaTimeInterval(713, 714));
+    QVERIFY(!x.contains(400));
+
+    // Split a single interval
+    x.removeInterval(91, 92);
+    QCOMPARE(x.intervals().at(9), QMediaTimeInterval(90, 90));
+    QCOMPARE(x.intervals().at(10), QMediaTimeInterval(93, 94));
+    QCOMPARE(x.intervals().at(11), QMediaTimeInterval(100, 101));
+
+    // Removing everything leaves an empty range
+    x.removeInterval(0, 1000);
+    QVERIFY(x.isEmpty());
+}
+
 QTEST_MAIN(tst_QMediaTimeRange)
 
 #include "tst_qmediatimerange.moc"
@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKAUDIODECODERCONSUMERCONTROL_H
+#define MOCKAUDIODECODERCONSUMERCONTROL_H
+
+#include <private/qaudiodecoderconsumercontrol_p.h>
+
+#include "mockaudiodecodercontrol.h"
+
+QT_BEGIN_NAMESPACE
+
+class MockAudioDecoderConsumerControl : public QAudioDecoderConsumerControl
+{
+    Q_OBJECT
+
+public:
+    MockAudioDecoderConsumerControl(MockAudioDecoderControl *control, QObject *parent = 0)
+        : QAudioDecoderConsumerControl(parent)
+        , mControl(control)
+        , mDepth(4)
+    {
+    }
+
+    int bufferQueueDepth() const
+    {
+        return mDepth;
+    }
+
+    void setBufferQueueDepth(int depth)
+    {
+        mDepth = depth;
+    }
+
+    void setConsumer(const QSharedPointer<QAudioDecoderConsumer> &consumer)
+    {
+        mControl->setConsumer(consumer);
+    }
+
+    MockAudioDecoderControl *mControl;
+    int mDepth;
+};
+
+QT_END_NAMESPACE
+
+#endif // MOCKAUDIODECODERCONSUMERCONTROL_H
@@ -35,13 +35,52 @@
 #include <QtCore/qpair.h>
 
 #include "qaudiobuffer.h"
+#include <private/qaudiodecoderconsumer_p.h>
 #include <QTimer>
 #include <QIODevice>
+#include <QThread>
+#include <QAtomicInt>
+#include <QSharedPointer>
 
 #define MOCK_DECODER_MAX_BUFFERS 10
 
 QT_BEGIN_NAMESPACE
 
+// Pushes the buffers to the consumer like a backend streaming thread
+class MockAudioDecoderThread : public QThread
+{
+public:
+    MockAudioDecoderThread(const QSharedPointer<QAudioDecoderConsumer> &consumer,
+                           const QAudioFormat &format, QObject *control)
+        : mConsumer(consumer), mFormat(format), mControl(control)
+    {
+    }
+
+    QAtomicInt mPushed;
+
+protected:
+    void run() override
+    {
+        for (int serial = 0; serial < MOCK_DECODER_MAX_BUFFERS && !mConsumer->isCancelled(); ++serial) {
+            QByteArray b(sizeof(serial), 0);
+            memcpy(b.data(), &serial, sizeof(serial));
+            qint64 position = (sizeof(serial) * serial * qint64(1000000)) / (mFormat.sampleRate() * mFormat.channelCount());
+            mConsumer->push(QAudioBuffer(b, mFormat, position));
+            mPushed.fetchAndAddOrdered(1);
+        }
+
+        if (!mConsumer->isCancelled()) {
+            mConsumer->finish();
+            QMetaObject::invokeMethod(mControl, "consumerDecodeFinished", Qt::QueuedConnection);
+        }
+    }
+
+private:
+    QSharedPointer<QAudioDecoderConsumer> mConsumer;
+    QAudioFormat mFormat;
+    QObject *mControl;
+};
+
 class MockAudioDecoderControl : public QAudioDecoderControl
 {
     Q_OBJECT
@@ -53,6 +92,7 @@ public:
         , mDevice(0)
         , mPosition(-1)
         , mSerial(0)
+        , mThread(0)
     {
         mFormat.setChannelCount(1);
         mFormat.setSampleSize(8);
@@ -114,15 +154,31 @@ public:
                 emit stateChanged(mState);
                 emit durationChanged(duration());
 
-                QTimer::singleShot(50, this, SLOT(pretendDecode()));
+                if (mConsumer) {
+                    // An earlier thread was stopped with its consumer
+                    if (mThread)
+                        mThread->wait();
+                    delete mThread;
+                    mThread = new MockAudioDecoderThread(mConsumer, mFormat, this);
+                    mThread->start();
+                } else {
+                    QTimer::singleShot(50, this, SLOT(pretendDecode()));
+                }
             } else {
                 emit error(QAudioDecoder::ResourceError, "No source set");
             }
         }
     }
 
+    ~MockAudioDecoderControl()
+    {
+        stopThread();
+        delete mThread;
+    }
+
     void stop()
     {
+        stopThread();
         if (mState != QAudioDecoder::StoppedState) {
             mState = QAudioDecoder::StoppedState;
             mSerial = 0;
@@ -170,7 +226,34 @@ public:
         return (sizeof(mSerial) * MOCK_DECODER_MAX_BUFFERS * qint64(1000)) / (mFormat.sampleRate() * mFormat.channelCount());
     }
 
+    void setConsumer(const QSharedPointer<QAudioDecoderConsumer> &consumer)
+    {
+        stopThread();
+        mConsumer = consumer;
+    }
+
+    void stopThread()
+    {
+        if (!mThread)
+            return;
+
+        // The thread might be waiting for the consumer
+        if (mConsumer)
+            mConsumer->cancel();
+        mThread->wait();
+    }
+
 private slots:
+    void consumerDecodeFinished()
+    {
+        if (mState == QAudioDecoder::StoppedState)
+            return;
+
+        mState = QAudioDecoder::StoppedState;
+        emit finished();
+        emit stateChanged(mState);
+    }
+
     void pretendDecode()
     {
         // Check if we've reached end of stream
@@ -199,6 +282,9 @@ public:
 
     int mSerial;
     QList<QAudioBuffer> mBuffers;
+
+    QSharedPointer<QAudioDecoderConsumer> mConsumer;
+    MockAudioDecoderThread *mThread;
 };
 
 QT_END_NAMESPACE
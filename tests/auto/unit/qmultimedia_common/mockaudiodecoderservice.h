@@ -32,6 +32,7 @@
 #include "qmediaservice.h"
 
 #include "mockaudiodecodercontrol.h"
+#include "mockaudiodecoderconsumercontrol.h"
 
 class MockAudioDecoderService : public QMediaService
 {
@@ -43,10 +44,13 @@ public:
     {
         mockControl = new MockAudioDecoderControl(this);
         validControl = mockControl;
+        consumerControl = new MockAudioDecoderConsumerControl(mockControl, this);
+        consumerControlEnabled = false;
     }
 
     ~MockAudioDecoderService()
     {
+        delete consumerControl;
         delete mockControl;
     }
 
@@ -54,6 +58,8 @@ public:
     {
         if (qstrcmp(iid, QAudioDecoderControl_iid) == 0)
             return mockControl;
+        if (qstrcmp(iid, QAudioDecoderConsumerControl_iid) == 0 && consumerControlEnabled)
+            return consumerControl;
         return 0;
     }
 
@@ -74,6 +80,9 @@ public:
 
     MockAudioDecoderControl *mockControl;
     MockAudioDecoderControl *validControl;
+    MockAudioDecoderConsumerControl *consumerControl;
+    // The consumer control is only offered when enabled before the decoder is created
+    bool consumerControlEnabled;
 };
 
 
@@ -42,7 +42,8 @@ class MockCaptureControl : public QCameraImageCaptureControl
     Q_OBJECT
 public:
     MockCaptureControl(MockCameraControl *cameraControl, QObject *parent = 0)
-        : QCameraImageCaptureControl(parent), m_cameraControl(cameraControl), m_captureRequest(0), m_ready(true), m_captureCanceled(false)
+        : QCameraImageCaptureControl(parent), m_cameraControl(cameraControl), m_captureRequest(0), m_ready(true), m_captureCanceled(false),
+          m_driveMode(QCameraImageCapture::SingleImageCapture)
     {
     }
 
@@ -50,8 +51,8 @@ public:
     {
     }
 
-    QCameraImageCapture::DriveMode driveMode() const { return QCameraImageCapture::SingleImageCapture; }
-    void setDriveMode(QCameraImageCapture::DriveMode) {}
+    QCameraImageCapture::DriveMode driveMode() const { return m_driveMode; }
+    void setDriveMode(QCameraImageCapture::DriveMode mode) { m_driveMode = mode; }
 
     bool isReadyForCapture() const { return m_ready && m_cameraControl->state() == QCamera::ActiveState; }
 
@@ -113,6 +114,7 @@ private:
     int m_captureRequest;
     bool m_ready;
     bool m_captureCanceled;
+    QCameraImageCapture::DriveMode m_driveMode;
 };
 
 #endif // MOCKCAMERACAPTURECONTROL_H
@@ -39,6 +39,8 @@
 #include "mockvideowindowcontrol.h"
 #include "mockaudiorolecontrol.h"
 #include "mockcustomaudiorolecontrol.h"
+#include "mockmediastatisticscontrol.h"
+#include "mockmediaplayerpreloadcontrol.h"
 
 class MockMediaPlayerService : public QMediaService
 {
@@ -55,6 +57,8 @@ public:
         rendererControl = new MockVideoRendererControl;
         rendererRef = 0;
         mockVideoProbeControl = new MockVideoProbeControl;
+        mockStatisticsControl = new MockMediaStatisticsControl;
+        mockPreloadControl = new MockMediaPlayerPreloadControl;
         windowControl = new MockVideoWindowControl;
         windowRef = 0;
         enableAudioRole = true;
@@ -70,6 +74,8 @@ public:
         delete mockNetworkControl;
         delete rendererControl;
         delete mockVideoProbeControl;
+        delete mockStatisticsControl;
+        delete mockPreloadControl;
         delete windowControl;
     }
 
@@ -98,6 +104,10 @@ public:
 
         if (qstrcmp(iid, QMediaNetworkAccessControl_iid) == 0)
             return mockNetworkControl;
+        if (qstrcmp(iid, QMediaStatisticsControl_iid) == 0)
+            return mockStatisticsControl;
+        if (qstrcmp(iid, QMediaPlayerPreloadControl_iid) == 0)
+            return mockPreloadControl;
         return 0;
     }
 
@@ -160,6 +170,12 @@ public:
 
         mockNetworkControl->_current = QNetworkConfiguration();
         mockNetworkControl->_configurations = QList<QNetworkConfiguration>();
+
+        mockStatisticsControl->m_statistics.clear();
+        mockStatisticsControl->m_counters = nullptr;
+        mockStatisticsControl->m_resetCount = 0;
+
+        mockPreloadControl->m_preloaded.clear();
     }
 
     MockMediaPlayerControl *mockControl;
@@ -169,6 +185,8 @@ public:
     MockNetworkAccessControl *mockNetworkControl;
     MockVideoRendererControl *rendererControl;
     MockVideoProbeControl *mockVideoProbeControl;
+    MockMediaStatisticsControl *mockStatisticsControl;
+    MockMediaPlayerPreloadControl *mockPreloadControl;
     MockVideoWindowControl *windowControl;
     int windowRef;
     int rendererRef;
@@ -0,0 +1,61 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKMEDIARECORDERSEGMENTCONTROL_H
+#define MOCKMEDIARECORDERSEGMENTCONTROL_H
+
+#include <private/qmediarecordersegmentcontrol_p.h>
+
+class MockMediaRecorderSegmentControl : public QMediaRecorderSegmentControl
+{
+    Q_OBJECT
+
+public:
+    MockMediaRecorderSegmentControl(QObject *parent = 0)
+        : QMediaRecorderSegmentControl(parent)
+        , m_maxDuration(0)
+        , m_maxSize(0)
+    {
+    }
+
+    qint64 maxSegmentDuration() const { return m_maxDuration; }
+    void setMaxSegmentDuration(qint64 duration) { m_maxDuration = duration; }
+
+    qint64 maxSegmentSize() const { return m_maxSize; }
+    void setMaxSegmentSize(qint64 size) { m_maxSize = size; }
+
+    void finalizeSegment(const QUrl &location, qint64 startTime, qint64 endTime)
+    {
+        emit segmentFinalized(location, startTime, endTime);
+    }
+
+    qint64 m_maxDuration;
+    qint64 m_maxSize;
+};
+
+#endif // MOCKMEDIARECORDERSEGMENTCONTROL_H
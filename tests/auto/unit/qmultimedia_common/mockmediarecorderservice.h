@@ -39,6 +39,8 @@
 #include "mockmetadatawritercontrol.h"
 #include "mockavailabilitycontrol.h"
 #include "mockaudioprobecontrol.h"
+#include "mockmediarecordersegmentcontrol.h"
+#include "mockmediastatisticscontrol.h"
 
 class MockMediaRecorderService : public QMediaService
 {
@@ -56,6 +58,8 @@ public:
         mockVideoEncoderControl = new MockVideoEncoderControl(this);
         mockMetaDataControl = new MockMetaDataWriterControl(this);
         mockAudioProbeControl = new MockAudioProbeControl(this);
+        mockSegmentControl = new MockMediaRecorderSegmentControl(this);
+        mockStatisticsControl = new MockMediaStatisticsControl(this);
     }
 
     QMediaControl* requestControl(const char *name)
@@ -76,6 +80,10 @@ public:
             return mockAvailabilityControl;
         if (hasControls && qstrcmp(name, QMediaAudioProbeControl_iid) == 0)
             return mockAudioProbeControl;
+        if (hasControls && qstrcmp(name, QMediaRecorderSegmentControl_iid) == 0)
+            return mockSegmentControl;
+        if (hasControls && qstrcmp(name, QMediaStatisticsControl_iid) == 0)
+            return mockStatisticsControl;
 
         return 0;
     }
@@ -92,6 +100,8 @@ public:
     MockMetaDataWriterControl *mockMetaDataControl;
     MockAvailabilityControl *mockAvailabilityControl;
     MockAudioProbeControl *mockAudioProbeControl;
+    MockMediaRecorderSegmentControl *mockSegmentControl;
+    MockMediaStatisticsControl *mockStatisticsControl;
 
     bool hasControls;
 };
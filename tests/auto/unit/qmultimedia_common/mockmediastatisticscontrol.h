@@ -0,0 +1,61 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef MOCKMEDIASTATISTICSCONTROL_H
+#define MOCKMEDIASTATISTICSCONTROL_H
+
+#include <private/qmediastatisticscontrol_p.h>
+#include <private/qmediastatistics_p.h>
+
+class MockMediaStatisticsControl : public QMediaStatisticsControl
+{
+    Q_OBJECT
+
+public:
+    MockMediaStatisticsControl(QObject *parent = 0)
+        : QMediaStatisticsControl(parent)
+        , m_counters(nullptr)
+        , m_resetCount(0)
+    {
+    }
+
+    // Reports m_counters like the backends do, when it is set
+    QVariantMap statistics() const { return m_counters ? m_counters->toMap() : m_statistics; }
+    void resetStatistics()
+    {
+        if (m_counters)
+            m_counters->reset();
+        m_statistics.clear();
+        ++m_resetCount;
+    }
+
+    QVariantMap m_statistics;
+    QMediaStatistics *m_counters;
+    int m_resetCount;
+};
+
+#endif // MOCKMEDIASTATISTICSCONTROL_H
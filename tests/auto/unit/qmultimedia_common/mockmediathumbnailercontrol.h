@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKMEDIATHUMBNAILERCONTROL_H
+#define MOCKMEDIATHUMBNAILERCONTROL_H
+
+#include <private/qmediathumbnailercontrol_p.h>
+
+class MockMediaThumbnailerControl : public QMediaThumbnailerControl
+{
+    Q_OBJECT
+
+public:
+    struct Request
+    {
+        int id;
+        QUrl url;
+        qint64 position;
+        QSize size;
+    };
+
+    MockMediaThumbnailerControl(QObject *parent = 0)
+        : QMediaThumbnailerControl(parent)
+    {
+    }
+
+    void request(int id, const QUrl &url, qint64 position, const QSize &size)
+    {
+        m_requests.append({ id, url, position, size });
+    }
+
+    void cancel() { m_requests.clear(); }
+
+    int pendingCount() const { return m_requests.count(); }
+
+    int maximumWorkerCount() const { return m_workerCount; }
+    void setMaximumWorkerCount(int count) { m_workerCount = count; }
+
+    // Answers the oldest request with a blank image of the requested size,
+    // or fails it if no size was given
+    void processNext()
+    {
+        const Request request = m_requests.takeFirst();
+        if (request.size.isValid()) {
+            QImage image(request.size, QImage::Format_RGB32);
+            image.fill(Qt::black);
+            emit thumbnailReady(request.id, image);
+        } else {
+            emit failed(request.id, QStringLiteral("No size"));
+        }
+        if (m_requests.isEmpty())
+            emit finished();
+    }
+
+    QList<Request> m_requests;
+    int m_workerCount = 4;
+};
+
+#endif // MOCKMEDIATHUMBNAILERCONTROL_H
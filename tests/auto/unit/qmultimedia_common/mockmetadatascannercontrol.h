@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef MOCKMETADATASCANNERCONTROL_H
+#define MOCKMETADATASCANNERCONTROL_H
+
+#include <private/qmetadatascannercontrol_p.h>
+
+class MockMetaDataScannerControl : public QMetaDataScannerControl
+{
+    Q_OBJECT
+
+public:
+    MockMetaDataScannerControl(QObject *parent = 0)
+        : QMetaDataScannerControl(parent)
+    {
+    }
+
+    void scan(const QList<QUrl> &urls) { m_queue.append(urls); }
+    void cancel() { m_queue.clear(); }
+
+    int pendingCount() const { return m_queue.count(); }
+
+    int maximumWorkerCount() const { return m_workerCount; }
+    void setMaximumWorkerCount(int count) { m_workerCount = count; }
+
+    // Reports the oldest queued url as scanned, or as failed if it isn't local
+    void processNext()
+    {
+        const QUrl url = m_queue.takeFirst();
+        if (url.isLocalFile()) {
+            QVariantMap metaData;
+            metaData.insert(QStringLiteral("Title"), url.fileName());
+            emit scanned(url, metaData);
+        } else {
+            emit failed(url, QStringLiteral("Not a local file"));
+        }
+        if (m_queue.isEmpty())
+            emit finished();
+    }
+
+    QList<QUrl> m_queue;
+    int m_workerCount = 4;
+};
+
+#endif // MOCKMETADATASCANNERCONTROL_H
@@ -10,6 +10,8 @@ HEADERS *= \
     ../qmultimedia_common/mockmedianetworkaccesscontrol.h \
     ../qmultimedia_common/mockvideoprobecontrol.h \
     ../qmultimedia_common/mockaudiorolecontrol.h \
-    ../qmultimedia_common/mockcustomaudiorolecontrol.h
+    ../qmultimedia_common/mockcustomaudiorolecontrol.h \
+    ../qmultimedia_common/mockmediastatisticscontrol.h \
+    ../qmultimedia_common/mockmediaplayerpreloadcontrol.h
 
 include(mockvideo.pri)
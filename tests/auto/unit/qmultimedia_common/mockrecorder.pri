@@ -10,6 +10,8 @@ HEADERS *= \
     ../qmultimedia_common/mockaudioencodercontrol.h \
     ../qmultimedia_common/mockaudioinputselector.h \
     ../qmultimedia_common/mockaudioprobecontrol.h \
+    ../qmultimedia_common/mockmediarecordersegmentcontrol.h \
+    ../qmultimedia_common/mockmediastatisticscontrol.h \
 
 # We also need all the container/metadata bits
 include(mockcontainer.pri)
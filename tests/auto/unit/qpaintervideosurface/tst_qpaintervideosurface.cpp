@@ -57,6 +57,9 @@ private slots:
     void present();
     void presentOpaqueFrame();
 
+    void paintYuv_data();
+    void paintYuv();
+
 #if QT_CONFIG(opengl)
 
     void shaderType();
@@ -241,14 +244,26 @@ void tst_QPainterVideoSurface::supportedFormat_data()
             << QAbstractVideoBuffer::NoHandle
             << QVideoFrame::Format_YUV420P
             << QSize(640, 480)
-            << false
-            << false;
+            << true
+            << true;
     QTest::newRow("YUV420P 640x-480")
             << QAbstractVideoBuffer::NoHandle
             << QVideoFrame::Format_YUV420P
             << QSize(640, -480)
-            << false
+            << true
             << false;
+    QTest::newRow("NV12 640x480")
+            << QAbstractVideoBuffer::NoHandle
+            << QVideoFrame::Format_NV12
+            << QSize(640, 480)
+            << true
+            << true;
+    QTest::newRow("UYVY 640x480")
+            << QAbstractVideoBuffer::NoHandle
+            << QVideoFrame::Format_UYVY
+            << QSize(640, 480)
+            << true
+            << true;
     QTest::newRow("Y8 640x480")
             << QAbstractVideoBuffer::NoHandle
             << QVideoFrame::Format_Y8
@@ -554,6 +569,150 @@ void tst_QPainterVideoSurface::presentOpaqueFrame()
     QCOMPARE(surface.error(), QAbstractVideoSurface::IncorrectFormatError);
 }
 
+// Test pattern without clamping in the conversion: a luma gradient, and
+// chroma changing with every 2x2 block.
+static uchar lumaAt(int x, int y) { return uchar(64 + (x * 3 + y * 5) % 128); }
+static uchar uAt(int x, int y) { return uchar(104 + ((x / 2) * 7 + (y / 2) * 3) % 48); }
+static uchar vAt(int x, int y) { return uchar(96 + ((x / 2) * 5 + (y / 2) * 11) % 64); }
+
+static QVideoFrame yuvTestFrame(QVideoFrame::PixelFormat pixelFormat, const QSize &size)
+{
+    const int width = size.width();
+    const int height = size.height();
+    const bool packed = pixelFormat == QVideoFrame::Format_UYVY
+            || pixelFormat == QVideoFrame::Format_YUYV;
+    const int bytesPerLine = packed ? width * 2 : width;
+    const int bytes = packed ? bytesPerLine * height : bytesPerLine * height * 3 / 2;
+
+    QVideoFrame frame(bytes, size, bytesPerLine, pixelFormat);
+    if (!frame.map(QAbstractVideoBuffer::WriteOnly))
+        return QVideoFrame();
+
+    uchar *bits = frame.bits();
+    uchar *chroma = bits + width * height;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const uchar u = uAt(x, y);
+            const uchar v = vAt(x, y);
+            const int chromaIndex = (y / 2) * (width / 2) + x / 2;
+
+            switch (pixelFormat) {
+            case QVideoFrame::Format_YUV420P:
+                bits[y * width + x] = lumaAt(x, y);
+                chroma[chromaIndex] = u;
+                chroma[width * height / 4 + chromaIndex] = v;
+                break;
+            case QVideoFrame::Format_YV12:
+                bits[y * width + x] = lumaAt(x, y);
+                chroma[chromaIndex] = v;
+                chroma[width * height / 4 + chromaIndex] = u;
+                break;
+            case QVideoFrame::Format_NV12:
+            case QVideoFrame::Format_NV21: {
+                const bool nv12 = pixelFormat == QVideoFrame::Format_NV12;
+                bits[y * width + x] = lumaAt(x, y);
+                chroma[chromaIndex * 2] = nv12 ? u : v;
+                chroma[chromaIndex * 2 + 1] = nv12 ? v : u;
+                break;
+            }
+            case QVideoFrame::Format_UYVY: {
+                uchar *pair = bits + y * bytesPerLine + (x / 2) * 4;
+                pair[0] = u;
+                pair[x % 2 ? 3 : 1] = lumaAt(x, y);
+                pair[2] = v;
+                break;
+            }
+            case QVideoFrame::Format_YUYV: {
+                uchar *pair = bits + y * bytesPerLine + (x / 2) * 4;
+                pair[x % 2 ? 2 : 0] = lumaAt(x, y);
+                pair[1] = u;
+                pair[3] = v;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+    frame.unmap();
+
+    return frame;
+}
+
+void tst_QPainterVideoSurface::paintYuv_data()
+{
+    QTest::addColumn<QVideoFrame::PixelFormat>("pixelFormat");
+    QTest::addColumn<bool>("smooth");
+    QTest::addColumn<QSize>("frameSize");
+
+    const QPair<QVideoFrame::PixelFormat, QByteArray> formats[] = {
+        qMakePair(QVideoFrame::Format_YUV420P, QByteArray("YUV420P")),
+        qMakePair(QVideoFrame::Format_YV12, QByteArray("YV12")),
+        qMakePair(QVideoFrame::Format_NV12, QByteArray("NV12")),
+        qMakePair(QVideoFrame::Format_NV21, QByteArray("NV21")),
+        qMakePair(QVideoFrame::Format_UYVY, QByteArray("UYVY")),
+        qMakePair(QVideoFrame::Format_YUYV, QByteArray("YUYV"))
+    };
+
+    for (const auto &format : formats) {
+        QTest::newRow((format.second + " nearest").constData()) << format.first << false << QSize(32, 16);
+        QTest::newRow((format.second + " smooth").constData()) << format.first << true << QSize(32, 16);
+    }
+
+    // Outputs of more than 2 x 65536 pixels are converted in bands on the thread pool
+    QTest::newRow("YUV420P large nearest") << QVideoFrame::Format_YUV420P << false << QSize(1024, 512);
+    QTest::newRow("YUV420P large smooth") << QVideoFrame::Format_YUV420P << true << QSize(1024, 512);
+    QTest::newRow("UYVY large smooth") << QVideoFrame::Format_UYVY << true << QSize(1024, 512);
+}
+
+void tst_QPainterVideoSurface::paintYuv()
+{
+    QFETCH(QVideoFrame::PixelFormat, pixelFormat);
+    QFETCH(bool, smooth);
+    QFETCH(QSize, frameSize);
+
+    const QVideoFrame frame = yuvTestFrame(pixelFormat, frameSize);
+    QVERIFY(frame.isValid());
+
+    // Painted at half the size, so that every output pixel covers 2x2 frame
+    // pixels and both filters have a well defined reference
+    const QSize outputSize = frameSize / 2;
+    const QImage reference = frame.image().convertToFormat(QImage::Format_RGB32)
+            .scaled(outputSize, Qt::IgnoreAspectRatio,
+                    smooth ? Qt::SmoothTransformation : Qt::FastTransformation);
+    QVERIFY(!reference.isNull());
+
+    QPainterVideoSurface surface;
+    QVERIFY(surface.start(QVideoSurfaceFormat(frameSize, pixelFormat)));
+    QVERIFY(surface.present(frame));
+
+    QImage image(outputSize, QImage::Format_RGB32);
+    image.fill(Qt::black);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, smooth);
+        surface.paint(&painter, QRect(QPoint(0, 0), outputSize));
+    }
+    QCOMPARE(surface.error(), QAbstractVideoSurface::NoError);
+
+    // Filtering in YUV or in RGB only differs by rounding
+    const int tolerance = 3;
+    for (int row = 0; row < image.height(); ++row) {
+        for (int column = 0; column < image.width(); ++column) {
+            const QRgb painted = image.pixel(column, row);
+            const QRgb expected = reference.pixel(column, row);
+            if (qAbs(qRed(painted) - qRed(expected)) > tolerance
+                    || qAbs(qGreen(painted) - qGreen(expected)) > tolerance
+                    || qAbs(qBlue(painted) - qBlue(expected)) > tolerance) {
+                QFAIL(qPrintable(QString::fromLatin1("pixel %1,%2 is %3, expected %4")
+                                 .arg(column).arg(row)
+                                 .arg(painted, 8, 16, QLatin1Char('0'))
+                                 .arg(expected, 8, 16, QLatin1Char('0'))));
+            }
+        }
+    }
+}
+
 #if QT_CONFIG(opengl)
 
 void tst_QPainterVideoSurface::shaderType()
@@ -0,0 +1,6 @@
+CONFIG += testcase
+TARGET = tst_qvideosurfaces
+
+QT += core multimedia-private testlib
+
+SOURCES += tst_qvideosurfaces.cpp
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qvideosurfaces_p.h>
+
+#include <qabstractvideosurface.h>
+#include <qvideosurfaceformat.h>
+
+QT_USE_NAMESPACE
+
+class TestSurface : public QAbstractVideoSurface
+{
+public:
+    TestSurface(const QList<QVideoFrame::PixelFormat> &formats) : m_formats(formats) { }
+
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(QAbstractVideoBuffer::HandleType type) const override
+    {
+        return type == QAbstractVideoBuffer::NoHandle ? m_formats : QList<QVideoFrame::PixelFormat>();
+    }
+
+    bool start(const QVideoSurfaceFormat &format) override
+    {
+        if (failStart)
+            return false;
+        startFormat = format;
+        return QAbstractVideoSurface::start(format);
+    }
+
+    bool present(const QVideoFrame &frame) override
+    {
+        frames.append(frame);
+        return !failPresent;
+    }
+
+    QList<qint64> startTimes() const
+    {
+        QList<qint64> times;
+        for (const QVideoFrame &frame : frames)
+            times.append(frame.startTime());
+        return times;
+    }
+
+    QVideoSurfaceFormat startFormat;
+    QList<QVideoFrame> frames;
+    bool failStart = false;
+    bool failPresent = false;
+
+private:
+    QList<QVideoFrame::PixelFormat> m_formats;
+};
+
+class tst_QVideoSurfaces : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void perSurfaceConversion();
+    void queuedOnSameThread();
+    void queueDepth();
+    void maximumFrameRate();
+    void surfaceFailsToStart();
+    void surfaceFailsToPresent();
+
+private:
+    static QVideoFrame yuvFrame(qint64 startTime = -1);
+};
+
+// The start time identifies the frames
+QVideoFrame tst_QVideoSurfaces::yuvFrame(qint64 startTime)
+{
+    QVideoFrame frame(4 * 4 * 3 / 2, QSize(4, 4), 4, QVideoFrame::Format_YUV420P);
+    if (frame.map(QAbstractVideoBuffer::WriteOnly)) {
+        memset(frame.bits(), 0x80, frame.mappedBytes());
+        frame.unmap();
+    }
+    frame.setStartTime(startTime);
+    return frame;
+}
+
+void tst_QVideoSurfaces::perSurfaceConversion()
+{
+    TestSurface rgbSurface({ QVideoFrame::Format_RGB32 });
+    TestSurface yuvSurface({ QVideoFrame::Format_YUV420P });
+    QVideoSurfaces surfaces({ &rgbSurface, &yuvSurface });
+
+    const auto formats = surfaces.supportedPixelFormats(QAbstractVideoBuffer::NoHandle);
+    QCOMPARE(formats, QList<QVideoFrame::PixelFormat>({ QVideoFrame::Format_RGB32, QVideoFrame::Format_YUV420P }));
+
+    QVERIFY(surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+    QCOMPARE(rgbSurface.startFormat.pixelFormat(), QVideoFrame::Format_RGB32);
+    QCOMPARE(rgbSurface.startFormat.frameSize(), QSize(4, 4));
+    QCOMPARE(yuvSurface.startFormat.pixelFormat(), QVideoFrame::Format_YUV420P);
+
+    QVERIFY(surfaces.present(yuvFrame()));
+
+    // Only the surface that can't take the frame gets a converted one
+    QTRY_COMPARE(rgbSurface.frames.count(), 1);
+    QTRY_COMPARE(yuvSurface.frames.count(), 1);
+    QCOMPARE(rgbSurface.frames.first().pixelFormat(), QVideoFrame::Format_RGB32);
+    QCOMPARE(rgbSurface.frames.first().size(), QSize(4, 4));
+    QCOMPARE(yuvSurface.frames.first().pixelFormat(), QVideoFrame::Format_YUV420P);
+
+    surfaces.stop();
+    QVERIFY(!rgbSurface.isActive());
+    QVERIFY(!yuvSurface.isActive());
+}
+
+void tst_QVideoSurfaces::queuedOnSameThread()
+{
+    TestSurface surface1({ QVideoFrame::Format_YUV420P });
+    TestSurface surface2({ QVideoFrame::Format_YUV420P });
+    QVideoSurfaces surfaces({ &surface1, &surface2 });
+
+    QVERIFY(surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+
+    // Surfaces living on the presenting thread are not called from present()
+    QVERIFY(surfaces.present(yuvFrame(0)));
+    QCOMPARE(surface1.frames.count(), 0);
+    QCOMPARE(surface2.frames.count(), 0);
+
+    QTRY_COMPARE(surface1.startTimes(), QList<qint64>({ 0 }));
+    QTRY_COMPARE(surface2.startTimes(), QList<qint64>({ 0 }));
+}
+
+void tst_QVideoSurfaces::queueDepth()
+{
+    TestSurface surface1({ QVideoFrame::Format_YUV420P });
+    TestSurface surface2({ QVideoFrame::Format_YUV420P });
+    surface2.setProperty("maximumQueuedFrames", 4);
+    QVideoSurfaces surfaces({ &surface1, &surface2 });
+
+    QVERIFY(surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+
+    // Without the event loop running, each surface keeps only its newest frames
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(surfaces.present(yuvFrame(i)));
+
+    QTRY_COMPARE(surface1.startTimes(), QList<qint64>({ 8, 9 }));
+    QTRY_COMPARE(surface2.startTimes(), QList<qint64>({ 6, 7, 8, 9 }));
+}
+
+void tst_QVideoSurfaces::maximumFrameRate()
+{
+    TestSurface throttled({ QVideoFrame::Format_YUV420P });
+    throttled.setProperty("maximumFrameRate", 1.0);
+    TestSurface full({ QVideoFrame::Format_YUV420P });
+    QVideoSurfaces surfaces({ &throttled, &full });
+
+    QVERIFY(surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+
+    // One frame per second at most, the other surface is not affected
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(surfaces.present(yuvFrame(i)));
+        QTRY_COMPARE(full.frames.count(), i + 1);
+    }
+    QCOMPARE(throttled.startTimes(), QList<qint64>({ 0 }));
+
+    QTest::qWait(1100);
+    QVERIFY(surfaces.present(yuvFrame(5)));
+    QTRY_COMPARE(full.frames.count(), 6);
+    QTRY_COMPARE(throttled.startTimes(), QList<qint64>({ 0, 5 }));
+}
+
+void tst_QVideoSurfaces::surfaceFailsToStart()
+{
+    TestSurface surface1({ QVideoFrame::Format_YUV420P });
+    TestSurface surface2({ QVideoFrame::Format_YUV420P });
+    surface2.failStart = true;
+    QVideoSurfaces surfaces({ &surface1, &surface2 });
+
+    QVERIFY(!surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+    QCOMPARE(surfaces.error(), QAbstractVideoSurface::UnsupportedFormatError);
+    QVERIFY(!surfaces.isActive());
+
+    // The surfaces already started are stopped again
+    QVERIFY(!surface1.isActive());
+    QVERIFY(!surface2.isActive());
+
+    QVERIFY(!surfaces.present(yuvFrame()));
+    QCOMPARE(surfaces.error(), QAbstractVideoSurface::StoppedError);
+}
+
+void tst_QVideoSurfaces::surfaceFailsToPresent()
+{
+    TestSurface surface1({ QVideoFrame::Format_YUV420P });
+    TestSurface surface2({ QVideoFrame::Format_YUV420P });
+    surface1.failPresent = true;
+    QVideoSurfaces surfaces({ &surface1, &surface2 });
+
+    QVERIFY(surfaces.start(QVideoSurfaceFormat(QSize(4, 4), QVideoFrame::Format_YUV420P)));
+
+    // The failure is only known once the frame was delivered
+    QVERIFY(surfaces.present(yuvFrame(0)));
+    QTRY_COMPARE(surface1.frames.count(), 1);
+    QTRY_COMPARE(surface2.frames.count(), 1);
+
+    // The failed surface gets no more frames, the other one still does
+    QVERIFY(surfaces.present(yuvFrame(1)));
+    QTRY_COMPARE(surface2.startTimes(), QList<qint64>({ 0, 1 }));
+    QCOMPARE(surface1.frames.count(), 1);
+
+    // Once every surface failed, so does presenting
+    surface2.failPresent = true;
+    QVERIFY(surfaces.present(yuvFrame(2)));
+    QTRY_COMPARE(surface2.frames.count(), 3);
+    QVERIFY(!surfaces.present(yuvFrame(3)));
+    QCOMPARE(surfaces.error(), QAbstractVideoSurface::ResourceError);
+}
+
+QTEST_MAIN(tst_QVideoSurfaces)
+
+#include "tst_qvideosurfaces.moc"
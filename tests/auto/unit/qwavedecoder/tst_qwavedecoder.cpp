@@ -65,6 +65,11 @@ private slots:
 
     void readAllAtOnce();
     void readPerByte();
+
+    void formats_data();
+    void formats();
+
+    void mappedFile();
 };
 
 Q_DECLARE_METATYPE(tst_QWaveDecoder::Corruption)
@@ -91,6 +96,64 @@ static QString testFilePath(const char *filename)
     return QFINDTESTDATA(path);
 }
 
+static void appendLE16(QByteArray *wave, quint16 value)
+{
+    char bytes[2];
+    qToLittleEndian(value, bytes);
+    wave->append(bytes, 2);
+}
+
+static void appendLE32(QByteArray *wave, quint32 value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    wave->append(bytes, 4);
+}
+
+// Builds a little endian wave file holding 100 frames of a byte ramp, with
+// an odd sized LIST and a fact chunk in front of the sample data.
+static QByteArray createWave(quint16 formatTag, int channels, int bitsPerSample, bool extensible)
+{
+    const int blockAlign = channels * ((bitsPerSample + 7) / 8);
+    const quint32 dataSize = 100 * blockAlign;
+
+    QByteArray format;
+    appendLE16(&format, extensible ? 0xfffe : formatTag);
+    appendLE16(&format, quint16(channels));
+    appendLE32(&format, 8000);
+    appendLE32(&format, 8000 * blockAlign);
+    appendLE16(&format, quint16(blockAlign));
+    appendLE16(&format, quint16(bitsPerSample));
+    if (extensible) {
+        appendLE16(&format, 22);
+        appendLE16(&format, quint16(bitsPerSample));
+        appendLE32(&format, 0);
+        appendLE16(&format, formatTag);
+        format.append("\x00\x00\x00\x00\x10\x00\x80\x00\x00\xaa\x00\x38\x9b\x71", 14);
+    }
+
+    QByteArray wave;
+    wave.append("RIFF", 4);
+    appendLE32(&wave, 0);
+    wave.append("WAVE", 4);
+    wave.append("fmt ", 4);
+    appendLE32(&wave, format.size());
+    wave.append(format);
+    wave.append("LIST", 4);
+    appendLE32(&wave, 5);
+    wave.append("INFO\x01\x00", 6);
+    wave.append("fact", 4);
+    appendLE32(&wave, 4);
+    appendLE32(&wave, 100);
+    wave.append("data", 4);
+    appendLE32(&wave, dataSize);
+    for (quint32 i = 0; i < dataSize; ++i)
+        wave.append(char(i));
+
+    qToLittleEndian(quint32(wave.size() - 8), wave.data() + 4);
+    return wave;
+}
+
 void tst_QWaveDecoder::file_data()
 {
     QTest::addColumn<QString>("file");
@@ -120,11 +183,11 @@ void tst_QWaveDecoder::file_data()
     // The next file has extra data in the wave header.
     QTest::newRow("File isawav_1_16_44100_le_2.wav") << testFilePath("isawav_1_16_44100_le_2.wav")  << tst_QWaveDecoder::None << 1 << 16 << 44100 << QAudioFormat::LittleEndian;
 
-    // 32 bit waves are not supported
-    QTest::newRow("File isawav_1_32_8000_le.wav") << testFilePath("isawav_1_32_8000_le.wav")  << tst_QWaveDecoder::FormatDescriptor << 1 << 32 << 8000 << QAudioFormat::LittleEndian;
-    QTest::newRow("File isawav_1_32_44100_le.wav") << testFilePath("isawav_1_32_44100_le.wav")  << tst_QWaveDecoder::FormatDescriptor << 1 << 32 << 44100 << QAudioFormat::LittleEndian;
-    QTest::newRow("File isawav_2_32_8000_be.wav") << testFilePath("isawav_2_32_8000_be.wav")  << tst_QWaveDecoder::FormatDescriptor << 2 << 32 << 8000 << QAudioFormat::BigEndian;
-    QTest::newRow("File isawav_2_32_44100_be.wav") << testFilePath("isawav_2_32_44100_be.wav")  << tst_QWaveDecoder::FormatDescriptor << 2 << 32 << 44100 << QAudioFormat::BigEndian;
+    // 32 bit waves use WAVE_FORMAT_EXTENSIBLE
+    QTest::newRow("File isawav_1_32_8000_le.wav") << testFilePath("isawav_1_32_8000_le.wav")  << tst_QWaveDecoder::None << 1 << 32 << 8000 << QAudioFormat::LittleEndian;
+    QTest::newRow("File isawav_1_32_44100_le.wav") << testFilePath("isawav_1_32_44100_le.wav")  << tst_QWaveDecoder::None << 1 << 32 << 44100 << QAudioFormat::LittleEndian;
+    QTest::newRow("File isawav_2_32_8000_be.wav") << testFilePath("isawav_2_32_8000_be.wav")  << tst_QWaveDecoder::None << 2 << 32 << 8000 << QAudioFormat::BigEndian;
+    QTest::newRow("File isawav_2_32_44100_be.wav") << testFilePath("isawav_2_32_44100_be.wav")  << tst_QWaveDecoder::None << 2 << 32 << 44100 << QAudioFormat::BigEndian;
 }
 
 void tst_QWaveDecoder::file()
@@ -299,6 +362,117 @@ void tst_QWaveDecoder::readPerByte()
     stream.close();
 }
 
+void tst_QWaveDecoder::formats_data()
+{
+    QTest::addColumn<QByteArray>("wave");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<int>("samplesize");
+    QTest::addColumn<QAudioFormat::SampleType>("sampletype");
+
+    QTest::newRow("PCM 24 bit") << createWave(1, 2, 24, false)
+                                << true << 24 << QAudioFormat::SignedInt;
+    QTest::newRow("PCM 20 bit") << createWave(1, 1, 20, false)
+                                << true << 24 << QAudioFormat::SignedInt;
+    QTest::newRow("IEEE float 32 bit") << createWave(3, 2, 32, false)
+                                       << true << 32 << QAudioFormat::Float;
+    QTest::newRow("Extensible PCM 24 bit") << createWave(1, 2, 24, true)
+                                           << true << 24 << QAudioFormat::SignedInt;
+    QTest::newRow("Extensible IEEE float 32 bit") << createWave(3, 1, 32, true)
+                                                  << true << 32 << QAudioFormat::Float;
+    QTest::newRow("IEEE float 16 bit") << createWave(3, 1, 16, false)
+                                       << false << 0 << QAudioFormat::Unknown;
+    QTest::newRow("ADPCM") << createWave(2, 1, 4, false)
+                           << false << 0 << QAudioFormat::Unknown;
+    QTest::newRow("Extensible ADPCM") << createWave(2, 1, 16, true)
+                                      << false << 0 << QAudioFormat::Unknown;
+}
+
+void tst_QWaveDecoder::formats()
+{
+    QFETCH(QByteArray, wave);
+    QFETCH(bool, valid);
+    QFETCH(int, samplesize);
+    QFETCH(QAudioFormat::SampleType, sampletype);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(wave), qint64(wave.size()));
+    file.close();
+
+    QNetworkAccessManager nam;
+
+    // Once from memory and once as a sequential stream
+    for (int pass = 0; pass < 2; ++pass) {
+        QBuffer buffer(&wave);
+        buffer.open(QIODevice::ReadOnly);
+
+        QScopedPointer<QNetworkReply> reply;
+        QIODevice *device = &buffer;
+        if (pass == 1) {
+            reply.reset(nam.get(QNetworkRequest(QUrl::fromLocalFile(file.fileName()))));
+            device = reply.data();
+        }
+
+        QWaveDecoder waveDecoder(device);
+        QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+        QSignalSpy parsingErrorSpy(&waveDecoder, SIGNAL(parsingError()));
+
+        if (!valid) {
+            QTRY_COMPARE(parsingErrorSpy.count(), 1);
+            QCOMPARE(validFormatSpy.count(), 0);
+            continue;
+        }
+
+        QTRY_COMPARE(validFormatSpy.count(), 1);
+        QCOMPARE(parsingErrorSpy.count(), 0);
+
+        const QAudioFormat format = waveDecoder.audioFormat();
+        QVERIFY(format.isValid());
+        QCOMPARE(format.sampleSize(), samplesize);
+        QCOMPARE(format.sampleType(), sampletype);
+        QCOMPARE(waveDecoder.size(), qint64(100 * format.bytesPerFrame()));
+
+        // The LIST and fact chunks must have been skipped
+        const QByteArray samples = waveDecoder.readAll();
+        QCOMPARE(samples.size(), int(waveDecoder.size()));
+        for (int i = 0; i < samples.size(); ++i)
+            QCOMPARE(samples.at(i), char(i));
+    }
+}
+
+void tst_QWaveDecoder::mappedFile()
+{
+    const QByteArray wave = createWave(1, 2, 16, false);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(wave), qint64(wave.size()));
+    QVERIFY(file.seek(0));
+
+    QWaveDecoder waveDecoder(&file);
+    QSignalSpy validFormatSpy(&waveDecoder, SIGNAL(formatKnown()));
+
+    QTRY_COMPARE(validFormatSpy.count(), 1);
+    QCOMPARE(waveDecoder.size(), qint64(400));
+    QVERIFY(!waveDecoder.isSequential());
+
+    // The source is left at the first sample
+    QCOMPARE(file.pos(), qint64(wave.size() - 400));
+
+    const uchar *data = waveDecoder.mappedData();
+    QVERIFY(data);
+    QCOMPARE(QByteArray(reinterpret_cast<const char *>(data), 400), wave.right(400));
+
+    QVERIFY(waveDecoder.seek(398));
+    QCOMPARE(waveDecoder.bytesAvailable(), qint64(2));
+    QCOMPARE(waveDecoder.read(8), wave.right(2));
+    QVERIFY(waveDecoder.atEnd());
+
+    QVERIFY(waveDecoder.seek(0));
+    QCOMPARE(waveDecoder.readAll(), wave.right(400));
+    QVERIFY(!waveDecoder.seek(401));
+}
+
 QTEST_MAIN(tst_QWaveDecoder)
 
 #include "tst_qwavedecoder.moc"
@@ -0,0 +1,8 @@
+TARGET = tst_bench_gstreamerthroughput
+
+QT += multimedia-private multimediagsttools-private testlib
+CONFIG += benchmark
+
+QMAKE_USE += gstreamer
+
+SOURCES += tst_bench_gstreamerthroughput.cpp
@@ -0,0 +1,390 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qtemporarydir.h>
+
+#include <qabstractvideosurface.h>
+#include <qaudiodecoder.h>
+#include <qvideosurfaceformat.h>
+
+#include <private/qgstreamerbushelper_p.h>
+#include <private/qgstreamermessage_p.h>
+#include <private/qvideosurfacegstsink_p.h>
+
+#include <gst/gst.h>
+
+#include <algorithm>
+#include <time.h>
+
+QT_USE_NAMESPACE
+
+// Runs videotestsrc and audiotestsrc generated media through the Qt
+// GStreamer sinks as fast as they accept it and reports the throughput.
+//
+// Environment:
+//   QT_GST_BENCH_FRAMES         video frames per row (default 300)
+//   QT_GST_BENCH_VIDEO          comma separated FORMAT:WIDTHxHEIGHT rows,
+//                               e.g. "I420:1920x1080,NV12:3840x2160"
+//   QT_GST_BENCH_AUDIO_SECONDS  length of the generated audio (default 60)
+
+static qint64 processCpuTimeUs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return qint64(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int environmentInt(const char *name, int defaultValue)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(name, &ok);
+    return ok && value > 0 ? value : defaultValue;
+}
+
+class CountingSurface : public QAbstractVideoSurface
+{
+public:
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+            QAbstractVideoBuffer::HandleType handleType) const override
+    {
+        if (handleType != QAbstractVideoBuffer::NoHandle)
+            return QList<QVideoFrame::PixelFormat>();
+
+        return QList<QVideoFrame::PixelFormat>()
+                << QVideoFrame::Format_ARGB32
+                << QVideoFrame::Format_RGB32
+                << QVideoFrame::Format_BGRA32
+                << QVideoFrame::Format_BGR32
+                << QVideoFrame::Format_RGB24
+                << QVideoFrame::Format_BGR24
+                << QVideoFrame::Format_RGB565
+                << QVideoFrame::Format_AYUV444
+                << QVideoFrame::Format_YUV444
+                << QVideoFrame::Format_YUV420P
+                << QVideoFrame::Format_YV12
+                << QVideoFrame::Format_UYVY
+                << QVideoFrame::Format_YUYV
+                << QVideoFrame::Format_NV12
+                << QVideoFrame::Format_NV21
+                << QVideoFrame::Format_Y8
+                << QVideoFrame::Format_Y16;
+    }
+
+    bool present(const QVideoFrame &frame) override
+    {
+        const qint64 now = clock.nsecsElapsed();
+
+        // Flushing presents an empty frame.
+        if (!frame.isValid())
+            return true;
+
+        // Touch the pixels so that a mapping regression shows up as well.
+        QVideoFrame mapped(frame);
+        if (mapped.map(QAbstractVideoBuffer::ReadOnly)) {
+            checksum += mapped.bits()[0];
+            mapped.unmap();
+        }
+
+        QMutexLocker locker(&mutex);
+        const auto it = arrivals.find(frame.startTime());
+        if (it != arrivals.end()) {
+            latencies.append((now - it.value()) / 1000);
+            arrivals.erase(it);
+        }
+        ++presented;
+        return true;
+    }
+
+    // Called on the streaming thread when a buffer reaches the sink.
+    void bufferArrived(qint64 startTimeUs)
+    {
+        QMutexLocker locker(&mutex);
+        arrivals.insert(startTimeUs, clock.nsecsElapsed());
+        ++arrived;
+    }
+
+    QElapsedTimer clock;
+    QMutex mutex;
+    QHash<qint64, qint64> arrivals;
+    QVector<qint64> latencies;
+    int arrived = 0;
+    int presented = 0;
+    quint32 checksum = 0;
+};
+
+static GstPadProbeReturn sinkBufferProbe(GstPad *, GstPadProbeInfo *info, gpointer userData)
+{
+    if (GstBuffer *buffer = gst_pad_probe_info_get_buffer(info))
+        static_cast<CountingSurface *>(userData)->bufferArrived(GST_BUFFER_PTS(buffer) / 1000);
+    return GST_PAD_PROBE_OK;
+}
+
+static qint64 percentile(QVector<qint64> values, int percent)
+{
+    if (values.isEmpty())
+        return 0;
+    const int index = qMin(values.size() - 1, values.size() * percent / 100);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values.at(index);
+}
+
+// Runs the pipeline to EOS while the event loop delivers the sink's
+// events to the surface; returns false on error or timeout.
+static bool runPipeline(GstElement *pipeline, int timeout)
+{
+    GstBus *bus = gst_element_get_bus(pipeline);
+    QGstreamerBusHelper busHelper(bus);
+    gst_object_unref(GST_OBJECT(bus));
+
+    QEventLoop loop;
+    bool ok = false;
+    QObject::connect(&busHelper, &QGstreamerBusHelper::message,
+                     [&](const QGstreamerMessage &message) {
+        GstMessage *gm = message.rawMessage();
+        if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_EOS) {
+            ok = true;
+            loop.quit();
+        } else if (GST_MESSAGE_TYPE(gm) == GST_MESSAGE_ERROR) {
+            GError *err = nullptr;
+            gchar *debug = nullptr;
+            gst_message_parse_error(gm, &err, &debug);
+            qWarning() << "Pipeline error:" << err->message;
+            g_error_free(err);
+            g_free(debug);
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE)
+        return false;
+    loop.exec();
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    return ok;
+}
+
+class tst_GStreamerThroughput : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void videoSink_data();
+    void videoSink();
+    void audioDecoder_data();
+    void audioDecoder();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void tst_GStreamerThroughput::initTestCase()
+{
+    gst_init(nullptr, nullptr);
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_GStreamerThroughput::videoSink_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<QSize>("size");
+
+    const QString rows = qEnvironmentVariable("QT_GST_BENCH_VIDEO");
+    if (!rows.isEmpty()) {
+        for (const QString &row : rows.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+            const QStringList parts = row.trimmed().split(QLatin1Char(':'));
+            const QStringList dimensions = parts.value(1).split(QLatin1Char('x'));
+            const QSize size(dimensions.value(0).toInt(), dimensions.value(1).toInt());
+            if (parts.size() != 2 || size.isEmpty()) {
+                qWarning() << "Ignoring malformed QT_GST_BENCH_VIDEO row" << row;
+                continue;
+            }
+            QTest::newRow(qPrintable(row.trimmed())) << parts.at(0) << size;
+        }
+        return;
+    }
+
+    const char *formats[] = { "I420", "NV12", "YUY2", "UYVY", "BGRx" };
+    const QSize sizes[] = { QSize(640, 480), QSize(1280, 720), QSize(1920, 1080), QSize(3840, 2160) };
+    for (const char *format : formats) {
+        for (const QSize &size : sizes) {
+            QTest::addRow("%s:%dx%d", format, size.width(), size.height())
+                    << QString::fromLatin1(format) << size;
+        }
+    }
+}
+
+void tst_GStreamerThroughput::videoSink()
+{
+    QFETCH(QString, format);
+    QFETCH(QSize, size);
+
+    const int frames = environmentInt("QT_GST_BENCH_FRAMES", 300);
+
+    // The frame rate only makes the timestamps unique, the sink does not sync.
+    const QString description = QStringLiteral(
+            "videotestsrc num-buffers=%1 pattern=black ! "
+            "capsfilter caps=video/x-raw,format=%2,width=%3,height=%4,framerate=1000/1")
+            .arg(frames).arg(format).arg(size.width()).arg(size.height());
+
+    GError *err = nullptr;
+    GstElement *source = gst_parse_bin_from_description(description.toLatin1().constData(), TRUE, &err);
+    if (!source) {
+        const QByteArray message = err ? err->message : "unknown error";
+        if (err)
+            g_error_free(err);
+        QSKIP(message.constData());
+    }
+
+    CountingSurface surface;
+    GstElement *sink = GST_ELEMENT(QVideoSurfaceGstSink::createSink(&surface));
+    g_object_set(G_OBJECT(sink), "sync", FALSE, "async", FALSE, NULL);
+
+    GstElement *pipeline = gst_pipeline_new("throughput");
+    gst_bin_add_many(GST_BIN(pipeline), source, sink, NULL);
+    QVERIFY(gst_element_link(source, sink));
+
+    GstPad *pad = gst_element_get_static_pad(sink, "sink");
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, sinkBufferProbe, &surface, nullptr);
+    gst_object_unref(GST_OBJECT(pad));
+
+    surface.clock.start();
+    const qint64 cpuStart = processCpuTimeUs();
+    const bool ok = runPipeline(pipeline, 120000);
+    const qint64 cpuTime = processCpuTimeUs() - cpuStart;
+    const qint64 wallTime = surface.clock.nsecsElapsed() / 1000;
+
+    gst_object_unref(GST_OBJECT(pipeline));
+
+    QVERIFY2(ok, "pipeline did not reach EOS");
+    QVERIFY(surface.presented > 0);
+
+    const int dropped = surface.arrived - surface.presented;
+    qInfo("%d frames, %d dropped, latency p50 %lld us p95 %lld us p99 %lld us, cpu %lld us/frame",
+          surface.presented, dropped,
+          percentile(surface.latencies, 50),
+          percentile(surface.latencies, 95),
+          percentile(surface.latencies, 99),
+          cpuTime / surface.presented);
+
+    QTest::setBenchmarkResult(qreal(surface.presented) * 1000000 / qMax<qint64>(wallTime, 1),
+                              QTest::FramesPerSecond);
+}
+
+void tst_GStreamerThroughput::audioDecoder_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<int>("sampleRate");
+    QTest::addColumn<int>("channels");
+
+    QTest::newRow("S16LE 44100 Hz stereo") << QStringLiteral("S16LE") << 44100 << 2;
+    QTest::newRow("S16LE 48000 Hz 6 channels") << QStringLiteral("S16LE") << 48000 << 6;
+    QTest::newRow("S32LE 96000 Hz stereo") << QStringLiteral("S32LE") << 96000 << 2;
+    QTest::newRow("F32LE 48000 Hz stereo") << QStringLiteral("F32LE") << 48000 << 2;
+}
+
+void tst_GStreamerThroughput::audioDecoder()
+{
+    QFETCH(QString, format);
+    QFETCH(int, sampleRate);
+    QFETCH(int, channels);
+
+    const int seconds = environmentInt("QT_GST_BENCH_AUDIO_SECONDS", 60);
+    const QString fileName = m_dir.filePath(QStringLiteral("%1_%2_%3.wav")
+                                            .arg(format).arg(sampleRate).arg(channels));
+
+    const QString caps = QStringLiteral("audio/x-raw,format=%1,rate=%2,channels=%3")
+            .arg(format).arg(sampleRate).arg(channels);
+
+    // 1024 samples per buffer; wavenc writes the file without any Qt code.
+    const int buffers = (sampleRate * seconds + 1023) / 1024;
+    const QString description = QStringLiteral(
+            "audiotestsrc num-buffers=%1 samplesperbuffer=1024 wave=sine ! %2 ! wavenc ! filesink location=\"%3\"")
+            .arg(buffers).arg(caps).arg(fileName);
+
+    GError *err = nullptr;
+    GstElement *pipeline = gst_parse_launch(description.toLocal8Bit().constData(), &err);
+    if (!pipeline || err) {
+        const QByteArray message = err ? err->message : "unknown error";
+        if (err)
+            g_error_free(err);
+        if (pipeline)
+            gst_object_unref(GST_OBJECT(pipeline));
+        QSKIP(message.constData());
+    }
+    const bool generated = runPipeline(pipeline, 120000);
+    gst_object_unref(GST_OBJECT(pipeline));
+    QVERIFY2(generated, "could not generate the test file");
+
+    QAudioDecoder decoder;
+    if (!decoder.isAvailable())
+        QSKIP("No audio decoder available");
+
+    qint64 bytes = 0;
+    int bufferCount = 0;
+    QEventLoop loop;
+    connect(&decoder, &QAudioDecoder::bufferReady, [&]() {
+        const QAudioBuffer buffer = decoder.read();
+        bytes += buffer.byteCount();
+        ++bufferCount;
+    });
+    connect(&decoder, &QAudioDecoder::finished, &loop, &QEventLoop::quit);
+    connect(&decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error),
+            &loop, &QEventLoop::quit);
+    QTimer::singleShot(120000, &loop, &QEventLoop::quit);
+
+    decoder.setSourceFilename(fileName);
+
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 cpuStart = processCpuTimeUs();
+    decoder.start();
+    loop.exec();
+    const qint64 cpuTime = processCpuTimeUs() - cpuStart;
+    const qint64 wallTime = clock.nsecsElapsed() / 1000;
+
+    QCOMPARE(decoder.error(), QAudioDecoder::NoError);
+    QVERIFY(bufferCount > 0);
+
+    qInfo("%d buffers, %lld bytes, %.1fx realtime, cpu %lld us/buffer",
+          bufferCount, bytes, seconds * 1000000.0 / qMax<qint64>(wallTime, 1),
+          cpuTime / bufferCount);
+
+    QTest::setBenchmarkResult(qreal(bytes) * 1000000 / qMax<qint64>(wallTime, 1),
+                              QTest::BytesPerSecond);
+}
+
+QTEST_GUILESS_MAIN(tst_GStreamerThroughput)
+
+#include "tst_bench_gstreamerthroughput.moc"
@@ -0,0 +1,13 @@
+TEMPLATE = subdirs
+QT_FOR_CONFIG += multimedia-private
+
+SUBDIRS += \
+    qaudiohelpers \
+    qmediaplaylist \
+    qmediatimerange \
+    qsamplecache \
+    qvideoframe \
+    qwavedecoder
+
+# The throughput harness uses GStreamer 1.0 caps and pad probes
+qtHaveModule(multimediagsttools):qtConfig(gstreamer_1_0): SUBDIRS += gstreamerthroughput
@@ -0,0 +1,6 @@
+TARGET = tst_bench_qaudiohelpers
+
+QT += multimedia-private testlib
+CONFIG += benchmark
+
+SOURCES += tst_bench_qaudiohelpers.cpp
@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qaudioformat.h>
+#include <private/qaudiohelpers_p.h>
+
+QT_USE_NAMESPACE
+
+class tst_QAudioHelpersBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void multiplySamples_data();
+    void multiplySamples();
+};
+
+void tst_QAudioHelpersBenchmark::multiplySamples_data()
+{
+    QTest::addColumn<int>("sampleSize");
+    QTest::addColumn<QAudioFormat::SampleType>("sampleType");
+    QTest::addColumn<int>("frames");
+
+    static const struct {
+        int sampleSize;
+        QAudioFormat::SampleType sampleType;
+        const char *name;
+    } formats[] = {
+        { 8, QAudioFormat::SignedInt, "s8" },
+        { 8, QAudioFormat::UnSignedInt, "u8" },
+        { 16, QAudioFormat::SignedInt, "s16" },
+        { 16, QAudioFormat::UnSignedInt, "u16" },
+        { 24, QAudioFormat::SignedInt, "s24" },
+        { 24, QAudioFormat::UnSignedInt, "u24" },
+        { 32, QAudioFormat::SignedInt, "s32" },
+        { 32, QAudioFormat::UnSignedInt, "u32" },
+        { 32, QAudioFormat::Float, "float" }
+    };
+
+    // One 10 ms period and one second of stereo audio at 48 kHz.
+    for (const auto &format : formats) {
+        for (int frames : { 480, 48000 }) {
+            QTest::addRow("%s %d frames", format.name, frames)
+                    << format.sampleSize << format.sampleType << frames;
+        }
+    }
+}
+
+void tst_QAudioHelpersBenchmark::multiplySamples()
+{
+    QFETCH(int, sampleSize);
+    QFETCH(QAudioFormat::SampleType, sampleType);
+    QFETCH(int, frames);
+
+    QAudioFormat format;
+    format.setSampleRate(48000);
+    format.setChannelCount(2);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(sampleType);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec(QStringLiteral("audio/pcm"));
+
+    const int bytes = format.bytesForFrames(frames);
+    QByteArray source(bytes, Qt::Uninitialized);
+    if (sampleType == QAudioFormat::Float) {
+        float *samples = reinterpret_cast<float *>(source.data());
+        for (int i = 0; i < bytes / int(sizeof(float)); ++i)
+            samples[i] = float(i % 200 - 100) / 100.0f;
+    } else {
+        for (int i = 0; i < bytes; ++i)
+            source[i] = char(i * 13);
+    }
+    QByteArray destination(bytes, Qt::Uninitialized);
+
+    QBENCHMARK {
+        QAudioHelperInternal::qMultiplySamples(0.5, format, source.constData(),
+                                               destination.data(), bytes);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QAudioHelpersBenchmark)
+
+#include "tst_bench_qaudiohelpers.moc"
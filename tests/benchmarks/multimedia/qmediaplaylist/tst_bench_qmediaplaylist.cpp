@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qmediaplaylist.h>
+
+#include <QtCore/qtemporarydir.h>
+
+QT_USE_NAMESPACE
+
+class tst_QMediaPlaylistBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void addMedia_data();
+    void addMedia();
+    void insertMedia_data();
+    void insertMedia();
+    void shuffle_data();
+    void shuffle();
+    void loadM3u_data();
+    void loadM3u();
+
+private:
+    void mediaCountData();
+
+    QTemporaryDir m_dir;
+};
+
+static QList<QMediaContent> createContent(int count)
+{
+    QList<QMediaContent> content;
+    content.reserve(count);
+    for (int i = 0; i < count; ++i)
+        content.append(QUrl(QStringLiteral("file:///music/album%1/track%2.ogg").arg(i / 12).arg(i % 12)));
+    return content;
+}
+
+void tst_QMediaPlaylistBenchmark::mediaCountData()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void tst_QMediaPlaylistBenchmark::addMedia_data()
+{
+    mediaCountData();
+}
+
+void tst_QMediaPlaylistBenchmark::addMedia()
+{
+    QFETCH(int, count);
+
+    const QList<QMediaContent> content = createContent(count);
+
+    QBENCHMARK {
+        QMediaPlaylist playlist;
+        QVERIFY(playlist.addMedia(content));
+        QCOMPARE(playlist.mediaCount(), count);
+    }
+}
+
+void tst_QMediaPlaylistBenchmark::insertMedia_data()
+{
+    mediaCountData();
+}
+
+// Single items inserted in the middle, which is the worst case for the
+// list backing the playlist provider.
+void tst_QMediaPlaylistBenchmark::insertMedia()
+{
+    QFETCH(int, count);
+
+    const QList<QMediaContent> content = createContent(count);
+
+    QBENCHMARK {
+        QMediaPlaylist playlist;
+        for (const QMediaContent &media : content)
+            playlist.insertMedia(playlist.mediaCount() / 2, media);
+        QCOMPARE(playlist.mediaCount(), count);
+    }
+}
+
+void tst_QMediaPlaylistBenchmark::shuffle_data()
+{
+    mediaCountData();
+}
+
+void tst_QMediaPlaylistBenchmark::shuffle()
+{
+    QFETCH(int, count);
+
+    QMediaPlaylist playlist;
+    QVERIFY(playlist.addMedia(createContent(count)));
+
+    QBENCHMARK {
+        playlist.shuffle();
+    }
+
+    QCOMPARE(playlist.mediaCount(), count);
+}
+
+void tst_QMediaPlaylistBenchmark::loadM3u_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<int>("count");
+
+    for (int count : { 100, 1000, 10000 }) {
+        QByteArray data("#EXTM3U\n");
+        for (int i = 0; i < count; ++i) {
+            data += "#EXTINF:" + QByteArray::number(180 + i % 120) + ",Artist - Track "
+                    + QByteArray::number(i) + '\n';
+            data += "/music/album" + QByteArray::number(i / 12) + "/track"
+                    + QByteArray::number(i % 12) + ".ogg\n";
+        }
+        QTest::addRow("%d entries", count) << data << count;
+    }
+}
+
+// Loading from a URL goes through the playlist file parser that
+// QMediaPlayer uses as well, rather than through an I/O plugin.
+void tst_QMediaPlaylistBenchmark::loadM3u()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(int, count);
+
+    QVERIFY(m_dir.isValid());
+    QFile file(m_dir.filePath(QStringLiteral("playlist%1.m3u").arg(count)));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+    file.close();
+    const QUrl location = QUrl::fromLocalFile(file.fileName());
+
+    QBENCHMARK {
+        QMediaPlaylist playlist;
+        bool done = false;
+        connect(&playlist, &QMediaPlaylist::loaded, [&done]() { done = true; });
+        connect(&playlist, &QMediaPlaylist::loadFailed, [&done]() { done = true; });
+        playlist.load(location, "m3u");
+        QVERIFY(QTest::qWaitFor([&done]() { return done; }));
+
+        QCOMPARE(playlist.error(), QMediaPlaylist::NoError);
+        QCOMPARE(playlist.mediaCount(), count);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QMediaPlaylistBenchmark)
+
+#include "tst_bench_qmediaplaylist.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_bench_qmediatimerange
+
+QT += multimedia testlib
+CONFIG += benchmark
+
+SOURCES += tst_bench_qmediatimerange.cpp
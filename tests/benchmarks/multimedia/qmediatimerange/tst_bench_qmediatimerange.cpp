@@ -0,0 +1,185 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qmediatimerange.h>
+
+QT_USE_NAMESPACE
+
+class tst_QMediaTimeRangeBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void addDisjointIntervals_data();
+    void addDisjointIntervals();
+    void addOverlappingIntervals_data();
+    void addOverlappingIntervals();
+    void contains_data();
+    void contains();
+    void removeIntervals_data();
+    void removeIntervals();
+    void unite_data();
+    void unite();
+    void subtract_data();
+    void subtract();
+
+private:
+    void intervalCountData();
+};
+
+// Disjoint intervals of 10 units, 10 units apart, added in ascending order
+// the way buffered ranges usually grow.
+static QMediaTimeRange disjointRange(int count, qint64 offset = 0)
+{
+    QMediaTimeRange range;
+    for (int i = 0; i < count; ++i)
+        range.addInterval(offset + i * 20, offset + i * 20 + 9);
+    return range;
+}
+
+void tst_QMediaTimeRangeBenchmark::intervalCountData()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void tst_QMediaTimeRangeBenchmark::addDisjointIntervals_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::addDisjointIntervals()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        QMediaTimeRange range = disjointRange(count);
+        Q_UNUSED(range);
+    }
+}
+
+void tst_QMediaTimeRangeBenchmark::addOverlappingIntervals_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::addOverlappingIntervals()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        QMediaTimeRange range;
+        for (int i = 0; i < count; ++i)
+            range.addInterval(i * 10, i * 10 + 15);
+        QVERIFY(range.isContinuous());
+    }
+}
+
+void tst_QMediaTimeRangeBenchmark::contains_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::contains()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange range = disjointRange(count);
+    const qint64 end = range.latestTime();
+
+    QBENCHMARK {
+        int hits = 0;
+        for (qint64 time = 0; time <= end; time += 7)
+            hits += range.contains(time) ? 1 : 0;
+        QVERIFY(hits > 0);
+    }
+}
+
+void tst_QMediaTimeRangeBenchmark::removeIntervals_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::removeIntervals()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange source = disjointRange(count);
+
+    QBENCHMARK {
+        QMediaTimeRange range = source;
+        for (int i = 0; i < count; ++i)
+            range.removeInterval(i * 20 + 3, i * 20 + 5);
+        QCOMPARE(range.intervals().size(), count * 2);
+    }
+}
+
+void tst_QMediaTimeRangeBenchmark::unite_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::unite()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange a = disjointRange(count);
+    const QMediaTimeRange b = disjointRange(count, 10);
+
+    QBENCHMARK {
+        const QMediaTimeRange result = a + b;
+        QVERIFY(result.isContinuous());
+    }
+}
+
+void tst_QMediaTimeRangeBenchmark::subtract_data()
+{
+    intervalCountData();
+}
+
+void tst_QMediaTimeRangeBenchmark::subtract()
+{
+    QFETCH(int, count);
+
+    const QMediaTimeRange a(0, count * 20);
+    const QMediaTimeRange b = disjointRange(count);
+
+    QBENCHMARK {
+        const QMediaTimeRange result = a - b;
+        QCOMPARE(result.intervals().size(), count);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMediaTimeRangeBenchmark)
+
+#include "tst_bench_qmediatimerange.moc"
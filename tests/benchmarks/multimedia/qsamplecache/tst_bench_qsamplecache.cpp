@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qsamplecache_p.h>
+
+#include <QtCore/qendian.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtimer.h>
+
+QT_USE_NAMESPACE
+
+class tst_QSampleCacheBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void load_data();
+    void load();
+    void cachedRequest();
+    void evict();
+
+private:
+    QUrl createSample(const QString &name, int seconds);
+    static bool waitForSample(QSample *sample);
+
+    QTemporaryDir m_dir;
+    QList<QUrl> m_evictionSamples;
+};
+
+QUrl tst_QSampleCacheBenchmark::createSample(const QString &name, int seconds)
+{
+    // 44.1 kHz stereo 16 bit PCM
+    const quint32 byteRate = 44100 * 2 * 2;
+    const quint32 dataSize = byteRate * seconds;
+
+    QByteArray header;
+    auto appendLE32 = [&header](quint32 value) {
+        char bytes[4];
+        qToLittleEndian(value, bytes);
+        header.append(bytes, 4);
+    };
+    auto appendLE16 = [&header](quint16 value) {
+        char bytes[2];
+        qToLittleEndian(value, bytes);
+        header.append(bytes, 2);
+    };
+    header.append("RIFF", 4);
+    appendLE32(36 + dataSize);
+    header.append("WAVEfmt ", 8);
+    appendLE32(16);
+    appendLE16(1);
+    appendLE16(2);
+    appendLE32(44100);
+    appendLE32(byteRate);
+    appendLE16(4);
+    appendLE16(16);
+    header.append("data", 4);
+    appendLE32(dataSize);
+
+    QByteArray samples(int(dataSize), Qt::Uninitialized);
+    for (int i = 0; i < samples.size(); ++i)
+        samples[i] = char(i * 17);
+
+    QFile file(m_dir.filePath(name));
+    if (!file.open(QIODevice::WriteOnly))
+        return QUrl();
+    file.write(header);
+    file.write(samples);
+
+    return QUrl::fromLocalFile(file.fileName());
+}
+
+bool tst_QSampleCacheBenchmark::waitForSample(QSample *sample)
+{
+    // The sample is decoded on the cache's loading thread. Wake up as soon as
+    // it is done, instead of polling, so the timings don't include sleeps.
+    // Connecting before checking the state ensures no signal is missed.
+    QEventLoop loop;
+    QObject::connect(sample, &QSample::ready, &loop, &QEventLoop::quit);
+    QObject::connect(sample, &QSample::error, &loop, &QEventLoop::quit);
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+
+    const QSample::State state = sample->state();
+    if (state != QSample::Ready && state != QSample::Error)
+        loop.exec();
+
+    return sample->state() == QSample::Ready;
+}
+
+void tst_QSampleCacheBenchmark::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    for (int i = 0; i < 4; ++i) {
+        const QUrl url = createSample(QStringLiteral("evict%1.wav").arg(i), 1);
+        QVERIFY(url.isValid());
+        m_evictionSamples.append(url);
+    }
+}
+
+void tst_QSampleCacheBenchmark::load_data()
+{
+    QTest::addColumn<int>("seconds");
+
+    QTest::newRow("1 s") << 1;
+    QTest::newRow("5 s") << 5;
+    QTest::newRow("20 s") << 20;
+}
+
+// Capacity 0 unloads a sample as soon as it is released, so every
+// iteration decodes the file again.
+void tst_QSampleCacheBenchmark::load()
+{
+    QFETCH(int, seconds);
+
+    const QUrl url = createSample(QStringLiteral("load%1.wav").arg(seconds), seconds);
+    QVERIFY(url.isValid());
+
+    QSampleCache cache;
+
+    QBENCHMARK {
+        QSample *sample = cache.requestSample(url);
+        QVERIFY(waitForSample(sample));
+        sample->release();
+    }
+
+    QVERIFY(!cache.isCached(url));
+}
+
+void tst_QSampleCacheBenchmark::cachedRequest()
+{
+    QSampleCache cache;
+    cache.setCapacity(64 * 1024 * 1024);
+
+    const QUrl url = m_evictionSamples.first();
+    QSample *sample = cache.requestSample(url);
+    QVERIFY(waitForSample(sample));
+    sample->release();
+    QVERIFY(cache.isCached(url));
+
+    QBENCHMARK {
+        sample = cache.requestSample(url);
+        QVERIFY(waitForSample(sample));
+        sample->release();
+    }
+}
+
+// The capacity holds two of the four samples, so cycling through them
+// evicts the least recently used one on every request.
+void tst_QSampleCacheBenchmark::evict()
+{
+    QSampleCache cache;
+
+    QSample *sample = cache.requestSample(m_evictionSamples.first());
+    QVERIFY(waitForSample(sample));
+    const qint64 sampleSize = sample->data().size();
+    sample->release();
+    cache.setCapacity(sampleSize * 2);
+
+    int next = 0;
+    QBENCHMARK {
+        sample = cache.requestSample(m_evictionSamples.at(next));
+        QVERIFY(waitForSample(sample));
+        sample->release();
+        next = (next + 1) % m_evictionSamples.size();
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QSampleCacheBenchmark)
+
+#include "tst_bench_qsamplecache.moc"
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <qvideoframe.h>
+
+QT_USE_NAMESPACE
+
+class tst_QVideoFrameBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void convert_data();
+    void convert();
+};
+
+static const struct
+{
+    QVideoFrame::PixelFormat format;
+    const char *name;
+    int bytesPerPixel; // of the first plane
+    bool subsampledPlanes;
+} converterFormats[] = {
+    { QVideoFrame::Format_BGRA32, "BGRA32", 4, false },
+    { QVideoFrame::Format_BGRA32_Premultiplied, "BGRA32_Premultiplied", 4, false },
+    { QVideoFrame::Format_BGR32, "BGR32", 4, false },
+    { QVideoFrame::Format_BGR24, "BGR24", 3, false },
+    { QVideoFrame::Format_BGR565, "BGR565", 2, false },
+    { QVideoFrame::Format_BGR555, "BGR555", 2, false },
+    { QVideoFrame::Format_AYUV444, "AYUV444", 4, false },
+    { QVideoFrame::Format_YUV444, "YUV444", 3, false },
+    { QVideoFrame::Format_YUV420P, "YUV420P", 1, true },
+    { QVideoFrame::Format_YV12, "YV12", 1, true },
+    { QVideoFrame::Format_UYVY, "UYVY", 2, false },
+    { QVideoFrame::Format_YUYV, "YUYV", 2, false },
+    { QVideoFrame::Format_NV12, "NV12", 1, true },
+    { QVideoFrame::Format_NV21, "NV21", 1, true }
+};
+
+static const QSize resolutions[] = {
+    QSize(320, 240),
+    QSize(640, 480),
+    QSize(1280, 720),
+    QSize(1920, 1080),
+    QSize(3840, 2160)
+};
+
+void tst_QVideoFrameBenchmark::convert_data()
+{
+    QTest::addColumn<QVideoFrame::PixelFormat>("pixelFormat");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("bytesPerLine");
+    QTest::addColumn<int>("mappedBytes");
+
+    for (const auto &format : converterFormats) {
+        for (const QSize &size : resolutions) {
+            const int bytesPerLine = size.width() * format.bytesPerPixel;
+            const int mappedBytes = format.subsampledPlanes
+                    ? bytesPerLine * size.height() * 3 / 2
+                    : bytesPerLine * size.height();
+
+            QTest::addRow("%s %dx%d", format.name, size.width(), size.height())
+                    << format.format << size << bytesPerLine << mappedBytes;
+        }
+    }
+}
+
+// QVideoFrame::image() is the only way into the converter table, so this
+// also measures mapping the frame and allocating the destination image.
+void tst_QVideoFrameBenchmark::convert()
+{
+    QFETCH(QVideoFrame::PixelFormat, pixelFormat);
+    QFETCH(QSize, size);
+    QFETCH(int, bytesPerLine);
+    QFETCH(int, mappedBytes);
+
+    QVideoFrame frame(mappedBytes, size, bytesPerLine, pixelFormat);
+    QVERIFY(frame.map(QAbstractVideoBuffer::WriteOnly));
+    uchar *bits = frame.bits();
+    for (int i = 0; i < mappedBytes; ++i)
+        bits[i] = uchar(i * 7);
+    frame.unmap();
+
+    QVERIFY(!frame.image().isNull());
+
+    QBENCHMARK {
+        QImage image = frame.image();
+        Q_UNUSED(image);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QVideoFrameBenchmark)
+
+#include "tst_bench_qvideoframe.moc"
@@ -0,0 +1,8 @@
+TARGET = tst_bench_qwavedecoder
+
+QT += multimedia-private testlib
+CONFIG += benchmark
+
+HEADERS += ../../../../src/multimedia/audio/qwavedecoder_p.h
+SOURCES += tst_bench_qwavedecoder.cpp \
+           ../../../../src/multimedia/audio/qwavedecoder_p.cpp
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qwavedecoder_p.h>
+
+#include <QtCore/qbuffer.h>
+#include <QtCore/qendian.h>
+
+QT_USE_NAMESPACE
+
+class tst_QWaveDecoderBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode_data();
+    void decode();
+};
+
+static QByteArray createWave(int sampleRate, int channels, int sampleSize, int seconds)
+{
+    const quint32 dataSize = quint32(sampleRate) * channels * (sampleSize / 8) * seconds;
+
+    QByteArray wave;
+    wave.reserve(int(dataSize) + 44);
+
+    auto appendLE32 = [&wave](quint32 value) {
+        char bytes[4];
+        qToLittleEndian(value, bytes);
+        wave.append(bytes, 4);
+    };
+    auto appendLE16 = [&wave](quint16 value) {
+        char bytes[2];
+        qToLittleEndian(value, bytes);
+        wave.append(bytes, 2);
+    };
+
+    wave.append("RIFF", 4);
+    appendLE32(36 + dataSize);
+    wave.append("WAVE", 4);
+    wave.append("fmt ", 4);
+    appendLE32(16);
+    appendLE16(1); // PCM
+    appendLE16(quint16(channels));
+    appendLE32(quint32(sampleRate));
+    appendLE32(quint32(sampleRate) * channels * (sampleSize / 8));
+    appendLE16(quint16(channels * (sampleSize / 8)));
+    appendLE16(quint16(sampleSize));
+    wave.append("data", 4);
+    appendLE32(dataSize);
+
+    const int headerSize = wave.size();
+    wave.resize(headerSize + int(dataSize));
+    char *samples = wave.data() + headerSize;
+    for (quint32 i = 0; i < dataSize; ++i)
+        samples[i] = char(i * 31);
+
+    return wave;
+}
+
+void tst_QWaveDecoderBenchmark::decode_data()
+{
+    QTest::addColumn<QByteArray>("wave");
+    QTest::addColumn<bool>("readAll");
+
+    QTest::newRow("header only") << createWave(44100, 2, 16, 0) << false;
+    QTest::newRow("1 s 8 kHz mono 8 bit") << createWave(8000, 1, 8, 1) << true;
+    QTest::newRow("1 s 44.1 kHz stereo 16 bit") << createWave(44100, 2, 16, 1) << true;
+    QTest::newRow("10 s 44.1 kHz stereo 16 bit") << createWave(44100, 2, 16, 10) << true;
+    QTest::newRow("10 s 48 kHz stereo 32 bit") << createWave(48000, 2, 32, 10) << true;
+}
+
+// Parsing is driven from the event loop, so every iteration spins it until
+// the decoder reported the format and then drains the sample data.
+void tst_QWaveDecoderBenchmark::decode()
+{
+    QFETCH(QByteArray, wave);
+    QFETCH(bool, readAll);
+
+    QBENCHMARK {
+        QBuffer buffer(&wave);
+        buffer.open(QIODevice::ReadOnly);
+
+        QWaveDecoder decoder(&buffer);
+        bool done = false;
+        connect(&decoder, &QWaveDecoder::formatKnown, [&done]() { done = true; });
+        connect(&decoder, &QWaveDecoder::parsingError, [&done]() { done = true; });
+        while (!done)
+            QCoreApplication::processEvents();
+
+        QVERIFY(decoder.audioFormat().isValid());
+        if (readAll)
+            QCOMPARE(decoder.readAll().size(), wave.size() - 44);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QWaveDecoderBenchmark)
+
+#include "tst_bench_qwavedecoder.moc"